@@ -0,0 +1,617 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <CLI/CLI.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <vrs/RecordFileReader.h>
+
+#include <benchmarks/SyntheticAriaRecording.h>
+#include <benchmarks/SyntheticRecordingCli.h>
+#include <calibration/camera_projections/FisheyeRadTanThinPrism.h>
+#include <calibration/utility/Distort.h>
+#include <data_provider/VrsDataProvider.h>
+#include <image/utility/Debayer.h>
+#include <image/utility/Resize.h>
+#include <image/utility/TensorConversion.h>
+#include <mps/EyeGazeReader.h>
+#include <mps/GlobalPointCloudReader.h>
+#include <mps/HandTrackingReader.h>
+#include <mps/OnlineCalibrationsReader.h>
+#include <mps/TrajectoryReaders.h>
+#include <trace/Trace.h>
+
+#define DEFAULT_LOG_CHANNEL "ProjectAriaToolsBenchmarks"
+#include <logging/Log.h>
+
+namespace fs = std::filesystem;
+
+using namespace projectaria::tools;
+using namespace projectaria::tools::data_provider;
+
+#define STRING(x) #x
+#define XSTRING(x) std::string(STRING(x))
+
+namespace {
+
+// Version of the layout of the results, to be bumped when fields change meaning
+constexpr int kResultsSchemaVersion = 1;
+
+constexpr size_t kNumRandomQueries = 256;
+constexpr size_t kNumCalibrationPoints = 100'000;
+
+// Results of the benchmarks are accumulated here, so that no work can be optimized away
+uint64_t gChecksum = 0;
+
+class BenchmarkSuite {
+ public:
+  BenchmarkSuite(int numRepeats, std::string filter)
+      : numRepeats_(std::max(numRepeats, 1)), filter_(std::move(filter)) {}
+
+  bool isSelected(const std::string& name) const {
+    return filter_.empty() || name.find(filter_) != std::string::npos;
+  }
+
+  /**
+   * Runs a benchmark once to warm up, then numRepeats times
+   * @param body runs the benchmark once and returns the number of items it processed
+   * @param setup if set, runs before each run of the benchmark, untimed
+   */
+  void run(
+      const std::string& name,
+      const std::function<size_t()>& body,
+      const std::function<void()>& setup = {}) {
+    if (!isSelected(name)) {
+      return;
+    }
+    if (setup) {
+      setup();
+    }
+    body();
+    trace::resetTraceStats();
+    std::vector<int64_t> runNs;
+    size_t numItems = 0;
+    for (int repeat = 0; repeat < numRepeats_; ++repeat) {
+      if (setup) {
+        setup();
+      }
+      const auto start = std::chrono::steady_clock::now();
+      numItems = body();
+      runNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count());
+    }
+    std::sort(runNs.begin(), runNs.end());
+
+    nlohmann::json result;
+    result["name"] = name;
+    result["items"] = numItems;
+    result["repeats"] = numRepeats_;
+    result["min_ns"] = runNs.front();
+    result["median_ns"] = runNs[runNs.size() / 2];
+    result["max_ns"] = runNs.back();
+    result["items_per_sec"] = runNs.front() > 0 ? numItems * 1e9 / runNs.front() : 0.0;
+    for (const auto& [traceName, stats] : trace::getTraceStats()) {
+      if (stats.count > 0) {
+        result["traces"][traceName] = {
+            {"count", stats.count}, {"total_ns", stats.totalNs}, {"max_ns", stats.maxNs}};
+      }
+    }
+    XR_LOGI(
+        "{}: {} items in {:.3f} ms (median {:.3f} ms), {:.1f} items/s",
+        name,
+        numItems,
+        runNs.front() * 1e-6,
+        runNs[runNs.size() / 2] * 1e-6,
+        result["items_per_sec"].get<double>());
+    results_.push_back(std::move(result));
+  }
+
+  const nlohmann::json& getResults() const {
+    return results_;
+  }
+
+ private:
+  const int numRepeats_;
+  const std::string filter_;
+  nlohmann::json results_ = nlohmann::json::array();
+};
+
+std::string getStreamName(const VrsDataProvider& provider, const vrs::StreamId& streamId) {
+  return provider.getLabelFromStreamId(streamId).value_or(streamId.getNumericName());
+}
+
+uint64_t consumeSensorData(const SensorData& sensorData) {
+  uint64_t checksum = sensorData.getTimeNs(TimeDomain::DeviceTime);
+  if (sensorData.sensorDataType() == SensorDataType::Image) {
+    const auto image = sensorData.imageDataAndRecord().first.imageVariant();
+    checksum += image ? 1 : 0;
+  }
+  return checksum;
+}
+
+void benchmarkProviderOpen(BenchmarkSuite& suite, const std::string& vrsPath) {
+  for (const bool lazyInitialization : {false, true}) {
+    VrsDataProviderOpenOptions options;
+    options.lazyInitialization = lazyInitialization;
+    suite.run(lazyInitialization ? "provider_open/lazy" : "provider_open/eager", [&]() {
+      auto provider = createVrsDataProvider(vrsPath, options);
+      checkAndThrow(provider != nullptr, "Cannot open " + vrsPath);
+      gChecksum += provider->getAllStreams().size();
+      return size_t(1);
+    });
+  }
+}
+
+void benchmarkRandomAccess(BenchmarkSuite& suite, VrsDataProvider& provider) {
+  std::mt19937 rng(0);
+  for (const auto& streamId : provider.getAllStreams()) {
+    const size_t numData = provider.getNumData(streamId);
+    if (numData == 0) {
+      continue;
+    }
+    const std::string name = getStreamName(provider, streamId);
+
+    std::uniform_int_distribution<int> indexDistribution(0, static_cast<int>(numData) - 1);
+    std::vector<int> indices(kNumRandomQueries);
+    std::generate(indices.begin(), indices.end(), [&]() { return indexDistribution(rng); });
+    suite.run("random_access_by_index/" + name, [&]() {
+      for (const int index : indices) {
+        gChecksum += consumeSensorData(provider.getSensorDataByIndex(streamId, index));
+      }
+      return indices.size();
+    });
+
+    std::uniform_int_distribution<int64_t> timeDistribution(
+        provider.getFirstTimeNs(streamId, TimeDomain::DeviceTime),
+        provider.getLastTimeNs(streamId, TimeDomain::DeviceTime));
+    std::vector<int64_t> timesNs(kNumRandomQueries);
+    std::generate(timesNs.begin(), timesNs.end(), [&]() { return timeDistribution(rng); });
+    suite.run("random_access_by_time/" + name, [&]() {
+      for (const int64_t timeNs : timesNs) {
+        gChecksum += consumeSensorData(provider.getSensorDataByTimeNs(
+            streamId, timeNs, TimeDomain::DeviceTime, TimeQueryOptions::Closest));
+      }
+      return timesNs.size();
+    });
+  }
+}
+
+void benchmarkReplay(BenchmarkSuite& suite, VrsDataProvider& provider) {
+  const auto replay = [&](const DeliverQueuedOptions& options) {
+    size_t numRecords = 0;
+    for (const auto& sensorData : provider.deliverQueuedSensorData(options)) {
+      gChecksum += sensorData.getTimeNs(TimeDomain::DeviceTime);
+      ++numRecords;
+    }
+    return numRecords;
+  };
+
+  // IMU-only replay exercises the merge with few, high-rate streams
+  DeliverQueuedOptions imuOptions = provider.getDefaultDeliverQueuedOptions();
+  imuOptions.deactivateStreamAll();
+  imuOptions.activateStream(vrs::RecordableTypeId::SlamImuData);
+  suite.run("sequential_replay/imu", [&]() { return replay(imuOptions); });
+
+  // All-streams replay includes image and audio payloads
+  const DeliverQueuedOptions allOptions = provider.getDefaultDeliverQueuedOptions();
+  suite.run("sequential_replay/all", [&]() { return replay(allOptions); });
+}
+
+// Drops the pages of files from the page cache, so that the next reads go to the storage. Returns
+// false where this is not supported.
+bool evictFromPageCache(const std::vector<std::string>& paths) {
+#if defined(__linux__)
+  for (const auto& path : paths) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return false;
+    }
+    ::fdatasync(fd); // dirty pages are not dropped
+    const bool evicted = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    ::close(fd);
+    if (!evicted) {
+      return false;
+    }
+  }
+  return true;
+#else
+  (void)paths;
+  return false;
+#endif
+}
+
+// Replays and strided reads from a cold page cache, with and without reading records ahead
+void benchmarkColdCache(BenchmarkSuite& suite, const std::string& vrsPath) {
+  std::vector<std::string> chunkPaths;
+  vrs::RecordFileReader fileReader;
+  if (fileReader.openFile(vrsPath) == 0) {
+    for (const auto& [chunkPath, chunkSize] : fileReader.getFileChunks()) {
+      chunkPaths.push_back(chunkPath);
+    }
+  }
+  if (chunkPaths.empty() || !evictFromPageCache(chunkPaths)) {
+    XR_LOGW("Cannot drop {} from the page cache, skipping the cold cache benchmarks", vrsPath);
+    return;
+  }
+  const auto evict = [&]() { evictFromPageCache(chunkPaths); };
+
+  auto provider = createVrsDataProvider(vrsPath);
+  checkAndThrow(provider != nullptr, "Cannot open " + vrsPath);
+  const DeliverQueuedOptions allOptions = provider->getDefaultDeliverQueuedOptions();
+  for (const auto& [patternName, pattern] :
+       {std::make_pair("random", AccessPattern::Random),
+        std::make_pair("sequential", AccessPattern::Sequential)}) {
+    provider->setAccessPattern(pattern);
+    suite.run(
+        fmt::format("cold_cache_replay/{}", patternName),
+        [&]() {
+          size_t numRecords = 0;
+          for (const auto& sensorData : provider->deliverQueuedSensorData(allOptions)) {
+            gChecksum += sensorData.getTimeNs(TimeDomain::DeviceTime);
+            ++numRecords;
+          }
+          return numRecords;
+        },
+        evict);
+  }
+
+  // every 4th RGB frame, as when sampling training frames
+  constexpr int kStride = 4;
+  const auto rgbStreamId = provider->getStreamIdFromLabel("camera-rgb");
+  if (!rgbStreamId || !provider->checkStreamIsActive(*rgbStreamId)) {
+    return;
+  }
+  const int numFrames = static_cast<int>(provider->getNumData(*rgbStreamId));
+  for (const auto& [patternName, pattern] :
+       {std::make_pair("random", AccessPattern::Random),
+        std::make_pair("strided", AccessPattern::Strided)}) {
+    provider->setAccessPattern(pattern);
+    suite.run(
+        fmt::format("cold_cache_strided/{}", patternName),
+        [&]() {
+          size_t numRead = 0;
+          for (int index = 0; index < numFrames; index += kStride) {
+            gChecksum += provider->getImageDataByIndex(*rgbStreamId, index).second.frameNumber;
+            ++numRead;
+          }
+          return numRead;
+        },
+        evict);
+  }
+}
+
+void benchmarkDebayer(BenchmarkSuite& suite, const VrsDataProvider& provider) {
+  int width = 1408;
+  int height = 1408;
+  if (const auto streamId = provider.getStreamIdFromLabel("camera-rgb")) {
+    const auto config = provider.getImageConfiguration(*streamId);
+    width = static_cast<int>(config.imageWidth);
+    height = static_cast<int>(config.imageHeight);
+  }
+  image::ManagedImageU8 raw(width, height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      raw(x, y) = static_cast<uint8_t>((x * 7 + y * 13) & 0xff);
+    }
+  }
+  suite.run(fmt::format("debayer/{}x{}", width, height), [&]() {
+    const auto rgb = image::debayer(raw);
+    gChecksum += rgb(width / 2, height / 2)[0];
+    return size_t(1);
+  });
+
+  // ImageNet normalization of the debayered image, into the input tensor of a model
+  const image::ManagedImage3U8 rgb = image::debayer(raw);
+  image::TensorConversionOptions options;
+  options.mean = {0.485f, 0.456f, 0.406f};
+  options.std = {0.229f, 0.224f, 0.225f};
+  const size_t tensorSize = static_cast<size_t>(width) * height * 3;
+  std::vector<float> tensor(tensorSize);
+  std::vector<Eigen::half> halfTensor(tensorSize);
+  for (const auto layout : {image::TensorLayout::CHW, image::TensorLayout::HWC}) {
+    options.layout = layout;
+    const char* layoutName = layout == image::TensorLayout::CHW ? "chw" : "hwc";
+    suite.run(fmt::format("image_to_tensor/rgb_f32_{}", layoutName), [&]() {
+      image::imageToTensor(rgb, options, tensor.data());
+      gChecksum += static_cast<int64_t>(tensor[tensorSize / 2] * 1000);
+      return size_t(1);
+    });
+    suite.run(fmt::format("image_to_tensor/rgb_f16_{}", layoutName), [&]() {
+      image::imageToTensor(rgb, options, halfTensor.data());
+      gChecksum += static_cast<int64_t>(static_cast<float>(halfTensor[tensorSize / 2]) * 1000);
+      return size_t(1);
+    });
+  }
+  options.layout = image::TensorLayout::CHW;
+  options.grayToRgb = true;
+  suite.run("image_to_tensor/gray_to_rgb_f32_chw", [&]() {
+    image::imageToTensor(raw, options, tensor.data());
+    gChecksum += static_cast<int64_t>(tensor[tensorSize / 2] * 1000);
+    return size_t(1);
+  });
+
+  // thumbnails and training downscales of the debayered image, and feature extraction pyramids
+  const Eigen::Vector2i thumbnailSize(width / 4, height / 4);
+  for (const auto& [methodName, method] :
+       {std::make_pair("area", image::ResizeMethod::Area),
+        std::make_pair("bilinear", image::ResizeMethod::Bilinear),
+        std::make_pair("lanczos3", image::ResizeMethod::Lanczos3)}) {
+    suite.run(fmt::format("resize/{}", methodName), [&]() {
+      const auto resized = image::resizeImageVariant(rgb, thumbnailSize, method);
+      gChecksum += image::getWidth(image::toImageVariant(resized));
+      return size_t(1);
+    });
+  }
+  for (const auto& [filterName, filter] :
+       {std::make_pair("gaussian", image::PyramidFilter::Gaussian),
+        std::make_pair("box", image::PyramidFilter::Box)}) {
+    suite.run(fmt::format("pyramid/{}", filterName), [&]() {
+      gChecksum += image::buildImagePyramid(raw, 4, filter).size();
+      return size_t(1);
+    });
+  }
+}
+
+void benchmarkCalibration(BenchmarkSuite& suite, VrsDataProvider& provider) {
+  const auto maybeDeviceCalib = provider.getDeviceCalibration();
+  if (!maybeDeviceCalib) {
+    XR_LOGW("No calibration, skipping the distortion and projection benchmarks");
+    return;
+  }
+  for (const auto& label : maybeDeviceCalib->getCameraLabels()) {
+    const auto camCalib = maybeDeviceCalib->getCameraCalib(label).value();
+    const Eigen::Vector2i imageSize = camCalib.getImageSize();
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> xDistribution(0, imageSize.x() - 1);
+    std::uniform_real_distribution<double> yDistribution(0, imageSize.y() - 1);
+    std::vector<Eigen::Vector2d> pixels(kNumCalibrationPoints);
+    std::vector<Eigen::Vector3d> rays(kNumCalibrationPoints);
+    for (size_t i = 0; i < kNumCalibrationPoints; ++i) {
+      pixels[i] = {xDistribution(rng), yDistribution(rng)};
+      rays[i] = camCalib.unprojectNoChecks(pixels[i]);
+    }
+    suite.run("calibration_project/" + label, [&]() {
+      for (const auto& ray : rays) {
+        gChecksum += camCalib.project(ray).has_value();
+      }
+      return rays.size();
+    });
+    // the batch keeps its buffers across runs, as a refinement loop would
+    const Eigen::Matrix3Xd points = Eigen::Map<const Eigen::Matrix3Xd>(
+        rays.front().data(), 3, static_cast<Eigen::Index>(rays.size()));
+    Eigen::Matrix2Xd batchPixels;
+    calibration::CameraProjection::BatchJacobians jacobiansWrtPoint;
+    calibration::CameraProjection::BatchJacobians jacobiansWrtParams;
+    suite.run("calibration_project_jacobians/" + label, [&]() {
+      camCalib.projectBatchNoChecks(points, batchPixels, &jacobiansWrtPoint, &jacobiansWrtParams);
+      gChecksum += batchPixels.cols();
+      return rays.size();
+    });
+    suite.run("calibration_unproject/" + label, [&]() {
+      for (const auto& pixel : pixels) {
+        gChecksum += camCalib.unproject(pixel).has_value();
+      }
+      return pixels.size();
+    });
+    if (camCalib.modelName() == calibration::CameraProjection::ModelType::Fisheye624) {
+      // the Newton solver from its default guesses, without the inverse distortion table
+      const Eigen::VectorXd params = camCalib.projectionParams();
+      suite.run("calibration_unproject_newton/" + label, [&]() {
+        for (const auto& pixel : pixels) {
+          gChecksum += calibration::Fisheye624::unproject(pixel, params).z() > 0;
+        }
+        return pixels.size();
+      });
+    }
+
+    // the ET calibrations are per eye, while the ET frames hold both eyes
+    const auto streamId = provider.getStreamIdFromLabel(label);
+    if (!streamId || provider.getNumData(*streamId) == 0) {
+      continue;
+    }
+    const auto image = provider.getImageDataByIndex(*streamId, 0).first.imageVariant();
+    if (!image) {
+      continue;
+    }
+    const auto linearCalib = calibration::getLinearCameraCalibration(
+        imageSize.x(), imageSize.y(), camCalib.getFocalLengths().x(), label);
+    suite.run("distort/" + label, [&]() {
+      const auto distorted = calibration::distortByCalibration(*image, linearCalib, camCalib);
+      gChecksum += distorted.index();
+      return size_t(1);
+    });
+  }
+}
+
+void benchmarkMps(BenchmarkSuite& suite, const fs::path& mpsFolder) {
+  const auto runIfFound = [&](const std::string& name,
+                              const fs::path& relativePath,
+                              const std::function<size_t(const std::string&)>& read) {
+    const fs::path path = mpsFolder / relativePath;
+    if (!fs::exists(path)) {
+      XR_LOGW("{} not found, skipping {}", path.string(), name);
+      return;
+    }
+    suite.run(name, [&]() { return read(path.string()); });
+  };
+
+  runIfFound(
+      "mps/open_loop_trajectory",
+      "trajectory/open_loop_trajectory.csv",
+      [](const std::string& path) { return mps::readOpenLoopTrajectory(path).size(); });
+  runIfFound(
+      "mps/closed_loop_trajectory",
+      "trajectory/closed_loop_trajectory.csv",
+      [](const std::string& path) { return mps::readClosedLoopTrajectory(path).size(); });
+  runIfFound(
+      "mps/global_points",
+      "trajectory/global_points.csv.gz",
+      [](const std::string& path) { return mps::readGlobalPointCloud(path).size(); });
+  runIfFound(
+      "mps/online_calibration",
+      "trajectory/online_calibration.jsonl",
+      [](const std::string& path) { return mps::readOnlineCalibration(path).size(); });
+  runIfFound(
+      "mps/eye_gaze",
+      "eye_gaze/generalized_eye_gaze.csv",
+      [](const std::string& path) { return mps::readEyeGaze(path).size(); });
+  runIfFound(
+      "mps/wrist_and_palm_poses",
+      "hand_tracking/wrist_and_palm_poses.csv",
+      [](const std::string& path) { return mps::readWristAndPalmPoses(path).size(); });
+}
+
+nlohmann::json getRecordingJson(
+    const std::string& vrsPath,
+    const std::optional<benchmarks::SyntheticRecordingOptions>& syntheticOptions) {
+  nlohmann::json recording;
+  recording["path"] = vrsPath;
+  recording["size_bytes"] = fs::file_size(vrsPath);
+  recording["synthetic"] = syntheticOptions.has_value();
+  if (syntheticOptions) {
+    const auto cameraJson = [](const benchmarks::SyntheticCameraOptions& camera) {
+      return nlohmann::json{
+          {"enabled", camera.enabled},
+          {"width", camera.width},
+          {"height", camera.height},
+          {"rate_hz", camera.rateHz},
+          {"encoding",
+           camera.encoding == benchmarks::SyntheticImageEncoding::Jpeg ? "jpeg" : "raw"}};
+    };
+    recording["duration_sec"] = syntheticOptions->durationSec;
+    recording["rgb"] = cameraJson(syntheticOptions->rgb);
+    recording["slam"] = cameraJson(syntheticOptions->slam);
+    recording["et"] = cameraJson(syntheticOptions->et);
+    recording["imu"] = {
+        {"enabled", syntheticOptions->enableImu},
+        {"right_rate_hz", syntheticOptions->imuRightRateHz},
+        {"left_rate_hz", syntheticOptions->imuLeftRateHz}};
+    recording["audio"] = syntheticOptions->enableAudio;
+    recording["barometer"] = syntheticOptions->enableBarometer;
+    recording["time_sync"] = syntheticOptions->enableTimeSync;
+  }
+  return recording;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+  std::string vrsPath;
+  std::string mpsFolder = XSTRING(TEST_FOLDER) + "mps_sample";
+  std::string outputPath;
+  std::string filter;
+  std::string traceOutputPath;
+  int numRepeats = 5;
+  bool keepSyntheticRecording = false;
+  benchmarks::SyntheticRecordingOptions syntheticOptions;
+
+  CLI::App app{
+      "Benchmarks the data access stack of projectaria_tools, on a recording written "
+      "synthetically unless one is given"};
+  app.add_option("--vrs", vrsPath, "Recording to benchmark instead of a synthetic one");
+  app.add_option("--mps-folder", mpsFolder, "Folder of MPS outputs to benchmark the readers on")
+      ->capture_default_str();
+  app.add_option("-o,--output", outputPath, "Path of the JSON file to write the results to");
+  app.add_option("--filter", filter, "Only runs the benchmarks whose name contains this string");
+  app.add_option("--repeats", numRepeats, "Number of timed runs of each benchmark")
+      ->capture_default_str();
+  app.add_option(
+      "--trace-output",
+      traceOutputPath,
+      "Writes a Chrome trace of the runs, if built with PROJECTARIA_TOOLS_ENABLE_TRACING");
+  app.add_flag(
+      "--keep-synthetic-recording",
+      keepSyntheticRecording,
+      "Keeps the synthetic recording next to the results instead of deleting it");
+  benchmarks::addSyntheticRecordingOptions(app, syntheticOptions);
+  CLI11_PARSE(app, argc, argv);
+
+  try {
+    const bool isSynthetic = vrsPath.empty();
+    if (isSynthetic) {
+      const fs::path folder =
+          keepSyntheticRecording && !outputPath.empty() ? fs::path(outputPath).parent_path()
+                                                        : fs::temp_directory_path();
+      vrsPath = (folder / "projectaria_tools_benchmark_synthetic.vrs").string();
+      benchmarks::writeSyntheticAriaRecording(vrsPath, syntheticOptions);
+    }
+
+    if (!traceOutputPath.empty()) {
+      trace::startTraceEventCapture();
+    }
+    BenchmarkSuite suite(numRepeats, filter);
+    benchmarkProviderOpen(suite, vrsPath);
+    auto provider = createVrsDataProvider(vrsPath);
+    checkAndThrow(provider != nullptr, "Cannot open " + vrsPath);
+    benchmarkRandomAccess(suite, *provider);
+    benchmarkReplay(suite, *provider);
+    benchmarkColdCache(suite, vrsPath);
+    benchmarkDebayer(suite, *provider);
+    benchmarkCalibration(suite, *provider);
+    benchmarkMps(suite, mpsFolder);
+    if (!traceOutputPath.empty()) {
+      trace::stopTraceEventCapture();
+      if (!trace::writeChromeTrace(traceOutputPath)) {
+        XR_LOGE("Cannot write {}", traceOutputPath);
+      }
+    }
+
+    nlohmann::json results;
+    results["schema_version"] = kResultsSchemaVersion;
+    results["unix_time"] = static_cast<int64_t>(std::time(nullptr));
+    results["tracing_compiled_in"] = trace::isTracingCompiledIn();
+    results["recording"] = getRecordingJson(
+        vrsPath, isSynthetic ? std::make_optional(syntheticOptions) : std::nullopt);
+    results["benchmarks"] = suite.getResults();
+    XR_LOGD("Checksum: {}", gChecksum);
+
+    if (isSynthetic && !keepSyntheticRecording) {
+      provider.reset();
+      fs::remove(vrsPath);
+    }
+    if (outputPath.empty()) {
+      fmt::print("{}\n", results.dump(2));
+    } else {
+      std::ofstream outputFile(outputPath);
+      outputFile << results.dump(2) << std::endl;
+      checkAndThrow(static_cast<bool>(outputFile), "Cannot write " + outputPath);
+    }
+  } catch (const std::exception& e) {
+    XR_LOGE("{}", e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
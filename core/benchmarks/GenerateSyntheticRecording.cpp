@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+#include <CLI/CLI.hpp>
+
+#include <benchmarks/SyntheticAriaRecording.h>
+#include <benchmarks/SyntheticRecordingCli.h>
+
+#define DEFAULT_LOG_CHANNEL "GenerateSyntheticRecording"
+#include <logging/Log.h>
+
+using namespace projectaria::tools::benchmarks;
+
+int main(int argc, const char* argv[]) {
+  std::string outputPath;
+  SyntheticRecordingOptions options;
+
+  CLI::App app{"Writes a synthetic Aria recording, e.g. to benchmark the data access stack"};
+  app.add_option("-o,--output", outputPath, "Path of the VRS file to write")->required();
+  addSyntheticRecordingOptions(app, options);
+  CLI11_PARSE(app, argc, argv);
+
+  try {
+    writeSyntheticAriaRecording(outputPath, options);
+  } catch (const std::exception& e) {
+    XR_LOGE("{}", e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,772 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmarks/SyntheticAriaRecording.h>
+
+#include <algorithm>
+#include <cmath>
+#include <csetjmp>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+#include <jpeglib.h>
+#include <nlohmann/json.hpp>
+
+#include <data_layout/AudioMetadata.h>
+#include <data_layout/BarometerMetadata.h>
+#include <data_layout/ImageSensorMetadata.h>
+#include <data_layout/MotionSensorMetadata.h>
+#include <data_layout/TimeSyncMetadata.h>
+#include <vrs/DataSource.h>
+#include <vrs/ErrorCode.h>
+#include <vrs/RecordFileWriter.h>
+#include <vrs/RecordFormat.h>
+#include <vrs/Recordable.h>
+
+#define DEFAULT_LOG_CHANNEL "SyntheticAriaRecording"
+#include <logging/Log.h>
+
+namespace projectaria::tools::benchmarks {
+
+namespace {
+
+constexpr const char* kDeviceType = "Aria";
+constexpr const char* kDeviceVersion = "DVT-S";
+
+// Configuration and state records are written just before the first data records
+constexpr double kConfigurationLeadSec = 1e-3;
+// Records are created and handed to the writer thread one slice of device time at a time
+constexpr int64_t kWriteSliceNs = 100'000'000;
+// Distinct frames generated per camera, cycled over the recording
+constexpr size_t kMaxDistinctFrames = 8;
+constexpr size_t kDistinctFramesMaxBytes = size_t(64) << 20;
+
+// ---------------------------------------------------------------------------------------------
+// Calibration
+
+nlohmann::json makeSe3Json(const std::vector<double>& translation, const std::vector<double>& q) {
+  return {{"Translation", translation}, {"UnitQuaternion", {q.at(0), {q.at(1), q.at(2), q.at(3)}}}};
+}
+
+nlohmann::json makeCameraCalibrationJson(
+    const std::string& label,
+    const std::string& projectionName,
+    const std::vector<double>& params,
+    const std::vector<double>& translation,
+    const std::vector<double>& quaternion) {
+  return {
+      {"Calibrated", true},
+      {"Label", label},
+      {"Projection", {{"Name", projectionName}, {"Params", params}}},
+      {"SerialNumber", ""},
+      {"T_Device_Camera", makeSe3Json(translation, quaternion)}};
+}
+
+nlohmann::json makeImuCalibrationJson(
+    const std::string& label,
+    const std::vector<double>& translation,
+    const std::vector<double>& quaternion) {
+  const nlohmann::json identity = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+  const nlohmann::json rectificationModel = {
+      {"Bias", {{"Name", "Constant"}, {"Offset", {0, 0, 0}}}},
+      {"Model", {{"Name", "Linear"}, {"RectificationMatrix", identity}}}};
+  return {
+      {"Accelerometer", rectificationModel},
+      {"Calibrated", true},
+      {"Gyroscope", rectificationModel},
+      {"Label", label},
+      {"SerialNumber", ""},
+      {"T_Device_Imu", makeSe3Json(translation, quaternion)}};
+}
+
+// Factory calibration of an Aria device, with ideal IMU intrinsics
+std::string makeCalibrationJson(const std::string& deviceSerial) {
+  nlohmann::json cameras = nlohmann::json::array();
+  cameras.push_back(makeCameraCalibrationJson(
+      "camera-slam-left",
+      "FisheyeRadTanThinPrism",
+      {241.3750342062049,     319.3992373928093,     235.3488155379409,
+       -0.02554250257507565,  0.09818043472962913,   -0.06800698506684882,
+       0.01004754653459986,   0.002113819488461028,  -0.0005372539409039102,
+       0.001928921054449906,  -0.001817644365036563, -0.001327331685747781,
+       5.066172231610697e-05, 0.002483775134654251,  -1.164500067938774e-05},
+      {0, 0, 0},
+      {1, 0, 0, 0}));
+  cameras.push_back(makeCameraCalibrationJson(
+      "camera-slam-right",
+      "FisheyeRadTanThinPrism",
+      {240.4079029979023,     319.5880700932008,     234.8281771724988,
+       -0.02560157338386939,  0.09589258631677708,   -0.06427616624414993,
+       0.007971424664885393,  0.002582036171107217,  -0.0005727824626056161,
+       0.002719223101436475,  -0.001623654038728183, -0.002291212990665018,
+       0.000232467586136037,  0.003472041557561332,  0.0001638243462707963},
+      {0.004537337020085505, -0.1087436408509408, -0.08458992264096366},
+      {0.7879958198550512, 0.6152765316450651, 0.0004361231876085225, 0.02229769706383132}));
+  cameras.push_back(makeCameraCalibrationJson(
+      "camera-et-left",
+      "KannalaBrandtK3",
+      {556.9986127195704,
+       556.2856565726103,
+       319.4997558679469,
+       239.5007627921714,
+       0.03919399881730679,
+       -0.03938141694892217,
+       0.1231126497844618,
+       -0.3030048861231687},
+      {0.02180069792013573, -0.01171976474011141, -0.008529579981466999},
+      {0.2390283865170416, -0.3769589102592896, -0.8447759785585566, 0.2951625932695772}));
+  cameras.push_back(makeCameraCalibrationJson(
+      "camera-et-right",
+      "KannalaBrandtK3",
+      {555.9129557987491,
+       555.506914820225,
+       319.4999983620271,
+       239.5008960217104,
+       0.03188002429815672,
+       0.04314335690427827,
+       -0.1892458755435164,
+       0.0891082616698516},
+      {0.02468290741996444, -0.09650282004207175, -0.07521707817288514},
+      {-0.7382834279506172, 0.4778777012025412, 0.4724601977951396, 0.05789511383733829}));
+  cameras.push_back(makeCameraCalibrationJson(
+      "camera-rgb",
+      "FisheyeRadTanThinPrism",
+      {1219.897559388867,      1451.844130105521,      1453.230076686263,
+       0.4155771977943428,     -0.5654675386349081,    0.4102690750474058,
+       0.7550466498106921,     -1.403495636190313,     0.5612327759388388,
+       0.0006139894388846695,  -0.0005063437150561582, -0.001531325356573677,
+       0.0001966747835378387,  0.001762293972731938,   -0.0001481272437606543},
+      {-0.004180357976150694, -0.01232943559259098, -0.004521688859111843},
+      {0.9421581354656898, 0.331880218714491, 0.03805133662020499, 0.02730684865106909}));
+
+  nlohmann::json imus = nlohmann::json::array();
+  imus.push_back(makeImuCalibrationJson(
+      "imu-right",
+      {0.004614027775070707, -0.102257215437773, -0.08630157032278213},
+      {0.6109459112529934, -0.7859482072793205, -0.07296621397616276, 0.06088054381866971}));
+  imus.push_back(makeImuCalibrationJson(
+      "imu-left",
+      {0.0008607863635805566, -0.0004710952525985622, -0.006386163058212968},
+      {0.02837575060925809, -0.7066290769886596, -0.7059142680101693, 0.03943615791609287}));
+
+  nlohmann::json microphones = nlohmann::json::array();
+  for (int i = 0; i < 7; ++i) {
+    microphones.push_back(
+        {{"DSensitivity1KDbv", -32.0}, {"Label", fmt::format("mic{}", i)}, {"SerialNumber", ""}});
+  }
+
+  nlohmann::json calibration = {
+      {"BaroCalibrations",
+       {{{"Label", "baro0"},
+         {"PressureModel", {{"Name", "Linear"}, {"OffsetPa", 0.0}, {"Slope", 1.0}}},
+         {"SerialNumber", ""}}}},
+      {"CalibrationSource", "Factory"},
+      {"CameraCalibrations", cameras},
+      {"DeviceClassInfo", {{"BuildVersion", kDeviceVersion}, {"DeviceClass", kDeviceType}}},
+      {"ImuCalibrations", imus},
+      {"MicCalibrations", microphones},
+      {"OriginSpecification", {{"ChildLabel", "camera-slam-left"}, {"Type", "Custom"}}},
+      {"Serial", deviceSerial}};
+  return calibration.dump();
+}
+
+// ---------------------------------------------------------------------------------------------
+// Frames
+
+// libjpeg reports fatal errors through error_exit, which must not return
+struct JpegErrorManager {
+  jpeg_error_mgr manager;
+  std::jmp_buf jumpBuffer;
+};
+
+void onJpegError(j_common_ptr cinfo) {
+  std::longjmp(reinterpret_cast<JpegErrorManager*>(cinfo->err)->jumpBuffer, 1);
+}
+
+std::vector<uint8_t> encodeJpeg(
+    const std::vector<uint8_t>& pixels,
+    uint32_t width,
+    uint32_t height,
+    int numComponents,
+    int quality) {
+  // everything alive across the setjmp boundary is declared first
+  jpeg_compress_struct cinfo;
+  JpegErrorManager errorManager;
+  unsigned char* buffer = nullptr;
+  unsigned long bufferSize = 0;
+
+  cinfo.err = jpeg_std_error(&errorManager.manager);
+  errorManager.manager.error_exit = onJpegError;
+  if (setjmp(errorManager.jumpBuffer)) {
+    jpeg_destroy_compress(&cinfo);
+    std::free(buffer);
+    throw std::runtime_error("Failed to compress a synthetic frame to JPEG");
+  }
+
+  jpeg_create_compress(&cinfo);
+  jpeg_mem_dest(&cinfo, &buffer, &bufferSize);
+  cinfo.image_width = width;
+  cinfo.image_height = height;
+  cinfo.input_components = numComponents;
+  cinfo.in_color_space = numComponents == 1 ? JCS_GRAYSCALE : JCS_RGB;
+  jpeg_set_defaults(&cinfo);
+  jpeg_set_quality(&cinfo, quality, TRUE);
+  jpeg_start_compress(&cinfo, TRUE);
+  const size_t stride = static_cast<size_t>(width) * numComponents;
+  while (cinfo.next_scanline < cinfo.image_height) {
+    JSAMPROW row = const_cast<uint8_t*>(pixels.data() + cinfo.next_scanline * stride);
+    jpeg_write_scanlines(&cinfo, &row, 1);
+  }
+  jpeg_finish_compress(&cinfo);
+  std::vector<uint8_t> jpeg(buffer, buffer + bufferSize);
+  jpeg_destroy_compress(&cinfo);
+  std::free(buffer);
+  return jpeg;
+}
+
+// A moving pattern with sensor noise, so that compression and decoding costs are realistic
+std::vector<uint8_t> generateFramePixels(
+    uint32_t width,
+    uint32_t height,
+    int numComponents,
+    size_t phase,
+    std::minstd_rand& rng) {
+  std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * numComponents);
+  std::uniform_int_distribution<int> noise(-6, 6);
+  const double cx = width * (0.3 + 0.05 * phase);
+  const double cy = height * 0.5;
+  const double radius2 = 0.04 * width * height;
+  size_t i = 0;
+  for (uint32_t y = 0; y < height; ++y) {
+    for (uint32_t x = 0; x < width; ++x) {
+      const double dx = x - cx;
+      const double dy = y - cy;
+      const int base = ((x + phase * 16) / 32 + y / 32) % 2 == 0 ? 60 : 140;
+      const int blob = dx * dx + dy * dy < radius2 ? 80 : 0;
+      for (int c = 0; c < numComponents; ++c) {
+        pixels[i++] = static_cast<uint8_t>(std::clamp(base + blob + 20 * c + noise(rng), 0, 255));
+      }
+    }
+  }
+  return pixels;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Streams
+
+int64_t toNs(double seconds) {
+  return std::llround(seconds * 1e9);
+}
+
+double toSec(int64_t ns) {
+  return static_cast<double>(ns) * 1e-9;
+}
+
+// A stream of periodic data records
+class SyntheticStream : public vrs::Recordable {
+ public:
+  SyntheticStream(vrs::RecordableTypeId typeId, int64_t startTimeNs, double rateHz)
+      : vrs::Recordable(typeId), startTimeNs_(startTimeNs), rateHz_(rateHz) {}
+
+  // Creates the data records of the stream until a device time, excluded
+  void createDataRecordsUntil(int64_t endTimeNs) {
+    for (int64_t timeNs = getTimeNs(nextIndex_); timeNs < endTimeNs;
+         timeNs = getTimeNs(++nextIndex_)) {
+      createDataRecord(nextIndex_, timeNs);
+    }
+  }
+
+  const vrs::Record* createStateRecord() override {
+    return createRecord(getConfigurationTimeSec(), vrs::Record::Type::STATE, 0);
+  }
+
+ protected:
+  virtual void createDataRecord(uint64_t index, int64_t timeNs) = 0;
+
+  int64_t getTimeNs(uint64_t index) const {
+    return startTimeNs_ + toNs(static_cast<double>(index) / rateHz_);
+  }
+
+  double getConfigurationTimeSec() const {
+    return toSec(startTimeNs_) - kConfigurationLeadSec;
+  }
+
+  double getRateHz() const {
+    return rateHz_;
+  }
+
+ private:
+  const int64_t startTimeNs_;
+  const double rateHz_;
+  uint64_t nextIndex_ = 0;
+};
+
+class SyntheticCamera : public SyntheticStream {
+ public:
+  SyntheticCamera(
+      vrs::RecordableTypeId typeId,
+      uint32_t cameraId,
+      const std::string& sensorModel,
+      const SyntheticCameraOptions& camera,
+      uint32_t imageWidth,
+      vrs::PixelFormat pixelFormat,
+      const SyntheticRecordingOptions& options,
+      std::minstd_rand& rng)
+      : SyntheticStream(typeId, options.startTimeNs, camera.rateHz),
+        cameraId_(cameraId),
+        sensorModel_(sensorModel),
+        deviceSerial_(options.deviceSerial),
+        width_(imageWidth),
+        height_(camera.height),
+        numComponents_(pixelFormat == vrs::PixelFormat::RGB8 ? 3 : 1),
+        pixelFormat_(pixelFormat) {
+    const size_t frameBytes = static_cast<size_t>(width_) * height_ * numComponents_;
+    const size_t numFrames =
+        std::clamp<size_t>(kDistinctFramesMaxBytes / frameBytes, 1, kMaxDistinctFrames);
+    const bool isJpeg = camera.encoding == SyntheticImageEncoding::Jpeg;
+    for (size_t phase = 0; phase < numFrames; ++phase) {
+      auto pixels = generateFramePixels(width_, height_, numComponents_, phase, rng);
+      frames_.push_back(
+          isJpeg ? encodeJpeg(pixels, width_, height_, numComponents_, options.jpegQuality)
+                 : std::move(pixels));
+    }
+
+    setCompression(vrs::CompressionPreset::None);
+    addRecordFormat(
+        vrs::Record::Type::CONFIGURATION,
+        config_.kVersion,
+        config_.getContentBlock(),
+        {&config_});
+    const vrs::ContentBlock imageBlock = isJpeg
+        ? vrs::ContentBlock(vrs::ImageFormat::JPG, width_, height_)
+        : vrs::ContentBlock(pixelFormat_, width_, height_);
+    addRecordFormat(
+        vrs::Record::Type::DATA, data_.kVersion, data_.getContentBlock() + imageBlock, {&data_});
+  }
+
+  const vrs::Record* createConfigurationRecord() override {
+    config_.deviceType.stage(kDeviceType);
+    config_.deviceVersion.stage(kDeviceVersion);
+    config_.deviceSerial.stage(deviceSerial_);
+    config_.cameraId.set(cameraId_);
+    config_.sensorModel.stage(sensorModel_);
+    config_.sensorSerial.stage(deviceSerial_);
+    config_.nominalRateHz.set(getRateHz());
+    config_.imageWidth.set(width_);
+    config_.imageHeight.set(height_);
+    config_.imageStride.set(width_ * numComponents_);
+    config_.pixelFormat.set(static_cast<datalayout::ImageSpecType>(pixelFormat_));
+    config_.exposureDurationMin.set(1e-5);
+    config_.exposureDurationMax.set(1e-2);
+    config_.gainMin.set(1);
+    config_.gainMax.set(16);
+    config_.gammaFactor.set(1);
+    config_.factoryCalibration.stage("");
+    config_.onlineCalibration.stage("");
+    config_.description.stage("synthetic");
+    return createRecord(
+        getConfigurationTimeSec(),
+        vrs::Record::Type::CONFIGURATION,
+        config_.kVersion,
+        vrs::DataSource(config_));
+  }
+
+ protected:
+  void createDataRecord(uint64_t index, int64_t timeNs) override {
+    data_.groupId.set(index);
+    data_.groupMask.set(1);
+    data_.frameNumber.set(index);
+    data_.exposureDuration.set(5e-3);
+    data_.gain.set(1);
+    data_.captureTimestampNs.set(timeNs);
+    data_.arrivalTimestampNs.set(timeNs + 5'000'000);
+    data_.temperature.set(35);
+    const std::vector<uint8_t>& frame = frames_[index % frames_.size()];
+    createRecord(
+        toSec(timeNs),
+        vrs::Record::Type::DATA,
+        data_.kVersion,
+        vrs::DataSource(data_, vrs::DataSourceChunk(frame.data(), frame.size())));
+  }
+
+ private:
+  const uint32_t cameraId_;
+  const std::string sensorModel_;
+  const std::string deviceSerial_;
+  const uint32_t width_;
+  const uint32_t height_;
+  const uint32_t numComponents_;
+  const vrs::PixelFormat pixelFormat_;
+  std::vector<std::vector<uint8_t>> frames_;
+  datalayout::ImageSensorConfigRecordMetadata config_;
+  datalayout::ImageSensorDataRecordMetadata data_;
+};
+
+class SyntheticImu : public SyntheticStream {
+ public:
+  SyntheticImu(
+      uint32_t streamIndex,
+      double rateHz,
+      const SyntheticRecordingOptions& options,
+      std::minstd_rand& rng)
+      : SyntheticStream(vrs::RecordableTypeId::SlamImuData, options.startTimeNs, rateHz),
+        streamIndex_(streamIndex),
+        deviceSerial_(options.deviceSerial),
+        rng_(rng) {
+    addRecordFormat(
+        vrs::Record::Type::CONFIGURATION,
+        config_.kVersion,
+        config_.getContentBlock(),
+        {&config_});
+    addRecordFormat(vrs::Record::Type::DATA, data_.kVersion, data_.getContentBlock(), {&data_});
+  }
+
+  const vrs::Record* createConfigurationRecord() override {
+    config_.streamIndex.set(streamIndex_);
+    config_.deviceType.stage(kDeviceType);
+    config_.deviceVersion.stage(kDeviceVersion);
+    config_.deviceSerial.stage(deviceSerial_);
+    config_.deviceId.set(streamIndex_);
+    config_.sensorModel.stage("synthetic-imu");
+    config_.nominalRateHz.set(getRateHz());
+    config_.hasAccelerometer.set(true);
+    config_.hasGyroscope.set(true);
+    config_.hasMagnetometer.set(false);
+    config_.factoryCalibration.stage("");
+    config_.onlineCalibration.stage("");
+    config_.description.stage("synthetic");
+    return createRecord(
+        getConfigurationTimeSec(),
+        vrs::Record::Type::CONFIGURATION,
+        config_.kVersion,
+        vrs::DataSource(config_));
+  }
+
+ protected:
+  void createDataRecord(uint64_t /* index */, int64_t timeNs) override {
+    std::normal_distribution<float> noise(0, 0.02f);
+    const double t = toSec(timeNs);
+    const float accel[3] = {
+        noise(rng_), static_cast<float>(-9.81 + 0.5 * std::sin(t)) + noise(rng_), noise(rng_)};
+    const float gyro[3] = {
+        static_cast<float>(0.2 * std::sin(2 * t)) + noise(rng_), noise(rng_), noise(rng_)};
+    const float mag[3] = {0, 0, 0};
+    data_.accelValid.set(true);
+    data_.gyroValid.set(true);
+    data_.magValid.set(false);
+    data_.temperature.set(35);
+    data_.captureTimestampNs.set(timeNs);
+    data_.arrivalTimestampNs.set(timeNs + 1'000'000);
+    data_.accelMSec2.set(accel);
+    data_.gyroRadSec.set(gyro);
+    data_.magTesla.set(mag);
+    createRecord(t, vrs::Record::Type::DATA, data_.kVersion, vrs::DataSource(data_));
+  }
+
+ private:
+  const uint32_t streamIndex_;
+  const std::string deviceSerial_;
+  std::minstd_rand& rng_;
+  datalayout::MotionSensorConfigRecordMetadata config_;
+  datalayout::MotionSensorDataRecordMetadata data_;
+};
+
+class SyntheticAudio : public SyntheticStream {
+ public:
+  explicit SyntheticAudio(const SyntheticRecordingOptions& options)
+      : SyntheticStream(
+            vrs::RecordableTypeId::StereoAudioRecordableClass,
+            options.startTimeNs,
+            static_cast<double>(options.audioSampleRate) / options.audioSamplesPerRecord),
+        sampleRate_(options.audioSampleRate),
+        samplesPerRecord_(options.audioSamplesPerRecord),
+        numChannels_(options.audioNumChannels),
+        samples_(static_cast<size_t>(samplesPerRecord_) * numChannels_),
+        sampleTimestampsNs_(samplesPerRecord_) {
+    setCompression(vrs::CompressionPreset::None);
+    addRecordFormat(
+        vrs::Record::Type::CONFIGURATION,
+        config_.kVersion,
+        config_.getContentBlock(),
+        {&config_});
+    addRecordFormat(
+        vrs::Record::Type::DATA,
+        data_.kVersion,
+        data_.getContentBlock() +
+            vrs::ContentBlock(
+                vrs::AudioFormat::PCM,
+                vrs::AudioSampleFormat::S32_LE,
+                numChannels_,
+                0,
+                sampleRate_,
+                samplesPerRecord_),
+        {&data_});
+  }
+
+  const vrs::Record* createConfigurationRecord() override {
+    config_.streamId.set(0);
+    config_.numChannels.set(numChannels_);
+    config_.sampleRate.set(sampleRate_);
+    config_.sampleFormat.set(static_cast<uint8_t>(vrs::AudioSampleFormat::S32_LE));
+    return createRecord(
+        getConfigurationTimeSec(),
+        vrs::Record::Type::CONFIGURATION,
+        config_.kVersion,
+        vrs::DataSource(config_));
+  }
+
+ protected:
+  void createDataRecord(uint64_t index, int64_t timeNs) override {
+    const uint64_t firstSample = index * samplesPerRecord_;
+    for (uint32_t s = 0; s < samplesPerRecord_; ++s) {
+      const double t = static_cast<double>(firstSample + s) / sampleRate_;
+      sampleTimestampsNs_[s] = timeNs + toNs(static_cast<double>(s) / sampleRate_);
+      for (uint8_t c = 0; c < numChannels_; ++c) {
+        samples_[s * numChannels_ + c] =
+            static_cast<int32_t>(1e8 * std::sin(2 * M_PI * (440.0 + 110.0 * c) * t));
+      }
+    }
+    data_.captureTimestampsNs.stage(sampleTimestampsNs_);
+    data_.audioMuted.set(0);
+    createRecord(
+        toSec(timeNs),
+        vrs::Record::Type::DATA,
+        data_.kVersion,
+        vrs::DataSource(data_, vrs::DataSourceChunk(samples_.data(), samples_.size() * 4)));
+  }
+
+ private:
+  const uint32_t sampleRate_;
+  const uint32_t samplesPerRecord_;
+  const uint8_t numChannels_;
+  std::vector<int32_t> samples_;
+  std::vector<int64_t> sampleTimestampsNs_;
+  datalayout::AudioConfigRecordMetadata config_;
+  datalayout::AudioDataRecordMetadata data_;
+};
+
+class SyntheticBarometer : public SyntheticStream {
+ public:
+  SyntheticBarometer(double rateHz, int64_t startTimeNs)
+      : SyntheticStream(vrs::RecordableTypeId::BarometerRecordableClass, startTimeNs, rateHz) {
+    addRecordFormat(
+        vrs::Record::Type::CONFIGURATION,
+        config_.kVersion,
+        config_.getContentBlock(),
+        {&config_});
+    addRecordFormat(vrs::Record::Type::DATA, data_.kVersion, data_.getContentBlock(), {&data_});
+  }
+
+  const vrs::Record* createConfigurationRecord() override {
+    config_.streamId.set(0);
+    config_.sensorModelName.stage("synthetic-barometer");
+    config_.sampleRate.set(getRateHz());
+    return createRecord(
+        getConfigurationTimeSec(),
+        vrs::Record::Type::CONFIGURATION,
+        config_.kVersion,
+        vrs::DataSource(config_));
+  }
+
+ protected:
+  void createDataRecord(uint64_t /* index */, int64_t timeNs) override {
+    data_.captureTimestampNs.set(timeNs);
+    data_.temperature.set(25);
+    data_.pressure.set(101325.0 + 10 * std::sin(toSec(timeNs)));
+    createRecord(toSec(timeNs), vrs::Record::Type::DATA, data_.kVersion, vrs::DataSource(data_));
+  }
+
+ private:
+  datalayout::BarometerConfigRecordMetadata config_;
+  datalayout::BarometerDataMetadata data_;
+};
+
+class SyntheticTimeSync : public SyntheticStream {
+ public:
+  SyntheticTimeSync(double rateHz, int64_t startTimeNs, int64_t offsetNs)
+      : SyntheticStream(vrs::RecordableTypeId::TimeRecordableClass, startTimeNs, rateHz),
+        offsetNs_(offsetNs) {
+    addRecordFormat(
+        vrs::Record::Type::CONFIGURATION,
+        config_.kVersion,
+        config_.getContentBlock(),
+        {&config_});
+    addRecordFormat(vrs::Record::Type::DATA, data_.kVersion, data_.getContentBlock(), {&data_});
+  }
+
+  const vrs::Record* createConfigurationRecord() override {
+    config_.streamId.set(0);
+    config_.sampleRateHz.set(getRateHz());
+    config_.mode.stage("TIMECODE");
+    return createRecord(
+        getConfigurationTimeSec(),
+        vrs::Record::Type::CONFIGURATION,
+        config_.kVersion,
+        vrs::DataSource(config_));
+  }
+
+ protected:
+  void createDataRecord(uint64_t /* index */, int64_t timeNs) override {
+    data_.monotonicTimestampNs.set(timeNs);
+    data_.realTimestampNs.set(timeNs + offsetNs_);
+    createRecord(toSec(timeNs), vrs::Record::Type::DATA, data_.kVersion, vrs::DataSource(data_));
+  }
+
+ private:
+  const int64_t offsetNs_;
+  datalayout::TimeSyncConfigRecordMetadata config_;
+  datalayout::TimeSyncDataRecordMetadata data_;
+};
+
+void checkCameraOptions(
+    const std::string& name,
+    const SyntheticCameraOptions& camera,
+    const std::vector<std::pair<uint32_t, uint32_t>>& supportedResolutions) {
+  if (!camera.enabled) {
+    return;
+  }
+  if (!(camera.rateHz > 0)) {
+    throw std::runtime_error(fmt::format("The {} camera rate must be positive", name));
+  }
+  for (const auto& [width, height] : supportedResolutions) {
+    if (camera.width == width && camera.height == height) {
+      return;
+    }
+  }
+  throw std::runtime_error(fmt::format(
+      "The {} camera resolution {}x{} cannot be calibrated", name, camera.width, camera.height));
+}
+
+void checkOptions(const SyntheticRecordingOptions& options) {
+  if (!(options.durationSec > 0)) {
+    throw std::runtime_error("The recording duration must be positive");
+  }
+  checkCameraOptions("RGB", options.rgb, {{2880, 2880}, {1408, 1408}});
+  checkCameraOptions("SLAM", options.slam, {{640, 480}});
+  checkCameraOptions("ET", options.et, {{640, 480}, {320, 240}});
+  if ((options.enableImu && !(options.imuRightRateHz > 0 && options.imuLeftRateHz > 0)) ||
+      (options.enableAudio &&
+       (options.audioSampleRate == 0 || options.audioSamplesPerRecord == 0 ||
+        options.audioNumChannels == 0)) ||
+      (options.enableBarometer && !(options.barometerRateHz > 0)) ||
+      (options.enableTimeSync && !(options.timeSyncRateHz > 0))) {
+    throw std::runtime_error("The sensor rates must be positive");
+  }
+  if (options.jpegQuality < 1 || options.jpegQuality > 100) {
+    throw std::runtime_error("The JPEG quality must be in [1, 100]");
+  }
+}
+
+} // namespace
+
+void writeSyntheticAriaRecording(
+    const std::string& path,
+    const SyntheticRecordingOptions& options) {
+  checkOptions(options);
+  std::minstd_rand rng(options.randomSeed);
+
+  // Aria stream ids are allocated by creation order: slam-left, then slam-right, imu-right, then
+  // imu-left
+  vrs::Recordable::resetNewInstanceIds();
+  std::vector<std::unique_ptr<SyntheticStream>> streams;
+  if (options.slam.enabled) {
+    for (uint32_t cameraId = 0; cameraId < 2; ++cameraId) {
+      streams.push_back(std::make_unique<SyntheticCamera>(
+          vrs::RecordableTypeId::SlamCameraData,
+          cameraId,
+          "synthetic-slam",
+          options.slam,
+          options.slam.width,
+          vrs::PixelFormat::GREY8,
+          options,
+          rng));
+    }
+  }
+  if (options.et.enabled) {
+    streams.push_back(std::make_unique<SyntheticCamera>(
+        vrs::RecordableTypeId::EyeCameraRecordableClass,
+        2,
+        "synthetic-et",
+        options.et,
+        options.et.width * 2,
+        vrs::PixelFormat::GREY8,
+        options,
+        rng));
+  }
+  if (options.rgb.enabled) {
+    streams.push_back(std::make_unique<SyntheticCamera>(
+        vrs::RecordableTypeId::RgbCameraRecordableClass,
+        3,
+        "synthetic-rgb",
+        options.rgb,
+        options.rgb.width,
+        vrs::PixelFormat::RGB8,
+        options,
+        rng));
+  }
+  if (options.enableImu) {
+    streams.push_back(std::make_unique<SyntheticImu>(0, options.imuRightRateHz, options, rng));
+    streams.push_back(std::make_unique<SyntheticImu>(1, options.imuLeftRateHz, options, rng));
+  }
+  if (options.enableAudio) {
+    streams.push_back(std::make_unique<SyntheticAudio>(options));
+  }
+  if (options.enableBarometer) {
+    streams.push_back(
+        std::make_unique<SyntheticBarometer>(options.barometerRateHz, options.startTimeNs));
+  }
+  if (options.enableTimeSync) {
+    streams.push_back(std::make_unique<SyntheticTimeSync>(
+        options.timeSyncRateHz, options.startTimeNs, options.timeSyncOffsetNs));
+  }
+
+  vrs::RecordFileWriter writer;
+  for (const auto& stream : streams) {
+    writer.addRecordable(stream.get());
+  }
+  if (options.writeCalibration) {
+    writer.setTag("calib_json", makeCalibrationJson(options.deviceSerial));
+  }
+  int status = writer.createFileAsync(path);
+  if (status != 0) {
+    throw std::runtime_error(fmt::format(
+        "Cannot create VRS file {}: {}", path, vrs::errorCodeToMessage(status)));
+  }
+
+  const int64_t endTimeNs = options.startTimeNs + toNs(options.durationSec);
+  for (int64_t sliceEndNs = options.startTimeNs; sliceEndNs < endTimeNs;) {
+    sliceEndNs = std::min(sliceEndNs + kWriteSliceNs, endTimeNs);
+    for (const auto& stream : streams) {
+      stream->createDataRecordsUntil(sliceEndNs);
+    }
+    // records at sliceEndNs are created with the next slice
+    writer.writeRecordsAsync(std::nextafter(toSec(sliceEndNs), -1.0));
+  }
+  status = writer.waitForFileClosed();
+  if (status != 0) {
+    throw std::runtime_error(fmt::format(
+        "Cannot write VRS file {}: {}", path, vrs::errorCodeToMessage(status)));
+  }
+  XR_LOGI("Wrote {:.1f}s synthetic recording to {}", options.durationSec, path);
+}
+
+} // namespace projectaria::tools::benchmarks
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace projectaria::tools::benchmarks {
+
+/**
+ * @brief How the frames of a synthetic camera stream are stored
+ */
+enum class SyntheticImageEncoding {
+  Raw, /**< uncompressed pixels, GREY8 or RGB8 */
+  Jpeg, /**< JPEG compressed pixels */
+};
+
+/**
+ * @brief A synthetic camera stream. The resolutions are limited to the ones the Aria calibration
+ * can be rescaled to: 2880x2880 or 1408x1408 for RGB, 640x480 for SLAM, and 640x480 or 320x240 per
+ * eye for ET, whose frames hold both eyes side by side.
+ */
+struct SyntheticCameraOptions {
+  bool enabled = true;
+  uint32_t width = 0; ///< @brief width of a frame, per eye for the ET camera
+  uint32_t height = 0;
+  double rateHz = 10;
+  SyntheticImageEncoding encoding = SyntheticImageEncoding::Raw;
+};
+
+/**
+ * @brief Content of a synthetic Aria recording, written with the Aria data layouts so that it
+ * reads like a device recording. Defaults follow a common Aria recording profile.
+ */
+struct SyntheticRecordingOptions {
+  double durationSec = 10;
+  int64_t startTimeNs = 1'000'000'000; ///< @brief device time of the first records
+  std::string deviceSerial = "synthetic"; ///< @brief in the configurations and the calibration
+
+  SyntheticCameraOptions rgb{true, 1408, 1408, 10, SyntheticImageEncoding::Jpeg};
+  SyntheticCameraOptions slam{true, 640, 480, 10, SyntheticImageEncoding::Raw};
+  SyntheticCameraOptions et{true, 320, 240, 10, SyntheticImageEncoding::Raw};
+  int jpegQuality = 90;
+
+  bool enableImu = true;
+  double imuRightRateHz = 1000;
+  double imuLeftRateHz = 800;
+
+  bool enableAudio = true;
+  uint32_t audioSampleRate = 48000;
+  uint32_t audioSamplesPerRecord = 4096;
+  uint8_t audioNumChannels = 7;
+
+  bool enableBarometer = true;
+  double barometerRateHz = 50;
+
+  bool enableTimeSync = true; ///< @brief a TIMECODE stream, offset from device time
+  double timeSyncRateHz = 10;
+  int64_t timeSyncOffsetNs = 3'600'000'000'000;
+
+  bool writeCalibration = true; ///< @brief writes the calib_json tag
+  uint32_t randomSeed = 0; ///< @brief seed of the pixel and sensor noise
+};
+
+/**
+ * @brief Writes a synthetic Aria recording to a VRS file. Frames are generated and compressed
+ * once per stream and then cycled, so that even long recordings are quick to write.
+ * Throws std::runtime_error if the options are not valid or the file cannot be written.
+ */
+void writeSyntheticAriaRecording(const std::string& path, const SyntheticRecordingOptions& options);
+
+} // namespace projectaria::tools::benchmarks
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+
+#include <CLI/CLI.hpp>
+
+#include <benchmarks/SyntheticAriaRecording.h>
+
+namespace projectaria::tools::benchmarks {
+
+/**
+ * @brief Adds the command line options of a synthetic recording to an app, shared by the
+ * generator and the benchmarks
+ */
+inline void addSyntheticRecordingOptions(CLI::App& app, SyntheticRecordingOptions& options) {
+  const std::map<std::string, SyntheticImageEncoding> encodings{
+      {"raw", SyntheticImageEncoding::Raw}, {"jpeg", SyntheticImageEncoding::Jpeg}};
+  const std::string group = "Synthetic recording";
+
+  app.add_option("--duration", options.durationSec, "Duration of the recording [s]")
+      ->capture_default_str()
+      ->group(group);
+  app.add_option_function<uint32_t>(
+         "--rgb-resolution",
+         [&options](const uint32_t& resolution) {
+           options.rgb.width = resolution;
+           options.rgb.height = resolution;
+         },
+         "Width and height of the RGB frames")
+      ->check(CLI::IsMember({1408, 2880}))
+      ->default_str(std::to_string(options.rgb.width))
+      ->group(group);
+  app.add_option("--rgb-encoding", options.rgb.encoding, "Encoding of the RGB frames")
+      ->transform(CLI::CheckedTransformer(encodings, CLI::ignore_case))
+      ->group(group);
+  app.add_option("--rgb-rate", options.rgb.rateHz, "Frame rate of the RGB camera [Hz]")
+      ->capture_default_str()
+      ->group(group);
+  app.add_option("--slam-encoding", options.slam.encoding, "Encoding of the SLAM frames")
+      ->transform(CLI::CheckedTransformer(encodings, CLI::ignore_case))
+      ->group(group);
+  app.add_option("--slam-rate", options.slam.rateHz, "Frame rate of the SLAM cameras [Hz]")
+      ->capture_default_str()
+      ->group(group);
+  app.add_option_function<uint32_t>(
+         "--et-resolution",
+         [&options](const uint32_t& width) {
+           options.et.width = width;
+           options.et.height = width * 3 / 4;
+         },
+         "Width of one eye in the ET frames")
+      ->check(CLI::IsMember({320, 640}))
+      ->default_str(std::to_string(options.et.width))
+      ->group(group);
+  app.add_option("--et-encoding", options.et.encoding, "Encoding of the ET frames")
+      ->transform(CLI::CheckedTransformer(encodings, CLI::ignore_case))
+      ->group(group);
+  app.add_option("--et-rate", options.et.rateHz, "Frame rate of the ET camera [Hz]")
+      ->capture_default_str()
+      ->group(group);
+  app.add_option("--jpeg-quality", options.jpegQuality, "Quality of the JPEG frames")
+      ->check(CLI::Range(1, 100))
+      ->capture_default_str()
+      ->group(group);
+  app.add_option("--imu-right-rate", options.imuRightRateHz, "Rate of imu-right [Hz]")
+      ->capture_default_str()
+      ->group(group);
+  app.add_option("--imu-left-rate", options.imuLeftRateHz, "Rate of imu-left [Hz]")
+      ->capture_default_str()
+      ->group(group);
+  app.add_option("--seed", options.randomSeed, "Seed of the pixel and sensor noise")
+      ->capture_default_str()
+      ->group(group);
+
+  app.add_flag_function(
+         "--no-rgb", [&options](int64_t) { options.rgb.enabled = false; }, "Omit the RGB camera")
+      ->group(group);
+  app.add_flag_function(
+         "--no-slam",
+         [&options](int64_t) { options.slam.enabled = false; },
+         "Omit the SLAM cameras")
+      ->group(group);
+  app.add_flag_function(
+         "--no-et", [&options](int64_t) { options.et.enabled = false; }, "Omit the ET camera")
+      ->group(group);
+  app.add_flag_function(
+         "--no-imu", [&options](int64_t) { options.enableImu = false; }, "Omit the IMUs")
+      ->group(group);
+  app.add_flag_function(
+         "--no-audio",
+         [&options](int64_t) { options.enableAudio = false; },
+         "Omit the microphones")
+      ->group(group);
+  app.add_flag_function(
+         "--no-barometer",
+         [&options](int64_t) { options.enableBarometer = false; },
+         "Omit the barometer")
+      ->group(group);
+  app.add_flag_function(
+         "--no-time-sync",
+         [&options](int64_t) { options.enableTimeSync = false; },
+         "Omit the time sync stream")
+      ->group(group);
+}
+
+} // namespace projectaria::tools::benchmarks
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmarks/SyntheticAriaRecording.h>
+#include <data_provider/VrsDataProvider.h>
+
+#include <filesystem>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using namespace projectaria::tools::benchmarks;
+using namespace projectaria::tools::data_provider;
+
+namespace fs = std::filesystem;
+
+TEST(SyntheticAriaRecording, ReadByDataProvider) {
+  const std::string path =
+      (fs::temp_directory_path() / "synthetic_aria_recording_test.vrs").string();
+  SyntheticRecordingOptions options;
+  options.durationSec = 1;
+  writeSyntheticAriaRecording(path, options);
+
+  auto provider = createVrsDataProvider(path);
+  ASSERT_TRUE(provider);
+  ASSERT_TRUE(provider->getDeviceCalibration());
+
+  const auto expectNumData = [&](const std::string& label, size_t numData) {
+    const auto streamId = provider->getStreamIdFromLabel(label);
+    ASSERT_TRUE(streamId) << label;
+    EXPECT_EQ(provider->getNumData(*streamId), numData) << label;
+  };
+  expectNumData("camera-rgb", 10);
+  expectNumData("camera-slam-left", 10);
+  expectNumData("camera-slam-right", 10);
+  expectNumData("camera-et", 10);
+  expectNumData("imu-right", 1000);
+  expectNumData("imu-left", 800);
+  expectNumData("mic", 12);
+  expectNumData("baro0", 50);
+
+  const auto rgbStreamId = provider->getStreamIdFromLabel("camera-rgb").value();
+  const auto image = provider->getImageDataByIndex(rgbStreamId, 3).first;
+  ASSERT_TRUE(image.isValid());
+  EXPECT_EQ(image.getWidth(), 1408);
+  EXPECT_EQ(image.getHeight(), 1408);
+  EXPECT_EQ(provider->getFirstTimeNs(rgbStreamId, TimeDomain::DeviceTime), options.startTimeNs);
+
+  const auto imuStreamId = provider->getStreamIdFromLabel("imu-right").value();
+  EXPECT_TRUE(provider->supportsTimeDomain(imuStreamId, TimeDomain::TimeCode));
+  const int64_t deviceTimeNs = options.startTimeNs + 500'000'000;
+  EXPECT_EQ(
+      provider->convertFromDeviceTimeToTimeCodeNs(deviceTimeNs),
+      deviceTimeNs + options.timeSyncOffsetNs);
+
+  provider.reset();
+  fs::remove(path);
+}
+
+TEST(SyntheticAriaRecording, InvalidOptions) {
+  const std::string path = (fs::temp_directory_path() / "synthetic_aria_invalid.vrs").string();
+  SyntheticRecordingOptions options;
+  options.rgb.width = 1000;
+  EXPECT_THROW(writeSyntheticAriaRecording(path, options), std::runtime_error);
+
+  options = SyntheticRecordingOptions();
+  options.durationSec = 0;
+  EXPECT_THROW(writeSyntheticAriaRecording(path, options), std::runtime_error);
+  EXPECT_FALSE(fs::exists(path));
+}
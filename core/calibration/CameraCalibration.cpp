@@ -128,6 +128,14 @@ std::optional<Eigen::Vector2d> CameraCalibration::project(
   return {};
 }
 
+void CameraCalibration::projectBatchNoChecks(
+    const Eigen::Ref<const Eigen::Matrix3Xd>& pointsInCamera,
+    Eigen::Matrix2Xd& pixels,
+    CameraProjection::BatchJacobians* jacobiansWrtPoint,
+    CameraProjection::BatchJacobians* jacobiansWrtParams) const {
+  projectionModel_.projectBatch(pointsInCamera, pixels, jacobiansWrtPoint, jacobiansWrtParams);
+}
+
 Eigen::Vector3d CameraCalibration::unprojectNoChecks(const Eigen::Vector2d& cameraPixel) const {
   return projectionModel_.unproject(cameraPixel);
 }
@@ -93,6 +93,22 @@ class CameraCalibration {
    */
   std::optional<Eigen::Vector2d> project(const Eigen::Vector3d& pointInCamera) const;
 
+  /**
+   * @brief Function to project a batch of 3d points (in camera frame) to 2d camera pixel
+   * locations, with the Jacobians of the pixels w.r.t. the points and the projection parameters,
+   * e.g. to refine the intrinsics against point observations. In this function, no check is
+   * performed. See CameraProjection::projectBatch for the layout of the Jacobians.
+   * @param pointsInCamera 3d points in camera frame, one per column.
+   * @param pixels 2d pixel locations in image plane, one per column.
+   * @param jacobiansWrtPoint if not null, the Jacobians of the pixels w.r.t. the points.
+   * @param jacobiansWrtParams if not null, the Jacobians of the pixels w.r.t. projectionParams().
+   */
+  void projectBatchNoChecks(
+      const Eigen::Ref<const Eigen::Matrix3Xd>& pointsInCamera,
+      Eigen::Matrix2Xd& pixels,
+      CameraProjection::BatchJacobians* jacobiansWrtPoint = nullptr,
+      CameraProjection::BatchJacobians* jacobiansWrtParams = nullptr) const;
+
   /**
    * @brief Function to unproject a 2d pixel location to a 3d ray in camera frame. In this function,
    * no check is performed.
@@ -131,12 +131,21 @@ std::optional<SensorCalibration> DeviceCalibration::getSensorCalib(const std::st
 }
 
 std::optional<CameraCalibration> DeviceCalibration::getCameraCalib(const std::string& label) const {
+  const CameraCalibration* camCalib = findCameraCalib(label);
+  if (camCalib == nullptr) {
+    return {};
+  }
+  return *camCalib;
+}
+
+const CameraCalibration* DeviceCalibration::findCameraCalib(const std::string& label) const {
   if (label == "camera-et") {
     XR_LOGW(
         "camera-et contains calibrations for both left and right cameras. Please use getSensorCalib(camera-et) or getAriaEtCameraCalib() instead");
-    return {};
+    return nullptr;
   }
-  return returnIfFound<CameraCalibration>(cameraCalibs_, label);
+  auto itCalib = cameraCalibs_.find(label);
+  return itCalib != cameraCalibs_.end() ? &itCalib->second : nullptr;
 }
 
 std::optional<ImuCalibration> DeviceCalibration::getImuCalib(const std::string& label) const {
@@ -205,9 +214,9 @@ std::optional<Sophus::SE3d> DeviceCalibration::getT_Device_Sensor(
     // Get calibrated extrinsics for camera
     if (label == "camera-slam-left" || label == "camera-slam-right" || label == "camera-rgb" ||
         label == "camera-et-left" || label == "camera-et-right") {
-      const auto maybeCamCalib = getCameraCalib(label);
-      if (maybeCamCalib.has_value()) {
-        return maybeCamCalib.value().getT_Device_Camera();
+      const CameraCalibration* camCalib = findCameraCalib(label);
+      if (camCalib != nullptr) {
+        return camCalib->getT_Device_Camera();
       } else {
         XR_LOGE("Camera label {} not found in calibration. Please double check label.", label);
         return {};
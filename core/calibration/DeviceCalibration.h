@@ -90,6 +90,12 @@ class DeviceCalibration {
    * in device calibration.
    */
   std::optional<CameraCalibration> getCameraCalib(const std::string& label) const;
+  /**
+   * @brief returns a camera calibration by its label without copying it, e.g. to access it per
+   * frame. Will return `nullptr` if label does not exist in device calibration. The pointer is
+   * valid for the lifetime of this DeviceCalibration.
+   */
+  const CameraCalibration* findCameraCalib(const std::string& label) const;
   /**
    * @brief returns a imu calibration by its label. Will return `nullopt` if label does not exist in
    * device calibration.
@@ -15,9 +15,26 @@
  */
 
 #include <calibration/camera_projections/CameraProjection.h>
+
+#include <dispenso/parallel_for.h>
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
 
 namespace projectaria::tools::calibration {
+namespace {
+// points projected by each task of a batch
+constexpr int kBatchPointsPerTask = 1024;
+} // namespace
+
+struct CameraProjection::InverseDistortionTableCache {
+  std::once_flag computed;
+  Fisheye624::InverseDistortionTable table;
+};
+
 CameraProjection::ProjectionVariant getProjectionVariant(const CameraProjection::ModelType& type) {
   switch (type) {
     case CameraProjection::ModelType::Linear:
@@ -36,7 +53,11 @@ CameraProjection::ProjectionVariant getProjectionVariant(const CameraProjection:
 CameraProjection::CameraProjection(const ModelType& type, const Eigen::VectorXd& projectionParams)
     : modelName_(type),
       projectionParams_(projectionParams),
-      projectionVariant_(getProjectionVariant(type)) {}
+      projectionVariant_(getProjectionVariant(type)) {
+  if (type == ModelType::Fisheye624 && projectionParams_.size() == Fisheye624::kNumParams) {
+    fisheye624InverseTable_ = std::make_shared<InverseDistortionTableCache>();
+  }
+}
 
 CameraProjection::ModelType CameraProjection::modelName() const {
   return modelName_;
@@ -77,11 +98,71 @@ Eigen::Vector2d CameraProjection::project(const Eigen::Vector3d& pointInCamera)
       projectionVariant_);
 }
 
+void CameraProjection::projectBatch(
+    const Eigen::Ref<const Eigen::Matrix3Xd>& pointsInCamera,
+    Eigen::Matrix2Xd& pixels,
+    BatchJacobians* jacobiansWrtPoint,
+    BatchJacobians* jacobiansWrtParams) const {
+  const int numPoints = static_cast<int>(pointsInCamera.cols());
+  pixels.resize(2, numPoints);
+  if (jacobiansWrtPoint != nullptr) {
+    jacobiansWrtPoint->resize(2 * numPoints, 3);
+  }
+  if (jacobiansWrtParams != nullptr) {
+    jacobiansWrtParams->resize(2 * numPoints, projectionParams_.size());
+  }
+
+  std::visit(
+      [&](auto&& projection) {
+        using T = std::decay_t<decltype(projection)>;
+        if (projectionParams_.size() != T::kNumParams) {
+          throw std::runtime_error("The number of projection parameters does not match the model");
+        }
+        const Eigen::Matrix<double, T::kNumParams, 1> params = projectionParams_;
+        double* const pointJacobiansData =
+            jacobiansWrtPoint != nullptr ? jacobiansWrtPoint->data() : nullptr;
+        double* const paramsJacobiansData =
+            jacobiansWrtParams != nullptr ? jacobiansWrtParams->data() : nullptr;
+        const int numTasks = (numPoints + kBatchPointsPerTask - 1) / kBatchPointsPerTask;
+        dispenso::parallel_for(0, numTasks, [&](const int task) {
+          const int end = std::min(numPoints, (task + 1) * kBatchPointsPerTask);
+          for (int i = task * kBatchPointsPerTask; i < end; ++i) {
+            // the Jacobians are written in place, the two rows of point i start at row 2i
+            std::optional<Eigen::Map<Eigen::Matrix<double, 2, 3, Eigen::RowMajor>>> d_point;
+            if (pointJacobiansData != nullptr) {
+              d_point.emplace(pointJacobiansData + 6 * i);
+            }
+            std::optional<Eigen::Map<Eigen::Matrix<double, 2, T::kNumParams, Eigen::RowMajor>>>
+                d_params;
+            if (paramsJacobiansData != nullptr) {
+              d_params.emplace(paramsJacobiansData + 2 * T::kNumParams * i);
+            }
+            pixels.col(i) = T::project(
+                pointsInCamera.col(i),
+                params,
+                d_point ? &*d_point : nullptr,
+                d_params ? &*d_params : nullptr);
+          }
+        });
+      },
+      projectionVariant_);
+}
+
 Eigen::Vector3d CameraProjection::unproject(const Eigen::Vector2d& cameraPixel) const {
   return std::visit(
       [&](auto&& projection) {
         using T = std::decay_t<decltype(projection)>;
-        return T::unproject(cameraPixel, projectionParams_);
+        if constexpr (std::is_same_v<T, Fisheye624>) {
+          if (!fisheye624InverseTable_) {
+            return T::unproject(cameraPixel, projectionParams_);
+          }
+          std::call_once(fisheye624InverseTable_->computed, [this]() {
+            fisheye624InverseTable_->table = T::computeInverseDistortionTable(projectionParams_);
+          });
+          return T::unproject(cameraPixel, projectionParams_, &fisheye624InverseTable_->table);
+        } else {
+          return T::unproject(cameraPixel, projectionParams_);
+        }
       },
       projectionVariant_);
 }
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <string>
 #include <variant>
 
@@ -67,9 +68,33 @@ struct CameraProjection {
    */
   Eigen::Vector2d project(const Eigen::Vector3d& pointInCamera) const;
 
+  // Jacobians of a batch of projections, row major so that the two rows of each point are
+  // contiguous
+  using BatchJacobians = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  /**
+   * @brief projects a batch of 3d points in the camera space to 2d pixels in the image space, and
+   * optionally computes the Jacobians of each pixel w.r.t. its point and the projection
+   * parameters. The projection model is dispatched once for the batch, whose points are projected
+   * in parallel. No checks performed in this process.
+   * @param pointsInCamera the 3d points, one per column
+   * @param pixels the 2d pixels, one per column, resized to the number of points
+   * @param jacobiansWrtPoint if not null, resized to (2N)x3, rows 2i and 2i+1 being the Jacobian
+   * of pixel i w.r.t. point i
+   * @param jacobiansWrtParams if not null, resized to (2N)x(number of projection parameters), rows
+   * 2i and 2i+1 being the Jacobian of pixel i w.r.t. the parameters
+   */
+  void projectBatch(
+      const Eigen::Ref<const Eigen::Matrix3Xd>& pointsInCamera,
+      Eigen::Matrix2Xd& pixels,
+      BatchJacobians* jacobiansWrtPoint = nullptr,
+      BatchJacobians* jacobiansWrtParams = nullptr) const;
+
   /**
    * @brief unprojects a 2d pixel in the image space to a 3d world point in homogenous coordinate.
-   * No checks performed in this process.
+   * No checks performed in this process. For Fisheye624 the iterative inversion of the distortion
+   * starts from an inverse distortion table computed on the first call, and converges to the same
+   * tolerance as without it.
    */
   Eigen::Vector3d unproject(const Eigen::Vector2d& cameraPixel) const;
 
@@ -98,5 +123,9 @@ struct CameraProjection {
   ModelType modelName_;
   Eigen::VectorXd projectionParams_;
   ProjectionVariant projectionVariant_;
+  // inverse distortion table of Fisheye624 computed on the first unprojection, shared by the
+  // copies since the distortion parameters are not changed by scaling or cropping
+  struct InverseDistortionTableCache;
+  std::shared_ptr<InverseDistortionTableCache> fisheye624InverseTable_;
 };
 } // namespace projectaria::tools::calibration
@@ -18,6 +18,9 @@
 
 #include <calibration/camera_projections/Common.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace projectaria::tools::calibration {
 
 // Model for fisheye cameras with radial, tangential, and thin-prism distortion.
@@ -71,10 +74,18 @@ class FisheyeRadTanThinPrism {
   static constexpr bool kIsFisheye = true;
   static constexpr bool kHasAnalyticalProjection = true;
 
-  template <class D, class DP>
+  // Optionally computes the Jacobians of the pixel w.r.t. pointOptical (2x3) and w.r.t. params
+  // (2xkNumParams).
+  template <
+      class D,
+      class DP,
+      class DJ = Eigen::Matrix<typename D::Scalar, 2, 3>,
+      class DJP = Eigen::Matrix<typename D::Scalar, 2, kNumParams>>
   static Eigen::Matrix<typename D::Scalar, 2, 1> project(
       const Eigen::MatrixBase<D>& pointOptical,
-      const Eigen::MatrixBase<DP>& params) {
+      const Eigen::MatrixBase<DP>& params,
+      Eigen::MatrixBase<DJ>* d_point = nullptr,
+      Eigen::MatrixBase<DJP>* d_params = nullptr) {
     using T = typename D::Scalar;
 
     validateProjectInput<D, DP, kNumParams>();
@@ -137,12 +148,70 @@ class FisheyeRadTanThinPrism {
     }
 
     // compute the return value
+    Eigen::Matrix<T, 2, 2> focalLengths;
     if (useSingleFocalLength) {
-      return params[0] * uvDistorted + params.template segment<2>(kPrincipalPointColIdx);
+      focalLengths = params[0] * Eigen::Matrix<T, 2, 2>::Identity();
     } else {
-      return uvDistorted.cwiseProduct(params.template head<2>()) +
-          params.template segment<2>(kPrincipalPointColIdx);
+      focalLengths = params.template head<2>().asDiagonal();
     }
+    const Eigen::Matrix<T, 2, 1> px =
+        focalLengths * uvDistorted + params.template segment<2>(kPrincipalPointColIdx);
+
+    if (d_point == nullptr && d_params == nullptr) {
+      return px;
+    }
+
+    // chain rule through [x_r; y_r]: d_px/d_xryr = diag(fu,fv) * d_uvDistorted/d_xryr
+    Eigen::Matrix<T, 2, 2> duvDistorted_dxryr;
+    compute_duvDistorted_dxryr(xr_yr, xr_yr_squaredNorm, params, duvDistorted_dxryr);
+    const Eigen::Matrix<T, 2, 2> dpx_dxryr = focalLengths * duvDistorted_dxryr;
+
+    if (d_point != nullptr) {
+      // [x_r; y_r] = s(r) * [a; b] with s = th * th_radial / r and dth/dr = 1 / (1 + r^2)
+      Eigen::Matrix<T, 2, 2> dxryr_dab = (th_radial * th_divr) * Eigen::Matrix<T, 2, 2>::Identity();
+      if (r >= std::numeric_limits<T>::epsilon()) {
+        T dthRadial_dth = static_cast<T>(1.0);
+        T theta2is = thetaSq;
+        for (int i = 0; i < numK; ++i) {
+          dthRadial_dth += T(2 * i + 3) * theta2is * params(startK + i);
+          theta2is *= thetaSq;
+        }
+        const T ds_dr = (dthRadial_dth / (static_cast<T>(1.0) + r_sq) - th_radial * th_divr) / r;
+        dxryr_dab.noalias() += (ds_dr / r) * ab * ab.transpose();
+      }
+      Eigen::Matrix<T, 2, 3> dab_dpoint;
+      dab_dpoint << inv_z, T(0), -ab(0) * inv_z, //
+          T(0), inv_z, -ab(1) * inv_z;
+      *d_point = dpx_dxryr * dxryr_dab * dab_dpoint;
+    }
+
+    if (d_params != nullptr) {
+      if (useSingleFocalLength) {
+        d_params->col(kFocalXIdx) = uvDistorted;
+      } else {
+        d_params->template leftCols<2>() = uvDistorted.asDiagonal();
+      }
+      d_params->template middleCols<2>(kPrincipalPointColIdx).setIdentity();
+      // d_xryr/d_k_i = th^(2i+2) * th/r * [a; b]
+      const Eigen::Matrix<T, 2, 1> dpx_dthRadial = dpx_dxryr * (th_divr * ab);
+      T theta2is = thetaSq;
+      for (int i = 0; i < numK; ++i) {
+        d_params->col(startK + i) = theta2is * dpx_dthRadial;
+        theta2is *= thetaSq;
+      }
+      if (useTangential) {
+        d_params->template middleCols<2>(startP) = focalLengths *
+            (T(2) * xr_yr * xr_yr.transpose() +
+             xr_yr_squaredNorm * Eigen::Matrix<T, 2, 2>::Identity());
+      }
+      if (useThinPrism) {
+        Eigen::Matrix<T, 2, 4> duvDistorted_ds;
+        duvDistorted_ds << radialPowers2And4(0), radialPowers2And4(1), T(0), T(0), //
+            T(0), T(0), radialPowers2And4(0), radialPowers2And4(1);
+        d_params->template middleCols<4>(startS) = focalLengths * duvDistorted_ds;
+      }
+    }
+    return px;
   }
 
   // Return scaled parameters to cope with scaled image.
@@ -170,10 +239,146 @@ class FisheyeRadTanThinPrism {
     params[kPrincipalPointRowIdx] -= v;
   }
 
+  // Inverse of the distortion tabulated once for a set of parameters, to start the Newton
+  // iterations of unproject next to their solution. The table is in the coordinates normalized by
+  // the focal length and principal point, which are unchanged by scaleParams and
+  // subtractFromOrigin.
+  struct InverseDistortionTable {
+    // theta at norms of [x_r; y_r] spaced by radiusStep
+    std::vector<double> thetas;
+    double radiusStep = 0;
+    // [x_r; y_r] - uvDistorted at uvDistorted on a grid of gridSize x gridSize points spaced by
+    // gridStep from (-gridRadius, -gridRadius), used within gridRadius - gridStep of the center
+    // so that the cells used are checked. Without tangential and thin-prism distortion the grid
+    // is empty.
+    std::vector<Eigen::Vector2f> xryrOffsets;
+    int gridSize = 0;
+    double gridStep = 0;
+    double gridRadius = 0;
+    // Newton iterations converging from the guesses of the table, which are checked against
+    // converged solutions between all its entries when it is computed
+    int thetaIterations = CameraNewtonsMethod::kMaxIterations;
+    int xryrIterations = CameraNewtonsMethod::kMaxIterations;
+  };
+
+  template <typename DP>
+  static InverseDistortionTable computeInverseDistortionTable(const Eigen::MatrixBase<DP>& params) {
+    constexpr int kNumThetaSamples = 16384;
+    constexpr int kNumRadii = 4096;
+    constexpr int kGridSize = 129;
+    // beyond this slope the polynomial extrapolates past the calibrated field of view
+    constexpr double kMaxRadialSlope = 8.0;
+    constexpr double kTolerance = CameraNewtonsMethod::getConvergenceTolerance<double>();
+
+    // sample the radial polynomial up to 90 degrees, or up to where it stops increasing or
+    // increases too steeply
+    const double maxTheta = 0.999 * Sophus::Constants<double>::pi() / 2.0;
+    const double thetaStep = maxTheta / kNumThetaSamples;
+    std::vector<double> radii{0.0};
+    std::vector<double> thetas{0.0};
+    for (int i = 1; i <= kNumThetaSamples; ++i) {
+      const double theta = i * thetaStep;
+      const double radius = evaluateRadialPolynomial(theta, params);
+      if (!(radius > radii.back()) || radius - radii.back() > kMaxRadialSlope * thetaStep) {
+        break;
+      }
+      radii.push_back(radius);
+      thetas.push_back(theta);
+    }
+
+    // invert it at evenly spaced radii
+    InverseDistortionTable table;
+    if (radii.size() < 2) {
+      return table;
+    }
+    table.radiusStep = radii.back() / (kNumRadii - 1);
+    table.thetas.resize(kNumRadii);
+    size_t sample = 1;
+    for (int i = 0; i < kNumRadii; ++i) {
+      const double radius = std::min(i * table.radiusStep, radii.back());
+      while (sample + 1 < radii.size() && radii[sample] < radius) {
+        ++sample;
+      }
+      const double alpha = (radius - radii[sample - 1]) / (radii[sample] - radii[sample - 1]);
+      table.thetas[i] = thetas[sample - 1] + alpha * (thetas[sample] - thetas[sample - 1]);
+    }
+
+    // check that a single iteration converges in the middle of the entries, where the
+    // interpolation is the least accurate
+    double maxThetaError = 0;
+    for (int i = 0; i + 1 < kNumRadii && maxThetaError <= kTolerance; ++i) {
+      const double radius = (i + 0.5) * table.radiusStep;
+      double theta = radius;
+      lookUpTheta(radius, table, theta);
+      theta = getThetaFromNorm_xr_yr(radius, params, theta, 1);
+      const double solution =
+          getThetaFromNorm_xr_yr(radius, params, theta, CameraNewtonsMethod::kMaxIterations);
+      maxThetaError = std::max(maxThetaError, std::abs(theta - solution));
+    }
+    if (maxThetaError <= kTolerance) {
+      table.thetaIterations = 1;
+    }
+
+    if (!useTangential && !useThinPrism) {
+      return table;
+    }
+    table.gridSize = kGridSize;
+    table.gridRadius = radii.back();
+    table.gridStep = 2 * table.gridRadius / (kGridSize - 1);
+    table.xryrOffsets.resize(kGridSize * kGridSize, Eigen::Vector2f::Zero());
+    for (int row = 0; row < kGridSize; ++row) {
+      for (int col = 0; col < kGridSize; ++col) {
+        const Eigen::Vector2d uvDistorted(
+            col * table.gridStep - table.gridRadius, row * table.gridStep - table.gridRadius);
+        const Eigen::Vector2d xryrOffset = compute_xr_yr_from_uvDistorted(
+                                               uvDistorted,
+                                               params,
+                                               uvDistorted,
+                                               CameraNewtonsMethod::kMaxIterations) -
+            uvDistorted;
+        if (xryrOffset.allFinite()) {
+          table.xryrOffsets[row * kGridSize + col] = xryrOffset.cast<float>();
+        }
+      }
+    }
+
+    // same check in the middle of the cells within gridRadius
+    double maxXryrError = 0;
+    for (int row = 0; row + 1 < kGridSize && maxXryrError <= kTolerance; ++row) {
+      for (int col = 0; col + 1 < kGridSize && maxXryrError <= kTolerance; ++col) {
+        const Eigen::Vector2d uvDistorted(
+            (col + 0.5) * table.gridStep - table.gridRadius,
+            (row + 0.5) * table.gridStep - table.gridRadius);
+        if (uvDistorted.norm() >= table.gridRadius) {
+          continue;
+        }
+        Eigen::Vector2d xr_yr = interpolate_xr_yr(uvDistorted, table);
+        xr_yr = compute_xr_yr_from_uvDistorted(uvDistorted, params, xr_yr, 1);
+        const Eigen::Vector2d solution = compute_xr_yr_from_uvDistorted(
+            uvDistorted, params, xr_yr, CameraNewtonsMethod::kMaxIterations);
+        maxXryrError = std::max(maxXryrError, (xr_yr - solution).norm());
+      }
+    }
+    if (maxXryrError <= kTolerance) {
+      table.xryrIterations = 1;
+    }
+    return table;
+  }
+
   template <typename D, typename DP>
   static Eigen::Matrix<typename D::Scalar, 3, 1> unproject(
       const Eigen::MatrixBase<D>& p,
       const Eigen::MatrixBase<DP>& params) {
+    return unproject(p, params, nullptr);
+  }
+
+  // Unprojects with the Newton iterations started from the inverse distortion table of params
+  // computed by computeInverseDistortionTable, or from the distorted point when it is null.
+  template <typename D, typename DP>
+  static Eigen::Matrix<typename D::Scalar, 3, 1> unproject(
+      const Eigen::MatrixBase<D>& p,
+      const Eigen::MatrixBase<DP>& params,
+      const InverseDistortionTable* table) {
     validateUnprojectInput<D, DP, kNumParams>();
 
     using T = typename D::Scalar;
@@ -190,7 +395,11 @@ class FisheyeRadTanThinPrism {
     }
 
     // get xr_yr from uvDistorted
-    Eigen::Matrix<T, 2, 1> xr_yr = compute_xr_yr_from_uvDistorted(uvDistorted, params);
+    Eigen::Matrix<T, 2, 1> xr_yr = uvDistorted;
+    const int xryrIterations = table && lookUp_xr_yr(uvDistorted, *table, xr_yr)
+        ? table->xryrIterations
+        : CameraNewtonsMethod::kMaxIterations;
+    xr_yr = compute_xr_yr_from_uvDistorted(uvDistorted, params, xr_yr, xryrIterations);
 
     // early exit if point is in the center of the image
     const T xr_yrNorm = xr_yr.norm();
@@ -199,7 +408,11 @@ class FisheyeRadTanThinPrism {
     }
 
     // otherwise, find theta
-    T theta = getThetaFromNorm_xr_yr(xr_yrNorm, params);
+    T theta = xr_yrNorm;
+    const int thetaIterations = table && lookUpTheta(xr_yrNorm, *table, theta)
+        ? table->thetaIterations
+        : CameraNewtonsMethod::kMaxIterations;
+    theta = getThetaFromNorm_xr_yr(xr_yrNorm, params, theta, thetaIterations);
 
     // get the point coordinates:
     Eigen::Matrix<T, 3, 1> point3dEst;
@@ -214,17 +427,18 @@ class FisheyeRadTanThinPrism {
   template <typename T, typename DP>
   inline static Eigen::Matrix<T, 2, 1> compute_xr_yr_from_uvDistorted(
       const Eigen::Matrix<T, 2, 1>& uvDistorted,
-      const Eigen::MatrixBase<DP>& params) {
+      const Eigen::MatrixBase<DP>& params,
+      const Eigen::Matrix<T, 2, 1>& initialGuess,
+      const int maxIterations) {
     // early exit if we're not using any tangential/ thin prism distortions
     if (!useTangential && !useThinPrism) {
       return uvDistorted;
     }
 
-    // initial guess:
-    Eigen::Matrix<T, 2, 1> xr_yr = uvDistorted;
+    Eigen::Matrix<T, 2, 1> xr_yr = initialGuess;
 
     // do Newton iterations to find xr_yr
-    for (int j = 0; j < CameraNewtonsMethod::kMaxIterations; ++j) {
+    for (int j = 0; j < maxIterations; ++j) {
       // compute the estimated uvDistorted
       Eigen::Matrix<T, 2, 1> uvDistorted_est = xr_yr;
       const T xr_yr_squaredNorm = xr_yr.squaredNorm();
@@ -266,13 +480,14 @@ class FisheyeRadTanThinPrism {
   template <typename T, typename D>
   inline static T getThetaFromNorm_xr_yr(
       const T th_radialDesired,
-      const Eigen::MatrixBase<D>& params) {
-    // initial guess
-    T th = th_radialDesired;
+      const Eigen::MatrixBase<D>& params,
+      const T initialGuess,
+      const int maxIterations) {
+    T th = initialGuess;
 
     using std::abs;
 
-    for (int j = 0; j < CameraNewtonsMethod::kMaxIterations; ++j) {
+    for (int j = 0; j < maxIterations; ++j) {
       const T thetaSq = th * th;
 
       T th_radial = T(1);
@@ -316,6 +531,71 @@ class FisheyeRadTanThinPrism {
     return th;
   }
 
+  // helper function to compute the norm of [x_r; y_r] at the angle theta
+  template <typename T, typename D>
+  inline static T evaluateRadialPolynomial(const T theta, const Eigen::MatrixBase<D>& params) {
+    const T thetaSq = theta * theta;
+    T th_radial = T(1);
+    T theta2is = thetaSq;
+    for (int i = 0; i < numK; ++i) {
+      th_radial += theta2is * params(startK + i);
+      theta2is *= thetaSq;
+    }
+    return th_radial * theta;
+  }
+
+  // helper function to look up theta in an inverse distortion table by linear interpolation,
+  // returns false beyond the table
+  template <typename T>
+  inline static bool
+  lookUpTheta(const T th_radialDesired, const InverseDistortionTable& table, T& theta) {
+    const double position = IgnoreJetInfinitesimal(th_radialDesired) / table.radiusStep;
+    if (table.thetas.empty() || !(position >= 0) || position >= table.thetas.size() - 1) {
+      return false;
+    }
+    const int index = static_cast<int>(position);
+    const double alpha = position - index;
+    theta = T((1 - alpha) * table.thetas[index] + alpha * table.thetas[index + 1]);
+    return true;
+  }
+
+  // helper function to look up [x_r; y_r] in an inverse distortion table, returns false beyond
+  // gridRadius - gridStep
+  template <typename T>
+  inline static bool lookUp_xr_yr(
+      const Eigen::Matrix<T, 2, 1>& uvDistorted,
+      const InverseDistortionTable& table,
+      Eigen::Matrix<T, 2, 1>& xr_yr) {
+    const double maxRadius = table.gridRadius - table.gridStep;
+    if (table.gridSize == 0 ||
+        !(IgnoreEigenJetInfinitesimal(uvDistorted).squaredNorm() < maxRadius * maxRadius)) {
+      return false;
+    }
+    xr_yr = interpolate_xr_yr(uvDistorted, table);
+    return true;
+  }
+
+  // helper function to interpolate [x_r; y_r] bilinearly in the grid of an inverse distortion
+  // table
+  template <typename T>
+  inline static Eigen::Matrix<T, 2, 1> interpolate_xr_yr(
+      const Eigen::Matrix<T, 2, 1>& uvDistorted,
+      const InverseDistortionTable& table) {
+    const Eigen::Vector2d uv = IgnoreEigenJetInfinitesimal(uvDistorted);
+    const double col = (uv.x() + table.gridRadius) / table.gridStep;
+    const double row = (uv.y() + table.gridRadius) / table.gridStep;
+    const int col0 = std::clamp(static_cast<int>(col), 0, table.gridSize - 2);
+    const int row0 = std::clamp(static_cast<int>(row), 0, table.gridSize - 2);
+    const float alphaCol = static_cast<float>(col - col0);
+    const float alphaRow = static_cast<float>(row - row0);
+    const Eigen::Vector2f* top = &table.xryrOffsets[row0 * table.gridSize + col0];
+    const Eigen::Vector2f* bottom = top + table.gridSize;
+    const Eigen::Vector2f offset =
+        (1 - alphaRow) * ((1 - alphaCol) * top[0] + alphaCol * top[1]) +
+        alphaRow * ((1 - alphaCol) * bottom[0] + alphaCol * bottom[1]);
+    return uvDistorted + offset.cast<double>().template cast<T>();
+  }
+
   // helper function, computes the Jacobian of uvDistorted wrt the vector [x_r;y_r]
   template <typename D>
   inline static void compute_duvDistorted_dxryr(
@@ -50,10 +50,18 @@ class KannalaBrandtK3Projection {
   static constexpr bool kIsFisheye = true;
   static constexpr bool kHasAnalyticalProjection = true;
 
-  template <class D, class DP>
+  // Optionally computes the Jacobians of the pixel w.r.t. pointOptical (2x3) and w.r.t. params
+  // (2x8).
+  template <
+      class D,
+      class DP,
+      class DJ = Eigen::Matrix<typename D::Scalar, 2, 3>,
+      class DJP = Eigen::Matrix<typename D::Scalar, 2, kNumParams>>
   static Eigen::Matrix<typename D::Scalar, 2, 1> project(
       const Eigen::MatrixBase<D>& pointOptical,
-      const Eigen::MatrixBase<DP>& params) {
+      const Eigen::MatrixBase<DP>& params,
+      Eigen::MatrixBase<DJ>* d_point = nullptr,
+      Eigen::MatrixBase<DJP>* d_params = nullptr) {
     validateProjectInput<D, DP, kNumParams>();
 
     using T = typename D::Scalar;
@@ -87,12 +95,52 @@ class KannalaBrandtK3Projection {
       const Eigen::Matrix<T, 2, 1> px =
           scaling * ff.cwiseProduct(pointOptical.template head<2>()) + pp;
 
+      if (d_point != nullptr || d_params != nullptr) {
+        const Eigen::Matrix<T, 2, 1> xy = pointOptical.template head<2>();
+        const Eigen::Matrix<T, 2, 1> ffxy = ff.cwiseProduct(xy);
+        if (d_point != nullptr) {
+          // derivatives of the scaling w.r.t. the radius and z, with
+          // dtheta/dradius = z / (radius^2 + z^2) and dtheta/dz = -radius / (radius^2 + z^2)
+          const T inv_normSquared = T(1.0) / (radiusSquared + pointOptical(2) * pointOptical(2));
+          const T dRDistorted_dTheta = T(1.0) + T(3) * k0 * theta2 + T(5) * k1 * theta4 +
+              T(7) * k2 * theta6 + T(9) * k3 * theta8;
+          const T dScaling_dRadius =
+              (dRDistorted_dTheta * pointOptical(2) * inv_normSquared - scaling) * radiusInverse;
+          const T dScaling_dz = -dRDistorted_dTheta * inv_normSquared;
+          d_point->template leftCols<2>() = ff.asDiagonal() *
+              (scaling * Eigen::Matrix<T, 2, 2>::Identity() +
+               (dScaling_dRadius * radiusInverse) * xy * xy.transpose());
+          d_point->col(2) = dScaling_dz * ffxy;
+        }
+        if (d_params != nullptr) {
+          d_params->template leftCols<2>() = (scaling * xy).asDiagonal();
+          d_params->template middleCols<2>(2).setIdentity();
+          const T theta3_divr = theta * theta2 * radiusInverse;
+          d_params->col(4) = theta3_divr * ffxy;
+          d_params->col(5) = (theta3_divr * theta2) * ffxy;
+          d_params->col(6) = (theta3_divr * theta4) * ffxy;
+          d_params->col(7) = (theta3_divr * theta6) * ffxy;
+        }
+      }
       return px;
     } else {
       // linearize r around radius=0
       const Eigen::Matrix<T, 2, 1> px =
           ff.cwiseProduct(pointOptical.template head<2>()) / pointOptical(2) + pp;
 
+      if (d_point != nullptr || d_params != nullptr) {
+        const T inv_z = T(1.0) / pointOptical(2);
+        const Eigen::Matrix<T, 2, 1> ab = pointOptical.template head<2>() * inv_z;
+        if (d_point != nullptr) {
+          *d_point << ff(0) * inv_z, T(0), -ff(0) * ab(0) * inv_z, //
+              T(0), ff(1) * inv_z, -ff(1) * ab(1) * inv_z;
+        }
+        if (d_params != nullptr) {
+          d_params->setZero();
+          d_params->template leftCols<2>() = ab.asDiagonal();
+          d_params->template middleCols<2>(2).setIdentity();
+        }
+      }
       return px;
     }
   }
@@ -42,10 +42,18 @@ class LinearProjection {
   static constexpr bool kIsFisheye = false;
   static constexpr bool kHasAnalyticalProjection = true;
 
-  template <class D, class DP>
+  // Optionally computes the Jacobians of the pixel w.r.t. pointOptical (2x3) and w.r.t. params
+  // (2x4).
+  template <
+      class D,
+      class DP,
+      class DJ = Eigen::Matrix<typename D::Scalar, 2, 3>,
+      class DJP = Eigen::Matrix<typename D::Scalar, 2, kNumParams>>
   static Eigen::Matrix<typename D::Scalar, 2, 1> project(
       const Eigen::MatrixBase<D>& pointOptical,
-      const Eigen::MatrixBase<DP>& params) {
+      const Eigen::MatrixBase<DP>& params,
+      Eigen::MatrixBase<DJ>* d_point = nullptr,
+      Eigen::MatrixBase<DJP>* d_params = nullptr) {
     validateProjectInput<D, DP, kNumParams>();
     using T = typename D::Scalar;
 
@@ -57,6 +65,19 @@ class LinearProjection {
     const Eigen::Matrix<T, 2, 1> px =
         ff.cwiseProduct(pointOptical.template head<2>()) / pointOptical(2) + pp;
 
+    if (d_point != nullptr || d_params != nullptr) {
+      const T inv_z = T(1.0) / pointOptical(2);
+      const Eigen::Matrix<T, 2, 1> ab = pointOptical.template head<2>() * inv_z;
+      if (d_point != nullptr) {
+        *d_point << ff(0) * inv_z, T(0), -ff(0) * ab(0) * inv_z, //
+            T(0), ff(1) * inv_z, -ff(1) * ab(1) * inv_z;
+      }
+      if (d_params != nullptr) {
+        *d_params << ab(0), T(0), T(1), T(0), //
+            T(0), ab(1), T(0), T(1);
+      }
+    }
+
     return px;
   }
 
@@ -49,10 +49,19 @@ class SphericalProjection {
   //
   // Return 2-point in the image plane.
   //
-  template <class D, class DP>
+  // Optionally computes the Jacobians of the pixel w.r.t. pointOptical (2x3) and w.r.t. params
+  // (2x4).
+  //
+  template <
+      class D,
+      class DP,
+      class DJ = Eigen::Matrix<typename D::Scalar, 2, 3>,
+      class DJP = Eigen::Matrix<typename D::Scalar, 2, kNumParams>>
   static Eigen::Matrix<typename D::Scalar, 2, 1> project(
       const Eigen::MatrixBase<D>& pointOptical,
-      const Eigen::MatrixBase<DP>& params) {
+      const Eigen::MatrixBase<DP>& params,
+      Eigen::MatrixBase<DJ>* d_point = nullptr,
+      Eigen::MatrixBase<DJP>* d_params = nullptr) {
     validateProjectInput<D, DP, kNumParams>();
     using T = typename D::Scalar;
     SOPHUS_ENSURE(pointOptical.z() != T(0), "z(%) must not be zero.", pointOptical.z());
@@ -73,12 +82,43 @@ class SphericalProjection {
       const T scaling = theta * radiusInverse;
       const Eigen::Matrix<T, 2, 1> px =
           scaling * ff.cwiseProduct(pointOptical.template head<2>()) + pp;
+
+      if (d_point != nullptr || d_params != nullptr) {
+        const Eigen::Matrix<T, 2, 1> xy = pointOptical.template head<2>();
+        // derivatives of the scaling w.r.t. the radius and z, with
+        // dtheta/dradius = z / (radius^2 + z^2) and dtheta/dz = -radius / (radius^2 + z^2)
+        const T inv_normSquared = T(1.0) / (radiusSquared + pointOptical(2) * pointOptical(2));
+        const T dScaling_dRadius = (pointOptical(2) * inv_normSquared - scaling) * radiusInverse;
+        const T dScaling_dz = -inv_normSquared;
+        if (d_point != nullptr) {
+          d_point->template leftCols<2>() = ff.asDiagonal() *
+              (scaling * Eigen::Matrix<T, 2, 2>::Identity() +
+               (dScaling_dRadius * radiusInverse) * xy * xy.transpose());
+          d_point->col(2) = dScaling_dz * ff.cwiseProduct(xy);
+        }
+        if (d_params != nullptr) {
+          d_params->template leftCols<2>() = (scaling * xy).asDiagonal();
+          d_params->template rightCols<2>().setIdentity();
+        }
+      }
       return px;
     } else {
       // linearize r around radius=0
       const Eigen::Matrix<T, 2, 1> px =
           ff.cwiseProduct(pointOptical.template head<2>()) / pointOptical(2) + pp;
 
+      if (d_point != nullptr || d_params != nullptr) {
+        const T inv_z = T(1.0) / pointOptical(2);
+        const Eigen::Matrix<T, 2, 1> ab = pointOptical.template head<2>() * inv_z;
+        if (d_point != nullptr) {
+          *d_point << ff(0) * inv_z, T(0), -ff(0) * ab(0) * inv_z, //
+              T(0), ff(1) * inv_z, -ff(1) * ab(1) * inv_z;
+        }
+        if (d_params != nullptr) {
+          *d_params << ab(0), T(0), T(1), T(0), //
+              T(0), ab(1), T(0), T(1);
+        }
+      }
       return px;
     }
   }
@@ -21,6 +21,7 @@
 #define DEFAULT_LOG_CHANNEL "DeviceCalibrationFactory"
 #include <logging/Log.h>
 
+#include <stdexcept>
 #include <string>
 
 namespace projectaria::tools::calibration {
@@ -127,4 +128,26 @@ std::optional<DeviceCalibration> deviceCalibrationFromJson(const std::string& ca
       deviceSubtype,
       originLabel};
 }
+
+std::string updateCameraCalibrationsInJson(
+    const std::string& calibJsonStr,
+    const std::vector<CameraCalibration>& cameraCalibs) {
+  auto json = nlohmann::json::parse(calibJsonStr.c_str());
+  for (const auto& camCalib : cameraCalibs) {
+    bool updated = false;
+    if (json.contains("CameraCalibrations")) {
+      for (auto& camJson : json["CameraCalibrations"]) {
+        if (camJson["Label"] == camCalib.getLabel()) {
+          updateCameraCalibrationJson(camCalib, camJson);
+          updated = true;
+        }
+      }
+    }
+    if (!updated) {
+      throw std::runtime_error{
+          fmt::format("Camera {} is not in the calib json", camCalib.getLabel())};
+    }
+  }
+  return json.dump();
+}
 } // namespace projectaria::tools::calibration
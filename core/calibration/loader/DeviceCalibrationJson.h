@@ -18,6 +18,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <calibration/DeviceCalibration.h>
 
@@ -25,4 +26,12 @@ namespace projectaria::tools::calibration {
 
 std::optional<DeviceCalibration> deviceCalibrationFromJson(const std::string& calibJsonStr);
 
+/**
+ * @brief Returns the calib json string with the given camera calibrations, e.g. rescaled to the
+ * resolution of a downscaled recording, in place of the ones with the same labels
+ */
+std::string updateCameraCalibrationsInJson(
+    const std::string& calibJsonStr,
+    const std::vector<CameraCalibration>& cameraCalibs);
+
 } // namespace projectaria::tools::calibration
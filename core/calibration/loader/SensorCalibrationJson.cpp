@@ -23,6 +23,7 @@
 #include <logging/Log.h>
 
 #include <stdexcept>
+#include <vector>
 
 namespace projectaria::tools::calibration {
 namespace {
@@ -114,6 +115,14 @@ CameraCalibration parseCameraCalibrationFromJson(const nlohmann::json& json) {
     XR_LOGE("{}", error);
     throw std::runtime_error{error};
   }
+  // Calibrations rescaled to a downscaled recording store their resolution and valid radius
+  if (json.contains("ImageSize")) {
+    width = json["ImageSize"][0];
+    height = json["ImageSize"][1];
+  }
+  if (json.contains("ValidRadius")) {
+    validRadius = json["ValidRadius"].get<double>();
+  }
 
   CameraCalibration camCalib(
       label,
@@ -128,6 +137,18 @@ CameraCalibration parseCameraCalibrationFromJson(const nlohmann::json& json) {
   return camCalib;
 }
 
+void updateCameraCalibrationJson(const CameraCalibration& camCalib, nlohmann::json& json) {
+  const Eigen::VectorXd projectionParams = camCalib.projectionParams();
+  json["Projection"]["Params"] = std::vector<double>(
+      projectionParams.data(), projectionParams.data() + projectionParams.size());
+  json["ImageSize"] = {camCalib.getImageSize().x(), camCalib.getImageSize().y()};
+  if (camCalib.getValidRadius()) {
+    json["ValidRadius"] = *camCalib.getValidRadius();
+  } else {
+    json.erase("ValidRadius");
+  }
+}
+
 namespace {
 std::pair<Eigen::Matrix3d, Eigen::Vector3d> parseRectModelFromJson(const nlohmann::json& json) {
   return {
@@ -27,4 +27,10 @@ MagnetometerCalibration parseMagnetometerCalibrationFromJson(const nlohmann::jso
 BarometerCalibration parseBarometerCalibrationFromJson(const nlohmann::json& json);
 MicrophoneCalibration parseMicrophoneCalibrationFromJson(const nlohmann::json& json);
 
+/**
+ * @brief Writes the projection parameters, resolution and valid radius of a camera calibration,
+ * e.g. rescaled, to its json, leaving the other fields as they are
+ */
+void updateCameraCalibrationJson(const CameraCalibration& camCalib, nlohmann::json& json);
+
 } // namespace projectaria::tools::calibration
@@ -17,6 +17,9 @@
 #include "Distort.h"
 #include "image/utility/Distort.h"
 
+#include <cmath>
+#include <stdexcept>
+
 namespace projectaria::tools::calibration {
 
 image::ManagedImageVariant distortByCalibration(
@@ -52,4 +55,69 @@ image::ManagedImageVariant distortLabelMaskByCalibration(
       srcVariant, dstCalib, srcCalib, image::InterpolationMethod::NearestNeighbor);
 }
 
+CalibrationWarp makeCalibrationWarp(
+    const CameraCalibration& srcCalib,
+    const CameraCalibration& dstCalib) {
+  const Eigen::Matrix3d R_srcCamera_dstCamera =
+      (srcCalib.getT_Device_Camera().so3().inverse() * dstCalib.getT_Device_Camera().so3())
+          .matrix();
+
+  CalibrationWarp warp;
+  warp.dstCalib = dstCalib;
+  warp.warpMap = image::computeWarpMap(
+      [&](const Eigen::Vector2f& dstPixel) -> std::optional<Eigen::Vector2f> {
+        const Eigen::Vector3d rayDir =
+            R_srcCamera_dstCamera * dstCalib.unprojectNoChecks(dstPixel.template cast<double>());
+        std::optional<Eigen::Vector2d> maybeSrcPixel = srcCalib.project(rayDir);
+        if (!maybeSrcPixel) {
+          return std::nullopt;
+        }
+        return maybeSrcPixel->template cast<float>();
+      },
+      dstCalib.getImageSize());
+  return warp;
+}
+
+CalibrationWarp makeCalibrationWarp(
+    const CameraCalibration& srcCalib,
+    const CameraProjection::ModelType dstModelType,
+    const Eigen::Vector2i& dstImageSize,
+    const double dstFocalLength,
+    const ImageRotation rotation) {
+  if (dstModelType != CameraProjection::ModelType::Linear &&
+      dstModelType != CameraProjection::ModelType::Spherical) {
+    throw std::runtime_error("Only support CameraProjection::ModelType::{Linear, Spherical}");
+  }
+  if (dstImageSize.minCoeff() <= 0 || dstFocalLength <= 0) {
+    throw std::runtime_error("The output image size and focal length must be positive");
+  }
+
+  // each clockwise quarter turn of the image is a rotation of -90 degrees around the optical axis
+  const int numQuarterTurns = static_cast<int>(rotation);
+  const Sophus::SE3d T_srcCamera_dstCamera = Sophus::SE3d::rotZ(numQuarterTurns * M_PI / -2.0);
+  const Sophus::SE3d T_Device_dstCamera = srcCalib.getT_Device_Camera() * T_srcCamera_dstCamera;
+
+  const CameraCalibration dstCalib = dstModelType == CameraProjection::ModelType::Linear
+      ? getLinearCameraCalibration(
+            dstImageSize.x(),
+            dstImageSize.y(),
+            dstFocalLength,
+            srcCalib.getLabel(),
+            T_Device_dstCamera)
+      : getSphericalCameraCalibration(
+            dstImageSize.x(),
+            dstImageSize.y(),
+            dstFocalLength,
+            srcCalib.getLabel(),
+            T_Device_dstCamera);
+  return makeCalibrationWarp(srcCalib, dstCalib);
+}
+
+image::ManagedImageVariant warpByCalibration(
+    const image::ImageVariant& srcVariant,
+    const CalibrationWarp& warp,
+    const image::InterpolationMethod method) {
+  return image::warpImageVariant(srcVariant, warp.warpMap, method);
+}
+
 } // namespace projectaria::tools::calibration
@@ -57,4 +57,65 @@ image::ManagedImageVariant distortLabelMaskByCalibration(
     const CameraCalibration& dstCalib,
     const CameraCalibration& srcCalib);
 
+/**
+ * @brief Clockwise in-plane rotation of the output images of a CalibrationWarp
+ */
+enum class ImageRotation {
+  None,
+  CW90, ///< @brief e.g. to view the RGB and SLAM images of Aria upright
+  Rotate180,
+  CCW90,
+};
+
+/**
+ * @brief Warp from the images of a camera to the images of another camera model, with the mapping
+ * of the pixels computed once to warp many images
+ */
+struct CalibrationWarp {
+  // calibration of the warped images
+  CameraCalibration dstCalib;
+  image::WarpMap warpMap;
+};
+
+/**
+ * @brief Prepares a warp from the images of a camera to the images of another camera at the same
+ * position, e.g. a rectified camera. The rotation between the cameras is that of their extrinsics,
+ * the translation between them is ignored.
+ * @param srcCalib the calibration model of the input images
+ * @param dstCalib the calibration model of the output images
+ */
+CalibrationWarp makeCalibrationWarp(
+    const CameraCalibration& srcCalib,
+    const CameraCalibration& dstCalib);
+
+/**
+ * @brief Prepares a warp undistorting, rotating and resizing the images of a camera in a single
+ * pass: the output images are seen by a Linear (pinhole) or Spherical camera with its principal
+ * point at the image center, rotated in-plane from the input camera.
+ * @param srcCalib the calibration model of the input images
+ * @param dstModelType the model of the output images, Linear or Spherical
+ * @param dstImageSize the size of the output images, once rotated
+ * @param dstFocalLength the focal length of the output images in pixels
+ * @param rotation the in-plane rotation of the output images. The extrinsics of the calibration of
+ * the output images account for the rotation, as with rotateCameraCalibCW90Deg()
+ */
+CalibrationWarp makeCalibrationWarp(
+    const CameraCalibration& srcCalib,
+    const CameraProjection::ModelType dstModelType,
+    const Eigen::Vector2i& dstImageSize,
+    const double dstFocalLength,
+    const ImageRotation rotation = ImageRotation::None);
+
+/**
+ * @brief Warps an input image with a warp prepared by makeCalibrationWarp(), see
+ * image::warpImageVariant()
+ * @param srcVariant the input image, of the size of the input calibration of the warp
+ * @param warp the warp to apply
+ * @param method the interpolation method (Bilinear, NearestNeighbor)
+ */
+image::ManagedImageVariant warpByCalibration(
+    const image::ImageVariant& srcVariant,
+    const CalibrationWarp& warp,
+    const image::InterpolationMethod method = image::InterpolationMethod::Bilinear);
+
 } // namespace projectaria::tools::calibration
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StereoRectification.h"
+
+#include <dispenso/parallel_for.h>
+
+#include <array>
+#include <stdexcept>
+
+namespace projectaria::tools::calibration {
+
+StereoRectification makeStereoRectification(
+    const CameraCalibration& leftCalib,
+    const CameraCalibration& rightCalib,
+    const Eigen::Vector2i& imageSize,
+    const std::optional<double>& focalLength) {
+  if (imageSize.minCoeff() <= 0 || (focalLength && *focalLength <= 0)) {
+    throw std::runtime_error("The rectified image size and focal length must be positive");
+  }
+
+  const Sophus::SE3d& T_Device_left = leftCalib.getT_Device_Camera();
+  const Sophus::SE3d& T_Device_right = rightCalib.getT_Device_Camera();
+  const Sophus::SE3d T_left_right = T_Device_left.inverse() * T_Device_right;
+
+  // axes of the rectified cameras in the left camera frame: x along the baseline, z along the
+  // average optical axis made orthogonal to x, y completing the right handed frame
+  const double baseline = T_left_right.translation().norm();
+  if (baseline <= 0) {
+    throw std::runtime_error("The stereo cameras must be at different positions");
+  }
+  const Eigen::Vector3d xAxis = T_left_right.translation() / baseline;
+  const Eigen::Vector3d averageOpticalAxis =
+      Eigen::Vector3d::UnitZ() + T_left_right.so3() * Eigen::Vector3d::UnitZ();
+  Eigen::Vector3d zAxis = averageOpticalAxis - averageOpticalAxis.dot(xAxis) * xAxis;
+  if (zAxis.norm() < 1e-6) {
+    throw std::runtime_error("The optical axes of the stereo cameras are along their baseline");
+  }
+  zAxis.normalize();
+  Eigen::Matrix3d R_left_rectified;
+  R_left_rectified << xAxis, zAxis.cross(xAxis), zAxis;
+
+  // both rectified cameras have the same orientation, at the positions of the cameras
+  const Sophus::SO3d R_Device_rectified = T_Device_left.so3() * Sophus::SO3d(R_left_rectified);
+  const double rectifiedFocalLength = focalLength.value_or(
+      leftCalib.getFocalLengths().x() * imageSize.x() / leftCalib.getImageSize().x());
+  auto makeRectifiedCalib = [&](const CameraCalibration& calib) {
+    return getLinearCameraCalibration(
+        imageSize.x(),
+        imageSize.y(),
+        rectifiedFocalLength,
+        calib.getLabel(),
+        Sophus::SE3d(R_Device_rectified, calib.getT_Device_Camera().translation()));
+  };
+
+  StereoRectification rectification;
+  rectification.leftWarp = makeCalibrationWarp(leftCalib, makeRectifiedCalib(leftCalib));
+  rectification.rightWarp = makeCalibrationWarp(rightCalib, makeRectifiedCalib(rightCalib));
+  rectification.baseline = baseline;
+  return rectification;
+}
+
+std::pair<image::ManagedImageVariant, image::ManagedImageVariant> rectifyStereoPair(
+    const image::ImageVariant& leftVariant,
+    const image::ImageVariant& rightVariant,
+    const StereoRectification& rectification,
+    const image::InterpolationMethod method) {
+  const std::array<const image::ImageVariant*, 2> srcVariants = {&leftVariant, &rightVariant};
+  const std::array<const CalibrationWarp*, 2> warps = {
+      &rectification.leftWarp, &rectification.rightWarp};
+  std::array<image::ManagedImageVariant, 2> rectified;
+  dispenso::parallel_for(0, 2, [&](const int i) {
+    rectified[i] = warpByCalibration(*srcVariants[i], *warps[i], method);
+  });
+  return {std::move(rectified[0]), std::move(rectified[1])};
+}
+
+} // namespace projectaria::tools::calibration
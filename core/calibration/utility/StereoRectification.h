@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <calibration/CameraCalibration.h>
+#include <calibration/utility/Distort.h>
+#include <image/ImageVariant.h>
+
+#include <optional>
+#include <utility>
+
+namespace projectaria::tools::calibration {
+/**
+ * @brief Rectification of a stereo pair of cameras, e.g. camera-slam-left and camera-slam-right.
+ * The rectified cameras are linear cameras with the same orientation, image size and focal length,
+ * whose x axis is along the baseline from the left to the right camera. A 3D point is seen on the
+ * same row of both rectified images, with a disparity uLeft - uRight of focalLength * baseline /
+ * depth pixels.
+ */
+struct StereoRectification {
+  // warp from the left images to the rectified left images
+  CalibrationWarp leftWarp;
+  // warp from the right images to the rectified right images
+  CalibrationWarp rightWarp;
+  // distance between the centers of the cameras, in meters
+  double baseline = 0;
+
+  const CameraCalibration& getLeftCalib() const {
+    return leftWarp.dstCalib;
+  }
+  const CameraCalibration& getRightCalib() const {
+    return rightWarp.dstCalib;
+  }
+  double getFocalLength() const {
+    return leftWarp.dstCalib.getFocalLengths().x();
+  }
+
+  /**
+   * @brief Depth along the optical axis of the rectified cameras of a point, in meters
+   * @param disparity the disparity uLeft - uRight of the point in the rectified images, in pixels
+   */
+  double disparityToDepth(const double disparity) const {
+    return getFocalLength() * baseline / disparity;
+  }
+};
+
+/**
+ * @brief Computes the rectifying rotations of a stereo pair of cameras from their extrinsics, and
+ * prepares the warps of their images to the rectified cameras.
+ * The optical axis of the rectified cameras is the average of the optical axes of the cameras,
+ * made orthogonal to the baseline.
+ * @param leftCalib the calibration of the left camera
+ * @param rightCalib the calibration of the right camera
+ * @param imageSize the size of the rectified images
+ * @param focalLength the focal length of the rectified cameras, by default the one of the left
+ * camera scaled to the width of the rectified images. The field of view of linear cameras is
+ * below 180 degrees, so the rectified images of fisheye cameras cover their central part only.
+ */
+StereoRectification makeStereoRectification(
+    const CameraCalibration& leftCalib,
+    const CameraCalibration& rightCalib,
+    const Eigen::Vector2i& imageSize,
+    const std::optional<double>& focalLength = std::nullopt);
+
+/**
+ * @brief Rectifies a stereo pair of images, warping both images in parallel
+ * @param leftVariant the image of the left camera
+ * @param rightVariant the image of the right camera
+ * @param rectification the rectification of the cameras
+ * @param method the interpolation method (Bilinear, NearestNeighbor)
+ */
+std::pair<image::ManagedImageVariant, image::ManagedImageVariant> rectifyStereoPair(
+    const image::ImageVariant& leftVariant,
+    const image::ImageVariant& rightVariant,
+    const StereoRectification& rectification,
+    const image::InterpolationMethod method = image::InterpolationMethod::Bilinear);
+
+} // namespace projectaria::tools::calibration
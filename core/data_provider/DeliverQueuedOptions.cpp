@@ -65,4 +65,23 @@ void DeliverQueuedOptions::setSubsampleRate(const vrs::StreamId& streamId, size_
   streamIdToDownSampleRate_.at(streamId) = rate;
 }
 
+bool DeliverQueuedOptions::getReadContent(const vrs::StreamId& streamId) const {
+  return metadataOnlyStreamIds_.count(streamId) == 0;
+}
+
+void DeliverQueuedOptions::setReadContent(const vrs::StreamId& streamId, bool readContent) {
+  checkAndThrow(streamIdToDownSampleRate_.count(streamId) > 0);
+  if (readContent) {
+    metadataOnlyStreamIds_.erase(streamId);
+  } else {
+    metadataOnlyStreamIds_.insert(streamId);
+  }
+}
+
+void DeliverQueuedOptions::setReadContent(const vrs::RecordableTypeId& typeId, bool readContent) {
+  for (const auto& streamId : getStreamIds(typeId)) {
+    setReadContent(streamId, readContent);
+  }
+}
+
 } // namespace projectaria::tools::data_provider
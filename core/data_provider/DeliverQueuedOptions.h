@@ -17,6 +17,7 @@
 #pragma once
 
 #include <map>
+#include <set>
 
 #include <vrs/StreamId.h>
 
@@ -58,10 +59,30 @@ class DeliverQueuedOptions : public SubstreamSelector {
    * @param streamId ID of the VRS stream of interest
    */
   void setSubsampleRate(const vrs::StreamId& streamId, size_t rate);
+  /**
+   * @brief Returns if the image or audio content of a stream is read, or only its metadata
+   * @param streamId ID of the VRS stream of interest
+   */
+  bool getReadContent(const vrs::StreamId& streamId) const;
+  /**
+   * @brief Sets if the image or audio content of a stream is read. When turned off, image data
+   * are delivered with their ImageDataRecord and an empty frame, and audio data with their
+   * AudioDataRecord and no samples. Other sensor types are not affected.
+   * @param streamId ID of the VRS stream of interest
+   * @param readContent false to deliver metadata only
+   */
+  void setReadContent(const vrs::StreamId& streamId, bool readContent);
+  /**
+   * @brief Sets if the image or audio content is read for all streams of a specific typeId
+   * @param typeId the ID of a VRS recordable type e.g. vrs::RecordableTypeId::SlamCameraData
+   * @param readContent false to deliver metadata only
+   */
+  void setReadContent(const vrs::RecordableTypeId& typeId, bool readContent);
 
  private:
   int64_t truncateFirstDeviceTimeNs_;
   int64_t truncateLastDeviceTimeNs_;
   std::map<vrs::StreamId, size_t> streamIdToDownSampleRate_;
+  std::set<vrs::StreamId> metadataOnlyStreamIds_;
 };
 } // namespace projectaria::tools::data_provider
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <optional>
+
+#include <data_provider/ErrorHandler.h>
+#include <data_provider/FrameSetSequence.h>
+#include <data_provider/VrsDataProvider.h>
+#include <dispenso/task_set.h>
+#include <trace/Trace.h>
+
+namespace projectaria::tools::data_provider {
+
+bool FrameSet::isComplete() const {
+  return std::all_of(indices.begin(), indices.end(), [](int index) { return index >= 0; });
+}
+
+std::vector<FrameSetIndices> matchFrameSets(
+    const std::vector<std::vector<int64_t>>& timestampsNs,
+    int64_t toleranceNs,
+    bool dropIncomplete) {
+  checkAndThrow(toleranceNs >= 0, fmt::format("Invalid frame set tolerance {}", toleranceNs));
+  const size_t numStreams = timestampsNs.size();
+  std::vector<size_t> cursors(numStreams, 0); // next frame of each stream not yet grouped
+  std::vector<FrameSetIndices> frameSets;
+  while (true) {
+    // the earliest frame not yet grouped starts the next set
+    std::optional<int64_t> firstTimeNs;
+    for (size_t s = 0; s < numStreams; ++s) {
+      if (cursors[s] < timestampsNs[s].size()) {
+        const int64_t timeNs = timestampsNs[s][cursors[s]];
+        firstTimeNs = firstTimeNs ? std::min(*firstTimeNs, timeNs) : timeNs;
+      }
+    }
+    if (!firstTimeNs) {
+      break;
+    }
+
+    FrameSetIndices frameSet{*firstTimeNs, std::vector<int>(numStreams, -1)};
+    bool isComplete = true;
+    for (size_t s = 0; s < numStreams; ++s) {
+      if (cursors[s] < timestampsNs[s].size() &&
+          timestampsNs[s][cursors[s]] - *firstTimeNs <= toleranceNs) {
+        frameSet.indices[s] = static_cast<int>(cursors[s]++);
+      } else {
+        isComplete = false;
+      }
+    }
+    if (isComplete || !dropIncomplete) {
+      frameSets.push_back(std::move(frameSet));
+    }
+  }
+  return frameSets;
+}
+
+FrameSetIterator::FrameSetIterator(
+    VrsDataProvider* provider,
+    std::shared_ptr<const Plan> plan,
+    size_t setIndex)
+    : provider_(provider), plan_(std::move(plan)), setIndex_(setIndex) {
+  if (setIndex_ < plan_->frameSets.size()) {
+    readFrameSet();
+  }
+}
+
+void FrameSetIterator::readFrameSet() {
+  PROJECTARIA_TRACE_SCOPE("FrameSetIterator::readFrameSet");
+  const FrameSetIndices& frameSet = plan_->frameSets.at(setIndex_);
+  current_.timestampNs = frameSet.timestampNs;
+  current_.indices = frameSet.indices;
+  current_.frames.assign(frameSet.indices.size(), std::nullopt);
+
+  // reads are serialized by the provider, while the frames already read are decoded in parallel
+  dispenso::TaskSet decodeTasks(dispenso::globalThreadPool());
+  for (size_t i = 0; i < frameSet.indices.size(); ++i) {
+    if (frameSet.indices[i] < 0) {
+      continue;
+    }
+    auto& frame = current_.frames[i].emplace(
+        provider_->getImageDataByIndex(plan_->streamIds[i], frameSet.indices[i]));
+    ImageData& imageData = frame.first;
+    if (imageData.isValid() &&
+        imageData.pixelFrame->getSpec().getImageFormat() == vrs::ImageFormat::JPG) {
+      decodeTasks.schedule([&imageData] { imageData.imageVariant(); });
+    }
+  }
+  decodeTasks.wait();
+}
+
+FrameSetIterator& FrameSetIterator::operator++() {
+  ++setIndex_;
+  if (setIndex_ < plan_->frameSets.size()) {
+    readFrameSet();
+  } else {
+    current_ = FrameSet{};
+  }
+  return *this;
+}
+
+bool FrameSetIterator::operator==(const FrameSetIterator& other) const {
+  return plan_ == other.plan_ && setIndex_ == other.setIndex_;
+}
+
+bool FrameSetIterator::operator!=(const FrameSetIterator& other) const {
+  return !(*this == other);
+}
+
+const FrameSet& FrameSetIterator::operator*() const {
+  return current_;
+}
+
+FrameSetSequence::FrameSetSequence(VrsDataProvider* provider, const FrameSetOptions& options)
+    : provider_(provider) {
+  PROJECTARIA_TRACE_SCOPE("FrameSetSequence::FrameSetSequence");
+  checkAndThrow(!options.streamIds.empty(), "No stream to group the frames of");
+  auto plan = std::make_shared<FrameSetIterator::Plan>();
+  plan->streamIds = options.streamIds;
+
+  std::vector<std::vector<int64_t>> timestampsNs;
+  timestampsNs.reserve(options.streamIds.size());
+  for (const auto& streamId : options.streamIds) {
+    checkAndThrow(
+        provider_->checkStreamIsActive(streamId) &&
+            provider_->checkStreamIsType(streamId, SensorDataType::Image),
+        fmt::format("StreamId {} is not an active image stream", streamId.getNumericName()));
+    timestampsNs.push_back(provider_->getTimestampsNs(streamId, options.timeDomain));
+  }
+  plan->frameSets = matchFrameSets(timestampsNs, options.toleranceNs, options.dropIncomplete);
+  plan_ = std::move(plan);
+}
+
+FrameSetIterator FrameSetSequence::begin() {
+  return FrameSetIterator(provider_, plan_, 0);
+}
+
+FrameSetIterator FrameSetSequence::end() {
+  return FrameSetIterator(provider_, plan_, plan_->frameSets.size());
+}
+
+size_t FrameSetSequence::size() const {
+  return plan_->frameSets.size();
+}
+
+} // namespace projectaria::tools::data_provider
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <data_provider/SensorData.h>
+#include <data_provider/TimeTypes.h>
+
+namespace projectaria::tools::data_provider {
+
+class VrsDataProvider;
+
+/**
+ * @brief Options to group the frames of several image streams by capture time
+ */
+struct FrameSetOptions {
+  std::vector<vrs::StreamId> streamIds; ///< @brief image streams of a set, in the order of frames
+  int64_t toleranceNs = 1'000'000; ///< @brief max time between the first and last frame of a set
+  /**
+   * @brief time domain the frames are matched in. RecordTime is matched from the vrs index alone,
+   * other time domains read the metadata of every frame once, when the sequence is created.
+   */
+  TimeDomain timeDomain = TimeDomain::DeviceTime;
+  /**
+   * @brief skip the sets missing a frame of some stream, instead of delivering them with the
+   * missing frames empty
+   */
+  bool dropIncomplete = true;
+};
+
+/**
+ * @brief Indices of the frames of a set, -1 for a stream missing from the set
+ */
+struct FrameSetIndices {
+  int64_t timestampNs; ///< @brief timestamp of the earliest frame of the set
+  std::vector<int> indices;
+};
+
+/**
+ * @brief Frames of several image streams captured within a tolerance of each other
+ */
+struct FrameSet {
+  int64_t timestampNs = -1; ///< @brief timestamp of the earliest frame, in the options time domain
+  std::vector<int> indices; ///< @brief index of the frame of each stream, -1 if missing
+  std::vector<std::optional<ImageDataAndRecord>> frames; ///< @brief decoded frame of each stream
+
+  /** @brief Returns true if the set has a frame of every stream */
+  bool isComplete() const;
+};
+
+/**
+ * @brief Groups the frames of several streams into sets in a single merge pass over their sorted
+ * timestamps. Each set starts at the earliest frame not yet grouped, and takes the next frame of
+ * every stream within toleranceNs of it.
+ * @param timestampsNs sorted timestamps of the frames of each stream
+ * @param toleranceNs max time between the first and last frame of a set
+ * @param dropIncomplete skip the sets missing a frame of some stream
+ * @return the indices of the frames of each set, in time order
+ */
+std::vector<FrameSetIndices> matchFrameSets(
+    const std::vector<std::vector<int64_t>>& timestampsNs,
+    int64_t toleranceNs,
+    bool dropIncomplete);
+
+/**
+ * @brief Forward iterator over the frame sets of a FrameSetSequence. The frames of a set are read
+ * in turn, and decoded concurrently while the next ones are read.
+ */
+class FrameSetIterator {
+ public:
+  /**
+   * @brief Frame sets to deliver, shared by the iterators of a sequence
+   */
+  struct Plan {
+    std::vector<vrs::StreamId> streamIds;
+    std::vector<FrameSetIndices> frameSets;
+  };
+
+  FrameSetIterator() = default;
+  FrameSetIterator(VrsDataProvider* provider, std::shared_ptr<const Plan> plan, size_t setIndex);
+
+  FrameSetIterator& operator++();
+  bool operator!=(const FrameSetIterator& other) const;
+  bool operator==(const FrameSetIterator& other) const;
+
+  const FrameSet& operator*() const;
+
+ private:
+  void readFrameSet();
+
+  VrsDataProvider* provider_ = nullptr; // non-owning pointer to vrs data provider
+  std::shared_ptr<const Plan> plan_;
+  size_t setIndex_ = 0;
+  FrameSet current_;
+};
+
+/**
+ * @brief Interface for delivering the frames of several image streams grouped by capture time,
+ * with iterator support
+ */
+class FrameSetSequence {
+ public:
+  /**
+   * @brief Constructs the sequence, matching the frames of the streams
+   * @param provider the provider holding the data
+   * @param options streams, tolerance and time domain to group the frames by
+   */
+  FrameSetSequence(VrsDataProvider* provider, const FrameSetOptions& options);
+  /**
+   * @brief Returns the iterator representing the starting point of the sequence
+   */
+  FrameSetIterator begin();
+  /**
+   * @brief Returns iterator representing the end point of the sequence
+   */
+  FrameSetIterator end();
+  /**
+   * @brief Returns the number of frame sets in the sequence
+   */
+  size_t size() const;
+
+ private:
+  VrsDataProvider* provider_; // non-owning pointer to vrs data provider
+  std::shared_ptr<const FrameSetIterator::Plan> plan_;
+};
+} // namespace projectaria::tools::data_provider
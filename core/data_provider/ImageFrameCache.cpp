@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <data_provider/ImageFrameCache.h>
+
+#include <functional>
+
+namespace projectaria::tools::data_provider {
+
+namespace {
+void hashCombine(size_t& seed, size_t value) {
+  seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+bool isSameRegion(
+    const std::optional<image::ImageRegion>& lhs,
+    const std::optional<image::ImageRegion>& rhs) {
+  if (!lhs || !rhs) {
+    return !lhs && !rhs;
+  }
+  return lhs->x == rhs->x && lhs->y == rhs->y && lhs->width == rhs->width &&
+      lhs->height == rhs->height;
+}
+
+// Returns a frame that owns its pixels: the players decode into, or reuse, their own frames
+std::shared_ptr<vrs::utils::PixelFrame> makeOwnedFrame(
+    const std::shared_ptr<vrs::utils::PixelFrame>& frame) {
+  if (frame->getSpec().getImageFormat() == vrs::ImageFormat::JPG) {
+    std::shared_ptr<vrs::utils::PixelFrame> decodedFrame;
+    frame->normalizeFrame(decodedFrame, true);
+    return decodedFrame;
+  }
+  return std::make_shared<vrs::utils::PixelFrame>(*frame);
+}
+} // namespace
+
+bool ImageFrameCache::Key::operator==(const Key& other) const {
+  return streamId == other.streamId && index == other.index &&
+      decodeOptions.scaleDenominator == other.decodeOptions.scaleDenominator &&
+      isSameRegion(decodeOptions.roi, other.decodeOptions.roi);
+}
+
+size_t ImageFrameCache::KeyHash::operator()(const Key& key) const {
+  size_t seed = std::hash<int>()(static_cast<int>(key.streamId.getTypeId()));
+  hashCombine(seed, key.streamId.getInstanceId());
+  hashCombine(seed, static_cast<size_t>(key.index));
+  hashCombine(seed, key.decodeOptions.scaleDenominator);
+  if (key.decodeOptions.roi) {
+    hashCombine(seed, key.decodeOptions.roi->x);
+    hashCombine(seed, key.decodeOptions.roi->y);
+    hashCombine(seed, key.decodeOptions.roi->width);
+    hashCombine(seed, key.decodeOptions.roi->height);
+  }
+  return seed;
+}
+
+ImageFrameCache::ImageFrameCache(size_t maxBytes) {
+  stats_.maxBytes = maxBytes;
+}
+
+std::optional<ImageDataAndRecord> ImageFrameCache::get(const Key& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = keyToEntry_.find(key);
+  if (it == keyToEntry_.end()) {
+    ++stats_.misses;
+    return std::nullopt;
+  }
+  ++stats_.hits;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->data;
+}
+
+ImageDataAndRecord ImageFrameCache::insert(const Key& key, const ImageDataAndRecord& data) {
+  if (!data.first.pixelFrame) {
+    return data;
+  }
+  // decode or copy outside of the lock, so that concurrent readers are not blocked
+  ImageDataAndRecord ownedData = data;
+  ownedData.first.pixelFrame = makeOwnedFrame(data.first.pixelFrame);
+  if (!ownedData.first.pixelFrame) {
+    return data;
+  }
+  const size_t numBytes = ownedData.first.pixelFrame->size() + sizeof(Entry);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (numBytes > stats_.maxBytes) {
+    return ownedData;
+  }
+  auto it = keyToEntry_.find(key);
+  if (it != keyToEntry_.end()) {
+    // another reader cached the same frame in the meantime
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->data;
+  }
+  evictToBudget(stats_.maxBytes - numBytes);
+  entries_.push_front(Entry{key, ownedData, numBytes});
+  keyToEntry_.emplace(key, entries_.begin());
+  stats_.numBytes += numBytes;
+  stats_.numFrames = entries_.size();
+  return ownedData;
+}
+
+void ImageFrameCache::setMaxBytes(size_t maxBytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.maxBytes = maxBytes;
+  evictToBudget(maxBytes);
+}
+
+void ImageFrameCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  keyToEntry_.clear();
+  stats_.numBytes = 0;
+  stats_.numFrames = 0;
+}
+
+ImageFrameCache::Stats ImageFrameCache::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void ImageFrameCache::evictToBudget(size_t maxBytes) {
+  while (!entries_.empty() && stats_.numBytes > maxBytes) {
+    const Entry& entry = entries_.back();
+    stats_.numBytes -= entry.numBytes;
+    keyToEntry_.erase(entry.key);
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+  stats_.numFrames = entries_.size();
+}
+
+} // namespace projectaria::tools::data_provider
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include <vrs/StreamId.h>
+
+#include <data_provider/SensorData.h>
+#include <image/utility/JpegDecode.h>
+
+namespace projectaria::tools::data_provider {
+
+/**
+ * @brief A thread safe cache of decoded image frames with a memory budget, evicting the least
+ * recently used frames first. Cached frames are decoded once and never written to again, so they
+ * are shared by all the readers that hit them.
+ */
+class ImageFrameCache {
+ public:
+  /**
+   * @brief Identifies a frame: the image at an index of a stream, decoded with given options
+   */
+  struct Key {
+    vrs::StreamId streamId;
+    int index;
+    image::JpegDecodeOptions decodeOptions;
+
+    bool operator==(const Key& other) const;
+  };
+
+  /**
+   * @brief Counters of the cache since it was created
+   */
+  struct Stats {
+    uint64_t hits = 0; ///< @brief number of lookups that found their frame
+    uint64_t misses = 0; ///< @brief number of lookups that did not find their frame
+    uint64_t evictions = 0; ///< @brief number of frames evicted to stay within the budget
+    size_t numFrames = 0; ///< @brief number of frames currently cached
+    size_t numBytes = 0; ///< @brief memory used by the frames currently cached
+    size_t maxBytes = 0; ///< @brief memory budget
+  };
+
+  /**
+   * @param maxBytes memory budget of the cached frames
+   */
+  explicit ImageFrameCache(size_t maxBytes);
+
+  /**
+   * @brief Returns the cached frame of a key, if any, and marks it as most recently used
+   */
+  std::optional<ImageDataAndRecord> get(const Key& key);
+
+  /**
+   * @brief Caches a frame read from a stream, evicting the least recently used frames as needed.
+   * Compressed frames are decoded, and other frames copied, so that the cached frame does not
+   * share its pixels with the player it was read by.
+   * @return the cached frame, or the frame as given if it cannot be cached
+   */
+  ImageDataAndRecord insert(const Key& key, const ImageDataAndRecord& data);
+
+  /**
+   * @brief Changes the memory budget, evicting frames if it shrinks
+   */
+  void setMaxBytes(size_t maxBytes);
+
+  /** @brief Removes all the frames, keeping the counters */
+  void clear();
+
+  Stats getStats() const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+  struct Entry {
+    Key key;
+    ImageDataAndRecord data;
+    size_t numBytes;
+  };
+
+  void evictToBudget(size_t maxBytes);
+
+  mutable std::mutex mutex_;
+  std::list<Entry> entries_; // most recently used first
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> keyToEntry_;
+  Stats stats_;
+};
+
+} // namespace projectaria::tools::data_provider
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <data_provider/RecordReadAhead.h>
+
+#include <algorithm>
+#include <climits>
+#include <optional>
+#include <set>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define PROJECTARIA_TOOLS_HAS_READ_AHEAD_HINTS
+#endif
+
+#include <trace/Trace.h>
+#include <vrs/RecordFileReader.h>
+
+#define DEFAULT_LOG_CHANNEL "RecordReadAhead"
+#include <logging/Log.h>
+
+namespace projectaria::tools::data_provider {
+
+namespace {
+
+// records closer than this in a file are hinted as one range, to save system calls
+constexpr int64_t kMaxMergeGapBytes = 64 * 1024;
+constexpr int kMaxRecordsAhead = 1 << 20;
+
+void adviseWillNeed(int fd, int64_t offset, int64_t size) {
+#if defined(__linux__)
+  posix_fadvise(fd, offset, size, POSIX_FADV_WILLNEED);
+#elif defined(__APPLE__)
+  struct radvisory advice;
+  advice.ra_offset = offset;
+  advice.ra_count = static_cast<int>(std::min<int64_t>(size, INT_MAX));
+  fcntl(fd, F_RDADVISE, &advice);
+#else
+  (void)fd;
+  (void)offset;
+  (void)size;
+#endif
+}
+
+} // namespace
+
+RecordReadAhead::RecordReadAhead(std::vector<std::string> filePaths)
+    : filePaths_(std::move(filePaths)) {}
+
+RecordReadAhead::~RecordReadAhead() {
+#ifdef PROJECTARIA_TOOLS_HAS_READ_AHEAD_HINTS
+  for (const auto& chunks : fileChunks_) {
+    for (const auto& chunk : chunks) {
+      ::close(chunk.fd);
+    }
+  }
+#endif
+}
+
+void RecordReadAhead::setAccessPattern(AccessPattern pattern, size_t readAheadBytes) {
+  pattern_ = pattern;
+  readAheadBytes_ = std::max<size_t>(readAheadBytes, 1);
+  if (pattern_ != AccessPattern::Random && !loaded_) {
+    loadRecordRanges();
+  }
+  for (auto& [streamId, stream] : streams_) {
+    int64_t totalBytes = 0;
+    for (const auto& record : stream.records) {
+      totalBytes += record.size;
+    }
+    const int64_t averageBytes =
+        std::max<int64_t>(1, totalBytes / std::max<int64_t>(1, stream.records.size()));
+    stream.recordsAhead = static_cast<int>(std::clamp<int64_t>(
+        static_cast<int64_t>(readAheadBytes_) / averageBytes, 1, kMaxRecordsAhead));
+    stream.step = 1;
+    stream.lastIndex = -1;
+    stream.nextHintIndex = 0;
+  }
+}
+
+void RecordReadAhead::loadRecordRanges() {
+  PROJECTARIA_TRACE_SCOPE("RecordReadAhead::loadRecordRanges");
+  loaded_ = true;
+#ifndef PROJECTARIA_TOOLS_HAS_READ_AHEAD_HINTS
+  XR_LOGW("Reading ahead is not supported on this platform, access patterns are ignored");
+#else
+  std::set<vrs::StreamId> duplicateStreams;
+  for (uint32_t fileIndex = 0; fileIndex < filePaths_.size(); ++fileIndex) {
+    const std::string& path = filePaths_[fileIndex];
+    std::vector<Chunk>& chunks = fileChunks_.emplace_back();
+    vrs::RecordFileReader reader;
+    if (reader.openFile(path) != 0) {
+      XR_LOGW("Cannot open {}, its records won't be read ahead", path);
+      continue;
+    }
+    int64_t chunkOffset = 0;
+    for (const auto& [chunkPath, chunkSize] : reader.getFileChunks()) {
+      const int fd = ::open(chunkPath.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd >= 0) {
+        chunks.push_back({fd, chunkOffset, chunkSize});
+      }
+      chunkOffset += chunkSize;
+    }
+    const int64_t fileSize = chunkOffset;
+
+    // a record spans until the next one in the file, which is not the next one in time
+    const auto& index = reader.getIndex();
+    std::vector<int64_t> offsets;
+    offsets.reserve(index.size());
+    for (const auto& record : index) {
+      offsets.push_back(record.fileOffset);
+    }
+    std::sort(offsets.begin(), offsets.end());
+
+    std::map<vrs::StreamId, StreamReadAhead> fileStreams;
+    for (const auto& record : index) {
+      if (record.recordType != vrs::Record::Type::DATA) {
+        continue;
+      }
+      const auto nextOffset = std::upper_bound(offsets.begin(), offsets.end(), record.fileOffset);
+      const int64_t endOffset = nextOffset != offsets.end() ? *nextOffset : fileSize;
+      fileStreams[record.streamId].records.push_back(
+          {fileIndex, record.fileOffset, endOffset - record.fileOffset});
+    }
+    for (auto& [streamId, stream] : fileStreams) {
+      // streams found in several files are renamed by the merged reader, their reads can't be
+      // matched with their records
+      if (streams_.count(streamId) > 0 || duplicateStreams.count(streamId) > 0) {
+        XR_LOGW("Stream {} is in several files, it won't be read ahead", streamId.getName());
+        streams_.erase(streamId);
+        duplicateStreams.insert(streamId);
+        continue;
+      }
+      streams_.emplace(streamId, std::move(stream));
+    }
+  }
+#endif
+}
+
+void RecordReadAhead::onReadRecord(const vrs::StreamId& streamId, int index) {
+  if (pattern_ == AccessPattern::Random) {
+    return;
+  }
+  auto streamIt = streams_.find(streamId);
+  if (streamIt == streams_.end()) {
+    return;
+  }
+  StreamReadAhead& stream = streamIt->second;
+  const int numRecords = static_cast<int>(stream.records.size());
+  if (index < 0 || index >= numRecords) {
+    return;
+  }
+
+  int step = 1;
+  if (pattern_ == AccessPattern::Strided) {
+    step = stream.lastIndex >= 0 && index > stream.lastIndex ? index - stream.lastIndex
+                                                             : stream.step;
+  }
+  // restart reading ahead when the reads leave the records read ahead, or change step
+  if (step != stream.step || index <= stream.lastIndex || index >= stream.nextHintIndex) {
+    stream.step = step;
+    stream.nextHintIndex = index + step;
+  }
+  stream.lastIndex = index;
+
+  // hint the records in batches, once half of the records read ahead were read
+  const int64_t windowRecords = static_cast<int64_t>(step) * stream.recordsAhead;
+  const int64_t refillRecords = static_cast<int64_t>(step) * std::max(1, stream.recordsAhead / 2);
+  if (stream.nextHintIndex - index <= refillRecords) {
+    const int endIndex = static_cast<int>(std::min<int64_t>(index + windowRecords, numRecords - 1));
+    hintRecords(stream, endIndex);
+  }
+}
+
+void RecordReadAhead::hintRecords(StreamReadAhead& stream, int endIndex) {
+  PROJECTARIA_TRACE_SCOPE("RecordReadAhead::hintRecords");
+  std::optional<RecordRange> merged;
+  for (int index = stream.nextHintIndex; index <= endIndex; index += stream.step) {
+    const RecordRange& record = stream.records[index];
+    if (merged && record.fileIndex == merged->fileIndex && record.offset >= merged->offset &&
+        record.offset <= merged->offset + merged->size + kMaxMergeGapBytes) {
+      merged->size = std::max(merged->size, record.offset + record.size - merged->offset);
+    } else {
+      if (merged) {
+        hintRange(merged->fileIndex, merged->offset, merged->size);
+      }
+      merged = record;
+    }
+    stream.nextHintIndex = index + stream.step;
+  }
+  if (merged) {
+    hintRange(merged->fileIndex, merged->offset, merged->size);
+  }
+}
+
+void RecordReadAhead::hintRange(uint32_t fileIndex, int64_t offset, int64_t size) {
+  for (const auto& chunk : fileChunks_[fileIndex]) {
+    const int64_t begin = std::max(offset, chunk.offset);
+    const int64_t end = std::min(offset + size, chunk.offset + chunk.size);
+    if (begin < end) {
+      adviseWillNeed(chunk.fd, begin - chunk.offset, end - begin);
+    }
+  }
+}
+
+} // namespace projectaria::tools::data_provider
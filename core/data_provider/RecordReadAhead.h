@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <vrs/StreamId.h>
+
+namespace projectaria::tools::data_provider {
+
+/**
+ * @brief Pattern in which the data of a provider are read, to read ahead the records about to be
+ * read
+ */
+enum class AccessPattern {
+  Random, ///< @brief no read ahead, e.g. for random queries by index or time
+  Sequential, ///< @brief the next records of each stream are read ahead
+  Strided, ///< @brief the records of each stream are read ahead at the step between its last reads
+};
+
+/**
+ * @brief Hints the operating system to load the records of a stream about to be read into the page
+ * cache, so that the reads of a sequential or strided pass over cold files don't wait on each
+ * record in turn. The byte ranges of the records are computed from the index of the vrs files,
+ * read on the first use of a read ahead pattern, and hinted with posix_fadvise(POSIX_FADV_WILLNEED)
+ * on Linux or F_RDADVISE on macOS. Not thread safe: reads are hinted under the reader lock.
+ */
+class RecordReadAhead {
+ public:
+  static constexpr size_t kDefaultReadAheadBytes = 8 * 1024 * 1024;
+
+  /**
+   * @param filePaths paths of the vrs files read by the provider, chunked files by their first
+   * chunk
+   */
+  explicit RecordReadAhead(std::vector<std::string> filePaths);
+  ~RecordReadAhead();
+  RecordReadAhead(const RecordReadAhead&) = delete;
+  RecordReadAhead& operator=(const RecordReadAhead&) = delete;
+
+  /**
+   * @brief Sets the access pattern to read ahead for
+   * @param readAheadBytes amount of data of each stream to keep read ahead of its last read
+   */
+  void setAccessPattern(AccessPattern pattern, size_t readAheadBytes = kDefaultReadAheadBytes);
+  AccessPattern getAccessPattern() const {
+    return pattern_;
+  }
+
+  // called before the data record of a stream at index is read
+  void onReadRecord(const vrs::StreamId& streamId, int index);
+
+ private:
+  // a file chunk opened for hints, its offset in the file, and its size
+  struct Chunk {
+    int fd;
+    int64_t offset;
+    int64_t size;
+  };
+  struct RecordRange {
+    uint32_t fileIndex;
+    int64_t offset; // in the file, across its chunks
+    int64_t size;
+  };
+  struct StreamReadAhead {
+    std::vector<RecordRange> records; // data records, in the order of their index
+    int recordsAhead = 1; // number of records in readAheadBytes, from their average size
+    int step = 1; // index increment between the reads being read ahead
+    int lastIndex = -1; // index of the last read
+    int nextHintIndex = 0; // index of the next record to hint
+  };
+
+  // read the record index of the files and open their chunks, once
+  void loadRecordRanges();
+  // hint the records of a stream from nextHintIndex to endIndex (included), merging close ranges
+  void hintRecords(StreamReadAhead& stream, int endIndex);
+  void hintRange(uint32_t fileIndex, int64_t offset, int64_t size);
+
+  const std::vector<std::string> filePaths_;
+  AccessPattern pattern_ = AccessPattern::Random;
+  size_t readAheadBytes_ = kDefaultReadAheadBytes;
+  bool loaded_ = false;
+  std::vector<std::vector<Chunk>> fileChunks_; // chunks of each file
+  std::map<vrs::StreamId, StreamReadAhead> streams_;
+};
+
+} // namespace projectaria::tools::data_provider
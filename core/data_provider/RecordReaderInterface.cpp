@@ -16,11 +16,32 @@
 
 #include <data_provider/ErrorHandler.h>
 #include <data_provider/RecordReaderInterface.h>
+#include <trace/Trace.h>
 
 #define DEFAULT_LOG_CHANNEL "RecordReaderInterface"
 #include <logging/Log.h>
 
+#include <functional>
+#include <optional>
+
 namespace projectaria::tools::data_provider {
+
+namespace {
+// Calls a function when going out of scope, including by exception
+class ScopeExit {
+ public:
+  explicit ScopeExit(std::function<void()> onExit) : onExit_(std::move(onExit)) {}
+  ScopeExit(const ScopeExit&) = delete;
+  ScopeExit& operator=(const ScopeExit&) = delete;
+  ~ScopeExit() {
+    onExit_();
+  }
+
+ private:
+  std::function<void()> onExit_;
+};
+} // namespace
+
 RecordReaderInterface::RecordReaderInterface(
     std::shared_ptr<vrs::MultiRecordFileReader> reader,
     std::map<vrs::StreamId, std::shared_ptr<ImageSensorPlayer>>& imagePlayers,
@@ -31,7 +52,9 @@ RecordReaderInterface::RecordReaderInterface(
     std::map<vrs::StreamId, std::shared_ptr<BarometerPlayer>>& barometerPlayers,
     std::map<vrs::StreamId, std::shared_ptr<BluetoothBeaconPlayer>>& bluetoothPlayers,
     std::map<vrs::StreamId, std::shared_ptr<MotionSensorPlayer>>& magnetometerPlayers,
-    const std::shared_ptr<TimeSyncMapper>& timeSyncMapper)
+    const std::shared_ptr<TimeSyncMapper>& timeSyncMapper,
+    const std::shared_ptr<std::mutex>& readerMutex,
+    const std::shared_ptr<RecordReadAhead>& readAhead)
     : reader_(reader),
       imagePlayers_(imagePlayers),
       motionPlayers_(motionPlayers),
@@ -42,7 +65,8 @@ RecordReaderInterface::RecordReaderInterface(
       bluetoothPlayers_(bluetoothPlayers),
       magnetometerPlayers_(magnetometerPlayers),
       timeSyncMapper_(timeSyncMapper),
-      readerMutex_(std::make_unique<std::mutex>()) {
+      readerMutex_(readerMutex ? readerMutex : std::make_shared<std::mutex>()),
+      readAhead_(readAhead) {
   for (const auto& [streamId, _] : imagePlayers_) {
     streamIds_.insert(streamId);
     streamIdToSensorDataType_.emplace(streamId, SensorDataType::Image);
@@ -131,12 +155,63 @@ RecordReaderInterface::getStreamIdToDataRecords() {
 // according to (streamId, index) pair if records exists
 const vrs::IndexRecord::RecordInfo* RecordReaderInterface::readRecordByIndex(
     const vrs::StreamId& streamId,
-    const int index) {
-  std::lock_guard<std::mutex> lockGuard(*readerMutex_);
+    const int index,
+    bool readContent,
+    const image::JpegDecodeOptions* decodeOptions) {
+  PROJECTARIA_TRACE_SCOPE("RecordReaderInterface::readRecordByIndex");
+  std::unique_lock<std::mutex> lockGuard(*readerMutex_, std::defer_lock);
+  {
+    PROJECTARIA_TRACE_SCOPE("RecordReaderInterface::waitForReader");
+    lockGuard.lock();
+  }
+  return readRecordByIndexLocked(streamId, index, readContent, decodeOptions);
+}
+
+std::optional<ImageDataAndRecord> RecordReaderInterface::readImageByIndex(
+    const vrs::StreamId& streamId,
+    const int index,
+    const image::JpegDecodeOptions* decodeOptions) {
+  PROJECTARIA_TRACE_SCOPE("RecordReaderInterface::readImageByIndex");
+  std::unique_lock<std::mutex> lockGuard(*readerMutex_, std::defer_lock);
+  {
+    PROJECTARIA_TRACE_SCOPE("RecordReaderInterface::waitForReader");
+    lockGuard.lock();
+  }
+  if (!readRecordByIndexLocked(streamId, index, /* readContent = */ true, decodeOptions)) {
+    return {};
+  }
+  // copied before another read can replace the image in the player
+  return getLastCachedImageData(streamId);
+}
 
+const vrs::IndexRecord::RecordInfo* RecordReaderInterface::readRecordByIndexLocked(
+    const vrs::StreamId& streamId,
+    const int index,
+    bool readContent,
+    const image::JpegDecodeOptions* decodeOptions) {
   if (index < 0 || index >= reader_->getRecordCount(streamId, vrs::Record::Type::DATA)) {
     return nullptr;
   }
+  if (readAhead_) {
+    readAhead_->onReadRecord(streamId, index);
+  }
+  // skip the content for this read only, restoring it even if the read throws
+  std::optional<ScopeExit> restoreReadContent;
+  if (!readContent) {
+    setReadContent(streamId, false);
+    restoreReadContent.emplace([this, &streamId] { setReadContent(streamId, true); });
+  }
+  // same for the decode options of the stream's images
+  std::optional<ScopeExit> restoreDecodeOptions;
+  auto imageIt = imagePlayers_.find(streamId);
+  if (decodeOptions && imageIt != imagePlayers_.end()) {
+    const auto& imagePlayer = imageIt->second;
+    restoreDecodeOptions.emplace(
+        [imagePlayer, streamDecodeOptions = imagePlayer->getDecodeOptions()] {
+          imagePlayer->setDecodeOptions(streamDecodeOptions);
+        });
+    imagePlayer->setDecodeOptions(*decodeOptions);
+  }
   const vrs::IndexRecord::RecordInfo* recordInfo =
       reader_->getRecord(streamId, vrs::Record::Type::DATA, static_cast<uint32_t>(index));
   checkAndThrow(
@@ -156,11 +231,68 @@ const vrs::IndexRecord::RecordInfo* RecordReaderInterface::readRecordByIndex(
   return recordInfo;
 }
 
-void RecordReaderInterface::setReadImageContent(vrs::StreamId streamId, bool readContent) {
+void RecordReaderInterface::setReadContent(vrs::StreamId streamId, bool readContent) {
+  auto imageIt = imagePlayers_.find(streamId);
+  if (imageIt != imagePlayers_.end()) {
+    imageIt->second->setReadContent(readContent);
+  }
+  auto audioIt = audioPlayers_.find(streamId);
+  if (audioIt != audioPlayers_.end()) {
+    audioIt->second->setReadContent(readContent);
+  }
+}
+
+image::JpegDecodeOptions RecordReaderInterface::getImageDecodeOptions(
+    vrs::StreamId streamId) const {
+  std::lock_guard<std::mutex> lockGuard(*readerMutex_);
+  auto it = imagePlayers_.find(streamId);
+  return it != imagePlayers_.end() ? it->second->getDecodeOptions() : image::JpegDecodeOptions{};
+}
+
+void RecordReaderInterface::setImageDecodeOptions(
+    vrs::StreamId streamId,
+    const image::JpegDecodeOptions& options) {
+  // not in the middle of a read, which may be decoding with options of its own
+  std::lock_guard<std::mutex> lockGuard(*readerMutex_);
   auto it = imagePlayers_.find(streamId);
   if (it != imagePlayers_.end()) {
-    it->second->setReadContent(readContent);
+    it->second->setDecodeOptions(options);
+  }
+}
+
+bool RecordReaderInterface::isJpegImageStream(vrs::StreamId streamId) const {
+  if (imagePlayers_.count(streamId) == 0) {
+    return false;
+  }
+  vrs::RecordFormatMap recordFormats;
+  reader_->getRecordFormats(streamId, recordFormats);
+  for (const auto& [typeAndVersion, recordFormat] : recordFormats) {
+    if (typeAndVersion.first != vrs::Record::Type::DATA) {
+      continue;
+    }
+    for (size_t index = 0; index < recordFormat.getUsedBlocksCount(); ++index) {
+      const vrs::ContentBlock& contentBlock = recordFormat.getContentBlock(index);
+      if (contentBlock.getContentType() == vrs::ContentType::IMAGE &&
+          contentBlock.image().getImageFormat() == vrs::ImageFormat::JPG) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void RecordReaderInterface::setAccessPattern(AccessPattern pattern, size_t readAheadBytes) {
+  if (!readAhead_) {
+    XR_LOGW("The files of the reader are not known, access patterns are ignored");
+    return;
   }
+  std::lock_guard<std::mutex> lockGuard(*readerMutex_);
+  readAhead_->setAccessPattern(pattern, readAheadBytes);
+}
+
+AccessPattern RecordReaderInterface::getAccessPattern() const {
+  std::lock_guard<std::mutex> lockGuard(*readerMutex_);
+  return readAhead_ ? readAhead_->getAccessPattern() : AccessPattern::Random;
 }
 
 /* read the last cached sensor data in player */
@@ -19,8 +19,10 @@
 #include <condition_variable>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <set>
 
+#include <data_provider/RecordReadAhead.h>
 #include <data_provider/SensorData.h>
 #include <data_provider/TimeSyncMapper.h>
 #include <vrs/MultiRecordFileReader.h>
@@ -42,7 +44,9 @@ class RecordReaderInterface {
       std::map<vrs::StreamId, std::shared_ptr<BarometerPlayer>>& barometerPlayers,
       std::map<vrs::StreamId, std::shared_ptr<BluetoothBeaconPlayer>>& bluetoothPlayers,
       std::map<vrs::StreamId, std::shared_ptr<MotionSensorPlayer>>& magnetometerPlayers,
-      const std::shared_ptr<TimeSyncMapper>& timeSyncMapper);
+      const std::shared_ptr<TimeSyncMapper>& timeSyncMapper,
+      const std::shared_ptr<std::mutex>& readerMutex = nullptr,
+      const std::shared_ptr<RecordReadAhead>& readAhead = nullptr);
 
   std::set<vrs::StreamId> getStreamIds() const;
   SensorDataType getSensorDataType(const vrs::StreamId& streamId) const;
@@ -56,9 +60,21 @@ class RecordReaderInterface {
   // if read fails return null
   // if read is successful, lock the player's corresponding mutex
   // the mutex can only be unlocked if the corresponding getLastCached*Data() is called
+  // if readContent is false, image and audio content blocks are skipped for this read only
+  // if decodeOptions is set, JPEG images are decoded with them for this read only
   const vrs::IndexRecord::RecordInfo* readRecordByIndex(
       const vrs::StreamId& streamId,
-      const int index);
+      const int index,
+      bool readContent = true,
+      const image::JpegDecodeOptions* decodeOptions = nullptr);
+
+  // read the image record at (streamId, index) and return its data, copied from the player before
+  // the reader is unlocked so that it can't be replaced by a concurrent read of the stream
+  // if read fails return nullopt
+  std::optional<ImageDataAndRecord> readImageByIndex(
+      const vrs::StreamId& streamId,
+      const int index,
+      const image::JpegDecodeOptions* decodeOptions = nullptr);
 
   /* read the last cached sensor data in player */
   SensorData getLastCachedSensorData(const vrs::StreamId& streamId);
@@ -71,7 +87,14 @@ class RecordReaderInterface {
   BarometerData getLastCachedBarometerData(const vrs::StreamId& streamId);
   MotionData getLastCachedMagnetometerData(const vrs::StreamId& streamId);
 
-  void setReadImageContent(vrs::StreamId streamId, bool readContent);
+  image::JpegDecodeOptions getImageDecodeOptions(vrs::StreamId streamId) const;
+  void setImageDecodeOptions(vrs::StreamId streamId, const image::JpegDecodeOptions& options);
+  // if the data records of the stream hold JPEG images, the only ones the decode options apply to
+  bool isJpegImageStream(vrs::StreamId streamId) const;
+
+  // read ahead the records about to be read, if the interface was created with a RecordReadAhead
+  void setAccessPattern(AccessPattern pattern, size_t readAheadBytes);
+  AccessPattern getAccessPattern() const;
 
  private:
   std::shared_ptr<vrs::MultiRecordFileReader> reader_;
@@ -89,10 +112,20 @@ class RecordReaderInterface {
   std::map<vrs::StreamId, std::shared_ptr<MotionSensorPlayer>> magnetometerPlayers_;
   std::shared_ptr<TimeSyncMapper> timeSyncMapper_;
 
-  std::unique_ptr<std::mutex> readerMutex_;
+  std::shared_ptr<std::mutex> readerMutex_; // shared with the TimeSyncMapper
+  std::shared_ptr<RecordReadAhead> readAhead_; // null if the files are not known
   std::map<vrs::StreamId, std::unique_ptr<std::mutex>> streamIdToPlayerMutex_;
   std::map<vrs::StreamId, std::unique_ptr<std::condition_variable>> streamIdToCondition_;
   std::map<vrs::StreamId, const vrs::IndexRecord::RecordInfo*> streamIdToLastReadRecord_;
+
+  // readRecordByIndex(), called with readerMutex_ held
+  const vrs::IndexRecord::RecordInfo* readRecordByIndexLocked(
+      const vrs::StreamId& streamId,
+      const int index,
+      bool readContent,
+      const image::JpegDecodeOptions* decodeOptions);
+  // called with readerMutex_ held, the players are shared by all the readers of the stream
+  void setReadContent(vrs::StreamId streamId, bool readContent);
 };
 
 } // namespace projectaria::tools::data_provider
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <functional>
+
 #include <data_provider/ErrorHandler.h>
 #include <data_provider/SensorDataSequence.h>
 #include <data_provider/VrsDataProvider.h>
@@ -41,10 +44,8 @@ SensorDataIterator SensorDataSequence::begin() {
           startDeviceTimeNs,
           endDeviceTimeNs));
 
-  std::map<vrs::StreamId, int> streamIdToNextIndex;
-  std::map<vrs::StreamId, int> streamIdToSubsampleRate;
-
-  std::priority_queue<SensorData, std::vector<SensorData>, CompareDeviceTime> queue;
+  std::vector<SensorDataIterator::StreamCursor> streams;
+  streams.reserve(streamIds.size());
   for (const auto& streamId : streamIds) {
     if (!provider_->checkStreamIsActive(streamId)) {
       continue;
@@ -52,17 +53,22 @@ SensorDataIterator SensorDataSequence::begin() {
 
     int index = provider_->getIndexByTimeNs(
         streamId, startDeviceTimeNs, TimeDomain::DeviceTime, TimeQueryOptions::After);
-    streamIdToNextIndex.emplace(streamId, index + options_.getSubsampleRate(streamId));
-    streamIdToSubsampleRate.emplace(streamId, options_.getSubsampleRate(streamId));
-
-    SensorData data = provider_->getSensorDataByIndex(streamId, index);
+    const bool readContent = options_.getReadContent(streamId);
+    SensorData data = readContent ? provider_->getSensorDataByIndex(streamId, index)
+                                  : provider_->getSensorDataMetadataByIndex(streamId, index);
     if (data.sensorDataType() == SensorDataType::NotValid) {
       continue;
     }
-    queue.push(data);
+    const int subsampleRate = static_cast<int>(options_.getSubsampleRate(streamId));
+    streams.push_back(SensorDataIterator::StreamCursor{
+        streamId,
+        index + subsampleRate,
+        subsampleRate,
+        static_cast<int>(provider_->getNumData(streamId)),
+        readContent,
+        std::move(data)});
   }
-  return SensorDataIterator(
-      provider_, queue, streamIdToNextIndex, streamIdToSubsampleRate, endDeviceTimeNs);
+  return SensorDataIterator(provider_, std::move(streams), endDeviceTimeNs);
 }
 
 SensorDataIterator SensorDataSequence::end() {
@@ -71,49 +77,57 @@ SensorDataIterator SensorDataSequence::end() {
 
 SensorDataIterator::SensorDataIterator(
     VrsDataProvider* provider,
-    const std::priority_queue<SensorData, std::vector<SensorData>, CompareDeviceTime>& queue,
-    const std::map<vrs::StreamId, int>& streamIdToNextIndex,
-    const std::map<vrs::StreamId, int>& streamIdToSubsampleRate,
+    std::vector<StreamCursor> streams,
     const int64_t endDeviceTimeNs)
-    : provider_(provider),
-      queue_(queue),
-      streamIdToNextIndex_(streamIdToNextIndex),
-      streamIdToSubsampleRate_(streamIdToSubsampleRate),
-      endDeviceTimeNs_(endDeviceTimeNs) {}
-
-SensorDataIterator SensorDataIterator::operator++() {
-  while (!queue_.empty()) {
-    SensorData sensorData = queue_.top();
-    queue_.pop();
-    vrs::StreamId streamId = sensorData.streamId();
-
-    int nextIndex = streamIdToNextIndex_.at(streamId);
-    if (nextIndex < provider_->getNumData(streamId)) {
-      SensorData nextData = provider_->getSensorDataByIndex(streamId, nextIndex);
-      streamIdToNextIndex_.at(streamId) += streamIdToSubsampleRate_.at(streamId);
-      if (nextData.getTimeNs(TimeDomain::DeviceTime) <= endDeviceTimeNs_) {
-        queue_.push(nextData);
-      }
-    }
+    : provider_(provider), streams_(std::move(streams)), endDeviceTimeNs_(endDeviceTimeNs) {
+  heap_.reserve(streams_.size());
+  for (size_t slot = 0; slot < streams_.size(); ++slot) {
+    heap_.emplace_back(streams_[slot].current.getTimeNs(TimeDomain::DeviceTime), slot);
+  }
+  std::make_heap(heap_.begin(), heap_.end(), std::greater<>());
+}
 
-    if (sensorData.sensorDataType() != SensorDataType::NotValid) {
-      return *this;
+SensorDataIterator& SensorDataIterator::operator++() {
+  if (heap_.empty()) {
+    return *this;
+  }
+  // Replace the data just delivered by the next data of the same stream, if any
+  std::pop_heap(heap_.begin(), heap_.end(), std::greater<>());
+  const size_t slot = heap_.back().second;
+  heap_.pop_back();
+  StreamCursor& stream = streams_[slot];
+  while (stream.nextIndex < stream.numData) {
+    stream.current = readData(stream, stream.nextIndex);
+    stream.nextIndex += stream.subsampleRate;
+    if (stream.current.sensorDataType() == SensorDataType::NotValid) {
+      continue;
+    }
+    const int64_t deviceTimeNs = stream.current.getTimeNs(TimeDomain::DeviceTime);
+    if (deviceTimeNs <= endDeviceTimeNs_) {
+      heap_.emplace_back(deviceTimeNs, slot);
+      std::push_heap(heap_.begin(), heap_.end(), std::greater<>());
     }
+    break;
   }
   return *this;
 }
 
 bool SensorDataIterator::operator!=(const SensorDataIterator& other) const {
-  return queue_.empty() != other.queue_.empty();
+  return heap_.empty() != other.heap_.empty();
 }
 
 bool SensorDataIterator::operator==(const SensorDataIterator& other) const {
-  return queue_.empty() && other.queue_.empty();
+  return heap_.empty() && other.heap_.empty();
+}
+
+SensorData SensorDataIterator::readData(const StreamCursor& stream, int index) const {
+  return stream.readContent ? provider_->getSensorDataByIndex(stream.streamId, index)
+                            : provider_->getSensorDataMetadataByIndex(stream.streamId, index);
 }
 
 const SensorData& SensorDataIterator::operator*() const {
-  checkAndThrow(!queue_.empty(), "empty queue, data has already been exhausted");
-  return queue_.top();
+  checkAndThrow(!heap_.empty(), "empty queue, data has already been exhausted");
+  return streams_[heap_.front().second].current;
 }
 
 } // namespace projectaria::tools::data_provider
@@ -17,19 +17,14 @@
 #pragma once
 
 #include <iterator>
-#include <queue>
+#include <utility>
+#include <vector>
 
 #include <data_provider/DeliverQueuedOptions.h>
 #include <data_provider/SensorData.h>
 
 namespace projectaria::tools::data_provider {
 
-struct CompareDeviceTime {
-  bool operator()(const SensorData& lhs, const SensorData& rhs) {
-    return lhs.getTimeNs(TimeDomain::DeviceTime) >= rhs.getTimeNs(TimeDomain::DeviceTime);
-  }
-};
-
 class VrsDataProvider;
 
 /**
@@ -37,30 +32,50 @@ class VrsDataProvider;
  */
 class SensorDataIterator {
  public:
+  /**
+   * @brief Replay state of one stream in the sequence
+   */
+  struct StreamCursor {
+    vrs::StreamId streamId;
+    int nextIndex; // index of the data to read after current
+    int subsampleRate; // index increment of each step
+    int numData; // number of data in the stream
+    bool readContent; // false to skip image and audio content blocks
+    SensorData current; // next data of this stream to be delivered
+  };
+
   SensorDataIterator() = default;
 
+  /**
+   * @brief Constructs the iterator, delivering the current data of each stream first
+   * @param provider the provider holding the data
+   * @param streams state of each stream, with a valid current data
+   * @param endDeviceTimeNs ending point of the sequence
+   */
   SensorDataIterator(
       VrsDataProvider* provider,
-      const std::priority_queue<SensorData, std::vector<SensorData>, CompareDeviceTime>& queue,
-      const std::map<vrs::StreamId, int>& streamIdToNextIndex,
-      const std::map<vrs::StreamId, int>& streamIdToSubsampleRate,
+      std::vector<StreamCursor> streams,
       const int64_t endDeviceTimeNs);
 
-  SensorDataIterator operator++();
+  SensorDataIterator& operator++();
   bool operator!=(const SensorDataIterator& other) const;
   bool operator==(const SensorDataIterator& other) const;
 
   const SensorData& operator*() const;
 
  private:
-  VrsDataProvider* provider_; // non-owning pointer to vrs data provider
-  // the queue stores "the next data" in each stream and orders data by device time
-  std::priority_queue<SensorData, std::vector<SensorData>, CompareDeviceTime> queue_;
-  // the next data index for each stream id
-  std::map<vrs::StreamId, int> streamIdToNextIndex_;
-  // index increments when each ++ operation is called
-  std::map<vrs::StreamId, int> streamIdToSubsampleRate_;
-  int64_t endDeviceTimeNs_; // ending point of the sequence
+  SensorData readData(const StreamCursor& stream, int index) const;
+
+  // (device time, stream slot) of the current data of each stream not yet exhausted
+  using HeapEntry = std::pair<int64_t, size_t>;
+
+  VrsDataProvider* provider_ = nullptr; // non-owning pointer to vrs data provider
+  // dense per-stream state, indexed by stream slot
+  std::vector<StreamCursor> streams_;
+  // min-heap ordering the streams by device time of their current data, kept small and
+  // trivially copyable so the merge never moves sensor data payloads
+  std::vector<HeapEntry> heap_;
+  int64_t endDeviceTimeNs_ = 0; // ending point of the sequence
 };
 
 /**
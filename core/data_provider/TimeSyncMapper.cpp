@@ -24,38 +24,62 @@ namespace projectaria::tools::data_provider {
 
 TimeSyncMapper::TimeSyncMapper(
     const std::shared_ptr<vrs::MultiRecordFileReader>& reader,
-    const std::map<TimeSyncMode, std::shared_ptr<TimeSyncPlayer>>& timesyncPlayers) {
+    const std::map<TimeSyncMode, std::shared_ptr<TimeSyncPlayer>>& timesyncPlayers,
+    const std::shared_ptr<std::mutex>& readerMutex,
+    bool loadLazily)
+    : reader_(reader),
+      readerMutex_(readerMutex ? readerMutex : std::make_shared<std::mutex>()) {
   if (timesyncPlayers.size() == 0) {
     return;
   }
   timesyncPlayers_ = timesyncPlayers;
   for (const auto& [mode, player] : timesyncPlayers) {
-    vrs::StreamId streamId = player->getStreamId();
-    int numTimeCode = reader->getRecordCount(streamId, vrs::Record::Type::DATA);
-    recordInfoTimeNs_[mode].reserve(numTimeCode);
-    timeSyncData_[mode].reserve(numTimeCode);
     timeSyncModes_.push_back(mode);
+    timeSyncData_[mode];
+    recordInfoTimeNs_[mode];
+    loadOnceFlags_[mode];
+  }
+  if (!loadLazily) {
+    for (const auto& mode : timeSyncModes_) {
+      getTimeSyncData(mode);
+    }
+  }
+}
+
+const std::vector<TimeSyncData>& TimeSyncMapper::getTimeSyncData(const TimeSyncMode mode) const {
+  std::call_once(loadOnceFlags_.at(mode), [&] { loadTimeSyncData(mode); });
+  return timeSyncData_.at(mode);
+}
 
-    for (int index = 0; index < numTimeCode; ++index) {
-      const vrs::IndexRecord::RecordInfo* recordInfo =
-          reader->getRecord(streamId, vrs::Record::Type::DATA, static_cast<uint32_t>(index));
-      checkAndThrow(
-          recordInfo, fmt::format("getRecord failed for {}, index {}", streamId.getName(), index));
-      const int errorCode = reader->readRecord(*recordInfo);
-      if (errorCode != 0) {
-        XR_LOGE(
-            "Fail to read record {} from streamId {} with code {}",
-            index,
-            streamId.getNumericName(),
-            errorCode);
-        continue;
-      }
-      recordInfoTimeNs_[mode].push_back(static_cast<int64_t>(recordInfo->timestamp * 1e9));
-      timeSyncData_[mode].push_back(player->getDataRecord());
+void TimeSyncMapper::loadTimeSyncData(const TimeSyncMode mode) const {
+  std::lock_guard<std::mutex> lockGuard(*readerMutex_);
+  const auto& player = timesyncPlayers_.at(mode);
+  vrs::StreamId streamId = player->getStreamId();
+  int numTimeCode = reader_->getRecordCount(streamId, vrs::Record::Type::DATA);
+  auto& recordInfoTimeNs = recordInfoTimeNs_.at(mode);
+  auto& timeSyncData = timeSyncData_.at(mode);
+  recordInfoTimeNs.reserve(numTimeCode);
+  timeSyncData.reserve(numTimeCode);
+
+  for (int index = 0; index < numTimeCode; ++index) {
+    const vrs::IndexRecord::RecordInfo* recordInfo =
+        reader_->getRecord(streamId, vrs::Record::Type::DATA, static_cast<uint32_t>(index));
+    checkAndThrow(
+        recordInfo, fmt::format("getRecord failed for {}, index {}", streamId.getName(), index));
+    const int errorCode = reader_->readRecord(*recordInfo);
+    if (errorCode != 0) {
+      XR_LOGE(
+          "Fail to read record {} from streamId {} with code {}",
+          index,
+          streamId.getNumericName(),
+          errorCode);
+      continue;
     }
-    recordInfoTimeNs_[mode].shrink_to_fit();
-    timeSyncData_[mode].shrink_to_fit();
+    recordInfoTimeNs.push_back(static_cast<int64_t>(recordInfo->timestamp * 1e9));
+    timeSyncData.push_back(player->getDataRecord());
   }
+  recordInfoTimeNs.shrink_to_fit();
+  timeSyncData.shrink_to_fit();
 }
 
 int64_t TimeSyncMapper::convertFromSyncTimeToDeviceTimeNs(
@@ -64,7 +88,7 @@ int64_t TimeSyncMapper::convertFromSyncTimeToDeviceTimeNs(
   if (!supportsMode(mode)) {
     return -1;
   }
-  auto timecodeData = timeSyncData_.at(mode);
+  const auto& timecodeData = getTimeSyncData(mode);
 
   if (timecodeTimeNs <= timecodeData.front().realTimestampNs) {
     return timecodeData.front().monotonicTimestampNs - timecodeData.front().realTimestampNs +
@@ -100,7 +124,7 @@ int64_t TimeSyncMapper::convertFromDeviceTimeToSyncTimeNs(
   if (!supportsMode(mode)) {
     return -1;
   }
-  auto timecodeData = timeSyncData_.at(mode);
+  const auto& timecodeData = getTimeSyncData(mode);
 
   if (deviceTimeNs <= timecodeData.front().monotonicTimestampNs) {
     return timecodeData.front().realTimestampNs - timecodeData.front().monotonicTimestampNs +
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <vrs/MultiRecordFileReader.h>
@@ -29,9 +31,13 @@ namespace projectaria::tools::data_provider {
 class TimeSyncMapper {
  public:
   TimeSyncMapper() = default;
+  // readerMutex: serializes the reads of the time sync records with other reads of the reader
+  // loadLazily: read the time sync records of a mode on its first conversion, instead of here
   explicit TimeSyncMapper(
       const std::shared_ptr<vrs::MultiRecordFileReader>& reader,
-      const std::map<TimeSyncMode, std::shared_ptr<TimeSyncPlayer>>& timesyncPlayers);
+      const std::map<TimeSyncMode, std::shared_ptr<TimeSyncPlayer>>& timesyncPlayers,
+      const std::shared_ptr<std::mutex>& readerMutex = nullptr,
+      bool loadLazily = false);
 
   // general function to convert between two times in TimeSyncData
   // syncTime: TimeSyncData.realTimestampNs
@@ -51,9 +57,17 @@ class TimeSyncMapper {
   std::vector<TimeSyncMode> getTimeSyncModes() const;
 
  private:
+  // reads all the time sync records of a mode, once
+  const std::vector<TimeSyncData>& getTimeSyncData(const TimeSyncMode mode) const;
+  void loadTimeSyncData(const TimeSyncMode mode) const;
+
+  std::shared_ptr<vrs::MultiRecordFileReader> reader_;
+  std::shared_ptr<std::mutex> readerMutex_;
   std::map<TimeSyncMode, std::shared_ptr<TimeSyncPlayer>> timesyncPlayers_;
-  std::map<TimeSyncMode, std::vector<TimeSyncData>> timeSyncData_;
-  std::map<TimeSyncMode, std::vector<int64_t>> recordInfoTimeNs_;
+  // the entries of each mode are created by the constructor, and filled once by loadTimeSyncData
+  mutable std::map<TimeSyncMode, std::vector<TimeSyncData>> timeSyncData_;
+  mutable std::map<TimeSyncMode, std::vector<int64_t>> recordInfoTimeNs_;
+  mutable std::map<TimeSyncMode, std::once_flag> loadOnceFlags_;
   std::vector<TimeSyncMode> timeSyncModes_;
 };
 } // namespace projectaria::tools::data_provider
@@ -16,71 +16,102 @@
 
 #include <data_provider/ErrorHandler.h>
 #include <data_provider/TimestampIndexMapper.h>
+#include <trace/Trace.h>
 
 #define DEFAULT_LOG_CHANNEL "TimestampIndexMapper"
 #include <logging/Log.h>
 
 namespace projectaria::tools::data_provider {
-TimestampIndexMapper::TimestampIndexMapper(std::shared_ptr<RecordReaderInterface> interface)
-    : interface_(interface), streamIdToDataRecords_(interface_->getStreamIdToDataRecords()) {
-  // find time range
+TimestampIndexMapper::TimestampIndexMapper(
+    std::shared_ptr<RecordReaderInterface> interface,
+    bool loadLazily)
+    : interface_(interface) {
   for (const auto& streamId : interface_->getStreamIds()) {
-    // lambda function for finding first or last timestamp
-    auto findFirstDataTimestamp = [&](int first, int last, int increment) {
-      std::array<int64_t, kNumTimeDomain - 1> timeNs;
-      timeNs.fill(-1);
-      for (int index = first; index != last; index += increment) {
-        const vrs::IndexRecord::RecordInfo* recordInfo =
-            interface_->readRecordByIndex(streamId, index);
-        if (recordInfo) {
-          for (auto timeDomain : std::vector<TimeDomain>{
-                   TimeDomain::RecordTime, TimeDomain::DeviceTime, TimeDomain::HostTime}) {
-            timeNs.at(static_cast<size_t>(timeDomain)) =
-                interface_->getLastCachedSensorData(streamId).getTimeNs(timeDomain);
-          }
-          break;
+    streamIdToTimeRange_[streamId];
+  }
+  if (loadLazily) {
+    return;
+  }
+  loadDataRecords();
+  for (const auto& streamId : interface_->getStreamIds()) {
+    getTimeRange(streamId);
+  }
+}
+
+const TimestampIndexMapper::StreamTimeRange& TimestampIndexMapper::getTimeRange(
+    const vrs::StreamId& streamId) const {
+  auto it = streamIdToTimeRange_.find(streamId);
+  checkAndThrow(
+      it != streamIdToTimeRange_.end(),
+      fmt::format("Cannot find streamId {}", streamId.getNumericName()));
+  StreamTimeRange& timeRange = it->second;
+  std::call_once(timeRange.onceFlag, [&] { findTimeRange(streamId, timeRange); });
+  return timeRange;
+}
+
+void TimestampIndexMapper::findTimeRange(
+    const vrs::StreamId& streamId,
+    StreamTimeRange& timeRange) const {
+  PROJECTARIA_TRACE_SCOPE("TimestampIndexMapper::findTimeRange");
+  // lambda function for finding first or last timestamp
+  auto findFirstDataTimestamp = [&](int first, int last, int increment) {
+    std::array<int64_t, kNumTimeDomain - 1> timeNs;
+    timeNs.fill(-1);
+    for (int index = first; index != last; index += increment) {
+      const vrs::IndexRecord::RecordInfo* recordInfo =
+          interface_->readRecordByIndex(streamId, index, /* readContent = */ false);
+      if (recordInfo) {
+        for (auto timeDomain : std::vector<TimeDomain>{
+                 TimeDomain::RecordTime, TimeDomain::DeviceTime, TimeDomain::HostTime}) {
+          timeNs.at(static_cast<size_t>(timeDomain)) =
+              interface_->getLastCachedSensorData(streamId).getTimeNs(timeDomain);
         }
+        break;
       }
-      return timeNs;
-    };
-
-    int numData = interface_->getNumData(streamId);
+    }
+    return timeNs;
+  };
 
-    auto firstTimeNs = findFirstDataTimestamp(0, numData, 1);
-    auto lastTimeNs = findFirstDataTimestamp(numData - 1, -1, -1);
+  int numData = interface_->getNumData(streamId);
 
-    streamIdToFirstTimeNs_.emplace(streamId, firstTimeNs);
-    streamIdToLastTimeNs_.emplace(streamId, lastTimeNs);
-  }
+  timeRange.firstTimeNs = findFirstDataTimestamp(0, numData, 1);
+  timeRange.lastTimeNs = findFirstDataTimestamp(numData - 1, -1, -1);
 
   // find delta time between record and device/host time
-  for (const auto& streamId : interface_->getStreamIds()) {
-    for (auto timeDomain : {TimeDomain::DeviceTime, TimeDomain::HostTime}) {
-      streamIdToDeltaToRecordTimeNs_[streamId].at(static_cast<size_t>(timeDomain)) =
-          (getFirstTimeNs(streamId, TimeDomain::RecordTime) - getFirstTimeNs(streamId, timeDomain) +
-           getLastTimeNs(streamId, TimeDomain::RecordTime) - getLastTimeNs(streamId, timeDomain)) /
-          2;
-    }
+  timeRange.deltaToRecordTimeNs.fill(0);
+  const auto recordTimeIndex = static_cast<size_t>(TimeDomain::RecordTime);
+  for (auto timeDomain : {TimeDomain::DeviceTime, TimeDomain::HostTime}) {
+    const auto timeIndex = static_cast<size_t>(timeDomain);
+    timeRange.deltaToRecordTimeNs.at(timeIndex) =
+        (timeRange.firstTimeNs.at(recordTimeIndex) - timeRange.firstTimeNs.at(timeIndex) +
+         timeRange.lastTimeNs.at(recordTimeIndex) - timeRange.lastTimeNs.at(timeIndex)) /
+        2;
   }
 }
 
+void TimestampIndexMapper::loadDataRecords() {
+  std::call_once(dataRecordsOnceFlag_, [&] {
+    streamIdToDataRecords_ = interface_->getStreamIdToDataRecords();
+  });
+}
+
+const std::vector<const vrs::IndexRecord::RecordInfo*>& TimestampIndexMapper::getDataRecords(
+    const vrs::StreamId& streamId) {
+  loadDataRecords();
+  return streamIdToDataRecords_.at(streamId);
+}
+
 // get start and end time w.r.t. different time domain
 int64_t TimestampIndexMapper::getFirstTimeNs(
     const vrs::StreamId& streamId,
     const TimeDomain& timeDomain) const {
-  checkAndThrow(
-      streamIdToFirstTimeNs_.count(streamId) > 0,
-      fmt::format("Cannot find streamId {}", streamId.getNumericName()));
-  return streamIdToFirstTimeNs_.at(streamId).at(static_cast<size_t>(timeDomain));
+  return getTimeRange(streamId).firstTimeNs.at(static_cast<size_t>(timeDomain));
 }
 
 int64_t TimestampIndexMapper::getLastTimeNs(
     const vrs::StreamId& streamId,
     const TimeDomain& timeDomain) const {
-  checkAndThrow(
-      streamIdToLastTimeNs_.count(streamId) > 0,
-      fmt::format("Cannot find streamId {}", streamId.getNumericName()));
-  return streamIdToLastTimeNs_.at(streamId).at(static_cast<size_t>(timeDomain));
+  return getTimeRange(streamId).lastTimeNs.at(static_cast<size_t>(timeDomain));
 }
 
 int TimestampIndexMapper::getIndexByTimeNs(
@@ -88,7 +119,7 @@ int TimestampIndexMapper::getIndexByTimeNs(
     const int64_t timeNsInTimeDomain,
     const TimeDomain& timeDomain,
     const TimeQueryOptions& timeQueryOptions) {
-  interface_->setReadImageContent(streamId, false);
+  PROJECTARIA_TRACE_SCOPE("TimestampIndexMapper::getIndexByTimeNs");
   int index = -1;
   switch (timeQueryOptions) {
     case TimeQueryOptions::Before:
@@ -103,7 +134,6 @@ int TimestampIndexMapper::getIndexByTimeNs(
     default:
       break;
   }
-  interface_->setReadImageContent(streamId, true);
   return index;
 }
 
@@ -123,14 +153,14 @@ int TimestampIndexMapper::getIndexBeforeTimeNsNonTimeCode(
 
   // convert from host/device to record timestamp
   int64_t deltaToRecordTimeNs =
-      streamIdToDeltaToRecordTimeNs_.at(streamId).at(static_cast<size_t>(timeDomain));
+      getTimeRange(streamId).deltaToRecordTimeNs.at(static_cast<size_t>(timeDomain));
   int64_t estTimeNsInRecordTime = std::max(timeNsInTimeDomain + deltaToRecordTimeNs, int64_t(0));
 
   // search
   double estTimeSecInRecordTime = double(estTimeNsInRecordTime) * 1e-9;
   vrs::IndexRecord::RecordInfo queryTime(
       estTimeSecInRecordTime, 0, vrs::StreamId(), vrs::Record::Type::UNDEFINED);
-  auto dataRecords = streamIdToDataRecords_.at(streamId);
+  const auto& dataRecords = getDataRecords(streamId);
   auto recordIter = std::upper_bound( // searches for earliest timestamp > query
       dataRecords.begin(),
       dataRecords.end(),
@@ -141,7 +171,7 @@ int TimestampIndexMapper::getIndexBeforeTimeNsNonTimeCode(
   }
   int indexAtRecordTime = static_cast<int>(std::distance(dataRecords.begin(), recordIter - 1));
   // make sure the returned data is undamaged
-  while (!interface_->readRecordByIndex(streamId, indexAtRecordTime)) {
+  while (!interface_->readRecordByIndex(streamId, indexAtRecordTime, /* readContent = */ false)) {
     checkAndThrow(
         indexAtRecordTime >= 0); // since we already checked boundary this shouldn't happen
     indexAtRecordTime--;
@@ -162,7 +192,8 @@ int TimestampIndexMapper::getIndexBeforeTimeNsNonTimeCode(
   const int increment = searchForward ? 1 : -1;
   bool foundRecord = false;
   while (indexAtRecordTime >= 0 && indexAtRecordTime < dataRecords.size()) {
-    if (interface_->readRecordByIndex(streamId, indexAtRecordTime)) { // if damaged data, skip
+    // if damaged data, skip
+    if (interface_->readRecordByIndex(streamId, indexAtRecordTime, /* readContent = */ false)) {
       int64_t cachedTimeNs = interface_->getLastCachedSensorData(streamId).getTimeNs(timeDomain);
       if ((cachedTimeNs > timeNsInTimeDomain) == searchForward) {
         foundRecord = true;
@@ -185,10 +216,9 @@ int64_t TimestampIndexMapper::getTimestampByIndex(
   if (index >= 0) {
     // check if timestamp at indexBefore == equal
     if (timeDomain == TimeDomain::RecordTime) {
-      timestamp =
-          static_cast<int64_t>(streamIdToDataRecords_.at(streamId).at(index)->timestamp * 1e9);
+      timestamp = static_cast<int64_t>(getDataRecords(streamId).at(index)->timestamp * 1e9);
     } else {
-      interface_->readRecordByIndex(streamId, index);
+      interface_->readRecordByIndex(streamId, index, /* readContent = */ false);
       timestamp = interface_->getLastCachedSensorData(streamId).getTimeNs(timeDomain);
     }
   }
@@ -203,7 +233,7 @@ int TimestampIndexMapper::getIndexAfterTimeNsNonTimeCodeFromIndexBefore(
   // search forward
   int64_t indexAfter = indexBefore + 1;
   while (indexAfter < interface_->getNumData(streamId) &&
-         !interface_->readRecordByIndex(streamId, indexAfter)) {
+         !interface_->readRecordByIndex(streamId, indexAfter, /* readContent = */ false)) {
     indexAfter++;
   }
   return indexAfter >= interface_->getNumData(streamId) ? -1 : indexAfter;
@@ -262,20 +292,20 @@ int TimestampIndexMapper::getIndexClosestTimeNsNonTimeCode(
 std::vector<int64_t> TimestampIndexMapper::getTimestampsNs(
     const vrs::StreamId& streamId,
     const TimeDomain& timeDomain) {
+  PROJECTARIA_TRACE_SCOPE("TimestampIndexMapper::getTimestampsNs");
   int numData = interface_->getNumData(streamId);
   std::vector<int64_t> timestampsNs(numData);
   if (timeDomain ==
       TimeDomain::RecordTime) { // separate recordTime for the fastest timestamp retrieval
+    const auto& dataRecords = getDataRecords(streamId);
     for (int index = 0; index < numData; ++index) {
-      timestampsNs.at(index) = streamIdToDataRecords_.at(streamId).at(index)->timestamp * 1e9;
+      timestampsNs.at(index) = dataRecords.at(index)->timestamp * 1e9;
     }
   } else {
-    interface_->setReadImageContent(streamId, false);
     for (int index = 0; index < numData; ++index) {
-      interface_->readRecordByIndex(streamId, index);
+      interface_->readRecordByIndex(streamId, index, /* readContent = */ false);
       timestampsNs.at(index) = interface_->getLastCachedSensorData(streamId).getTimeNs(timeDomain);
     }
-    interface_->setReadImageContent(streamId, true);
   }
   return timestampsNs;
 }
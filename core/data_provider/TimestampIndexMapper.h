@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <array>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <data_provider/RecordReaderInterface.h>
@@ -26,7 +29,10 @@ namespace projectaria::tools::data_provider {
 // maps between device time and timecode time
 class TimestampIndexMapper {
  public:
-  explicit TimestampIndexMapper(std::shared_ptr<RecordReaderInterface> interface);
+  // loadLazily: find the time range of a stream on its first query, instead of here
+  explicit TimestampIndexMapper(
+      std::shared_ptr<RecordReaderInterface> interface,
+      bool loadLazily = false);
 
   // get start and end time w.r.t. different time domain
   int64_t getFirstTimeNs(const vrs::StreamId& streamId, const TimeDomain& timeDomain) const;
@@ -59,9 +65,21 @@ class TimestampIndexMapper {
       const TimeDomain& timeDomain);
 
  private:
-  void cacheDataRecords();
-  void findTimeRange();
-  void findTimedomainDeltas();
+  // first and last timestamps of a stream, and the deltas from device/host time to record time
+  struct StreamTimeRange {
+    std::once_flag onceFlag;
+    std::array<int64_t, kNumTimeDomain - 1> firstTimeNs;
+    std::array<int64_t, kNumTimeDomain - 1> lastTimeNs;
+    std::array<int64_t, kNumTimeDomain - 1> deltaToRecordTimeNs;
+  };
+
+  // return the time range of a stream, reading its first and last valid records once
+  const StreamTimeRange& getTimeRange(const vrs::StreamId& streamId) const;
+  void findTimeRange(const vrs::StreamId& streamId, StreamTimeRange& timeRange) const;
+  // return the data records of a stream, filtering the records of the file index once
+  void loadDataRecords();
+  const std::vector<const vrs::IndexRecord::RecordInfo*>& getDataRecords(
+      const vrs::StreamId& streamId);
 
   int getIndexAfterTimeNsNonTimeCodeFromIndexBefore(
       const vrs::StreamId& streamId,
@@ -74,10 +92,10 @@ class TimestampIndexMapper {
 
  private:
   std::shared_ptr<RecordReaderInterface> interface_;
+  std::once_flag dataRecordsOnceFlag_;
   std::map<vrs::StreamId, std::vector<const vrs::IndexRecord::RecordInfo*>> streamIdToDataRecords_;
 
-  std::map<vrs::StreamId, std::array<int64_t, kNumTimeDomain - 1>> streamIdToFirstTimeNs_;
-  std::map<vrs::StreamId, std::array<int64_t, kNumTimeDomain - 1>> streamIdToLastTimeNs_;
-  std::map<vrs::StreamId, std::array<int64_t, kNumTimeDomain - 1>> streamIdToDeltaToRecordTimeNs_;
+  // the entries of all streams are created by the constructor, and filled once by findTimeRange
+  mutable std::map<vrs::StreamId, StreamTimeRange> streamIdToTimeRange_;
 };
 } // namespace projectaria::tools::data_provider
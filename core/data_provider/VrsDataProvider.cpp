@@ -21,21 +21,89 @@
 #define DEFAULT_LOG_CHANNEL "VrsDataProvider"
 #include <logging/Log.h>
 
+#include <algorithm>
 #include <limits>
 
 namespace projectaria::tools::data_provider {
+namespace {
+// Rescales and crops a camera calibration the same way as its images are decoded
+calibration::CameraCalibration rescaleToDecodedImage(
+    const calibration::CameraCalibration& camCalib,
+    const image::JpegDecodeOptions& decodeOptions) {
+  const Eigen::Vector2i imageSize = camCalib.getImageSize();
+  const uint32_t scale = std::max(decodeOptions.scaleDenominator, 1u);
+  const image::ImageRegion scaledImage =
+      image::getJpegDecodedRegion(imageSize.x(), imageSize.y(), {scale, std::nullopt});
+  const calibration::CameraCalibration scaledCalib = camCalib.rescale(
+      Eigen::Vector2i(scaledImage.width, scaledImage.height), 1.0 / static_cast<double>(scale));
+  if (!decodeOptions.roi) {
+    return scaledCalib;
+  }
+
+  // the decoded region may start anywhere, which rescale() does not support as it crops
+  // symmetrically, so shift the scaled projection to the origin of the region instead
+  const image::ImageRegion region =
+      image::getJpegDecodedRegion(imageSize.x(), imageSize.y(), decodeOptions);
+  calibration::CameraProjection projection(
+      scaledCalib.modelName(), scaledCalib.projectionParams());
+  projection.subtractFromOrigin(region.x, region.y);
+  return calibration::CameraCalibration(
+      scaledCalib.getLabel(),
+      scaledCalib.modelName(),
+      projection.projectionParams(),
+      scaledCalib.getT_Device_Camera(),
+      region.width,
+      region.height,
+      scaledCalib.getValidRadius(),
+      scaledCalib.getMaxSolidAngle(),
+      scaledCalib.getSerialNumber());
+}
+} // namespace
+
 VrsDataProvider::VrsDataProvider(
     const std::shared_ptr<RecordReaderInterface>& interface,
     const std::shared_ptr<StreamIdConfigurationMapper>& configMap,
     const std::shared_ptr<TimeSyncMapper>& timeSyncMapper,
     const std::shared_ptr<StreamIdLabelMapper>& streamIdLabelMapper,
     const std::optional<calibration::DeviceCalibration>& maybeDeviceCalib)
+    : VrsDataProvider(
+          interface,
+          configMap,
+          std::make_shared<TimestampIndexMapper>(interface),
+          timeSyncMapper,
+          streamIdLabelMapper,
+          [maybeDeviceCalib]() { return maybeDeviceCalib; }) {}
+
+VrsDataProvider::VrsDataProvider(
+    const std::shared_ptr<RecordReaderInterface>& interface,
+    const std::shared_ptr<StreamIdConfigurationMapper>& configMap,
+    const std::shared_ptr<TimestampIndexMapper>& timeQuery,
+    const std::shared_ptr<TimeSyncMapper>& timeSyncMapper,
+    const std::shared_ptr<StreamIdLabelMapper>& streamIdLabelMapper,
+    std::function<std::optional<calibration::DeviceCalibration>()> deviceCalibLoader,
+    const VrsDataProviderOpenTimings& openTimings)
     : interface_(interface),
       configMap_(configMap),
-      timeQuery_(std::make_shared<TimestampIndexMapper>(interface_)),
+      timeQuery_(timeQuery),
       timeSyncMapper_(timeSyncMapper),
       streamIdLabelMapper_(streamIdLabelMapper),
-      maybeDeviceCalib_(maybeDeviceCalib) {}
+      deviceCalibLoader_(std::move(deviceCalibLoader)),
+      openTimings_(openTimings) {}
+
+const std::optional<calibration::DeviceCalibration>& VrsDataProvider::getDeviceCalibrationRef()
+    const {
+  // the calibration is loaded on first use
+  std::call_once(deviceCalibOnceFlag_, [&] {
+    if (deviceCalibLoader_) {
+      maybeDeviceCalib_ = deviceCalibLoader_();
+    }
+  });
+  return maybeDeviceCalib_;
+}
+
+VrsDataProviderOpenTimings VrsDataProvider::getOpenTimings() const {
+  return openTimings_;
+}
 
 SensorDataType VrsDataProvider::getSensorDataType(const vrs::StreamId& streamId) const {
   return interface_->getSensorDataType(streamId);
@@ -155,23 +223,87 @@ DeliverQueuedOptions VrsDataProvider::getDefaultDeliverQueuedOptions() const {
 }
 
 std::optional<calibration::DeviceCalibration> VrsDataProvider::getDeviceCalibration() const {
-  return maybeDeviceCalib_;
+  return getDeviceCalibrationRef();
 }
 
 std::optional<calibration::SensorCalibration> VrsDataProvider::getSensorCalibration(
     const vrs::StreamId& streamId) const {
-  if (!maybeDeviceCalib_) {
+  const auto& maybeDeviceCalib = getDeviceCalibrationRef();
+  if (!maybeDeviceCalib) {
     return {};
   } else {
     auto maybeLabel = getLabelFromStreamId(streamId);
     if (!maybeLabel) {
       return {};
     } else {
-      return maybeDeviceCalib_->getSensorCalib(*maybeLabel);
+      return maybeDeviceCalib->getSensorCalib(*maybeLabel);
     }
   }
 }
 
+std::optional<calibration::CameraCalibration> VrsDataProvider::getDecodedCameraCalibration(
+    const vrs::StreamId& streamId,
+    const image::JpegDecodeOptions& decodeOptions) const {
+  auto maybeLabel = getLabelFromStreamId(streamId);
+  const auto& maybeDeviceCalib = getDeviceCalibrationRef();
+  if (!maybeDeviceCalib || !maybeLabel) {
+    return {};
+  }
+  const calibration::CameraCalibration* camCalib = maybeDeviceCalib->findCameraCalib(*maybeLabel);
+  if (camCalib == nullptr) {
+    return {};
+  }
+  // the decode options are ignored for images that are not compressed as JPEG
+  if (!interface_->isJpegImageStream(streamId)) {
+    return *camCalib;
+  }
+  return rescaleToDecodedImage(*camCalib, decodeOptions);
+}
+
+void VrsDataProvider::setImageDecodeOptions(
+    const vrs::StreamId& streamId,
+    const image::JpegDecodeOptions& decodeOptions) {
+  checkImageDecodeOptions(streamId, decodeOptions);
+  interface_->setImageDecodeOptions(streamId, decodeOptions);
+}
+
+image::JpegDecodeOptions VrsDataProvider::getImageDecodeOptions(
+    const vrs::StreamId& streamId) const {
+  return interface_->getImageDecodeOptions(streamId);
+}
+
+void VrsDataProvider::setImageCacheBudget(size_t maxBytes) {
+  std::lock_guard<std::mutex> lockGuard(imageCacheMutex_);
+  if (maxBytes == 0) {
+    imageCache_.reset();
+  } else if (imageCache_) {
+    imageCache_->setMaxBytes(maxBytes);
+  } else {
+    imageCache_ = std::make_shared<ImageFrameCache>(maxBytes);
+  }
+}
+
+std::optional<ImageFrameCache::Stats> VrsDataProvider::getImageCacheStats() const {
+  const std::shared_ptr<ImageFrameCache> imageCache = getImageCache();
+  if (!imageCache) {
+    return {};
+  }
+  return imageCache->getStats();
+}
+
+std::shared_ptr<ImageFrameCache> VrsDataProvider::getImageCache() const {
+  std::lock_guard<std::mutex> lockGuard(imageCacheMutex_);
+  return imageCache_;
+}
+
+void VrsDataProvider::setAccessPattern(AccessPattern pattern, size_t readAheadBytes) {
+  interface_->setAccessPattern(pattern, readAheadBytes);
+}
+
+AccessPattern VrsDataProvider::getAccessPattern() const {
+  return interface_->getAccessPattern();
+}
+
 /* get data from index */
 SensorData VrsDataProvider::getSensorDataByIndex(const vrs::StreamId& streamId, const int index) {
   if (interface_->readRecordByIndex(streamId, index)) {
@@ -181,6 +313,16 @@ SensorData VrsDataProvider::getSensorDataByIndex(const vrs::StreamId& streamId,
   }
 }
 
+SensorData VrsDataProvider::getSensorDataMetadataByIndex(
+    const vrs::StreamId& streamId,
+    const int index) {
+  if (interface_->readRecordByIndex(streamId, index, /* readContent = */ false)) {
+    return interface_->getLastCachedSensorData(streamId);
+  } else {
+    return SensorData(streamId, std::monostate{}, SensorDataType::NotValid, -1, {});
+  }
+}
+
 /* get data sequentially based on sensor data device time */
 SensorDataSequence VrsDataProvider::deliverQueuedSensorData() {
   auto options = getDefaultDeliverQueuedOptions();
@@ -191,17 +333,47 @@ SensorDataSequence VrsDataProvider::deliverQueuedSensorData(DeliverQueuedOptions
   return SensorDataSequence(this, options);
 }
 
+FrameSetSequence VrsDataProvider::deliverFrameSets(const FrameSetOptions& options) {
+  return FrameSetSequence(this, options);
+}
+
 ImageDataAndRecord VrsDataProvider::getImageDataByIndex(
     const vrs::StreamId& streamId,
     const int index) {
   assertStreamIsActive(streamId);
   assertStreamIsType(streamId, SensorDataType::Image);
+  return readImageData(streamId, index, getImageDecodeOptions(streamId));
+}
 
-  if (interface_->readRecordByIndex(streamId, index)) {
-    return interface_->getLastCachedImageData(streamId);
-  } else {
+ImageDataAndRecord VrsDataProvider::getImageDataByIndex(
+    const vrs::StreamId& streamId,
+    const int index,
+    const image::JpegDecodeOptions& decodeOptions) {
+  checkImageDecodeOptions(streamId, decodeOptions);
+  return readImageData(streamId, index, decodeOptions);
+}
+
+ImageDataAndRecord VrsDataProvider::readImageData(
+    const vrs::StreamId& streamId,
+    const int index,
+    const image::JpegDecodeOptions& decodeOptions) {
+  // the cache of this read, kept alive if the cache is disabled or replaced meanwhile
+  const std::shared_ptr<ImageFrameCache> imageCache = getImageCache();
+  std::optional<ImageFrameCache::Key> cacheKey;
+  if (imageCache) {
+    cacheKey = ImageFrameCache::Key{streamId, index, decodeOptions};
+    if (auto cachedData = imageCache->get(*cacheKey)) {
+      return std::move(*cachedData);
+    }
+  }
+
+  // the options are passed to the read itself, other reads of the stream are not affected, and
+  // the frame is the one of this read even if the stream is read concurrently
+  auto data = interface_->readImageByIndex(streamId, index, &decodeOptions);
+  if (!data) {
     return {};
   }
+  return cacheKey ? imageCache->insert(*cacheKey, *data) : std::move(*data);
 }
 
 MotionData VrsDataProvider::getImuDataByIndex(const vrs::StreamId& streamId, const int index) {
@@ -308,6 +480,16 @@ ImageDataAndRecord VrsDataProvider::getImageDataByTimeNs(
   return getImageDataByIndex(streamId, index);
 }
 
+ImageDataAndRecord VrsDataProvider::getImageDataByTimeNs(
+    const vrs::StreamId& streamId,
+    const int64_t timeNs,
+    const TimeDomain& timeDomain,
+    const TimeQueryOptions& timeQueryOptions,
+    const image::JpegDecodeOptions& decodeOptions) {
+  const int index = getIndexByTimeNs(streamId, timeNs, timeDomain, timeQueryOptions);
+  return getImageDataByIndex(streamId, index, decodeOptions);
+}
+
 MotionData VrsDataProvider::getImuDataByTimeNs(
     const vrs::StreamId& streamId,
     const int64_t timeNs,
@@ -513,6 +695,34 @@ bool VrsDataProvider::checkStreamIsType(const vrs::StreamId& streamId, SensorDat
   return streamIdType == type;
 }
 
+void VrsDataProvider::checkImageDecodeOptions(
+    const vrs::StreamId& streamId,
+    const image::JpegDecodeOptions& decodeOptions) const {
+  assertStreamIsActive(streamId);
+  assertStreamIsType(streamId, SensorDataType::Image);
+  const uint32_t scale = decodeOptions.scaleDenominator;
+  checkAndThrow(
+      scale == 1 || scale == 2 || scale == 4 || scale == 8,
+      fmt::format("Unsupported image decode scale 1/{}, expecting 1, 2, 4 or 8", scale));
+  if (decodeOptions.roi) {
+    // a region partly outside the image is clipped to it, one with no pixel in it is an error
+    const image::ImageRegion& roi = *decodeOptions.roi;
+    const ImageConfigRecord config = getImageConfiguration(streamId);
+    checkAndThrow(
+        roi.width > 0 && roi.height > 0 && roi.x < config.imageWidth &&
+            roi.y < config.imageHeight,
+        fmt::format(
+            "Image decode region {}x{} at ({}, {}) is empty or outside the {}x{} images of {}",
+            roi.width,
+            roi.height,
+            roi.x,
+            roi.y,
+            config.imageWidth,
+            config.imageHeight,
+            streamId.getName()));
+  }
+}
+
 void VrsDataProvider::assertStreamIsActive(const vrs::StreamId& streamId) const {
   checkAndThrow(
       checkStreamIsActive(streamId),
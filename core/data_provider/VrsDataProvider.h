@@ -16,11 +16,16 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <calibration/DeviceCalibration.h>
+#include <data_provider/FrameSetSequence.h>
+#include <data_provider/ImageFrameCache.h>
 #include <data_provider/RecordReaderInterface.h>
 #include <data_provider/SensorConfiguration.h>
 #include <data_provider/SensorDataSequence.h>
@@ -28,15 +33,61 @@
 #include <data_provider/StreamIdLabelMapper.h>
 #include <data_provider/TimeSyncMapper.h>
 #include <data_provider/TimestampIndexMapper.h>
+#include <image/utility/JpegDecode.h>
 
 namespace projectaria::tools::data_provider {
 class VrsDataProvider;
 
+/**
+ * @brief Options to create a VrsDataProvider
+ */
+struct VrsDataProviderOpenOptions {
+  /**
+   * @brief Defer the work that is not needed to read a frame by index to its first use: the time
+   * sync records are read on the first time sync conversion, the time range of a stream on its
+   * first time query, and the calibration is parsed on its first access.
+   */
+  bool lazyInitialization = false;
+};
+
+/**
+ * @brief Time spent in each phase of creating a VrsDataProvider, in nanoseconds. Phases deferred by
+ * VrsDataProviderOpenOptions::lazyInitialization are not included.
+ */
+struct VrsDataProviderOpenTimings {
+  bool lazyInitialization = false; ///< @brief if the provider was created with lazy initialization
+  int64_t openFilesNs = 0; ///< @brief opening the vrs files and reading their index
+  int64_t readConfigurationsNs = 0; ///< @brief reading the first configuration record of streams
+  int64_t loadCalibrationNs = 0; ///< @brief parsing calibration and matching camera configurations
+  int64_t loadTimeSyncNs = 0; ///< @brief reading the time sync records
+  int64_t buildTimeIndexNs = 0; ///< @brief finding the data records and time range of streams
+  int64_t totalNs = 0; ///< @brief from opening the files to returning the provider
+};
+
 /**
  * @brief Factory class to create a VrsDataProvider class.
  * @param vrsFilename Single vrs file to read from.
+ * @param options Options to create the provider with.
  */
-std::shared_ptr<VrsDataProvider> createVrsDataProvider(const std::string& vrsFilename);
+std::shared_ptr<VrsDataProvider> createVrsDataProvider(
+    const std::string& vrsFilename,
+    const VrsDataProviderOpenOptions& options = {});
+
+/**
+ * @brief Factory class to create a VrsDataProvider class over several vrs files sharing a timeline,
+ * such as the raw, synthetic and ground truth recordings of a sequence. The files are opened once,
+ * by a single reader that merges their streams into one time index; calibration and time sync are
+ * loaded once, from the tags and streams of the merged files. Throws if the files were recorded by
+ * different Aria devices.
+ * @param vrsFilenames Paths of the vrs files to read from. A path may use `*` wildcards in its file
+ * name, which expand to the sorted matching files of its directory. Chunked recordings are opened
+ * from their first chunk, so the continuation chunks `<file>_1`, `<file>_2`... of a listed file are
+ * ignored.
+ * @param options Options to create the provider with.
+ */
+std::shared_ptr<VrsDataProvider> createVrsDataProvider(
+    const std::vector<std::string>& vrsFilenames,
+    const VrsDataProviderOpenOptions& options = {});
 
 /**
  * @brief Given a vrs file that contains data collected from Aria devices, createVrsDataProvider
@@ -90,11 +141,21 @@ class VrsDataProvider {
    */
   bool checkStreamIsType(const vrs::StreamId& streamId, SensorDataType type) const;
 
+  /**
+   * @brief Get the time spent in each phase of creating this provider.
+   */
+  VrsDataProviderOpenTimings getOpenTimings() const;
+
   /**
    * @brief Get calibration of the device.
    * @return The Optional DeviceCalibration, that contains calibration of all sensors.
    */
   std::optional<calibration::DeviceCalibration> getDeviceCalibration() const;
+  /**
+   * @brief Get calibration of the device without copying it, e.g. to access it per frame.
+   * @return The Optional DeviceCalibration, valid for the lifetime of this provider.
+   */
+  const std::optional<calibration::DeviceCalibration>& getDeviceCalibrationRef() const;
   /**
    * @brief Get calibration of a sensor from the device
    * @param streamId The ID of a sensor's stream.
@@ -102,6 +163,17 @@ class VrsDataProvider {
    */
   std::optional<calibration::SensorCalibration> getSensorCalibration(
       const vrs::StreamId& streamId) const;
+  /**
+   * @brief Get calibration of a camera matching its images decoded with given options, i.e.
+   * rescaled to the decode scale and cropped to the decoded region. The calibration of a camera
+   * whose images are not JPEG is returned unchanged, as the options do not apply to them.
+   * @param streamId The ID of a camera's stream.
+   * @param decodeOptions Options the images are decoded with.
+   * @return The optional calibration of the camera.
+   */
+  std::optional<calibration::CameraCalibration> getDecodedCameraCalibration(
+      const vrs::StreamId& streamId,
+      const image::JpegDecodeOptions& decodeOptions) const;
 
   /**
    * @brief Get configuration of a specific stream.
@@ -132,6 +204,17 @@ class VrsDataProvider {
    */
   SensorDataSequence deliverQueuedSensorData(DeliverQueuedOptions options);
 
+  /**
+   * @brief Delivers the frames of several image streams grouped by capture time, e.g. the RGB and
+   * SLAM frames of a stereo or multi-view sample. The frames are matched in one pass over the
+   * timestamps of the streams, and the frames of each set are decoded concurrently.
+   * @param options Streams of the sets, and tolerance and time domain their frames are matched
+   * with.
+   * @return FrameSetSequence object that contains .begin() .end() iterator that iterate through
+   * the frame sets in time order.
+   */
+  FrameSetSequence deliverFrameSets(const FrameSetOptions& options);
+
   //////////////////////Pybind11 utilities//////////////////////
   /**
    * @brief Create iterator pair as a private variable for pybind11.
@@ -183,6 +266,17 @@ class VrsDataProvider {
    */
   SensorData getSensorDataByIndex(const vrs::StreamId& streamId, const int index);
 
+  /**
+   * @brief Return the N-th data of a stream without reading image and audio content blocks. Image
+   * data is returned with its ImageDataRecord and an empty frame, audio data with its
+   * AudioDataRecord and no samples; other sensor data are returned in full.
+   * @param streamId StreamId of the sensor stream.
+   * @param index Index in range of 0 - getNumData(streamId).
+   * @return SensorData. If no data is available, SensorData.sensorDataType() will be
+   * SensorDataType::NotValid.
+   */
+  SensorData getSensorDataMetadataByIndex(const vrs::StreamId& streamId, const int index);
+
   /**
    * @brief Check if a stream contains timestamp of a specific time domain specifically, Audio,
    * Barometer, and GPS data does not have host timestamps. if the vrs does not contain a timesync
@@ -342,8 +436,59 @@ class VrsDataProvider {
   BluetoothBeaconConfigRecord getBluetoothConfiguration(const vrs::StreamId& streamId) const;
   MotionConfigRecord getMagnetometerConfiguration(const vrs::StreamId& streamId) const;
 
+  /**
+   * @brief Sets the scale and region at which JPEG images of a stream are decoded on read, e.g. 1/4
+   * of the full resolution for thumbnail-scale consumers. Applies to all reads of the stream,
+   * including deliverQueuedSensorData(); non-JPEG images are not affected.
+   * @param streamId The ID of a camera's stream.
+   * @param decodeOptions Options to decode images with, scaleDenominator in {1, 2, 4, 8}. A region
+   * of interest is clipped to the image, and must not be empty nor entirely outside of it.
+   */
+  void setImageDecodeOptions(
+      const vrs::StreamId& streamId,
+      const image::JpegDecodeOptions& decodeOptions);
+  /**
+   * @brief Returns the options JPEG images of a stream are decoded with.
+   */
+  image::JpegDecodeOptions getImageDecodeOptions(const vrs::StreamId& streamId) const;
+
+  /**
+   * @brief Enables a cache of decoded images for getImageDataByIndex() and
+   * getImageDataByTimeNs(), keyed by stream, index and decode options, so that going back and
+   * forth over the same frames does not read and decode them again. Cached frames are shared with
+   * the callers and must not be modified.
+   * @param maxBytes memory budget of the cache, least recently used frames are evicted first. 0
+   * disables the cache.
+   */
+  void setImageCacheBudget(size_t maxBytes);
+  /**
+   * @brief Returns the hit, miss and eviction counters and the memory use of the decoded image
+   * cache, nullopt if the cache is disabled.
+   */
+  std::optional<ImageFrameCache::Stats> getImageCacheStats() const;
+
+  /**
+   * @brief Sets the pattern in which data will be read, so that the records about to be read are
+   * loaded ahead from the files, e.g. Sequential for deliverQueuedSensorData() or Strided to read
+   * every N-th frame of a stream. The default, Random, reads no record ahead.
+   * @param pattern Access pattern of the next reads.
+   * @param readAheadBytes Amount of data of each stream to read ahead of its last read.
+   */
+  void setAccessPattern(
+      AccessPattern pattern,
+      size_t readAheadBytes = RecordReadAhead::kDefaultReadAheadBytes);
+  /**
+   * @brief Returns the access pattern the records are read ahead for.
+   */
+  AccessPattern getAccessPattern() const;
+
   // retrieve by index for specific modalities
   ImageDataAndRecord getImageDataByIndex(const vrs::StreamId& streamId, const int index);
+  // decode a JPEG image with options for this read only, see setImageDecodeOptions()
+  ImageDataAndRecord getImageDataByIndex(
+      const vrs::StreamId& streamId,
+      const int index,
+      const image::JpegDecodeOptions& decodeOptions);
   MotionData getImuDataByIndex(const vrs::StreamId& streamId, const int index);
   GpsData getGpsDataByIndex(const vrs::StreamId& streamId, const int index);
   WifiBeaconData getWpsDataByIndex(const vrs::StreamId& streamId, const int index);
@@ -358,6 +503,13 @@ class VrsDataProvider {
       const int64_t timeNs,
       const TimeDomain& timeDomain = TimeDomain::DeviceTime,
       const TimeQueryOptions& timeQueryOptions = TimeQueryOptions::Before);
+  // decode a JPEG image with options for this read only, see setImageDecodeOptions()
+  ImageDataAndRecord getImageDataByTimeNs(
+      const vrs::StreamId& streamId,
+      const int64_t timeNs,
+      const TimeDomain& timeDomain,
+      const TimeQueryOptions& timeQueryOptions,
+      const image::JpegDecodeOptions& decodeOptions);
   MotionData getImuDataByTimeNs(
       const vrs::StreamId& streamId,
       const int64_t timeNs,
@@ -401,6 +553,16 @@ class VrsDataProvider {
       const std::shared_ptr<StreamIdLabelMapper>& streamIdLabelMapper,
       const std::optional<calibration::DeviceCalibration>& maybeDeviceCalib);
 
+  // deviceCalibLoader: called once, on the first access to the calibration
+  VrsDataProvider(
+      const std::shared_ptr<RecordReaderInterface>& interface,
+      const std::shared_ptr<StreamIdConfigurationMapper>& configMap,
+      const std::shared_ptr<TimestampIndexMapper>& timeQuery,
+      const std::shared_ptr<TimeSyncMapper>& timeSyncMapper,
+      const std::shared_ptr<StreamIdLabelMapper>& streamIdLabelMapper,
+      std::function<std::optional<calibration::DeviceCalibration>()> deviceCalibLoader,
+      const VrsDataProviderOpenTimings& openTimings = {});
+
   virtual ~VrsDataProvider() = default; // Add a virtual destructor
 
  private:
@@ -408,6 +570,17 @@ class VrsDataProvider {
   void assertStreamIsActive(const vrs::StreamId& streamId) const;
   // assert of a streamId is not of an expected type
   void assertStreamIsType(const vrs::StreamId& streamId, SensorDataType type) const;
+  // assert if decode options can not be applied to the images of a stream
+  void checkImageDecodeOptions(
+      const vrs::StreamId& streamId,
+      const image::JpegDecodeOptions& decodeOptions) const;
+  // the current image cache, null if disabled
+  std::shared_ptr<ImageFrameCache> getImageCache() const;
+  // read an image decoded with the given options, through the image cache if enabled
+  ImageDataAndRecord readImageData(
+      const vrs::StreamId& streamId,
+      const int index,
+      const image::JpegDecodeOptions& decodeOptions);
 
  private:
   const std::shared_ptr<RecordReaderInterface> interface_;
@@ -415,7 +588,12 @@ class VrsDataProvider {
   const std::shared_ptr<TimestampIndexMapper> timeQuery_;
   const std::shared_ptr<TimeSyncMapper> timeSyncMapper_;
   const std::shared_ptr<StreamIdLabelMapper> streamIdLabelMapper_;
-  std::optional<calibration::DeviceCalibration> maybeDeviceCalib_;
+  std::function<std::optional<calibration::DeviceCalibration>()> deviceCalibLoader_;
+  mutable std::once_flag deviceCalibOnceFlag_;
+  mutable std::optional<calibration::DeviceCalibration> maybeDeviceCalib_;
+  VrsDataProviderOpenTimings openTimings_;
+  mutable std::mutex imageCacheMutex_; // guards the imageCache_ pointer, not the cache
+  std::shared_ptr<ImageFrameCache> imageCache_; // null if disabled
 
   // pybind11 requires variable to attach to VrsDataProvider class
   // in order to keep the iterator alive
@@ -17,6 +17,10 @@
 #include <data_provider/ErrorHandler.h>
 #include <data_provider/VrsDataProvider.h>
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
 #include <map>
 #include <set>
 #include "vrs/StreamId.h"
@@ -24,13 +28,18 @@
 #include <calibration/loader/AriaCalibRescaleAndCrop.h>
 #include <calibration/loader/DeviceCalibrationJson.h>
 
+#include <fmt/ranges.h>
 #include <vrs/MultiRecordFileReader.h>
+#include <vrs/RecordFileReader.h>
 
 #define DEFAULT_LOG_CHANNEL "VrsDataProvider"
 #include <logging/Log.h>
 
 namespace projectaria::tools::data_provider {
 namespace {
+// device type in the stream configurations of Aria recordings
+constexpr const char* kAriaDeviceType = "Aria";
+
 SensorDataType getSensorDataType(const vrs::RecordableTypeId& id) {
   static const std::map<vrs::RecordableTypeId, SensorDataType> sensorTypeMap = {
       // Image
@@ -71,26 +80,133 @@ SensorDataType getSensorDataType(const vrs::RecordableTypeId& id) {
   }
 }
 
+int64_t getElapsedNs(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Matches a file name against a pattern, where `*` matches any sequence of characters
+bool matchesFilePattern(const std::string& name, const std::string& pattern) {
+  size_t nameIndex = 0;
+  size_t patternIndex = 0;
+  size_t starIndex = std::string::npos;
+  size_t starNameIndex = 0;
+  while (nameIndex < name.size()) {
+    if (patternIndex < pattern.size() && pattern[patternIndex] == '*') {
+      starIndex = patternIndex++;
+      starNameIndex = nameIndex;
+    } else if (patternIndex < pattern.size() && pattern[patternIndex] == name[nameIndex]) {
+      ++patternIndex;
+      ++nameIndex;
+    } else if (starIndex != std::string::npos) {
+      patternIndex = starIndex + 1;
+      nameIndex = ++starNameIndex;
+    } else {
+      return false;
+    }
+  }
+  while (patternIndex < pattern.size() && pattern[patternIndex] == '*') {
+    ++patternIndex;
+  }
+  return patternIndex == pattern.size();
+}
+
+// Returns the path of the file a continuation chunk `<file>_<n>` belongs to, if it is one
+std::optional<std::string> getFirstChunkPath(const std::string& path) {
+  const size_t separator = path.rfind('_');
+  if (separator == std::string::npos || separator + 1 == path.size()) {
+    return std::nullopt;
+  }
+  for (size_t i = separator + 1; i < path.size(); ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(path[i]))) {
+      return std::nullopt;
+    }
+  }
+  return path.substr(0, separator);
+}
+
+// Expands the `*` wildcards in file names, and drops the continuation chunks of listed files,
+// which vrs opens along with their first chunk
+std::vector<std::string> expandVrsFilePatterns(const std::vector<std::string>& patterns) {
+  namespace fs = std::filesystem;
+  std::vector<std::string> paths;
+  for (const auto& pattern : patterns) {
+    const fs::path patternPath(pattern);
+    const std::string filePattern = patternPath.filename().string();
+    if (filePattern.find('*') == std::string::npos) {
+      paths.push_back(pattern);
+      continue;
+    }
+    const fs::path directory =
+        patternPath.has_parent_path() ? patternPath.parent_path() : fs::path(".");
+    std::error_code error;
+    std::vector<std::string> matches;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+      if (entry.is_regular_file() &&
+          matchesFilePattern(entry.path().filename().string(), filePattern)) {
+        matches.push_back(entry.path().string());
+      }
+    }
+    std::sort(matches.begin(), matches.end());
+    paths.insert(paths.end(), matches.begin(), matches.end());
+  }
+
+  const std::set<std::string> listedPaths(paths.begin(), paths.end());
+  std::set<std::string> addedPaths;
+  std::vector<std::string> filePaths;
+  for (const auto& path : paths) {
+    const auto firstChunkPath = getFirstChunkPath(path);
+    if (firstChunkPath && listedPaths.count(firstChunkPath.value())) {
+      continue;
+    }
+    if (addedPaths.insert(path).second) {
+      filePaths.push_back(path);
+    }
+  }
+  return filePaths;
+}
+
 class VrsDataProviderFactory {
  public:
-  explicit VrsDataProviderFactory(std::shared_ptr<vrs::MultiRecordFileReader> reader);
+  // filePaths: the files opened by the reader, to read their records ahead
+  VrsDataProviderFactory(
+      std::shared_ptr<vrs::MultiRecordFileReader> reader,
+      std::vector<std::string> filePaths,
+      const VrsDataProviderOpenOptions& options = {},
+      const VrsDataProviderOpenTimings& openTimings = {});
 
   std::shared_ptr<VrsDataProvider> createProvider();
 
  private:
   // load streams
   void addPlayers();
-  // load calibration by reader_.get_tag
+  // throw if the streams were recorded by different Aria devices, whose files share neither a
+  // calibration nor a timeline. Streams derived from a recording, e.g. ground truth or simulated
+  // images, name other device types and are not checked
+  void checkSameDevice() const;
+  // load calibration by reader_.get_tag, now or on first use
   void loadCalibration();
   // establish stream id <=> label mapping to associate streams with calibration
   void loadStreamIdLabelMapper();
-  // change intrinsics based on camera configs
-  void checkCalibrationConfigConsistency();
+  // parse calibration and change intrinsics based on camera configs
+  static std::optional<calibration::DeviceCalibration> parseCalibration(
+      const std::string& calibJsonStr,
+      const std::shared_ptr<StreamIdLabelMapper>& streamIdLabelMapper,
+      const std::map<vrs::StreamId, std::shared_ptr<ImageSensorPlayer>>& imagePlayers);
+  static void checkCalibrationConfigConsistency(
+      calibration::DeviceCalibration& deviceCalib,
+      const std::shared_ptr<StreamIdLabelMapper>& streamIdLabelMapper,
+      const std::map<vrs::StreamId, std::shared_ptr<ImageSensorPlayer>>& imagePlayers);
   // add the stream player that contains time code data
   void tryAddTimeSyncPlayer(const vrs::StreamId& streamId);
 
  private:
   std::shared_ptr<vrs::MultiRecordFileReader> reader_;
+  std::vector<std::string> filePaths_;
+  VrsDataProviderOpenOptions options_;
+  VrsDataProviderOpenTimings openTimings_;
+  std::chrono::steady_clock::time_point startTime_;
 
   std::map<vrs::StreamId, std::shared_ptr<ImageSensorPlayer>> imagePlayers_;
   std::map<vrs::StreamId, std::shared_ptr<MotionSensorPlayer>> motionPlayers_;
@@ -103,15 +219,29 @@ class VrsDataProviderFactory {
   std::map<TimeSyncMode, std::shared_ptr<TimeSyncPlayer>> timesyncPlayers_;
 
   std::shared_ptr<StreamIdLabelMapper> streamIdLabelMapper_;
-  std::optional<calibration::DeviceCalibration> maybeDeviceCalib_;
+  std::function<std::optional<calibration::DeviceCalibration>()> deviceCalibLoader_;
 };
 
-VrsDataProviderFactory::VrsDataProviderFactory(std::shared_ptr<vrs::MultiRecordFileReader> reader)
-    : reader_(reader) {
+// openTimings: timings of the phases run before the factory, i.e. opening the files
+VrsDataProviderFactory::VrsDataProviderFactory(
+    std::shared_ptr<vrs::MultiRecordFileReader> reader,
+    std::vector<std::string> filePaths,
+    const VrsDataProviderOpenOptions& options,
+    const VrsDataProviderOpenTimings& openTimings)
+    : reader_(reader),
+      filePaths_(std::move(filePaths)),
+      options_(options),
+      openTimings_(openTimings),
+      startTime_(std::chrono::steady_clock::now()) {
+  openTimings_.lazyInitialization = options_.lazyInitialization;
   loadStreamIdLabelMapper();
+  auto phaseStart = std::chrono::steady_clock::now();
   addPlayers();
+  if (filePaths_.size() > 1) {
+    checkSameDevice();
+  }
+  openTimings_.readConfigurationsNs = getElapsedNs(phaseStart);
   loadCalibration();
-  checkCalibrationConfigConsistency();
 }
 
 void VrsDataProviderFactory::addPlayers() {
@@ -196,35 +326,83 @@ void VrsDataProviderFactory::addPlayers() {
   checkAndThrow(reader_->readFirstConfigurationRecords(), "Fail to read all configuration records");
 }
 
+void VrsDataProviderFactory::checkSameDevice() const {
+  std::map<std::string, vrs::StreamId> deviceSerialToStreamId;
+  auto addDevice = [&](const vrs::StreamId& streamId, const auto& config) {
+    if (config.deviceType == kAriaDeviceType && !config.deviceSerial.empty()) {
+      deviceSerialToStreamId.emplace(config.deviceSerial, streamId);
+    }
+  };
+  for (const auto& [streamId, player] : imagePlayers_) {
+    addDevice(streamId, player->getConfigRecord());
+  }
+  for (const auto& [streamId, player] : motionPlayers_) {
+    addDevice(streamId, player->getConfigRecord());
+  }
+  std::vector<std::string> devices;
+  for (const auto& [deviceSerial, streamId] : deviceSerialToStreamId) {
+    devices.push_back(fmt::format("{} (stream {})", deviceSerial, streamId.getNumericName()));
+  }
+  checkAndThrow(
+      devices.size() <= 1,
+      fmt::format(
+          "The files {} were recorded by different Aria devices: {}",
+          fmt::join(filePaths_, ", "),
+          fmt::join(devices, ", ")));
+}
+
 void VrsDataProviderFactory::loadCalibration() {
-  const std::string calibJsonStr = reader_->getTag("calib_json");
+  std::string calibJsonStr = reader_->getTag("calib_json");
   if (calibJsonStr.empty()) {
     XR_LOGW("VRS file does not contain calib_json field in VRS tags.");
+    deviceCalibLoader_ = [] { return std::optional<calibration::DeviceCalibration>(); };
     return;
   }
-  maybeDeviceCalib_ = calibration::deviceCalibrationFromJson(calibJsonStr);
+  if (options_.lazyInitialization) {
+    deviceCalibLoader_ = [calibJsonStr = std::move(calibJsonStr),
+                          streamIdLabelMapper = streamIdLabelMapper_,
+                          imagePlayers = imagePlayers_]() {
+      return parseCalibration(calibJsonStr, streamIdLabelMapper, imagePlayers);
+    };
+    return;
+  }
+  auto phaseStart = std::chrono::steady_clock::now();
+  auto maybeDeviceCalib = parseCalibration(calibJsonStr, streamIdLabelMapper_, imagePlayers_);
+  openTimings_.loadCalibrationNs = getElapsedNs(phaseStart);
+  deviceCalibLoader_ = [maybeDeviceCalib = std::move(maybeDeviceCalib)]() {
+    return maybeDeviceCalib;
+  };
+}
+
+std::optional<calibration::DeviceCalibration> VrsDataProviderFactory::parseCalibration(
+    const std::string& calibJsonStr,
+    const std::shared_ptr<StreamIdLabelMapper>& streamIdLabelMapper,
+    const std::map<vrs::StreamId, std::shared_ptr<ImageSensorPlayer>>& imagePlayers) {
+  auto maybeDeviceCalib = calibration::deviceCalibrationFromJson(calibJsonStr);
   checkAndThrow(
-      maybeDeviceCalib_.has_value(),
+      maybeDeviceCalib.has_value(),
       fmt::format("Cannot parse calib json string.\n{}", calibJsonStr));
+  checkCalibrationConfigConsistency(maybeDeviceCalib.value(), streamIdLabelMapper, imagePlayers);
+  return maybeDeviceCalib;
 }
 
 void VrsDataProviderFactory::loadStreamIdLabelMapper() {
   streamIdLabelMapper_ = getAriaStreamIdLabelMapper();
 }
 
-void VrsDataProviderFactory::checkCalibrationConfigConsistency() {
-  if (!maybeDeviceCalib_) { // no op if calibration doesn't exist
-    return;
-  }
-  if (maybeDeviceCalib_->getDeviceSubtype() == "SimulatedDevice") { // skip SimulatedDevice type
+void VrsDataProviderFactory::checkCalibrationConfigConsistency(
+    calibration::DeviceCalibration& deviceCalib,
+    const std::shared_ptr<StreamIdLabelMapper>& streamIdLabelMapper,
+    const std::map<vrs::StreamId, std::shared_ptr<ImageSensorPlayer>>& imagePlayers) {
+  if (deviceCalib.getDeviceSubtype() == "SimulatedDevice") { // skip SimulatedDevice type
     return;
   }
 
   std::map<std::string, Eigen::Vector2i> labelToCameraResolution;
-  for (const auto& label : maybeDeviceCalib_->getCameraLabels()) {
+  for (const auto& label : deviceCalib.getCameraLabels()) {
     bool isAriaEt = (label.rfind("camera-et", 0) == 0);
-    const auto maybeStreamId = isAriaEt ? streamIdLabelMapper_->getStreamIdFromLabel("camera-et")
-                                        : streamIdLabelMapper_->getStreamIdFromLabel(label);
+    const auto maybeStreamId = isAriaEt ? streamIdLabelMapper->getStreamIdFromLabel("camera-et")
+                                        : streamIdLabelMapper->getStreamIdFromLabel(label);
     checkAndThrow(
         maybeStreamId.has_value(),
         fmt::format(
@@ -232,8 +410,8 @@ void VrsDataProviderFactory::checkCalibrationConfigConsistency() {
             label));
     vrs::StreamId streamId = maybeStreamId.value();
 
-    auto it = imagePlayers_.find(streamId);
-    if (it == imagePlayers_.end()) {
+    auto it = imagePlayers.find(streamId);
+    if (it == imagePlayers.end()) {
       // Note: some labels maybe present in calibration but not in player
       continue;
     }
@@ -244,12 +422,12 @@ void VrsDataProviderFactory::checkCalibrationConfigConsistency() {
 
     Eigen::Vector2i resolution(configWidth, configHeight);
 
-    auto camCalib = maybeDeviceCalib_->getCameraCalib(label);
+    auto camCalib = deviceCalib.getCameraCalib(label);
     if (camCalib->getImageSize() != resolution) {
       labelToCameraResolution.emplace(label, resolution);
     }
   }
-  calibration::tryCropAndScaleCameraCalibration(maybeDeviceCalib_.value(), labelToCameraResolution);
+  calibration::tryCropAndScaleCameraCalibration(deviceCalib, labelToCameraResolution);
 }
 
 void VrsDataProviderFactory::tryAddTimeSyncPlayer(const vrs::StreamId& streamId) {
@@ -281,7 +459,12 @@ std::shared_ptr<VrsDataProvider> VrsDataProviderFactory::createProvider() {
   }
   checkAndThrow(hasStreamPlayer, "No stream activated, cannot create provider");
 
-  auto timeSyncMapper = std::make_shared<TimeSyncMapper>(reader_, timesyncPlayers_);
+  // the time sync mapper may read its records lazily, while the interface reads other records
+  auto readerMutex = std::make_shared<std::mutex>();
+  auto phaseStart = std::chrono::steady_clock::now();
+  auto timeSyncMapper = std::make_shared<TimeSyncMapper>(
+      reader_, timesyncPlayers_, readerMutex, options_.lazyInitialization);
+  openTimings_.loadTimeSyncNs = getElapsedNs(phaseStart);
 
   auto interface = std::make_shared<RecordReaderInterface>(
       reader_,
@@ -293,7 +476,9 @@ std::shared_ptr<VrsDataProvider> VrsDataProviderFactory::createProvider() {
       barometerPlayers_,
       bluetoothPlayers_,
       magnetometerPlayers_,
-      timeSyncMapper);
+      timeSyncMapper,
+      readerMutex,
+      std::make_shared<RecordReadAhead>(filePaths_));
 
   auto configMap = std::make_shared<StreamIdConfigurationMapper>(
       reader_,
@@ -306,18 +491,67 @@ std::shared_ptr<VrsDataProvider> VrsDataProviderFactory::createProvider() {
       bluetoothPlayers_,
       magnetometerPlayers_);
 
+  phaseStart = std::chrono::steady_clock::now();
+  auto timeQuery = std::make_shared<TimestampIndexMapper>(interface, options_.lazyInitialization);
+  openTimings_.buildTimeIndexNs = getElapsedNs(phaseStart);
+
+  openTimings_.totalNs += getElapsedNs(startTime_);
   return std::make_shared<VrsDataProvider>(
-      interface, configMap, timeSyncMapper, streamIdLabelMapper_, maybeDeviceCalib_);
+      interface,
+      configMap,
+      timeQuery,
+      timeSyncMapper,
+      streamIdLabelMapper_,
+      deviceCalibLoader_,
+      openTimings_);
 }
 } // namespace
 
-std::shared_ptr<VrsDataProvider> createVrsDataProvider(const std::string& vrsFilename) {
+std::shared_ptr<VrsDataProvider> createVrsDataProvider(
+    const std::string& vrsFilename,
+    const VrsDataProviderOpenOptions& options) {
+  VrsDataProviderOpenTimings openTimings;
+  auto phaseStart = std::chrono::steady_clock::now();
   auto reader = std::make_shared<vrs::MultiRecordFileReader>();
   if (reader->open({vrsFilename})) {
     XR_LOGE("Cannot open vrsFile {}.", vrsFilename);
     return {};
   }
-  VrsDataProviderFactory factory(reader);
+  openTimings.openFilesNs = getElapsedNs(phaseStart);
+  openTimings.totalNs = openTimings.openFilesNs;
+  VrsDataProviderFactory factory(reader, {vrsFilename}, options, openTimings);
+  return factory.createProvider();
+}
+
+std::shared_ptr<VrsDataProvider> createVrsDataProvider(
+    const std::vector<std::string>& vrsFilenames,
+    const VrsDataProviderOpenOptions& options) {
+  VrsDataProviderOpenTimings openTimings;
+  auto phaseStart = std::chrono::steady_clock::now();
+  const std::vector<std::string> paths = expandVrsFilePatterns(vrsFilenames);
+  if (paths.empty()) {
+    XR_LOGE("No vrs file matches {}.", fmt::join(vrsFilenames, ", "));
+    return {};
+  }
+
+  // The merged reader opens every file once. When it fails, the files are opened on their own to
+  // name the one at fault
+  auto reader = std::make_shared<vrs::MultiRecordFileReader>();
+  if (reader->open(paths)) {
+    for (const auto& path : paths) {
+      vrs::RecordFileReader fileReader;
+      const int status = fileReader.openFile(path);
+      if (status != 0) {
+        XR_LOGE("Cannot open vrsFile {}: {}.", path, vrs::errorCodeToMessage(status));
+        return {};
+      }
+    }
+    XR_LOGE("Cannot open vrsFiles {} as one recording.", fmt::join(paths, ", "));
+    return {};
+  }
+  openTimings.openFilesNs = getElapsedNs(phaseStart);
+  openTimings.totalNs = openTimings.openFilesNs;
+  VrsDataProviderFactory factory(reader, paths, options, openTimings);
   return factory.createProvider();
 }
 
@@ -19,6 +19,7 @@
 
 #include "AudioPlayer.h"
 
+#include <trace/Trace.h>
 #include <vrs/ErrorCode.h>
 #include <vrs/RecordFileReader.h>
 
@@ -39,14 +40,19 @@ bool AudioPlayer::onDataLayoutRead(
     data.captureTimestampsNs.get(dataRecord_.captureTimestampsNs);
     dataRecord_.audioMuted = data.audioMuted.get();
     nextTimestampSec_ = std::nextafter(r.timestamp, std::numeric_limits<double>::max());
+    if (!readContent_) {
+      // metadata only: do not leave the samples of a previous record behind
+      data_.data.clear();
+    }
   }
-  return true;
+  return readContent_;
 }
 
 bool AudioPlayer::onAudioRead(
     const vrs::CurrentRecord& r,
     size_t /* idx */,
     const vrs::ContentBlock& cb) {
+  PROJECTARIA_TRACE_SCOPE("AudioPlayer::onAudioRead");
   auto& audioSpec = cb.audio();
   assert(audioSpec.getSampleFormat() == vrs::AudioSampleFormat::S32_LE);
   data_.data.clear();
@@ -98,6 +98,10 @@ class AudioPlayer : public vrs::RecordFormatStreamPlayer {
     verbose_ = verbose;
   }
 
+  void setReadContent(bool readContent) {
+    readContent_ = readContent;
+  }
+
  private:
   bool onDataLayoutRead(const vrs::CurrentRecord& r, size_t blockIndex, vrs::DataLayout& dl)
       override;
@@ -114,6 +118,7 @@ class AudioPlayer : public vrs::RecordFormatStreamPlayer {
 
   double nextTimestampSec_ = 0;
   bool verbose_ = false;
+  bool readContent_ = true;
 };
 
 } // namespace projectaria::tools::data_provider
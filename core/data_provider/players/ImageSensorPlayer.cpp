@@ -19,11 +19,13 @@
 
 #include "ImageSensorPlayer.h"
 
+#include <trace/Trace.h>
 #include <vrs/MultiRecordFileReader.h>
 #include <vrs/RecordFormat.h>
 
 namespace projectaria::tools::data_provider {
 std::optional<projectaria::tools::image::ImageVariant> ImageData::imageVariant() const {
+  PROJECTARIA_TRACE_SCOPE("ImageData::imageVariant");
   if (pixelFrame->getSpec().getImageFormat() == vrs::ImageFormat::JPG) {
     std::shared_ptr<vrs::utils::PixelFrame> normalizedFrame;
     pixelFrame->normalizeFrame(normalizedFrame, true);
@@ -92,6 +94,10 @@ bool ImageSensorPlayer::onDataLayoutRead(
     dataRecord_.captureTimestampNs = data.captureTimestampNs.get();
     dataRecord_.arrivalTimestampNs = data.arrivalTimestampNs.get();
     nextTimestampSec_ = std::nextafter(r.timestamp, std::numeric_limits<double>::max());
+    if (!readContent_) {
+      // metadata only: deliver an empty frame rather than the pixels of a previous record
+      data_.pixelFrame.reset();
+    }
   }
   return readContent_;
 }
@@ -100,12 +106,22 @@ bool ImageSensorPlayer::onImageRead(
     const vrs::CurrentRecord& r,
     size_t /*idx*/,
     const vrs::ContentBlock& cb) {
+  PROJECTARIA_TRACE_SCOPE("ImageSensorPlayer::onImageRead");
   // the image data was not read yet: allocate your own buffer & read!
   auto& imageSpec = cb.image();
   size_t blockSize = cb.getBlockSize();
   // Synchronously read the image data
-  if (vrs::utils::PixelFrame::readFrame(data_.pixelFrame, r.reader, cb)) {
-    callback_(data_, dataRecord_, configRecord_, verbose_);
+  if (decodeOptions_.isFullImage() || imageSpec.getImageFormat() != vrs::ImageFormat::JPG) {
+    if (vrs::utils::PixelFrame::readFrame(data_.pixelFrame, r.reader, cb)) {
+      callback_(data_, dataRecord_, configRecord_, verbose_);
+    }
+  } else if (vrs::utils::PixelFrame::readFrame(compressedFrame_, r.reader, cb)) {
+    // decode right away at the requested scale and region, skipping the unused DCT coefficients
+    data_.pixelFrame =
+        image::decodeJpeg(compressedFrame_->rdata(), compressedFrame_->size(), decodeOptions_);
+    if (data_.pixelFrame) {
+      callback_(data_, dataRecord_, configRecord_, verbose_);
+    }
   }
 
   if (verbose_) {
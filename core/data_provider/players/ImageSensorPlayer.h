@@ -19,6 +19,7 @@
 #include <data_layout/ImageSensorMetadata.h>
 #include <image/FromPixelFrame.h>
 #include <image/ImageVariant.h>
+#include <image/utility/JpegDecode.h>
 #include <vrs/RecordFormatStreamPlayer.h>
 
 namespace projectaria::tools::data_provider {
@@ -135,6 +136,18 @@ class ImageSensorPlayer : public vrs::RecordFormatStreamPlayer {
     readContent_ = readContent;
   }
 
+  /**
+   * @brief Sets the scale and region at which JPEG images are decoded on read. With the default
+   * options, JPEG images are kept compressed until ImageData::imageVariant() is called.
+   */
+  void setDecodeOptions(const image::JpegDecodeOptions& decodeOptions) {
+    decodeOptions_ = decodeOptions;
+  }
+
+  const image::JpegDecodeOptions& getDecodeOptions() const {
+    return decodeOptions_;
+  }
+
  private:
   bool onDataLayoutRead(const vrs::CurrentRecord& r, size_t blockIndex, vrs::DataLayout& dl)
       override;
@@ -152,6 +165,8 @@ class ImageSensorPlayer : public vrs::RecordFormatStreamPlayer {
   double nextTimestampSec_ = 0;
   bool verbose_ = false;
   bool readContent_ = true;
+  image::JpegDecodeOptions decodeOptions_;
+  std::shared_ptr<vrs::utils::PixelFrame> compressedFrame_; // reused for scaled JPEG decoding
 };
 
 } // namespace projectaria::tools::data_provider
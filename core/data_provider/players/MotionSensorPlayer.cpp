@@ -18,6 +18,7 @@
 
 #include "MotionSensorPlayer.h"
 
+#include <trace/Trace.h>
 #include <vrs/ErrorCode.h>
 
 namespace projectaria::tools::data_provider {
@@ -26,6 +27,7 @@ bool MotionSensorPlayer::onDataLayoutRead(
     const vrs::CurrentRecord& r,
     size_t blockIndex,
     vrs::DataLayout& dl) {
+  PROJECTARIA_TRACE_SCOPE("MotionSensorPlayer::onDataLayoutRead");
   if (r.recordType == vrs::Record::Type::CONFIGURATION) {
     auto& config = getExpectedLayout<datalayout::MotionSensorConfigRecordMetadata>(dl, blockIndex);
     configRecord_.streamIndex = config.streamIndex.get();
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <data_provider/ImageFrameCache.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace projectaria::tools::data_provider;
+
+namespace {
+constexpr uint32_t kWidth = 64;
+constexpr uint32_t kHeight = 32;
+const vrs::StreamId kStreamId{vrs::RecordableTypeId::SlamCameraData, 1};
+
+ImageDataAndRecord makeFrame(int index) {
+  ImageDataAndRecord data;
+  data.first.pixelFrame =
+      std::make_shared<vrs::utils::PixelFrame>(vrs::PixelFormat::GREY8, kWidth, kHeight);
+  std::fill(
+      data.first.pixelFrame->wdata(),
+      data.first.pixelFrame->wdata() + data.first.pixelFrame->size(),
+      static_cast<uint8_t>(index));
+  data.second.frameNumber = index;
+  return data;
+}
+
+ImageFrameCache::Key makeKey(int index) {
+  return ImageFrameCache::Key{kStreamId, index, {}};
+}
+
+// budget to hold numFrames frames
+size_t getBudget(size_t numFrames) {
+  ImageFrameCache cache(1 << 20);
+  cache.insert(makeKey(0), makeFrame(0));
+  return numFrames * cache.getStats().numBytes;
+}
+} // namespace
+
+TEST(ImageFrameCache, LeastRecentlyUsedEviction) {
+  ImageFrameCache cache(getBudget(3));
+  for (int index = 0; index < 3; ++index) {
+    cache.insert(makeKey(index), makeFrame(index));
+  }
+  EXPECT_TRUE(cache.get(makeKey(0))); // frame 1 becomes the least recently used
+  cache.insert(makeKey(3), makeFrame(3));
+
+  EXPECT_FALSE(cache.get(makeKey(1)));
+  for (int index : {0, 2, 3}) {
+    const auto data = cache.get(makeKey(index));
+    ASSERT_TRUE(data);
+    EXPECT_EQ(data->second.frameNumber, static_cast<uint64_t>(index));
+    EXPECT_EQ(data->first.pixelFrame->rdata()[0], index);
+  }
+
+  const ImageFrameCache::Stats stats = cache.getStats();
+  EXPECT_EQ(stats.hits, 4u);
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.numFrames, 3u);
+  EXPECT_LE(stats.numBytes, stats.maxBytes);
+
+  cache.setMaxBytes(getBudget(1));
+  EXPECT_EQ(cache.getStats().numFrames, 1u);
+  EXPECT_TRUE(cache.get(makeKey(3)));
+}
+
+TEST(ImageFrameCache, DecodeOptionsArePartOfTheKey) {
+  ImageFrameCache cache(getBudget(4));
+  cache.insert(makeKey(0), makeFrame(0));
+  ImageFrameCache::Key scaledKey = makeKey(0);
+  scaledKey.decodeOptions.scaleDenominator = 2;
+  EXPECT_FALSE(cache.get(scaledKey));
+  scaledKey.decodeOptions.scaleDenominator = 1;
+  scaledKey.decodeOptions.roi = projectaria::tools::image::ImageRegion{0, 0, 8, 8};
+  EXPECT_FALSE(cache.get(scaledKey));
+  EXPECT_TRUE(cache.get(makeKey(0)));
+}
+
+TEST(ImageFrameCache, CachedFramesAreNotSharedWithThePlayer) {
+  ImageFrameCache cache(getBudget(2));
+  ImageDataAndRecord playerData = makeFrame(7);
+  const ImageDataAndRecord cachedData = cache.insert(makeKey(7), playerData);
+  EXPECT_NE(cachedData.first.pixelFrame, playerData.first.pixelFrame);
+
+  // the player reuses its frame for the next record
+  std::fill(playerData.first.pixelFrame->wdata(), playerData.first.pixelFrame->wdata() + 1, 8);
+  const auto hit = cache.get(makeKey(7));
+  ASSERT_TRUE(hit);
+  EXPECT_EQ(hit->first.pixelFrame, cachedData.first.pixelFrame);
+  EXPECT_EQ(hit->first.pixelFrame->rdata()[0], 7);
+}
+
+TEST(ImageFrameCache, ConcurrentReaders) {
+  constexpr int kNumFrames = 16;
+  ImageFrameCache cache(getBudget(kNumFrames / 2));
+  std::vector<std::thread> readers;
+  for (int reader = 0; reader < 4; ++reader) {
+    readers.emplace_back([&cache, reader] {
+      for (int step = 0; step < 1000; ++step) {
+        const int index = (step * 5 + reader) % kNumFrames;
+        auto data = cache.get(makeKey(index));
+        if (!data) {
+          data = cache.insert(makeKey(index), makeFrame(index));
+        }
+        EXPECT_EQ(data->first.pixelFrame->rdata()[0], index);
+      }
+    });
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  const ImageFrameCache::Stats stats = cache.getStats();
+  EXPECT_EQ(stats.hits + stats.misses, 4000u);
+  EXPECT_LE(stats.numFrames, kNumFrames / 2u);
+}
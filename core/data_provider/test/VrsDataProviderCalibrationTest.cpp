@@ -14,7 +14,14 @@
  * limitations under the License.
  */
 
+#include <calibration/camera_projections/FisheyeRadTanThinPrism.h>
+#include <calibration/loader/DeviceCalibrationJson.h>
 #include <data_provider/VrsDataProvider.h>
+#include <nlohmann/json.hpp>
+#include <vrs/RecordFileReader.h>
+
+#include <cmath>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -76,6 +83,140 @@ TEST(VrsDataProvider, getCalibrations) {
   }
 }
 
+TEST(VrsDataProvider, sharedCalibrations) {
+  auto provider = createVrsDataProvider(ariaTestDataPath);
+  const auto& maybeCalib = provider->getDeviceCalibrationRef();
+  ASSERT_TRUE(maybeCalib);
+  // the calibration is not copied by each call
+  EXPECT_EQ(&provider->getDeviceCalibrationRef(), &maybeCalib);
+
+  for (const auto& label : maybeCalib->getCameraLabels()) {
+    const auto* camCalib = maybeCalib->findCameraCalib(label);
+    ASSERT_NE(camCalib, nullptr);
+    EXPECT_EQ(maybeCalib->findCameraCalib(label), camCalib);
+    EXPECT_EQ(camCalib->getLabel(), label);
+    EXPECT_EQ(camCalib->projectionParams(), maybeCalib->getCameraCalib(label)->projectionParams());
+  }
+  EXPECT_EQ(maybeCalib->findCameraCalib("camera-et"), nullptr);
+  EXPECT_EQ(maybeCalib->findCameraCalib("not-a-camera"), nullptr);
+}
+
+TEST(VrsDataProvider, tabulatedFisheye624Unprojection) {
+  using projectaria::tools::calibration::CameraProjection;
+  using projectaria::tools::calibration::Fisheye624;
+  auto provider = createVrsDataProvider(ariaTestDataPath);
+  const auto& maybeCalib = provider->getDeviceCalibrationRef();
+  ASSERT_TRUE(maybeCalib);
+
+  for (const auto& label : maybeCalib->getCameraLabels()) {
+    const auto* camCalib = maybeCalib->findCameraCalib(label);
+    ASSERT_NE(camCalib, nullptr);
+    if (camCalib->modelName() != CameraProjection::ModelType::Fisheye624) {
+      continue;
+    }
+    const Eigen::VectorXd params = camCalib->projectionParams();
+    const Eigen::Vector2i imageSize = camCalib->getImageSize();
+    // a coarse grid over the image, and a dense band around the edge of the valid area, where
+    // the rays are the furthest from the optical axis
+    std::vector<Eigen::Vector2d> pixels;
+    for (int y = 0; y < imageSize.y(); y += 32) {
+      for (int x = 0; x < imageSize.x(); x += 32) {
+        pixels.emplace_back(x, y);
+      }
+    }
+    if (const auto validRadius = camCalib->getValidRadius()) {
+      const Eigen::Vector2d center = camCalib->getPrincipalPoint();
+      for (double radius = *validRadius - 8; radius <= *validRadius + 8; radius += 2) {
+        const int numAngles = static_cast<int>(2 * M_PI * radius / 4);
+        for (int i = 0; i < numAngles; ++i) {
+          const double angle = 2 * M_PI * i / numAngles;
+          const Eigen::Vector2d pixel =
+              center + radius * Eigen::Vector2d(std::cos(angle), std::sin(angle));
+          if (pixel.x() >= 0 && pixel.y() >= 0 && pixel.x() < imageSize.x() &&
+              pixel.y() < imageSize.y()) {
+            pixels.push_back(pixel);
+          }
+        }
+      }
+    }
+    // the unprojection seeded by the table agrees with the Newton solver from the default
+    // guesses, wherever the solver converges
+    for (const Eigen::Vector2d& pixel : pixels) {
+      const Eigen::Vector3d exactRay = Fisheye624::unproject(pixel, params);
+      if (!exactRay.allFinite() || (camCalib->projectNoChecks(exactRay) - pixel).norm() > 1e-3) {
+        continue;
+      }
+      const Eigen::Vector3d ray = camCalib->unprojectNoChecks(pixel);
+      EXPECT_LT((ray.normalized() - exactRay.normalized()).norm(), 1e-6)
+          << label << " " << pixel.transpose();
+      EXPECT_LT((camCalib->projectNoChecks(ray) - pixel).norm(), 1e-3)
+          << label << " " << pixel.transpose();
+    }
+  }
+}
+
+TEST(VrsDataProvider, batchProjectionJacobians) {
+  using projectaria::tools::calibration::CameraCalibration;
+  using projectaria::tools::calibration::CameraProjection;
+  auto provider = createVrsDataProvider(ariaTestDataPath);
+  const auto& maybeCalib = provider->getDeviceCalibrationRef();
+  ASSERT_TRUE(maybeCalib);
+
+  std::vector<CameraCalibration> camCalibs;
+  for (const auto& label : maybeCalib->getCameraLabels()) {
+    camCalibs.push_back(*maybeCalib->findCameraCalib(label));
+  }
+  camCalibs.push_back(
+      projectaria::tools::calibration::getLinearCameraCalibration(512, 512, 150.0, "linear"));
+
+  constexpr int kNumPoints = 2000;
+  Eigen::Matrix3Xd points = Eigen::Matrix3Xd::Random(3, kNumPoints);
+  points.row(2).array() += 1.5;
+  for (const auto& camCalib : camCalibs) {
+    Eigen::Matrix2Xd pixels;
+    CameraProjection::BatchJacobians jacobiansWrtPoint;
+    CameraProjection::BatchJacobians jacobiansWrtParams;
+    camCalib.projectBatchNoChecks(points, pixels, &jacobiansWrtPoint, &jacobiansWrtParams);
+    const Eigen::VectorXd params = camCalib.projectionParams();
+    ASSERT_EQ(pixels.cols(), kNumPoints);
+    ASSERT_EQ(jacobiansWrtPoint.rows(), 2 * kNumPoints);
+    ASSERT_EQ(jacobiansWrtParams.cols(), params.size());
+
+    // central differences of the single point projection
+    const CameraProjection projection(camCalib.modelName(), params);
+    for (int i = 0; i < kNumPoints; i += 10) {
+      const Eigen::Vector3d point = points.col(i);
+      EXPECT_LT((pixels.col(i) - projection.project(point)).norm(), 1e-9);
+      for (int j = 0; j < 3; ++j) {
+        const Eigen::Vector3d step = 1e-6 * Eigen::Vector3d::Unit(j);
+        const Eigen::Vector2d numerical =
+            (projection.project(point + step) - projection.project(point - step)) / 2e-6;
+        const Eigen::Vector2d analytical = jacobiansWrtPoint.block<2, 1>(2 * i, j);
+        EXPECT_LT((analytical - numerical).norm(), 1e-5 * (1 + numerical.norm()));
+      }
+      for (int j = 0; j < params.size(); ++j) {
+        const double step = 1e-6 * std::max(1.0, std::abs(params(j)));
+        Eigen::VectorXd paramsPlus = params;
+        Eigen::VectorXd paramsMinus = params;
+        paramsPlus(j) += step;
+        paramsMinus(j) -= step;
+        const Eigen::Vector2d numerical = (CameraProjection(camCalib.modelName(), paramsPlus)
+                                               .project(point) -
+                                           CameraProjection(camCalib.modelName(), paramsMinus)
+                                               .project(point)) /
+            (2 * step);
+        const Eigen::Vector2d analytical = jacobiansWrtParams.block<2, 1>(2 * i, j);
+        EXPECT_LT((analytical - numerical).norm(), 1e-5 * (1 + numerical.norm()));
+      }
+    }
+
+    // the Jacobians are optional
+    Eigen::Matrix2Xd pixelsOnly;
+    camCalib.projectBatchNoChecks(points, pixelsOnly);
+    EXPECT_EQ(pixelsOnly, pixels);
+  }
+}
+
 TEST(VrsDataProvider, rescaledCalibration) {
   auto provider = createVrsDataProvider(ariaTestDataPath);
   auto maybeCalib = provider->getDeviceCalibration();
@@ -128,6 +269,64 @@ TEST(VrsDataProvider, rescaledCalibration) {
   EXPECT_EQ(etSensorCalib[1].getImageSize().y(), eyeCameraCalib[1].getImageSize().y());
 }
 
+TEST(VrsDataProvider, rescaledCalibrationJsonRoundTrip) {
+  using namespace projectaria::tools::calibration;
+  vrs::RecordFileReader reader;
+  ASSERT_EQ(reader.openFile(ariaTestDataPath), 0);
+  const std::string calibJsonStr = reader.getTag("calib_json");
+  const auto maybeCalib = deviceCalibrationFromJson(calibJsonStr);
+  ASSERT_TRUE(maybeCalib);
+
+  // Rescale all cameras but one to half their factory resolution, as vrs_downscale does
+  const auto cameraLabels = maybeCalib->getCameraLabels();
+  ASSERT_GT(cameraLabels.size(), 1);
+  const std::string unchangedLabel = cameraLabels.back();
+  std::vector<CameraCalibration> rescaledCalibs;
+  for (const auto& label : cameraLabels) {
+    if (label != unchangedLabel) {
+      const auto camCalib = maybeCalib->getCameraCalib(label).value();
+      rescaledCalibs.push_back(camCalib.rescale(camCalib.getImageSize() / 2, 0.5));
+    }
+  }
+  const auto maybeUpdatedCalib =
+      deviceCalibrationFromJson(updateCameraCalibrationsInJson(calibJsonStr, rescaledCalibs));
+  ASSERT_TRUE(maybeUpdatedCalib);
+
+  const Eigen::Vector3d pointInCamera(0.1, -0.2, 1.0);
+  auto expectSameCalib = [&](const CameraCalibration& expected) {
+    const auto actual = maybeUpdatedCalib->getCameraCalib(expected.getLabel());
+    ASSERT_TRUE(actual) << expected.getLabel();
+    EXPECT_EQ(actual->getImageSize(), expected.getImageSize()) << expected.getLabel();
+    ASSERT_EQ(actual->getValidRadius().has_value(), expected.getValidRadius().has_value());
+    if (expected.getValidRadius()) {
+      EXPECT_DOUBLE_EQ(*actual->getValidRadius(), *expected.getValidRadius());
+    }
+    EXPECT_TRUE(actual->projectionParams().isApprox(expected.projectionParams()));
+    EXPECT_TRUE(actual->getT_Device_Camera().matrix().isApprox(
+        expected.getT_Device_Camera().matrix()));
+    EXPECT_TRUE(actual->projectNoChecks(pointInCamera).isApprox(
+        expected.projectNoChecks(pointInCamera)));
+  };
+  for (const auto& rescaledCalib : rescaledCalibs) {
+    expectSameCalib(rescaledCalib);
+  }
+  // The cameras that were not updated keep their factory calibration
+  expectSameCalib(maybeCalib->getCameraCalib(unchangedLabel).value());
+
+  // Updating a camera that is not in the calib json is an error
+  const CameraCalibration& missingCalib = rescaledCalibs.front();
+  auto calibJson = nlohmann::json::parse(calibJsonStr);
+  nlohmann::json otherCamerasJson = nlohmann::json::array();
+  for (const auto& camJson : calibJson["CameraCalibrations"]) {
+    if (camJson["Label"] != missingCalib.getLabel()) {
+      otherCamerasJson.push_back(camJson);
+    }
+  }
+  calibJson["CameraCalibrations"] = otherCamerasJson;
+  EXPECT_THROW(
+      updateCameraCalibrationsInJson(calibJson.dump(), {missingCalib}), std::runtime_error);
+}
+
 TEST(VrsDataProvider, streamIdToLabelMapping) {
   auto provider = createVrsDataProvider(ariaTestDataPath);
   const auto streamIds = provider->getAllStreams();
@@ -139,3 +338,65 @@ TEST(VrsDataProvider, streamIdToLabelMapping) {
     EXPECT_EQ(*maybeStreamId, streamId);
   }
 }
+
+TEST(VrsDataProvider, getDecodedCameraCalibration) {
+  auto provider = createVrsDataProvider(ariaTestDataPath);
+  static const vrs::StreamId kRgbCameraStreamId{vrs::RecordableTypeId::RgbCameraRecordableClass, 1};
+  const auto rgbCameraCalib =
+      provider->getSensorCalibration(kRgbCameraStreamId)->cameraCalibration();
+  const Eigen::Vector2i fullSize = rgbCameraCalib.getImageSize();
+
+  projectaria::tools::image::JpegDecodeOptions decodeOptions;
+  decodeOptions.scaleDenominator = 4;
+  decodeOptions.roi = projectaria::tools::image::ImageRegion{64, 128, 512, 256};
+
+  // decoded images and calibration agree on the resolution
+  const auto [imageData, imageRecord] =
+      provider->getImageDataByIndex(kRgbCameraStreamId, 0, decodeOptions);
+  ASSERT_TRUE(imageData.isValid());
+  const auto decodedCalib =
+      provider->getDecodedCameraCalibration(kRgbCameraStreamId, decodeOptions).value();
+  EXPECT_EQ(decodedCalib.getImageSize().x(), imageData.getWidth());
+  EXPECT_EQ(decodedCalib.getImageSize().y(), imageData.getHeight());
+  EXPECT_EQ(decodedCalib.getImageSize().x(), 512 / 4);
+
+  // a point projects to the same place in the full image and in the decoded region
+  const Eigen::Vector3d pointInCamera(0.1, -0.05, 1.0);
+  const Eigen::Vector2d fullPixel = rgbCameraCalib.projectNoChecks(pointInCamera);
+  const Eigen::Vector2d decodedPixel = decodedCalib.projectNoChecks(pointInCamera);
+  const Eigen::Vector2d expectedPixel =
+      (fullPixel + Eigen::Vector2d::Constant(0.5)) / 4.0 - Eigen::Vector2d(16, 32) -
+      Eigen::Vector2d::Constant(0.5);
+  EXPECT_NEAR(decodedPixel.x(), expectedPixel.x(), 1e-6);
+  EXPECT_NEAR(decodedPixel.y(), expectedPixel.y(), 1e-6);
+
+  // per-read options do not change the options of the stream
+  EXPECT_TRUE(provider->getImageDecodeOptions(kRgbCameraStreamId).isFullImage());
+  const auto fullImage = provider->getImageDataByIndex(kRgbCameraStreamId, 0).first.imageVariant();
+  ASSERT_TRUE(fullImage);
+  EXPECT_EQ(projectaria::tools::image::getWidth(*fullImage), fullSize.x());
+
+  // the options do not apply to the raw images of the SLAM cameras, nor to their calibration
+  const auto slamStreamId = provider->getStreamIdFromLabel("camera-slam-left");
+  ASSERT_TRUE(slamStreamId);
+  const auto slamCalib = provider->getSensorCalibration(*slamStreamId)->cameraCalibration();
+  const auto slamImage = provider->getImageDataByIndex(*slamStreamId, 0, decodeOptions).first;
+  ASSERT_TRUE(slamImage.isValid());
+  const auto decodedSlamCalib =
+      provider->getDecodedCameraCalibration(*slamStreamId, decodeOptions).value();
+  EXPECT_EQ(decodedSlamCalib.getImageSize(), slamCalib.getImageSize());
+  EXPECT_EQ(decodedSlamCalib.getImageSize().x(), slamImage.getWidth());
+  EXPECT_EQ(decodedSlamCalib.projectionParams(), slamCalib.projectionParams());
+
+  // regions with no pixel of the image are rejected
+  const auto config = provider->getImageConfiguration(kRgbCameraStreamId);
+  projectaria::tools::image::JpegDecodeOptions badOptions;
+  badOptions.roi = projectaria::tools::image::ImageRegion{64, 128, 0, 256};
+  EXPECT_THROW(provider->setImageDecodeOptions(kRgbCameraStreamId, badOptions), std::runtime_error);
+  badOptions.roi =
+      projectaria::tools::image::ImageRegion{config.imageWidth, 0, 64, config.imageHeight};
+  EXPECT_THROW(provider->setImageDecodeOptions(kRgbCameraStreamId, badOptions), std::runtime_error);
+  EXPECT_THROW(
+      provider->getImageDataByIndex(kRgbCameraStreamId, 0, badOptions), std::runtime_error);
+  EXPECT_TRUE(provider->getImageDecodeOptions(kRgbCameraStreamId).isFullImage());
+}
@@ -16,6 +16,8 @@
 
 #include <data_provider/VrsDataProvider.h>
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 using namespace projectaria::tools::data_provider;
@@ -52,3 +54,88 @@ TEST(VrsDataProvider, deliverQueuedSensorData) {
   }
   EXPECT_EQ(numData, numDataExpected);
 }
+
+TEST(VrsDataProvider, deliverQueuedSensorDataMetadataOnly) {
+  auto provider = createVrsDataProvider(ariaTestDataPath);
+
+  // play image records in full, keeping their metadata as reference
+  std::vector<ImageDataRecord> expectedRecords;
+  for (const auto& sensorData : provider->deliverQueuedSensorData()) {
+    if (sensorData.sensorDataType() == SensorDataType::Image) {
+      expectedRecords.push_back(sensorData.imageDataAndRecord().second);
+    }
+  }
+  EXPECT_FALSE(expectedRecords.empty());
+
+  // play again skipping all image content
+  auto options = provider->getDefaultDeliverQueuedOptions();
+  for (const auto& streamId : options.getStreamIds()) {
+    options.setReadContent(streamId, false);
+  }
+  size_t numImages = 0;
+  for (const auto& sensorData : provider->deliverQueuedSensorData(options)) {
+    if (sensorData.sensorDataType() != SensorDataType::Image) {
+      continue;
+    }
+    const auto [imageData, imageRecord] = sensorData.imageDataAndRecord();
+    EXPECT_FALSE(imageData.isValid());
+    ASSERT_LT(numImages, expectedRecords.size());
+    EXPECT_EQ(imageRecord.frameNumber, expectedRecords.at(numImages).frameNumber);
+    EXPECT_EQ(imageRecord.captureTimestampNs, expectedRecords.at(numImages).captureTimestampNs);
+    EXPECT_EQ(imageRecord.exposureDuration, expectedRecords.at(numImages).exposureDuration);
+    ++numImages;
+  }
+  EXPECT_EQ(numImages, expectedRecords.size());
+
+  // content is read again when requested by index
+  const auto imageStreamId = provider->getStreamIdFromLabel("camera-rgb");
+  if (imageStreamId) {
+    EXPECT_TRUE(provider->getImageDataByIndex(*imageStreamId, 0).first.isValid());
+
+    // metadata-only reads only skip the content of their own record
+    const int numData = static_cast<int>(provider->getNumData(*imageStreamId));
+    for (int index = 0; index < std::min(numData, 4); ++index) {
+      const SensorData metadata = provider->getSensorDataMetadataByIndex(*imageStreamId, index);
+      ASSERT_EQ(metadata.sensorDataType(), SensorDataType::Image);
+      EXPECT_FALSE(metadata.imageDataAndRecord().first.isValid());
+      EXPECT_TRUE(provider->getImageDataByIndex(*imageStreamId, index).first.isValid());
+      const SensorData data = provider->getSensorDataByIndex(*imageStreamId, index);
+      EXPECT_TRUE(data.imageDataAndRecord().first.isValid());
+    }
+  }
+}
+
+TEST(VrsDataProvider, deliverQueuedSensorDataReadAhead) {
+  auto provider = createVrsDataProvider(ariaTestDataPath);
+  EXPECT_EQ(provider->getAccessPattern(), AccessPattern::Random);
+
+  std::vector<std::pair<vrs::StreamId, int64_t>> expectedData;
+  for (const auto& sensorData : provider->deliverQueuedSensorData()) {
+    expectedData.emplace_back(sensorData.streamId(), sensorData.getTimeNs(TimeDomain::DeviceTime));
+  }
+
+  // reading ahead doesn't change the data delivered, with small windows to hint often
+  provider->setAccessPattern(AccessPattern::Sequential, 4096);
+  EXPECT_EQ(provider->getAccessPattern(), AccessPattern::Sequential);
+  size_t numData = 0;
+  for (const auto& sensorData : provider->deliverQueuedSensorData()) {
+    ASSERT_LT(numData, expectedData.size());
+    EXPECT_EQ(sensorData.streamId(), expectedData[numData].first);
+    EXPECT_EQ(sensorData.getTimeNs(TimeDomain::DeviceTime), expectedData[numData].second);
+    ++numData;
+  }
+  EXPECT_EQ(numData, expectedData.size());
+
+  // every other frame of a stream
+  provider->setAccessPattern(AccessPattern::Strided, 4096);
+  for (const auto& streamId : provider->getAllStreams()) {
+    if (provider->getSensorDataType(streamId) != SensorDataType::Image) {
+      continue;
+    }
+    for (int index = 0; index < static_cast<int>(provider->getNumData(streamId)); index += 2) {
+      EXPECT_TRUE(provider->getImageDataByIndex(streamId, index).first.isValid());
+    }
+  }
+  provider->setAccessPattern(AccessPattern::Random);
+  EXPECT_EQ(provider->getAccessPattern(), AccessPattern::Random);
+}
@@ -14,18 +14,160 @@
  * limitations under the License.
  */
 
+#include <benchmarks/SyntheticAriaRecording.h>
 #include <data_provider/VrsDataProvider.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
 #include <gtest/gtest.h>
 
 using namespace projectaria::tools::data_provider;
+using projectaria::tools::benchmarks::SyntheticRecordingOptions;
+using projectaria::tools::benchmarks::writeSyntheticAriaRecording;
+
+namespace fs = std::filesystem;
 
 #define STRING(x) #x
 #define XSTRING(x) std::string(STRING(x)) + "aria_unit_test_sequence_calib.vrs"
 
 static const std::string ariaTestDataPath = XSTRING(TEST_FOLDER);
+static const std::string adtTestDataFolder = std::string(STRING(TEST_FOLDER)) +
+    "aria_digital_twin_test_data/1WM103600M1292_optitrack_release_golden_skeleton_seq100/";
 
 TEST(VrsDataProvider, Factory) {
   EXPECT_TRUE(createVrsDataProvider(ariaTestDataPath));
   EXPECT_FALSE(createVrsDataProvider("123"));
 }
+
+TEST(VrsDataProvider, FactoryMultipleFiles) {
+  const std::string videoPath = adtTestDataFolder + "video.vrs";
+  auto videoProvider = createVrsDataProvider(videoPath);
+  ASSERT_TRUE(videoProvider);
+
+  // a file listed twice, directly and through a wildcard, is opened once
+  auto provider =
+      createVrsDataProvider(std::vector<std::string>{videoPath, adtTestDataFolder + "vid*.vrs"});
+  ASSERT_TRUE(provider);
+  EXPECT_EQ(provider->getAllStreams(), videoProvider->getAllStreams());
+  EXPECT_EQ(
+      provider->getDeviceCalibration().has_value(),
+      videoProvider->getDeviceCalibration().has_value());
+
+  EXPECT_FALSE(createVrsDataProvider(std::vector<std::string>{}));
+  EXPECT_FALSE(createVrsDataProvider(std::vector<std::string>{adtTestDataFolder + "*.none"}));
+  EXPECT_FALSE(createVrsDataProvider(std::vector<std::string>{videoPath, "123"}));
+}
+
+TEST(VrsDataProvider, FactoryDistinctRecordings) {
+  const fs::path folder = fs::temp_directory_path();
+  const std::string camerasPath = (folder / "factory_test_cameras.vrs").string();
+  const std::string imuPath = (folder / "factory_test_imu.vrs").string();
+  const std::string otherDeviceImuPath = (folder / "factory_test_other_device_imu.vrs").string();
+
+  // the cameras of a device, and its IMUs over a later and longer time span
+  SyntheticRecordingOptions camerasOptions;
+  camerasOptions.durationSec = 1;
+  camerasOptions.enableImu = false;
+  camerasOptions.enableAudio = false;
+  camerasOptions.enableBarometer = false;
+  writeSyntheticAriaRecording(camerasPath, camerasOptions);
+  SyntheticRecordingOptions imuOptions;
+  imuOptions.durationSec = 2;
+  imuOptions.startTimeNs = camerasOptions.startTimeNs + 500'000'000;
+  imuOptions.rgb.enabled = false;
+  imuOptions.slam.enabled = false;
+  imuOptions.et.enabled = false;
+  imuOptions.enableAudio = false;
+  imuOptions.enableBarometer = false;
+  imuOptions.enableTimeSync = false;
+  writeSyntheticAriaRecording(imuPath, imuOptions);
+
+  auto camerasProvider = createVrsDataProvider(camerasPath);
+  auto imuProvider = createVrsDataProvider(imuPath);
+  ASSERT_TRUE(camerasProvider && imuProvider);
+  auto provider = createVrsDataProvider(std::vector<std::string>{camerasPath, imuPath});
+  ASSERT_TRUE(provider);
+
+  // the streams of both files, with all their data
+  std::set<vrs::StreamId> expectedStreams = camerasProvider->getAllStreams();
+  const std::set<vrs::StreamId> imuStreams = imuProvider->getAllStreams();
+  expectedStreams.insert(imuStreams.begin(), imuStreams.end());
+  EXPECT_EQ(provider->getAllStreams(), expectedStreams);
+  for (const auto& streamId : provider->getAllStreams()) {
+    const auto& fileProvider = imuStreams.count(streamId) ? imuProvider : camerasProvider;
+    EXPECT_EQ(provider->getNumData(streamId), fileProvider->getNumData(streamId));
+  }
+
+  // over the time range of both files
+  EXPECT_EQ(
+      provider->getFirstTimeNsAllStreams(TimeDomain::DeviceTime),
+      std::min(
+          camerasProvider->getFirstTimeNsAllStreams(TimeDomain::DeviceTime),
+          imuProvider->getFirstTimeNsAllStreams(TimeDomain::DeviceTime)));
+  EXPECT_EQ(
+      provider->getLastTimeNsAllStreams(TimeDomain::DeviceTime),
+      std::max(
+          camerasProvider->getLastTimeNsAllStreams(TimeDomain::DeviceTime),
+          imuProvider->getLastTimeNsAllStreams(TimeDomain::DeviceTime)));
+  EXPECT_TRUE(provider->getDeviceCalibration());
+
+  // the IMUs of another device can't be merged with the cameras
+  SyntheticRecordingOptions otherDeviceImuOptions = imuOptions;
+  otherDeviceImuOptions.deviceSerial = "other-device";
+  writeSyntheticAriaRecording(otherDeviceImuPath, otherDeviceImuOptions);
+  EXPECT_THROW(
+      createVrsDataProvider(std::vector<std::string>{camerasPath, otherDeviceImuPath}),
+      std::runtime_error);
+
+  for (const auto& path : {camerasPath, imuPath, otherDeviceImuPath}) {
+    fs::remove(path);
+  }
+}
+
+TEST(VrsDataProvider, FactoryLazyInitialization) {
+  const std::string timecodeTestDataPath =
+      std::string(STRING(TEST_FOLDER)) + "aria_unit_test_timecode_sequence_calib.vrs";
+  VrsDataProviderOpenOptions lazyOptions;
+  lazyOptions.lazyInitialization = true;
+  auto provider = createVrsDataProvider(timecodeTestDataPath);
+  auto lazyProvider = createVrsDataProvider(timecodeTestDataPath, lazyOptions);
+  ASSERT_TRUE(provider && lazyProvider);
+
+  const auto timings = provider->getOpenTimings();
+  EXPECT_FALSE(timings.lazyInitialization);
+  EXPECT_GT(timings.totalNs, 0);
+  EXPECT_GE(
+      timings.totalNs,
+      timings.openFilesNs + timings.readConfigurationsNs + timings.loadCalibrationNs +
+          timings.loadTimeSyncNs + timings.buildTimeIndexNs);
+  const auto lazyTimings = lazyProvider->getOpenTimings();
+  EXPECT_TRUE(lazyTimings.lazyInitialization);
+  EXPECT_EQ(lazyTimings.loadCalibrationNs, 0);
+
+  // deferred results match the ones computed at creation
+  ASSERT_EQ(provider->getAllStreams(), lazyProvider->getAllStreams());
+  for (const auto& streamId : provider->getAllStreams()) {
+    for (auto timeDomain : {TimeDomain::RecordTime, TimeDomain::DeviceTime}) {
+      EXPECT_EQ(
+          provider->getFirstTimeNs(streamId, timeDomain),
+          lazyProvider->getFirstTimeNs(streamId, timeDomain));
+      EXPECT_EQ(
+          provider->getLastTimeNs(streamId, timeDomain),
+          lazyProvider->getLastTimeNs(streamId, timeDomain));
+    }
+  }
+  ASSERT_EQ(
+      provider->getDeviceCalibration().has_value(),
+      lazyProvider->getDeviceCalibration().has_value());
+  if (provider->getDeviceCalibration()) {
+    EXPECT_EQ(
+        provider->getDeviceCalibration()->getCameraLabels(),
+        lazyProvider->getDeviceCalibration()->getCameraLabels());
+  }
+  const int64_t deviceTimeNs = provider->getFirstTimeNsAllStreams(TimeDomain::DeviceTime);
+  EXPECT_EQ(
+      provider->convertFromDeviceTimeToTimeCodeNs(deviceTimeNs),
+      lazyProvider->convertFromDeviceTimeToTimeCodeNs(deviceTimeNs));
+}
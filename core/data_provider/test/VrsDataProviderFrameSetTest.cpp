@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <data_provider/VrsDataProvider.h>
+
+#include <gtest/gtest.h>
+
+using namespace projectaria::tools::data_provider;
+
+#define STRING(x) #x
+#define XSTRING(x) std::string(STRING(x)) + "aria_unit_test_sequence_calib.vrs"
+
+static const std::string ariaTestDataPath = XSTRING(TEST_FOLDER);
+
+TEST(FrameSetSequence, matchCompleteSets) {
+  // two streams with a small offset, and a third stream starting later
+  const std::vector<std::vector<int64_t>> timestampsNs = {
+      {0, 100, 200, 300}, {5, 104, 196, 302}, {98, 203, 299}};
+
+  const auto frameSets = matchFrameSets(timestampsNs, 10, true);
+  ASSERT_EQ(frameSets.size(), 3);
+  EXPECT_EQ(frameSets[0].timestampNs, 98);
+  EXPECT_EQ(frameSets[0].indices, (std::vector<int>{1, 1, 0}));
+  EXPECT_EQ(frameSets[1].timestampNs, 196);
+  EXPECT_EQ(frameSets[1].indices, (std::vector<int>{2, 2, 1}));
+  EXPECT_EQ(frameSets[2].timestampNs, 299);
+  EXPECT_EQ(frameSets[2].indices, (std::vector<int>{3, 3, 2}));
+}
+
+TEST(FrameSetSequence, matchIncompleteSets) {
+  // the second stream runs at half the rate of the first one
+  const std::vector<std::vector<int64_t>> timestampsNs = {{0, 50, 100, 150}, {1, 99}};
+
+  const auto frameSets = matchFrameSets(timestampsNs, 2, false);
+  ASSERT_EQ(frameSets.size(), 4);
+  EXPECT_EQ(frameSets[0].indices, (std::vector<int>{0, 0}));
+  EXPECT_EQ(frameSets[1].indices, (std::vector<int>{1, -1}));
+  EXPECT_EQ(frameSets[1].timestampNs, 50);
+  EXPECT_EQ(frameSets[2].indices, (std::vector<int>{2, 1}));
+  EXPECT_EQ(frameSets[2].timestampNs, 99);
+  EXPECT_EQ(frameSets[3].indices, (std::vector<int>{3, -1}));
+
+  const auto completeSets = matchFrameSets(timestampsNs, 2, true);
+  ASSERT_EQ(completeSets.size(), 2);
+  EXPECT_EQ(completeSets[0].indices, (std::vector<int>{0, 0}));
+  EXPECT_EQ(completeSets[1].indices, (std::vector<int>{2, 1}));
+
+  EXPECT_TRUE(matchFrameSets({{}, {}}, 2, false).empty());
+  EXPECT_THROW(matchFrameSets(timestampsNs, -1, true), std::runtime_error);
+}
+
+TEST(FrameSetSequence, deliverFrameSets) {
+  auto provider = createVrsDataProvider(ariaTestDataPath);
+  ASSERT_NE(provider, nullptr);
+
+  // the SLAM cameras are triggered together
+  FrameSetOptions options;
+  for (const auto& label : {"camera-slam-left", "camera-slam-right"}) {
+    const auto streamId = provider->getStreamIdFromLabel(label);
+    ASSERT_TRUE(streamId && provider->checkStreamIsActive(*streamId));
+    options.streamIds.push_back(*streamId);
+  }
+  options.toleranceNs = 1'000'000;
+
+  std::vector<std::vector<int64_t>> timestampsNs;
+  for (const auto& streamId : options.streamIds) {
+    timestampsNs.push_back(provider->getTimestampsNs(streamId, options.timeDomain));
+  }
+
+  auto frameSets = provider->deliverFrameSets(options);
+  EXPECT_GT(frameSets.size(), 0);
+  size_t numSets = 0;
+  int64_t lastTimestampNs = -1;
+  for (const auto& frameSet : frameSets) {
+    EXPECT_TRUE(frameSet.isComplete());
+    EXPECT_GT(frameSet.timestampNs, lastTimestampNs);
+    lastTimestampNs = frameSet.timestampNs;
+    ASSERT_EQ(frameSet.frames.size(), options.streamIds.size());
+    for (size_t i = 0; i < options.streamIds.size(); ++i) {
+      const int index = frameSet.indices[i];
+      const int64_t timestampNs = timestampsNs[i].at(index);
+      EXPECT_GE(timestampNs, frameSet.timestampNs);
+      EXPECT_LE(timestampNs - frameSet.timestampNs, options.toleranceNs);
+
+      // frames are delivered decoded, and match the frames read by index
+      ASSERT_TRUE(frameSet.frames[i].has_value());
+      const auto& [imageData, imageRecord] = *frameSet.frames[i];
+      ASSERT_TRUE(imageData.isValid());
+      EXPECT_NE(imageData.pixelFrame->getSpec().getImageFormat(), vrs::ImageFormat::JPG);
+      const auto expected = provider->getImageDataByIndex(options.streamIds[i], index);
+      EXPECT_EQ(imageRecord.captureTimestampNs, expected.second.captureTimestampNs);
+      EXPECT_EQ(imageData.getWidth(), expected.first.getWidth());
+      EXPECT_EQ(imageData.getHeight(), expected.first.getHeight());
+    }
+    ++numSets;
+  }
+  EXPECT_EQ(numSets, frameSets.size());
+
+  // delivering incomplete sets covers every frame of every stream once
+  options.dropIncomplete = false;
+  std::vector<size_t> numFrames(options.streamIds.size(), 0);
+  for (const auto& frameSet : provider->deliverFrameSets(options)) {
+    for (size_t i = 0; i < options.streamIds.size(); ++i) {
+      EXPECT_EQ(frameSet.indices[i] >= 0, frameSet.frames[i].has_value());
+      if (frameSet.indices[i] >= 0) {
+        EXPECT_EQ(frameSet.indices[i], static_cast<int>(numFrames[i]++));
+      }
+    }
+  }
+  for (size_t i = 0; i < options.streamIds.size(); ++i) {
+    EXPECT_EQ(numFrames[i], provider->getNumData(options.streamIds[i]));
+  }
+}
@@ -16,6 +16,8 @@
 
 #include <data_provider/VrsDataProvider.h>
 
+#include <thread>
+
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 
@@ -186,3 +188,35 @@ TEST(VrsDataProvider, multiThreadGetDataByIndex) {
     }
   }
 }
+
+TEST(VrsDataProvider, multiThreadGetCachedImageDataByIndex) {
+  auto provider = createVrsDataProvider(ariaTestDataPath);
+  const auto imageStreamId = provider->getStreamIdFromLabel("camera-slam-left");
+  ASSERT_TRUE(imageStreamId);
+  const int numData = static_cast<int>(provider->getNumData(*imageStreamId));
+
+  std::vector<ImageDataAndRecord> expectedData;
+  for (int index = 0; index < numData; ++index) {
+    expectedData.push_back(provider->getImageDataByIndex(*imageStreamId, index));
+  }
+
+  // concurrent reads of the same stream each cache their own frame, with room for all of them
+  const size_t frameBytes = expectedData.at(0).first.pixelFrame->size();
+  provider->setImageCacheBudget(2 * frameBytes * numData);
+  static constexpr int numThreads = 4;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&provider, &imageStreamId, numData, i]() {
+      for (int index = i; index < numData; index += numThreads) {
+        provider->getImageDataByIndex(*imageStreamId, index);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int index = 0; index < numData; ++index) {
+    compare(provider->getImageDataByIndex(*imageStreamId, index), expectedData.at(index));
+  }
+  EXPECT_EQ(provider->getImageCacheStats()->hits, static_cast<uint64_t>(numData));
+}
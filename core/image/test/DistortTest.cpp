@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <image/utility/Distort.h>
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace projectaria::tools::image;
+
+namespace {
+
+// Scales and rotates the output pixels, with the corners of the output image out of the input
+std::optional<Eigen::Vector2f> inverseWarp(const Eigen::Vector2f& dstPixel) {
+  const Eigen::Vector2f center(10.f, 8.f);
+  const Eigen::Vector2f offset = dstPixel - Eigen::Vector2f(12.f, 9.f);
+  if (offset.norm() > 11.f) {
+    return std::nullopt;
+  }
+  return center + 0.8f * Eigen::Vector2f(offset.y(), -offset.x());
+}
+
+} // namespace
+
+TEST(Distort, WarpMapMatchesInverseWarp) {
+  const int width = 21, height = 17;
+  std::vector<Eigen::Matrix<uint8_t, 3, 1>> pixels(width * height);
+  for (int i = 0; i < width * height; ++i) {
+    pixels[i] = {uint8_t(i % 251), uint8_t(i * 3 % 256), uint8_t(i / width * 9)};
+  }
+  const Image3U8 src(pixels.data(), width, height);
+
+  const Eigen::Vector2i dstSize(25, 19);
+  const WarpMap warpMap = computeWarpMap(inverseWarp, dstSize);
+  ASSERT_EQ(warpMap.srcPixels.size(), size_t{25 * 19});
+  EXPECT_TRUE(std::isnan(warpMap.srcPixels[0].x()));
+
+  for (const auto method : {InterpolationMethod::Bilinear, InterpolationMethod::NearestNeighbor}) {
+    const auto expected =
+        std::get<ManagedImage3U8>(distortImageVariant(src, inverseWarp, dstSize, method));
+    const auto warped = std::get<ManagedImage3U8>(warpImageVariant(src, warpMap, method));
+    ASSERT_EQ(warped.width(), size_t{25});
+    ASSERT_EQ(warped.height(), size_t{19});
+    int numSampled = 0;
+    for (int y = 0; y < dstSize.y(); ++y) {
+      for (int x = 0; x < dstSize.x(); ++x) {
+        EXPECT_EQ(warped(x, y), expected(x, y)) << x << "," << y;
+        numSampled += warped(x, y) != Eigen::Matrix<uint8_t, 3, 1>::Zero();
+      }
+    }
+    EXPECT_GT(numSampled, 100);
+  }
+}
+
+TEST(Distort, WarpMapOfAnotherSize) {
+  std::vector<float> pixels(16, 1.f);
+  WarpMap warpMap = computeWarpMap(inverseWarp, {4, 3});
+  warpMap.imageSize = {4, 4};
+  EXPECT_THROW(warpImageVariant(ImageF32(pixels.data(), 4, 4), warpMap), std::runtime_error);
+}
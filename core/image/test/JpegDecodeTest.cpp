@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <image/utility/JpegDecode.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <jpeglib.h>
+
+#include <gtest/gtest.h>
+
+using namespace projectaria::tools::image;
+
+namespace {
+// Encodes a smooth synthetic pattern
+std::vector<uint8_t> encodeTestJpeg(int width, int height, int numComponents) {
+  jpeg_compress_struct cinfo;
+  jpeg_error_mgr errorManager;
+  cinfo.err = jpeg_std_error(&errorManager);
+  jpeg_create_compress(&cinfo);
+  unsigned char* buffer = nullptr;
+  unsigned long bufferSize = 0;
+  jpeg_mem_dest(&cinfo, &buffer, &bufferSize);
+  cinfo.image_width = width;
+  cinfo.image_height = height;
+  cinfo.input_components = numComponents;
+  cinfo.in_color_space = numComponents == 1 ? JCS_GRAYSCALE : JCS_RGB;
+  jpeg_set_defaults(&cinfo);
+  jpeg_set_quality(&cinfo, 95, TRUE);
+  jpeg_start_compress(&cinfo, TRUE);
+  std::vector<uint8_t> row(width * numComponents);
+  while (cinfo.next_scanline < cinfo.image_height) {
+    const int y = cinfo.next_scanline;
+    for (int x = 0; x < width; ++x) {
+      for (int c = 0; c < numComponents; ++c) {
+        row[x * numComponents + c] =
+            static_cast<uint8_t>(128 + 100 * std::sin(x * 0.05 + c) * std::cos(y * 0.03));
+      }
+    }
+    JSAMPROW rowPointer = row.data();
+    jpeg_write_scanlines(&cinfo, &rowPointer, 1);
+  }
+  jpeg_finish_compress(&cinfo);
+  jpeg_destroy_compress(&cinfo);
+  std::vector<uint8_t> jpeg(buffer, buffer + bufferSize);
+  std::free(buffer);
+  return jpeg;
+}
+
+uint8_t pixelAt(const vrs::utils::PixelFrame& frame, uint32_t x, uint32_t y) {
+  return frame.rdata()[y * frame.getStride() + x];
+}
+} // namespace
+
+TEST(JpegDecode, DecodedRegion) {
+  JpegDecodeOptions options;
+  options.scaleDenominator = 4;
+  ImageRegion region = getJpegDecodedRegion(1408, 1408, options);
+  EXPECT_EQ(region.x, 0u);
+  EXPECT_EQ(region.width, 352u);
+  EXPECT_EQ(region.height, 352u);
+
+  // the region of interest is expanded to whole scaled pixels and clipped to the image
+  options.roi = ImageRegion{102, 6, 1400, 11};
+  region = getJpegDecodedRegion(1408, 1408, options);
+  EXPECT_EQ(region.x, 25u);
+  EXPECT_EQ(region.y, 1u);
+  EXPECT_EQ(region.width, 352u - 25u);
+  EXPECT_EQ(region.height, 4u);
+}
+
+TEST(JpegDecode, ScaledDecode) {
+  const std::vector<uint8_t> jpeg = encodeTestJpeg(640, 480, 3);
+  const auto fullFrame = decodeJpeg(jpeg.data(), jpeg.size(), {});
+  ASSERT_NE(fullFrame, nullptr);
+  EXPECT_EQ(fullFrame->getWidth(), 640u);
+  EXPECT_EQ(fullFrame->getHeight(), 480u);
+  EXPECT_EQ(fullFrame->getPixelFormat(), vrs::PixelFormat::RGB8);
+
+  for (uint32_t scale : {2u, 4u, 8u}) {
+    JpegDecodeOptions options;
+    options.scaleDenominator = scale;
+    const auto frame = decodeJpeg(jpeg.data(), jpeg.size(), options);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->getWidth(), 640 / scale);
+    EXPECT_EQ(frame->getHeight(), 480 / scale);
+
+    // DCT scaling approximates the box average of the full resolution image
+    double sumError = 0;
+    for (uint32_t y = 0; y < frame->getHeight(); ++y) {
+      for (uint32_t x = 0; x < frame->getWidth() * 3; ++x) {
+        double average = 0;
+        for (uint32_t dy = 0; dy < scale; ++dy) {
+          for (uint32_t dx = 0; dx < scale; ++dx) {
+            average += pixelAt(*fullFrame, (x / 3 * scale + dx) * 3 + x % 3, y * scale + dy);
+          }
+        }
+        sumError += std::abs(average / (scale * scale) - pixelAt(*frame, x, y));
+      }
+    }
+    EXPECT_LT(sumError / (frame->getWidth() * frame->getHeight() * 3), 2.0);
+  }
+}
+
+TEST(JpegDecode, RegionDecode) {
+  const std::vector<uint8_t> jpeg = encodeTestJpeg(1408, 1408, 1);
+  for (uint32_t scale : {1u, 2u, 8u}) {
+    JpegDecodeOptions options;
+    options.scaleDenominator = scale;
+    const auto scaledFrame = decodeJpeg(jpeg.data(), jpeg.size(), options);
+    ASSERT_NE(scaledFrame, nullptr);
+
+    options.roi = ImageRegion{101, 257, 333, 190};
+    const ImageRegion region = getJpegDecodedRegion(1408, 1408, options);
+    const auto frame = decodeJpeg(jpeg.data(), jpeg.size(), options);
+    ASSERT_NE(frame, nullptr);
+    ASSERT_EQ(frame->getWidth(), region.width);
+    ASSERT_EQ(frame->getHeight(), region.height);
+
+    // a region decode is the crop of the full decode at the same scale
+    for (uint32_t y = 0; y < region.height; ++y) {
+      for (uint32_t x = 0; x < region.width; ++x) {
+        ASSERT_EQ(pixelAt(*frame, x, y), pixelAt(*scaledFrame, x + region.x, y + region.y));
+      }
+    }
+  }
+}
+
+TEST(JpegDecode, InvalidData) {
+  const std::vector<uint8_t> notJpeg(128, 7);
+  EXPECT_EQ(decodeJpeg(notJpeg.data(), notJpeg.size(), {}), nullptr);
+}
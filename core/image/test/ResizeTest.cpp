@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <image/utility/Resize.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace projectaria::tools::image;
+
+TEST(Resize, IntegerFactorAveragesBlocks) {
+  const uint32_t width = 8, height = 6;
+  std::vector<uint8_t> src(width * height);
+  for (uint32_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<uint8_t>(i * 5);
+  }
+  std::vector<uint8_t> dst(4 * 3);
+  resizeAreaU8(src.data(), width, height, width, 1, dst.data(), 4, 3, 4);
+  for (uint32_t y = 0; y < 3; ++y) {
+    for (uint32_t x = 0; x < 4; ++x) {
+      const int sum = src[2 * y * width + 2 * x] + src[2 * y * width + 2 * x + 1] +
+          src[(2 * y + 1) * width + 2 * x] + src[(2 * y + 1) * width + 2 * x + 1];
+      EXPECT_EQ(dst[y * 4 + x], (sum + 2) / 4) << x << "," << y;
+    }
+  }
+}
+
+TEST(Resize, FractionalFactorWeighsOverlap) {
+  // 3 -> 2 pixels: the middle input pixel is split between both output pixels
+  const std::vector<uint8_t> src{0, 90, 180};
+  std::vector<uint8_t> dst(2);
+  resizeAreaU8(src.data(), 3, 1, 3, 1, dst.data(), 2, 1, 2);
+  EXPECT_EQ(dst[0], 30); // (0 * 1 + 90 * 0.5) / 1.5
+  EXPECT_EQ(dst[1], 150); // (90 * 0.5 + 180 * 1) / 1.5
+}
+
+TEST(Resize, ConstantImageAndStrides) {
+  const uint32_t width = 13, height = 7, channels = 3, srcStride = 48, dstStride = 20;
+  std::vector<uint8_t> src(srcStride * height, 0);
+  for (uint32_t y = 0; y < height; ++y) {
+    for (uint32_t x = 0; x < width; ++x) {
+      src[y * srcStride + x * channels] = 10;
+      src[y * srcStride + x * channels + 1] = 200;
+      src[y * srcStride + x * channels + 2] = 255;
+    }
+  }
+  std::vector<uint8_t> dst(dstStride * 3, 7);
+  resizeAreaU8(src.data(), width, height, srcStride, channels, dst.data(), 5, 3, dstStride);
+  for (uint32_t y = 0; y < 3; ++y) {
+    for (uint32_t x = 0; x < 5; ++x) {
+      EXPECT_EQ(dst[y * dstStride + x * channels], 10);
+      EXPECT_EQ(dst[y * dstStride + x * channels + 1], 200);
+      EXPECT_EQ(dst[y * dstStride + x * channels + 2], 255);
+    }
+    // padding past the row is left untouched
+    EXPECT_EQ(dst[y * dstStride + 5 * channels], 7);
+  }
+}
+
+TEST(Resize, ImageVariant) {
+  std::vector<uint8_t> pixels(64 * 48, 100);
+  const ImageVariant src = ImageU8(pixels.data(), 64, 48);
+  const auto dst = resizeImageVariant(src, {16, 12});
+  const auto* resized = std::get_if<ManagedImageU8>(&dst);
+  ASSERT_NE(resized, nullptr);
+  EXPECT_EQ(resized->width(), 16);
+  EXPECT_EQ(resized->height(), 12);
+  EXPECT_EQ((*resized)(3, 4), 100);
+
+  std::vector<uint64_t> wide(16);
+  EXPECT_THROW(
+      resizeImageVariant(ImageVariant{ImageU64(wide.data(), 4, 4)}, {2, 2}), std::runtime_error);
+  EXPECT_THROW(resizeImageVariant(src, {0, 12}), std::runtime_error);
+}
+
+TEST(Resize, ConstantImagesForAllMethods) {
+  std::vector<uint16_t> deep(17 * 9, 1000);
+  std::vector<float> floats(17 * 9 * 3, 0.25f);
+  for (const auto method : {ResizeMethod::Area, ResizeMethod::Bilinear, ResizeMethod::Lanczos3}) {
+    for (const Eigen::Vector2i& size : {Eigen::Vector2i(5, 4), Eigen::Vector2i(40, 21)}) {
+      const auto resizedDeep = std::get<ManagedImageU10>(
+          resizeImageVariant(ImageU10(deep.data(), 17, 9), size, method));
+      const auto resizedFloats = std::get<ManagedImage3F32>(resizeImageVariant(
+          Image3F32(reinterpret_cast<Eigen::Vector3f*>(floats.data()), 17, 9), size, method));
+      ASSERT_EQ(static_cast<int>(resizedDeep.width()), size.x());
+      ASSERT_EQ(static_cast<int>(resizedFloats.height()), size.y());
+      for (int y = 0; y < size.y(); ++y) {
+        for (int x = 0; x < size.x(); ++x) {
+          EXPECT_EQ(resizedDeep(x, y), 1000);
+          EXPECT_NEAR(resizedFloats(x, y)[2], 0.25f, 1e-6);
+        }
+      }
+    }
+  }
+}
+
+TEST(Resize, BilinearInterpolatesPixelCenters) {
+  // upscaling by 2: output pixels are at 1/4 and 3/4 between the input pixels
+  std::vector<float> ramp{0.f, 4.f, 8.f};
+  const auto upscaled = std::get<ManagedImageF32>(
+      resizeImageVariant(ImageF32(ramp.data(), 3, 1), {6, 1}, ResizeMethod::Bilinear));
+  const std::vector<float> expected{0.f, 1.f, 3.f, 5.f, 7.f, 8.f};
+  for (int x = 0; x < 6; ++x) {
+    EXPECT_FLOAT_EQ(upscaled(x, 0), expected[x]) << x;
+  }
+
+  // downscaling by 2: output pixels are between pairs of input pixels
+  std::vector<uint8_t> pixels{0, 10, 20, 30, 40, 51};
+  const auto downscaled = std::get<ManagedImageU8>(
+      resizeImageVariant(ImageU8(pixels.data(), 6, 1), {3, 1}, ResizeMethod::Bilinear));
+  EXPECT_EQ(downscaled(0, 0), 5);
+  EXPECT_EQ(downscaled(1, 0), 25);
+  EXPECT_EQ(downscaled(2, 0), 46);
+}
+
+TEST(Resize, LanczosPreservesRampsAndClamps) {
+  // interior output pixels of a linear ramp stay on the ramp
+  std::vector<float> ramp(32);
+  for (int x = 0; x < 32; ++x) {
+    ramp[x] = static_cast<float>(x);
+  }
+  const auto downscaled = std::get<ManagedImageF32>(
+      resizeImageVariant(ImageF32(ramp.data(), 32, 1), {16, 1}, ResizeMethod::Lanczos3));
+  for (int x = 4; x < 12; ++x) {
+    EXPECT_NEAR(downscaled(x, 0), 2 * x + 0.5f, 0.02f) << x;
+  }
+
+  // the ringing around a step is clamped, not wrapped around 8 bit values
+  std::vector<uint8_t> step{0, 0, 0, 0, 255, 255, 255, 255};
+  const auto upscaled = std::get<ManagedImageU8>(
+      resizeImageVariant(ImageU8(step.data(), 8, 1), {32, 1}, ResizeMethod::Lanczos3));
+  for (int x = 0; x < 12; ++x) {
+    EXPECT_LE(upscaled(x, 0), 30) << x;
+  }
+  for (int x = 20; x < 32; ++x) {
+    EXPECT_GE(upscaled(x, 0), 225) << x;
+  }
+}
+
+TEST(Resize, Pyramids) {
+  const uint32_t width = 13, height = 8;
+  std::vector<uint8_t> pixels(width * height * 3);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<uint8_t>(i * 11);
+  }
+  const Image3U8 src(
+      reinterpret_cast<Eigen::Matrix<uint8_t, 3, 1>*>(pixels.data()), width, height);
+
+  // levels are halved, rounding up, until 1x1
+  const std::vector<Eigen::Vector2i> sizes{{13, 8}, {7, 4}, {4, 2}, {2, 1}, {1, 1}};
+  for (const auto filter : {PyramidFilter::Gaussian, PyramidFilter::Box}) {
+    const auto levels = buildImagePyramid(src, 10, filter);
+    ASSERT_EQ(levels.size(), sizes.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+      const auto& level = std::get<ManagedImage3U8>(levels[i]);
+      EXPECT_EQ(static_cast<int>(level.width()), sizes[i].x());
+      EXPECT_EQ(static_cast<int>(level.height()), sizes[i].y());
+    }
+    EXPECT_EQ(std::get<ManagedImage3U8>(levels[0])(5, 6), src(5, 6));
+  }
+
+  // box levels are the means of 2x2 blocks, the last odd column the mean of 2 pixels
+  const auto levels = buildImagePyramid(src, 2, PyramidFilter::Box);
+  ASSERT_EQ(levels.size(), 2);
+  const auto& level = std::get<ManagedImage3U8>(levels[1]);
+  for (uint32_t y = 0; y < 4; ++y) {
+    for (uint32_t x = 0; x < 7; ++x) {
+      for (int c = 0; c < 3; ++c) {
+        const uint32_t x1 = std::min(2 * x + 1, width - 1);
+        const float mean = (src(2 * x, 2 * y)[c] + src(x1, 2 * y)[c] +
+                            src(2 * x, 2 * y + 1)[c] + src(x1, 2 * y + 1)[c]) /
+            4.f;
+        EXPECT_NEAR(level(x, y)[c], mean, 0.51f) << x << "," << y << "," << c;
+      }
+    }
+  }
+  EXPECT_THROW(buildImagePyramid(src, 0), std::runtime_error);
+}
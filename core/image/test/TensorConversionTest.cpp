@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <image/utility/TensorConversion.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace projectaria::tools::image;
+
+namespace {
+
+// Reference conversion of the pixel value v of channel c: (v / maxValue - mean[c]) / std[c]
+float expectedValue(float value, float maxValue, const TensorConversionOptions& options, int c) {
+  const float mean = options.mean.empty() ? 0.f : options.mean[c];
+  const float stdDev = options.std.empty() ? 1.f : options.std[c];
+  return (value / maxValue - mean) / stdDev;
+}
+
+// Pixels with distinct values in each channel, in rows with padding
+template <class T>
+std::vector<T> makePixels(int width, int height, int channels, int pitchElements, int maxValue) {
+  std::vector<T> pixels(static_cast<size_t>(pitchElements) * height, 0);
+  for (int y = 0; y < height; ++y) {
+    for (int i = 0; i < width * channels; ++i) {
+      pixels[y * pitchElements + i] = static_cast<T>((y * 131 + i * 7) % (maxValue + 1));
+    }
+  }
+  return pixels;
+}
+
+template <int C>
+void checkNormalized(
+    const std::vector<float>& mean,
+    const std::vector<float>& stdDevs,
+    TensorLayout layout) {
+  // widths around the 8 or 16 pixels processed at once by the vector kernels
+  for (const size_t width : {1, 7, 8, 15, 16, 37}) {
+    const size_t height = 3, pitch = width * C + 5;
+    auto pixels = makePixels<uint8_t>(width, height, C, pitch, 255);
+    const Image<Eigen::Matrix<uint8_t, C, 1>> image(
+        reinterpret_cast<Eigen::Matrix<uint8_t, C, 1>*>(pixels.data()), width, height, pitch);
+
+    TensorConversionOptions options;
+    options.mean = mean;
+    options.std = stdDevs;
+    options.layout = layout;
+    const bool chw = layout == TensorLayout::CHW;
+    const auto shape = getTensorShape(image, options);
+    ASSERT_EQ(
+        shape,
+        (chw ? std::array<size_t, 3>{C, height, width} : std::array<size_t, 3>{height, width, C}));
+    std::vector<float> tensor(shape[0] * shape[1] * shape[2]);
+    imageToTensor(image, options, tensor.data());
+    for (size_t c = 0; c < C; ++c) {
+      for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+          EXPECT_NEAR(
+              tensor[chw ? (c * height + y) * width + x : (y * width + x) * C + c],
+              expectedValue(pixels[y * pitch + x * C + c], 255.f, options, c),
+              1e-5)
+              << width << ": " << x << "," << y << "," << c;
+        }
+      }
+    }
+  }
+}
+
+} // namespace
+
+TEST(TensorConversion, ColorToNormalizedChw) {
+  checkNormalized<3>({0.485f, 0.456f, 0.406f}, {0.229f, 0.224f, 0.225f}, TensorLayout::CHW);
+  checkNormalized<2>({0.5f, 0.25f}, {}, TensorLayout::CHW);
+  checkNormalized<4>({}, {0.5f, 1.f, 2.f, 4.f}, TensorLayout::CHW);
+}
+
+TEST(TensorConversion, ColorToNormalizedHwc) {
+  checkNormalized<3>({0.485f, 0.456f, 0.406f}, {0.229f, 0.224f, 0.225f}, TensorLayout::HWC);
+  checkNormalized<2>({0.5f, 0.25f}, {}, TensorLayout::HWC);
+  checkNormalized<4>({}, {0.5f, 1.f, 2.f, 4.f}, TensorLayout::HWC);
+}
+
+TEST(TensorConversion, GrayToRgbAndHwc) {
+  const int width = 21, height = 2;
+  auto pixels = makePixels<uint8_t>(width, height, 1, width, 255);
+  const ImageU8 image(pixels.data(), width, height);
+
+  TensorConversionOptions options;
+  options.grayToRgb = true;
+  options.layout = TensorLayout::HWC;
+  options.mean = {0.1f, 0.2f, 0.3f};
+  ASSERT_EQ(getTensorShape(image, options), (std::array<size_t, 3>{height, width, 3}));
+  std::vector<float> hwc(width * height * 3);
+  imageToTensor(image, options, hwc.data());
+
+  options.layout = TensorLayout::CHW;
+  std::vector<float> chw(width * height * 3);
+  imageToTensor(image, options, chw.data());
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      for (int c = 0; c < 3; ++c) {
+        const float expected = expectedValue(pixels[y * width + x], 255.f, options, c);
+        EXPECT_NEAR(hwc[(y * width + x) * 3 + c], expected, 1e-6);
+        EXPECT_NEAR(chw[(c * height + y) * width + x], expected, 1e-6);
+      }
+    }
+  }
+}
+
+TEST(TensorConversion, DeepImagesToHalf) {
+  const int width = 19, height = 2;
+  auto pixels = makePixels<uint16_t>(width, height, 1, width, 1023);
+  // 10 bit images, e.g. RAW10, are scaled by their max value
+  const ImageU10 image(pixels.data(), width, height);
+  std::vector<Eigen::half> tensor(width * height);
+  imageToTensor(image, {}, tensor.data());
+  for (int i = 0; i < width * height; ++i) {
+    EXPECT_NEAR(static_cast<float>(tensor[i]), pixels[i] / 1023.f, 1e-3) << i;
+  }
+
+  // the max value of the options overrides the one of the image
+  TensorConversionOptions options;
+  options.maxValue = 1.f;
+  options.layout = TensorLayout::HWC;
+  std::vector<float> raw(width * height);
+  imageToTensor(image, options, raw.data());
+  for (int i = 0; i < width * height; ++i) {
+    EXPECT_EQ(raw[i], pixels[i]) << i;
+  }
+
+  // float images are scaled by 1
+  std::vector<float> depths(width * height);
+  for (int i = 0; i < width * height; ++i) {
+    depths[i] = 0.25f * i;
+  }
+  const ImageF32 depthImage(depths.data(), width, height);
+  imageToTensor(depthImage, {}, raw.data());
+  EXPECT_EQ(raw, depths);
+}
+
+TEST(TensorConversion, InvalidOptions) {
+  std::vector<uint8_t> pixels(4 * 4 * 3, 0);
+  const Image3U8 image(reinterpret_cast<Eigen::Matrix<uint8_t, 3, 1>*>(pixels.data()), 4, 4);
+  std::vector<float> tensor(4 * 4 * 3);
+
+  TensorConversionOptions options;
+  options.mean = {0.5f};
+  EXPECT_THROW(imageToTensor(image, options, tensor.data()), std::runtime_error);
+  options.mean.clear();
+  options.std = {1.f, 0.f, 1.f};
+  EXPECT_THROW(imageToTensor(image, options, tensor.data()), std::runtime_error);
+
+  std::vector<uint64_t> wide(16, 0);
+  EXPECT_THROW(imageToTensor(ImageU64(wide.data(), 4, 4), {}, tensor.data()), std::runtime_error);
+}
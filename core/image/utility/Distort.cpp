@@ -16,7 +16,10 @@
 
 #include "Distort.h"
 #include <dispenso/parallel_for.h>
+#include <trace/Trace.h>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
 namespace projectaria::tools::image {
@@ -62,11 +65,73 @@ ManagedImage<T, DefaultImageAllocator<T>, MaxVal> distortImage(
   return dst;
 }
 
+template <class T, int MaxVal>
+ManagedImage<T, DefaultImageAllocator<T>, MaxVal>
+warpImage(const Image<T, MaxVal>& src, const WarpMap& warpMap, const InterpolationMethod method) {
+  ManagedImage<T, DefaultImageAllocator<T>, MaxVal> dst(warpMap.imageSize(0), warpMap.imageSize(1));
+  const size_t width = dst.width();
+
+  dispenso::parallel_for(0, dst.height(), [&](size_t y) {
+    const Eigen::Vector2f* srcPixels = warpMap.srcPixels.data() + y * width;
+    T* dstRow = dst.rowPtr(y);
+    for (size_t x = 0; x < width; ++x) {
+      const Eigen::Vector2f& srcPixel = srcPixels[x];
+      // NaN pixels are out of bounds
+      if (!src.inBounds(srcPixel(0), srcPixel(1), 0.5f)) {
+        dstRow[x] = Zero<T>::val();
+      } else if (method == InterpolationMethod::Bilinear) {
+        dstRow[x] = src(srcPixel(0), srcPixel(1));
+      } else {
+        const Eigen::Vector2i nearestPixel =
+            (srcPixel + Eigen::Vector2f(0.5, 0.5)).template cast<int>();
+        dstRow[x] = src(nearestPixel(0), nearestPixel(1));
+      }
+    }
+  });
+
+  return dst;
+}
+
+WarpMap computeWarpMap(
+    const std::function<std::optional<Eigen::Vector2f>(const Eigen::Vector2f&)>& inverseWarp,
+    const Eigen::Vector2i& imageSize) {
+  PROJECTARIA_TRACE_SCOPE("image::computeWarpMap");
+  WarpMap warpMap;
+  warpMap.imageSize = imageSize;
+  warpMap.srcPixels.resize(static_cast<size_t>(imageSize(0)) * imageSize(1));
+  dispenso::parallel_for(0, imageSize(1), [&](int y) {
+    for (int x = 0; x < imageSize(0); ++x) {
+      std::optional<Eigen::Vector2f> maybeSrcPixel =
+          inverseWarp(Eigen::Vector2f(static_cast<float>(x), static_cast<float>(y)));
+      warpMap.srcPixels[static_cast<size_t>(y) * imageSize(0) + x] = maybeSrcPixel
+          ? *maybeSrcPixel
+          : Eigen::Vector2f::Constant(std::numeric_limits<float>::quiet_NaN());
+    }
+  });
+  return warpMap;
+}
+
+ManagedImageVariant warpImageVariant(
+    const ImageVariant& srcVariant,
+    const WarpMap& warpMap,
+    const InterpolationMethod method) {
+  PROJECTARIA_TRACE_SCOPE("image::warpImageVariant");
+  if (warpMap.srcPixels.size() != static_cast<size_t>(warpMap.imageSize.prod())) {
+    throw std::runtime_error("The warp map does not match its image size");
+  }
+  return std::visit(
+      [&warpMap, &method](const auto& src) {
+        return ManagedImageVariant{warpImage(src, warpMap, method)};
+      },
+      srcVariant);
+}
+
 ManagedImageVariant distortImageVariant(
     const ImageVariant& srcVariant,
     const std::function<std::optional<Eigen::Vector2f>(const Eigen::Vector2f&)>& inverseWarp,
     const Eigen::Vector2i& imageSize,
     const InterpolationMethod method) {
+  PROJECTARIA_TRACE_SCOPE("image::distortImageVariant");
   return std::visit(
       [&inverseWarp, &imageSize, &method](const auto& src) {
         return ManagedImageVariant{distortImage(src, inverseWarp, imageSize, method)};
@@ -17,6 +17,7 @@
 #pragma once
 #include <functional>
 #include <optional>
+#include <vector>
 
 #include <image/ImageVariant.h>
 
@@ -42,4 +43,34 @@ image::ManagedImageVariant distortImageVariant(
     const Eigen::Vector2i& imageSize,
     const InterpolationMethod method = InterpolationMethod::Bilinear);
 
+/**
+ * @brief Mapping from the pixels of an output image to the pixels of an input image, computed once
+ * to warp many images
+ */
+struct WarpMap {
+  Eigen::Vector2i imageSize{0, 0}; // size of the output image
+  // input pixel sampled by each output pixel, row by row. NaN if it samples no input pixel
+  std::vector<Eigen::Vector2f> srcPixels;
+};
+
+/**
+ * @brief Evaluates an inverse warp at every pixel of the output image
+ * @param inverseWarp the 2d mapping from a pixel in the output image to a pixel in the input image
+ * @param imageSize the size of the output image
+ */
+WarpMap computeWarpMap(
+    const std::function<std::optional<Eigen::Vector2f>(const Eigen::Vector2f&)>& inverseWarp,
+    const Eigen::Vector2i& imageSize);
+
+/**
+ * @brief Warps an input image with a precomputed mapping, in a single pass over the output image.
+ * Output pixels sampling no input pixel are set to 0.
+ * @param srcVariant the input image
+ * @param warpMap the mapping from the output image to the input image
+ */
+image::ManagedImageVariant warpImageVariant(
+    const image::ImageVariant& srcVariant,
+    const WarpMap& warpMap,
+    const InterpolationMethod method = InterpolationMethod::Bilinear);
+
 } // namespace projectaria::tools::image
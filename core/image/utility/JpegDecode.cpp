@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JpegDecode.h"
+
+#include <algorithm>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <jpeglib.h>
+
+namespace projectaria::tools::image {
+
+namespace {
+
+uint32_t divideRoundUp(uint32_t value, uint32_t denominator) {
+  return (value + denominator - 1) / denominator;
+}
+
+// libjpeg reports fatal errors through error_exit, which must not return
+struct JpegErrorManager {
+  jpeg_error_mgr manager;
+  std::jmp_buf jumpBuffer;
+};
+
+void onJpegError(j_common_ptr cinfo) {
+  std::longjmp(reinterpret_cast<JpegErrorManager*>(cinfo->err)->jumpBuffer, 1);
+}
+
+void onJpegMessage(j_common_ptr /* cinfo */) {}
+
+} // namespace
+
+ImageRegion getJpegDecodedRegion(
+    uint32_t imageWidth,
+    uint32_t imageHeight,
+    const JpegDecodeOptions& options) {
+  const uint32_t scale = std::max(options.scaleDenominator, 1u);
+  const uint32_t scaledWidth = divideRoundUp(imageWidth, scale);
+  const uint32_t scaledHeight = divideRoundUp(imageHeight, scale);
+  if (!options.roi) {
+    return {0, 0, scaledWidth, scaledHeight};
+  }
+  const ImageRegion& roi = *options.roi;
+  ImageRegion region;
+  region.x = std::min(roi.x / scale, scaledWidth);
+  region.y = std::min(roi.y / scale, scaledHeight);
+  region.width = std::min(divideRoundUp(roi.x + roi.width, scale), scaledWidth) - region.x;
+  region.height = std::min(divideRoundUp(roi.y + roi.height, scale), scaledHeight) - region.y;
+  return region;
+}
+
+std::shared_ptr<vrs::utils::PixelFrame>
+decodeJpeg(const uint8_t* data, size_t size, const JpegDecodeOptions& options) {
+  // everything alive across the setjmp boundary is declared first, so that a decoding error
+  // does not skip any destructor
+  jpeg_decompress_struct cinfo;
+  JpegErrorManager errorManager;
+  std::shared_ptr<vrs::utils::PixelFrame> frame;
+  std::vector<uint8_t> rowBuffer;
+
+  cinfo.err = jpeg_std_error(&errorManager.manager);
+  errorManager.manager.error_exit = onJpegError;
+  errorManager.manager.output_message = onJpegMessage;
+  if (setjmp(errorManager.jumpBuffer)) {
+    jpeg_destroy_decompress(&cinfo);
+    return nullptr;
+  }
+
+  jpeg_create_decompress(&cinfo);
+  jpeg_mem_src(&cinfo, data, static_cast<unsigned long>(size));
+  jpeg_read_header(&cinfo, TRUE);
+
+  const bool isGrey = cinfo.num_components == 1;
+  cinfo.out_color_space = isGrey ? JCS_GRAYSCALE : JCS_RGB;
+  cinfo.scale_num = 1;
+  cinfo.scale_denom = std::max(options.scaleDenominator, 1u);
+  jpeg_start_decompress(&cinfo);
+
+  const ImageRegion region = getJpegDecodedRegion(cinfo.image_width, cinfo.image_height, options);
+  if (region.width == 0 || region.height == 0 ||
+      region.x + region.width > cinfo.output_width ||
+      region.y + region.height > cinfo.output_height) {
+    jpeg_destroy_decompress(&cinfo);
+    return nullptr;
+  }
+
+  const size_t numComponents = isGrey ? 1 : 3;
+  frame = std::make_shared<vrs::utils::PixelFrame>(vrs::ImageContentBlockSpec(
+      isGrey ? vrs::PixelFormat::GREY8 : vrs::PixelFormat::RGB8, region.width, region.height));
+  const size_t stride = frame->getStride();
+
+  // horizontal crop, snapped by libjpeg to a whole iMCU: we copy our columns out of it
+  JDIMENSION cropX = region.x;
+  JDIMENSION cropWidth = region.width;
+  if (cropX != 0 || cropWidth != cinfo.output_width) {
+    jpeg_crop_scanline(&cinfo, &cropX, &cropWidth);
+  }
+  const size_t columnOffset = (region.x - cropX) * numComponents;
+  const bool isDirect = columnOffset == 0 && cinfo.output_width == region.width;
+  if (!isDirect) {
+    rowBuffer.resize(cinfo.output_width * numComponents);
+  }
+
+  // vertical crop: rows above the region are skipped without IDCT, rows below are never read
+  if (region.y > 0) {
+    jpeg_skip_scanlines(&cinfo, region.y);
+  }
+  for (uint32_t row = 0; row < region.height; ++row) {
+    uint8_t* destination = frame->wdata() + row * stride;
+    JSAMPROW rowPointer = isDirect ? destination : rowBuffer.data();
+    if (jpeg_read_scanlines(&cinfo, &rowPointer, 1) != 1) {
+      jpeg_destroy_decompress(&cinfo);
+      return nullptr;
+    }
+    if (!isDirect) {
+      std::memcpy(destination, rowBuffer.data() + columnOffset, region.width * numComponents);
+    }
+  }
+
+  jpeg_abort_decompress(&cinfo);
+  jpeg_destroy_decompress(&cinfo);
+  return frame;
+}
+
+} // namespace projectaria::tools::image
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include <vrs/utils/PixelFrame.h>
+
+namespace projectaria::tools::image {
+
+/**
+ * @brief A rectangular region of an image, in pixels
+ */
+struct ImageRegion {
+  uint32_t x = 0; ///< @brief column of the top left corner
+  uint32_t y = 0; ///< @brief row of the top left corner
+  uint32_t width = 0; ///< @brief number of columns
+  uint32_t height = 0; ///< @brief number of rows
+};
+
+/**
+ * @brief Options to decode a JPEG image at reduced resolution, using DCT domain scaling, and/or to
+ * decode only a region of it
+ */
+struct JpegDecodeOptions {
+  uint32_t scaleDenominator = 1; ///< @brief decode at 1/N of the full resolution, N in {1,2,4,8}
+  std::optional<ImageRegion> roi; ///< @brief region to decode, in full resolution pixels
+
+  /** @brief Returns if these options decode the full image at full resolution */
+  bool isFullImage() const {
+    return scaleDenominator == 1 && !roi;
+  }
+};
+
+/**
+ * @brief Returns the region of the scaled image produced by decoding an image of the given full
+ * resolution with the given options, in scaled pixels. The region of interest is expanded to whole
+ * scaled pixels and clipped to the image.
+ * @param imageWidth width of the full resolution image
+ * @param imageHeight height of the full resolution image
+ * @param options decode options
+ */
+ImageRegion getJpegDecodedRegion(
+    uint32_t imageWidth,
+    uint32_t imageHeight,
+    const JpegDecodeOptions& options);
+
+/**
+ * @brief Decodes a JPEG image to a RGB8 or GREY8 pixel frame, skipping the DCT coefficients and
+ * the rows that are not needed by the requested scale and region.
+ * @param data the compressed JPEG data
+ * @param size number of bytes of compressed data
+ * @param options decode options
+ * @return the decoded region given by getJpegDecodedRegion(), nullptr if decoding failed
+ */
+std::shared_ptr<vrs::utils::PixelFrame>
+decodeJpeg(const uint8_t* data, size_t size, const JpegDecodeOptions& options);
+
+} // namespace projectaria::tools::image
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Resize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <dispenso/parallel_for.h>
+#include <fmt/core.h>
+#include <trace/Trace.h>
+
+namespace projectaria::tools::image {
+
+namespace {
+
+// Contribution of an input pixel to an output pixel, along one axis
+struct Tap {
+  uint32_t src;
+  float weight;
+};
+
+// Taps of each output pixel along one axis: taps[offsets[dst]] to taps[offsets[dst + 1]]
+struct AxisTaps {
+  std::vector<Tap> taps;
+  std::vector<uint32_t> offsets{0};
+
+  void add(uint32_t src, float weight) {
+    taps.push_back({src, weight});
+  }
+  void endPixel() {
+    offsets.push_back(static_cast<uint32_t>(taps.size()));
+  }
+};
+
+// The weights of each output pixel sum to 1
+AxisTaps computeAreaTaps(uint32_t srcSize, uint32_t dstSize) {
+  AxisTaps axisTaps;
+  const double scale = static_cast<double>(srcSize) / dstSize;
+  for (uint32_t dst = 0; dst < dstSize; ++dst) {
+    const double begin = dst * scale;
+    const double end = std::min<double>(begin + scale, srcSize);
+    for (auto src = static_cast<uint32_t>(begin); src < end; ++src) {
+      const double overlap = std::min<double>(src + 1, end) - std::max<double>(src, begin);
+      if (overlap > 1e-6) {
+        axisTaps.add(src, static_cast<float>(overlap / (end - begin)));
+      }
+    }
+    axisTaps.endPixel();
+  }
+  return axisTaps;
+}
+
+// Output pixel centers are mapped to the input image, pixel centers being at integer coordinates
+double toSrcCoordinate(uint32_t dst, double scale) {
+  return (dst + 0.5) * scale - 0.5;
+}
+
+uint32_t clampIndex(int64_t index, uint32_t size) {
+  return static_cast<uint32_t>(std::clamp<int64_t>(index, 0, size - 1));
+}
+
+AxisTaps computeBilinearTaps(uint32_t srcSize, uint32_t dstSize) {
+  AxisTaps axisTaps;
+  const double scale = static_cast<double>(srcSize) / dstSize;
+  for (uint32_t dst = 0; dst < dstSize; ++dst) {
+    const double center = std::clamp(toSrcCoordinate(dst, scale), 0.0, srcSize - 1.0);
+    const auto left = static_cast<uint32_t>(center);
+    const auto rightWeight = static_cast<float>(center - left);
+    axisTaps.add(left, 1.f - rightWeight);
+    if (rightWeight > 0.f) {
+      axisTaps.add(left + 1, rightWeight);
+    }
+    axisTaps.endPixel();
+  }
+  return axisTaps;
+}
+
+double lanczos3(double x) {
+  constexpr double kPi = 3.14159265358979323846;
+  constexpr double kLobes = 3.0;
+  if (std::abs(x) < 1e-9) {
+    return 1.0;
+  }
+  if (std::abs(x) >= kLobes) {
+    return 0.0;
+  }
+  const double piX = kPi * x;
+  return kLobes * std::sin(piX) * std::sin(piX / kLobes) / (piX * piX);
+}
+
+// When downscaling, the filter is widened to the input pixels covered by an output pixel
+AxisTaps computeLanczosTaps(uint32_t srcSize, uint32_t dstSize) {
+  AxisTaps axisTaps;
+  const double scale = static_cast<double>(srcSize) / dstSize;
+  const double filterScale = std::max(scale, 1.0);
+  const double support = 3.0 * filterScale;
+  std::vector<Tap> pixelTaps;
+  for (uint32_t dst = 0; dst < dstSize; ++dst) {
+    const double center = toSrcCoordinate(dst, scale);
+    pixelTaps.clear();
+    double weightSum = 0;
+    for (auto src = static_cast<int64_t>(std::ceil(center - support));
+         src <= static_cast<int64_t>(std::floor(center + support));
+         ++src) {
+      const double weight = lanczos3((src - center) / filterScale);
+      if (weight != 0.0) {
+        // the border pixels are repeated
+        pixelTaps.push_back({clampIndex(src, srcSize), static_cast<float>(weight)});
+        weightSum += weight;
+      }
+    }
+    for (const Tap& tap : pixelTaps) {
+      axisTaps.add(tap.src, static_cast<float>(tap.weight / weightSum));
+    }
+    axisTaps.endPixel();
+  }
+  return axisTaps;
+}
+
+// pyrDown's 5 tap binomial filter, centered on the even input pixels, mirroring the borders
+AxisTaps computeGaussianPyramidTaps(uint32_t srcSize) {
+  AxisTaps axisTaps;
+  constexpr float kWeights[] = {1.f / 16, 4.f / 16, 6.f / 16, 4.f / 16, 1.f / 16};
+  const auto reflect = [srcSize](int64_t index) {
+    if (srcSize == 1) {
+      return uint32_t(0);
+    }
+    const int64_t period = 2 * (static_cast<int64_t>(srcSize) - 1);
+    index = std::abs(index) % period;
+    return static_cast<uint32_t>(index < srcSize ? index : period - index);
+  };
+  for (uint32_t dst = 0; dst < (srcSize + 1) / 2; ++dst) {
+    for (int i = -2; i <= 2; ++i) {
+      axisTaps.add(reflect(2 * static_cast<int64_t>(dst) + i), kWeights[i + 2]);
+    }
+    axisTaps.endPixel();
+  }
+  return axisTaps;
+}
+
+AxisTaps computeBoxPyramidTaps(uint32_t srcSize) {
+  AxisTaps axisTaps;
+  for (uint32_t dst = 0; dst < (srcSize + 1) / 2; ++dst) {
+    if (2 * dst + 1 < srcSize) {
+      axisTaps.add(2 * dst, 0.5f);
+      axisTaps.add(2 * dst + 1, 0.5f);
+    } else {
+      axisTaps.add(2 * dst, 1.f);
+    }
+    axisTaps.endPixel();
+  }
+  return axisTaps;
+}
+
+AxisTaps computeResizeTaps(uint32_t srcSize, uint32_t dstSize, ResizeMethod method) {
+  switch (method) {
+    case ResizeMethod::Area:
+      return computeAreaTaps(srcSize, dstSize);
+    case ResizeMethod::Bilinear:
+      return computeBilinearTaps(srcSize, dstSize);
+    case ResizeMethod::Lanczos3:
+      return computeLanczosTaps(srcSize, dstSize);
+  }
+  throw std::runtime_error("Unknown resize method");
+}
+
+/**
+ * Filters the input rows horizontally into a float buffer, then each output row vertically from
+ * the buffer, in parallel over the rows. Each output value only depends on the input, so the
+ * result is reproducible.
+ * @param maxValue integer values are rounded and clamped to [0, maxValue]
+ */
+template <class Scalar>
+void resizeSeparable(
+    const Scalar* src,
+    size_t srcStride,
+    uint32_t channels,
+    Scalar* dst,
+    size_t dstStride,
+    const AxisTaps& xTaps,
+    const AxisTaps& yTaps,
+    float maxValue) {
+  const size_t dstWidth = xTaps.offsets.size() - 1;
+  const size_t dstHeight = yTaps.offsets.size() - 1;
+  const size_t rowSize = dstWidth * channels;
+
+  // only the input rows within the span read by the vertical filter are filtered
+  uint32_t firstRow = UINT32_MAX;
+  uint32_t lastRow = 0;
+  for (const Tap& tap : yTaps.taps) {
+    firstRow = std::min(firstRow, tap.src);
+    lastRow = std::max(lastRow, tap.src);
+  }
+  std::vector<float> filteredRows((lastRow - firstRow + 1) * rowSize);
+
+  dispenso::parallel_for(firstRow, lastRow + 1, [&](uint32_t srcY) {
+    const auto* in = reinterpret_cast<const Scalar*>(
+        reinterpret_cast<const uint8_t*>(src) + srcY * srcStride);
+    float* out = filteredRows.data() + (srcY - firstRow) * rowSize;
+    for (size_t dstX = 0; dstX < dstWidth; ++dstX) {
+      float* outPixel = out + dstX * channels;
+      std::fill(outPixel, outPixel + channels, 0.f);
+      for (uint32_t t = xTaps.offsets[dstX]; t < xTaps.offsets[dstX + 1]; ++t) {
+        const Tap& tap = xTaps.taps[t];
+        const Scalar* inPixel = in + static_cast<size_t>(tap.src) * channels;
+        for (uint32_t c = 0; c < channels; ++c) {
+          outPixel[c] += tap.weight * inPixel[c];
+        }
+      }
+    }
+  });
+
+  dispenso::parallel_for(size_t(0), dstHeight, [&](size_t dstY) {
+    auto* out = reinterpret_cast<Scalar*>(reinterpret_cast<uint8_t*>(dst) + dstY * dstStride);
+    const Tap* firstTap = yTaps.taps.data() + yTaps.offsets[dstY];
+    const Tap* lastTap = yTaps.taps.data() + yTaps.offsets[dstY + 1];
+    for (size_t i = 0; i < rowSize; ++i) {
+      float value = 0.f;
+      for (const Tap* tap = firstTap; tap != lastTap; ++tap) {
+        value += tap->weight * filteredRows[(tap->src - firstRow) * rowSize + i];
+      }
+      if constexpr (std::is_integral_v<Scalar>) {
+        out[i] = static_cast<Scalar>(std::clamp(value + 0.5f, 0.f, maxValue));
+      } else {
+        out[i] = value;
+      }
+    }
+  });
+}
+
+template <class T, int M>
+using ManagedImageOf = ManagedImage<T, DefaultImageAllocator<T>, M>;
+
+template <class T, int M>
+ManagedImageVariant resizeImage(
+    const Image<T, M>& src,
+    const AxisTaps& xTaps,
+    const AxisTaps& yTaps) {
+  using Scalar = typename DefaultImageValTraits<T>::Scalar;
+  if constexpr (
+      std::is_same_v<Scalar, uint8_t> || std::is_same_v<Scalar, uint16_t> ||
+      std::is_same_v<Scalar, float>) {
+    ManagedImageOf<T, M> dst(xTaps.offsets.size() - 1, yTaps.offsets.size() - 1);
+    resizeSeparable(
+        reinterpret_cast<const Scalar*>(src.data()),
+        src.pitch(),
+        static_cast<uint32_t>(DefaultImageValTraits<T>::channel),
+        reinterpret_cast<Scalar*>(dst.data()),
+        dst.pitch(),
+        xTaps,
+        yTaps,
+        static_cast<float>(M));
+    return dst;
+  } else {
+    throw std::runtime_error(
+        "Only 8 bit, 16 bit and float images with 1 to 4 channels can be resized");
+  }
+}
+
+template <class T, int M>
+ManagedImageVariant copyImage(const Image<T, M>& src) {
+  ManagedImageOf<T, M> dst(src.width(), src.height());
+  for (size_t y = 0; y < src.height(); ++y) {
+    std::copy(src.rowPtr(y), src.rowPtr(y) + src.width(), dst.rowPtr(y));
+  }
+  return dst;
+}
+
+} // namespace
+
+void resizeAreaU8(
+    const uint8_t* src,
+    uint32_t srcWidth,
+    uint32_t srcHeight,
+    size_t srcStride,
+    uint32_t channels,
+    uint8_t* dst,
+    uint32_t dstWidth,
+    uint32_t dstHeight,
+    size_t dstStride) {
+  PROJECTARIA_TRACE_SCOPE("image::resizeAreaU8");
+  if (srcWidth == 0 || srcHeight == 0 || dstWidth == 0 || dstHeight == 0 || channels == 0) {
+    throw std::runtime_error(fmt::format(
+        "Can't resize a {}x{} image to {}x{}", srcWidth, srcHeight, dstWidth, dstHeight));
+  }
+  resizeSeparable(
+      src,
+      srcStride,
+      channels,
+      dst,
+      dstStride,
+      computeAreaTaps(srcWidth, dstWidth),
+      computeAreaTaps(srcHeight, dstHeight),
+      255.f);
+}
+
+ManagedImageVariant resizeImageVariant(
+    const ImageVariant& srcVariant,
+    const Eigen::Vector2i& imageSize,
+    ResizeMethod method) {
+  PROJECTARIA_TRACE_SCOPE("image::resizeImageVariant");
+  const int srcWidth = getWidth(srcVariant);
+  const int srcHeight = getHeight(srcVariant);
+  if (srcWidth <= 0 || srcHeight <= 0 || imageSize.x() <= 0 || imageSize.y() <= 0) {
+    throw std::runtime_error(fmt::format(
+        "Can't resize a {}x{} image to {}x{}",
+        srcWidth,
+        srcHeight,
+        imageSize.x(),
+        imageSize.y()));
+  }
+  const AxisTaps xTaps = computeResizeTaps(srcWidth, imageSize.x(), method);
+  const AxisTaps yTaps = computeResizeTaps(srcHeight, imageSize.y(), method);
+  return std::visit(
+      [&](const auto& src) { return resizeImage(src, xTaps, yTaps); }, srcVariant);
+}
+
+std::vector<ManagedImageVariant> buildImagePyramid(
+    const ImageVariant& srcVariant,
+    int numLevels,
+    PyramidFilter filter) {
+  PROJECTARIA_TRACE_SCOPE("image::buildImagePyramid");
+  if (numLevels < 1 || getWidth(srcVariant) <= 0 || getHeight(srcVariant) <= 0) {
+    throw std::runtime_error(fmt::format(
+        "Can't build a pyramid of {} levels of a {}x{} image",
+        numLevels,
+        getWidth(srcVariant),
+        getHeight(srcVariant)));
+  }
+  std::vector<ManagedImageVariant> levels;
+  levels.push_back(std::visit([](const auto& src) { return copyImage(src); }, srcVariant));
+  while (static_cast<int>(levels.size()) < numLevels) {
+    const ImageVariant previous = toImageVariant(levels.back());
+    const auto width = static_cast<uint32_t>(getWidth(previous));
+    const auto height = static_cast<uint32_t>(getHeight(previous));
+    if (width == 1 && height == 1) {
+      break;
+    }
+    const bool gaussian = filter == PyramidFilter::Gaussian;
+    const AxisTaps xTaps =
+        gaussian ? computeGaussianPyramidTaps(width) : computeBoxPyramidTaps(width);
+    const AxisTaps yTaps =
+        gaussian ? computeGaussianPyramidTaps(height) : computeBoxPyramidTaps(height);
+    levels.push_back(
+        std::visit([&](const auto& src) { return resizeImage(src, xTaps, yTaps); }, previous));
+  }
+  return levels;
+}
+
+} // namespace projectaria::tools::image
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <image/ImageVariant.h>
+
+namespace projectaria::tools::image {
+
+/**
+ * @brief Filters to resize images with
+ */
+enum class ResizeMethod {
+  Area, ///< @brief mean of the input pixels covered by each output pixel, for downscaling
+  Bilinear, ///< @brief bilinear interpolation at the center of each output pixel
+  Lanczos3, ///< @brief separable Lanczos filter with 3 lobes, widened when downscaling
+};
+
+/**
+ * @brief Filters to build image pyramids with
+ */
+enum class PyramidFilter {
+  Gaussian, ///< @brief 5x5 Gaussian blur then every other pixel, like OpenCV's pyrDown
+  Box, ///< @brief mean of each 2x2 block of pixels
+};
+
+/**
+ * @brief Resizes an 8 bit image with an area filter: each output pixel is the mean of the input
+ * pixels it covers, weighted by their overlap, like OpenCV's INTER_AREA. Meant for downscaling.
+ * The result only depends on the input, so it can be used to produce reproducible data.
+ * @param src first row of the input image, channels interleaved
+ * @param srcWidth width of the input image
+ * @param srcHeight height of the input image
+ * @param srcStride number of bytes per row of the input image
+ * @param channels number of channels of both images
+ * @param dst first row of the output image, channels interleaved
+ * @param dstWidth width of the output image
+ * @param dstHeight height of the output image
+ * @param dstStride number of bytes per row of the output image
+ */
+void resizeAreaU8(
+    const uint8_t* src,
+    uint32_t srcWidth,
+    uint32_t srcHeight,
+    size_t srcStride,
+    uint32_t channels,
+    uint8_t* dst,
+    uint32_t dstWidth,
+    uint32_t dstHeight,
+    size_t dstStride);
+
+/**
+ * @brief Resizes an image, with the rows of the output image computed in parallel
+ * @param srcVariant the input image, 8 bit, 16 bit (including 10 and 12 bit) or float, with 1 to 4
+ * channels
+ * @param imageSize the size of the output image
+ * @param method the filter to resize with, see ResizeMethod. Integer pixels are rounded and clamped
+ * to the max value of their type.
+ */
+image::ManagedImageVariant resizeImageVariant(
+    const image::ImageVariant& srcVariant,
+    const Eigen::Vector2i& imageSize,
+    ResizeMethod method = ResizeMethod::Area);
+
+/**
+ * @brief Builds an image pyramid: each level is half the size of the previous one, rounded up
+ * @param srcVariant the input image, of any type supported by resizeImageVariant()
+ * @param numLevels number of levels, including the input image, fewer if a level is 1x1 pixel
+ * @param filter the filter to downscale each level with
+ * @return the levels, the first one being a copy of the input image
+ */
+std::vector<image::ManagedImageVariant> buildImagePyramid(
+    const image::ImageVariant& srcVariant,
+    int numLevels,
+    PyramidFilter filter = PyramidFilter::Gaussian);
+
+} // namespace projectaria::tools::image
@@ -0,0 +1,604 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TensorConversion.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fmt/core.h>
+#include <trace/Trace.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define PROJECTARIA_TOOLS_TENSOR_AVX2
+// AVX2 kernels are compiled for any x86 target, and only called when the CPU supports them
+#define AVX2_FUNCTION __attribute__((target("avx2,fma,f16c")))
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PROJECTARIA_TOOLS_TENSOR_NEON
+#endif
+
+namespace projectaria::tools::image {
+
+namespace {
+
+constexpr int kMaxChannels = 4;
+
+// Channel of the tensor: the image channel it reads, and its value = pixel * scale + offset
+struct ChannelTransform {
+  int srcChannel;
+  float scale;
+  float offset;
+};
+
+// Converts the pixels [begin, end) of a row, the channel k of pixel x going to dstRows[k][x * step]
+template <class Src, class Dst>
+void convertPixelsScalar(
+    const Src* src,
+    int begin,
+    int end,
+    int srcChannels,
+    const ChannelTransform* transforms,
+    int numChannels,
+    Dst* const* dstRows,
+    size_t dstPixelStep) {
+  for (int x = begin; x < end; ++x) {
+    const Src* pixel = src + static_cast<size_t>(x) * srcChannels;
+    for (int k = 0; k < numChannels; ++k) {
+      const ChannelTransform& transform = transforms[k];
+      dstRows[k][x * dstPixelStep] =
+          static_cast<Dst>(pixel[transform.srcChannel] * transform.scale + transform.offset);
+    }
+  }
+}
+
+#ifdef PROJECTARIA_TOOLS_TENSOR_AVX2
+
+bool cpuHasAvx2() {
+  static const bool hasAvx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+      __builtin_cpu_supports("f16c");
+  return hasAvx2;
+}
+
+AVX2_FUNCTION inline void store8(float* dst, __m256 values) {
+  _mm256_storeu_ps(dst, values);
+}
+
+AVX2_FUNCTION inline void store8(Eigen::half* dst, __m256 values) {
+  _mm_storeu_si128(
+      reinterpret_cast<__m128i*>(dst), _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT));
+}
+
+AVX2_FUNCTION inline __m256 load8(const uint8_t* src) {
+  const __m128i values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+  return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(values));
+}
+
+AVX2_FUNCTION inline __m256 load8(const uint16_t* src) {
+  const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+  return _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(values));
+}
+
+AVX2_FUNCTION inline __m256 load8(const float* src) {
+  return _mm256_loadu_ps(src);
+}
+
+// Byte shuffles gathering channel c of 16 pixels with C interleaved 8 bit channels from their
+// p-th 16 bytes, at masks[c][p]. Bytes from other parts are zeroed (-1).
+template <int C>
+constexpr std::array<std::array<std::array<int8_t, 16>, C>, C> deinterleaveMasks() {
+  std::array<std::array<std::array<int8_t, 16>, C>, C> masks{};
+  for (int c = 0; c < C; ++c) {
+    for (int p = 0; p < C; ++p) {
+      for (int i = 0; i < 16; ++i) {
+        const int srcByte = i * C + c;
+        masks[c][p][i] = static_cast<int8_t>(srcByte / 16 == p ? srcByte % 16 : -1);
+      }
+    }
+  }
+  return masks;
+}
+
+// Converts a row of single channel pixels (or of values sharing their transform), 8 at a time.
+// Returns the number of pixels converted.
+template <class Src, class Dst>
+AVX2_FUNCTION int convertPlanePixelsAvx2(
+    const Src* src,
+    int width,
+    const ChannelTransform* transforms,
+    int numChannels,
+    Dst* const* dstRows) {
+  __m256 scales[kMaxChannels];
+  __m256 offsets[kMaxChannels];
+  for (int k = 0; k < numChannels; ++k) {
+    scales[k] = _mm256_set1_ps(transforms[k].scale);
+    offsets[k] = _mm256_set1_ps(transforms[k].offset);
+  }
+  int x = 0;
+  for (; x + 8 <= width; x += 8) {
+    const __m256 values = load8(src + x);
+    for (int k = 0; k < numChannels; ++k) {
+      store8(dstRows[k] + x, _mm256_fmadd_ps(values, scales[k], offsets[k]));
+    }
+  }
+  return x;
+}
+
+// Converts a row of pixels with C interleaved 8 bit channels into planes, 16 at a time.
+// Returns the number of pixels converted.
+template <int C, class Dst>
+AVX2_FUNCTION int convertU8PixelsAvx2(
+    const uint8_t* src,
+    int width,
+    const ChannelTransform* transforms,
+    int numChannels,
+    Dst* const* dstRows) {
+  static constexpr auto kMasks = deinterleaveMasks<C>();
+  __m128i masks[C][C];
+  for (int c = 0; c < C; ++c) {
+    for (int p = 0; p < C; ++p) {
+      masks[c][p] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kMasks[c][p].data()));
+    }
+  }
+  __m256 scales[kMaxChannels];
+  __m256 offsets[kMaxChannels];
+  for (int k = 0; k < numChannels; ++k) {
+    scales[k] = _mm256_set1_ps(transforms[k].scale);
+    offsets[k] = _mm256_set1_ps(transforms[k].offset);
+  }
+  int x = 0;
+  for (; x + 16 <= width; x += 16) {
+    __m128i parts[C];
+    for (int p = 0; p < C; ++p) {
+      parts[p] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (x * C + 16 * p)));
+    }
+    __m128i channels[C];
+    for (int c = 0; c < C; ++c) {
+      channels[c] = _mm_shuffle_epi8(parts[0], masks[c][0]);
+      for (int p = 1; p < C; ++p) {
+        channels[c] = _mm_or_si128(channels[c], _mm_shuffle_epi8(parts[p], masks[c][p]));
+      }
+    }
+    for (int k = 0; k < numChannels; ++k) {
+      const __m128i values = channels[transforms[k].srcChannel];
+      const __m256 low = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(values));
+      const __m256 high = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(values, 8)));
+      store8(dstRows[k] + x, _mm256_fmadd_ps(low, scales[k], offsets[k]));
+      store8(dstRows[k] + x + 8, _mm256_fmadd_ps(high, scales[k], offsets[k]));
+    }
+  }
+  return x;
+}
+
+// Converts a row of values with C interleaved channels, keeping them interleaved, 8 * C at a time:
+// the transforms of the channels repeat across C vectors of 8 lanes.
+// Returns the number of values converted.
+template <int C, class Src, class Dst>
+AVX2_FUNCTION int convertInterleavedAvx2(
+    const Src* src,
+    int size,
+    const ChannelTransform* transforms,
+    Dst* dst) {
+  __m256 scales[C];
+  __m256 offsets[C];
+  for (int v = 0; v < C; ++v) {
+    float laneScales[8];
+    float laneOffsets[8];
+    for (int lane = 0; lane < 8; ++lane) {
+      const ChannelTransform& transform = transforms[(8 * v + lane) % C];
+      laneScales[lane] = transform.scale;
+      laneOffsets[lane] = transform.offset;
+    }
+    scales[v] = _mm256_loadu_ps(laneScales);
+    offsets[v] = _mm256_loadu_ps(laneOffsets);
+  }
+  int i = 0;
+  for (; i + 8 * C <= size; i += 8 * C) {
+    for (int v = 0; v < C; ++v) {
+      store8(dst + i + 8 * v, _mm256_fmadd_ps(load8(src + i + 8 * v), scales[v], offsets[v]));
+    }
+  }
+  return i;
+}
+
+#endif // PROJECTARIA_TOOLS_TENSOR_AVX2
+
+#ifdef PROJECTARIA_TOOLS_TENSOR_NEON
+
+inline void store4(float* dst, float32x4_t values) {
+  vst1q_f32(dst, values);
+}
+
+inline void store4(Eigen::half* dst, float32x4_t values) {
+  vst1_u16(reinterpret_cast<uint16_t*>(dst), vreinterpret_u16_f16(vcvt_f16_f32(values)));
+}
+
+// Loads 16 pixels with C interleaved channels, as 4 float vectors per channel
+template <int C>
+inline void load16(const uint8_t* src, float32x4_t (&out)[C][4]) {
+  uint8x16_t channels[C];
+  if constexpr (C == 1) {
+    channels[0] = vld1q_u8(src);
+  } else if constexpr (C == 2) {
+    const uint8x16x2_t values = vld2q_u8(src);
+    channels[0] = values.val[0];
+    channels[1] = values.val[1];
+  } else if constexpr (C == 3) {
+    const uint8x16x3_t values = vld3q_u8(src);
+    for (int c = 0; c < C; ++c) {
+      channels[c] = values.val[c];
+    }
+  } else {
+    const uint8x16x4_t values = vld4q_u8(src);
+    for (int c = 0; c < C; ++c) {
+      channels[c] = values.val[c];
+    }
+  }
+  for (int c = 0; c < C; ++c) {
+    const uint16x8_t low = vmovl_u8(vget_low_u8(channels[c]));
+    const uint16x8_t high = vmovl_u8(vget_high_u8(channels[c]));
+    out[c][0] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(low)));
+    out[c][1] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(low)));
+    out[c][2] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(high)));
+    out[c][3] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(high)));
+  }
+}
+
+template <int C>
+inline void load16(const uint16_t* src, float32x4_t (&out)[C][4]) {
+  for (int half = 0; half < 2; ++half) {
+    const uint16_t* halfSrc = src + 8 * C * half;
+    uint16x8_t channels[C];
+    if constexpr (C == 1) {
+      channels[0] = vld1q_u16(halfSrc);
+    } else if constexpr (C == 2) {
+      const uint16x8x2_t values = vld2q_u16(halfSrc);
+      channels[0] = values.val[0];
+      channels[1] = values.val[1];
+    } else if constexpr (C == 3) {
+      const uint16x8x3_t values = vld3q_u16(halfSrc);
+      for (int c = 0; c < C; ++c) {
+        channels[c] = values.val[c];
+      }
+    } else {
+      const uint16x8x4_t values = vld4q_u16(halfSrc);
+      for (int c = 0; c < C; ++c) {
+        channels[c] = values.val[c];
+      }
+    }
+    for (int c = 0; c < C; ++c) {
+      out[c][2 * half] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(channels[c])));
+      out[c][2 * half + 1] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(channels[c])));
+    }
+  }
+}
+
+template <int C>
+inline void load16(const float* src, float32x4_t (&out)[C][4]) {
+  for (int quarter = 0; quarter < 4; ++quarter) {
+    const float* quarterSrc = src + 4 * C * quarter;
+    if constexpr (C == 1) {
+      out[0][quarter] = vld1q_f32(quarterSrc);
+    } else if constexpr (C == 2) {
+      const float32x4x2_t values = vld2q_f32(quarterSrc);
+      out[0][quarter] = values.val[0];
+      out[1][quarter] = values.val[1];
+    } else if constexpr (C == 3) {
+      const float32x4x3_t values = vld3q_f32(quarterSrc);
+      for (int c = 0; c < C; ++c) {
+        out[c][quarter] = values.val[c];
+      }
+    } else {
+      const float32x4x4_t values = vld4q_f32(quarterSrc);
+      for (int c = 0; c < C; ++c) {
+        out[c][quarter] = values.val[c];
+      }
+    }
+  }
+}
+
+// Converts a row of pixels with C interleaved channels into planes, 16 at a time.
+// Returns the number of pixels converted.
+template <int C, class Src, class Dst>
+int convertPixelsNeon(
+    const Src* src,
+    int width,
+    const ChannelTransform* transforms,
+    int numChannels,
+    Dst* const* dstRows) {
+  float32x4_t scales[kMaxChannels];
+  float32x4_t offsets[kMaxChannels];
+  for (int k = 0; k < numChannels; ++k) {
+    scales[k] = vdupq_n_f32(transforms[k].scale);
+    offsets[k] = vdupq_n_f32(transforms[k].offset);
+  }
+  int x = 0;
+  for (; x + 16 <= width; x += 16) {
+    float32x4_t channels[C][4];
+    load16<C>(src + static_cast<size_t>(x) * C, channels);
+    for (int k = 0; k < numChannels; ++k) {
+      for (int i = 0; i < 4; ++i) {
+        store4(
+            dstRows[k] + x + 4 * i,
+            vfmaq_f32(offsets[k], channels[transforms[k].srcChannel][i], scales[k]));
+      }
+    }
+  }
+  return x;
+}
+
+// Converts a row of values with C interleaved channels, keeping them interleaved, 16 * C at a
+// time: the transforms of the channels repeat across 4 * C vectors of 4 lanes.
+// Returns the number of values converted.
+template <int C, class Src, class Dst>
+int convertInterleavedNeon(
+    const Src* src,
+    int size,
+    const ChannelTransform* transforms,
+    Dst* dst) {
+  float32x4_t scales[4 * C];
+  float32x4_t offsets[4 * C];
+  for (int v = 0; v < 4 * C; ++v) {
+    float laneScales[4];
+    float laneOffsets[4];
+    for (int lane = 0; lane < 4; ++lane) {
+      const ChannelTransform& transform = transforms[(4 * v + lane) % C];
+      laneScales[lane] = transform.scale;
+      laneOffsets[lane] = transform.offset;
+    }
+    scales[v] = vld1q_f32(laneScales);
+    offsets[v] = vld1q_f32(laneOffsets);
+  }
+  int i = 0;
+  for (; i + 16 * C <= size; i += 16 * C) {
+    for (int part = 0; part < C; ++part) {
+      float32x4_t values[1][4];
+      load16<1>(src + i + 16 * part, values);
+      for (int q = 0; q < 4; ++q) {
+        const int v = 4 * part + q;
+        store4(dst + i + 4 * v, vfmaq_f32(offsets[v], values[0][q], scales[v]));
+      }
+    }
+  }
+  return i;
+}
+
+#endif // PROJECTARIA_TOOLS_TENSOR_NEON
+
+// Converts the first pixels of a row into planes with the vector kernels supported by the CPU.
+// Returns the number of pixels converted, the rest is left to convertPixelsScalar().
+template <class Src, class Dst>
+int convertPixelsVector(
+    const Src* src,
+    int width,
+    int srcChannels,
+    const ChannelTransform* transforms,
+    int numChannels,
+    Dst* const* dstRows) {
+#if defined(PROJECTARIA_TOOLS_TENSOR_AVX2)
+  if (!cpuHasAvx2()) {
+    return 0;
+  }
+  if (srcChannels == 1) {
+    return convertPlanePixelsAvx2(src, width, transforms, numChannels, dstRows);
+  }
+  // wider pixels with several channels are left to the compiler
+  if constexpr (std::is_same_v<Src, uint8_t>) {
+    switch (srcChannels) {
+      case 2:
+        return convertU8PixelsAvx2<2>(src, width, transforms, numChannels, dstRows);
+      case 3:
+        return convertU8PixelsAvx2<3>(src, width, transforms, numChannels, dstRows);
+      case 4:
+        return convertU8PixelsAvx2<4>(src, width, transforms, numChannels, dstRows);
+    }
+  }
+  return 0;
+#elif defined(PROJECTARIA_TOOLS_TENSOR_NEON)
+  switch (srcChannels) {
+    case 1:
+      return convertPixelsNeon<1>(src, width, transforms, numChannels, dstRows);
+    case 2:
+      return convertPixelsNeon<2>(src, width, transforms, numChannels, dstRows);
+    case 3:
+      return convertPixelsNeon<3>(src, width, transforms, numChannels, dstRows);
+    case 4:
+      return convertPixelsNeon<4>(src, width, transforms, numChannels, dstRows);
+  }
+  return 0;
+#else
+  (void)src;
+  (void)width;
+  (void)srcChannels;
+  (void)transforms;
+  (void)numChannels;
+  (void)dstRows;
+  return 0;
+#endif
+}
+
+// Converts the first pixels of a row with interleaved channels, keeping them interleaved, with the
+// vector kernels supported by the CPU. Each tensor channel reads the image channel of same index.
+// Returns the number of pixels converted, the rest is left to convertPixelsScalar().
+template <class Src, class Dst>
+int convertInterleavedVector(
+    const Src* src,
+    int width,
+    int channels,
+    const ChannelTransform* transforms,
+    Dst* dst) {
+  const int size = width * channels;
+#if defined(PROJECTARIA_TOOLS_TENSOR_AVX2)
+  if (!cpuHasAvx2()) {
+    return 0;
+  }
+  switch (channels) {
+    case 1:
+      return convertInterleavedAvx2<1>(src, size, transforms, dst);
+    case 2:
+      return convertInterleavedAvx2<2>(src, size, transforms, dst) / 2;
+    case 3:
+      return convertInterleavedAvx2<3>(src, size, transforms, dst) / 3;
+    case 4:
+      return convertInterleavedAvx2<4>(src, size, transforms, dst) / 4;
+  }
+  return 0;
+#elif defined(PROJECTARIA_TOOLS_TENSOR_NEON)
+  switch (channels) {
+    case 1:
+      return convertInterleavedNeon<1>(src, size, transforms, dst);
+    case 2:
+      return convertInterleavedNeon<2>(src, size, transforms, dst) / 2;
+    case 3:
+      return convertInterleavedNeon<3>(src, size, transforms, dst) / 3;
+    case 4:
+      return convertInterleavedNeon<4>(src, size, transforms, dst) / 4;
+  }
+  return 0;
+#else
+  (void)src;
+  (void)size;
+  (void)transforms;
+  (void)dst;
+  return 0;
+#endif
+}
+
+int getTensorChannels(int imageChannels, const TensorConversionOptions& options) {
+  return options.grayToRgb && imageChannels == 1 ? 3 : imageChannels;
+}
+
+template <class Src, class Dst>
+void convertImage(
+    const Src* src,
+    int width,
+    int height,
+    size_t pitch,
+    int srcChannels,
+    float maxValue,
+    const TensorConversionOptions& options,
+    Dst* dst) {
+  const int numChannels = getTensorChannels(srcChannels, options);
+  for (const auto& [name, values] : {std::make_pair("mean", &options.mean),
+                                     std::make_pair("std", &options.std)}) {
+    if (!values->empty() && values->size() != static_cast<size_t>(numChannels)) {
+      throw std::runtime_error(fmt::format(
+          "Expected {} values of {} for a tensor of {} channels, got {}",
+          numChannels,
+          name,
+          numChannels,
+          values->size()));
+    }
+  }
+  const float scaledMax = options.maxValue.value_or(maxValue);
+  if (!(scaledMax > 0.f)) {
+    throw std::runtime_error(fmt::format("Invalid max value {}", scaledMax));
+  }
+
+  ChannelTransform transforms[kMaxChannels];
+  for (int k = 0; k < numChannels; ++k) {
+    const float mean = options.mean.empty() ? 0.f : options.mean[k];
+    const float stdDev = options.std.empty() ? 1.f : options.std[k];
+    if (stdDev == 0.f) {
+      throw std::runtime_error("Tensor std values can't be 0");
+    }
+    transforms[k] = {srcChannels == 1 ? 0 : k, 1.f / (scaledMax * stdDev), -mean / stdDev};
+  }
+
+  const size_t planeSize = static_cast<size_t>(width) * height;
+  Dst* dstRows[kMaxChannels];
+  for (int y = 0; y < height; ++y) {
+    const Src* srcRow =
+        reinterpret_cast<const Src*>(reinterpret_cast<const uint8_t*>(src) + y * pitch);
+    if (options.layout == TensorLayout::CHW) {
+      for (int k = 0; k < numChannels; ++k) {
+        dstRows[k] = dst + k * planeSize + static_cast<size_t>(y) * width;
+      }
+      const int converted =
+          convertPixelsVector(srcRow, width, srcChannels, transforms, numChannels, dstRows);
+      convertPixelsScalar(
+          srcRow, converted, width, srcChannels, transforms, numChannels, dstRows, 1);
+    } else {
+      for (int k = 0; k < numChannels; ++k) {
+        dstRows[k] = dst + static_cast<size_t>(y) * width * numChannels + k;
+      }
+      // gray to RGB expands each value into 3 channels, which is left to the compiler
+      const int converted = numChannels == srcChannels
+          ? convertInterleavedVector(srcRow, width, srcChannels, transforms, dstRows[0])
+          : 0;
+      convertPixelsScalar(
+          srcRow, converted, width, srcChannels, transforms, numChannels, dstRows, numChannels);
+    }
+  }
+}
+
+template <class Dst>
+struct TensorConversionVisitor {
+  const TensorConversionOptions& options;
+  Dst* dst;
+
+  template <class T, int M>
+  void operator()(const Image<T, M>& image) const {
+    using Scalar = typename DefaultImageValTraits<T>::Scalar;
+    if constexpr (
+        std::is_same_v<Scalar, uint8_t> || std::is_same_v<Scalar, uint16_t> ||
+        std::is_same_v<Scalar, float>) {
+      convertImage(
+          reinterpret_cast<const Scalar*>(image.data()),
+          static_cast<int>(image.width()),
+          static_cast<int>(image.height()),
+          image.pitch(),
+          static_cast<int>(DefaultImageValTraits<T>::channel),
+          static_cast<float>(M),
+          options,
+          dst);
+    } else {
+      throw std::runtime_error(
+          "imageToTensor only supports 8 bit, 16 bit and float images, with 1 to 4 channels");
+    }
+  }
+};
+
+} // namespace
+
+std::array<size_t, 3> getTensorShape(
+    const ImageVariant& image,
+    const TensorConversionOptions& options) {
+  const auto channels = static_cast<size_t>(getTensorChannels(getChannel(image), options));
+  const auto width = static_cast<size_t>(getWidth(image));
+  const auto height = static_cast<size_t>(getHeight(image));
+  if (options.layout == TensorLayout::CHW) {
+    return {channels, height, width};
+  }
+  return {height, width, channels};
+}
+
+void imageToTensor(const ImageVariant& image, const TensorConversionOptions& options, float* dst) {
+  PROJECTARIA_TRACE_SCOPE("image::imageToTensor");
+  std::visit(TensorConversionVisitor<float>{options, dst}, image);
+}
+
+void imageToTensor(
+    const ImageVariant& image,
+    const TensorConversionOptions& options,
+    Eigen::half* dst) {
+  PROJECTARIA_TRACE_SCOPE("image::imageToTensor");
+  std::visit(TensorConversionVisitor<Eigen::half>{options, dst}, image);
+}
+
+} // namespace projectaria::tools::image
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <image/ImageVariant.h>
+
+namespace projectaria::tools::image {
+
+/**
+ * @brief Order of the elements of a tensor
+ */
+enum class TensorLayout {
+  CHW, ///< @brief one plane per channel, as expected by most models
+  HWC, ///< @brief interleaved channels, as in the images
+};
+
+/**
+ * @brief Options of imageToTensor()
+ */
+struct TensorConversionOptions {
+  TensorLayout layout = TensorLayout::CHW;
+  // per channel of the tensor, subtracted from the pixel values scaled to [0, 1]. Empty for 0
+  std::vector<float> mean;
+  // per channel of the tensor, dividing the pixel values once the mean is subtracted. Empty for 1
+  std::vector<float> std;
+  // pixel value scaled to 1. If unset, the max value of the image type: 255 for 8 bit images,
+  // 1023 for 10 bit images (e.g. RAW10), 65535 for 16 bit images, 1 for float images
+  std::optional<float> maxValue;
+  // replicate single channel images into 3 channels, for models taking RGB inputs
+  bool grayToRgb = false;
+};
+
+/**
+ * @brief Returns the shape of the tensor of an image, {channels, height, width} for the CHW
+ * layout, or {height, width, channels} for the HWC layout
+ */
+std::array<size_t, 3> getTensorShape(
+    const ImageVariant& image,
+    const TensorConversionOptions& options = {});
+
+/**
+ * @brief Converts an image into a model input tensor in a single pass: the value v of channel c of
+ * each pixel is written as (v / maxValue - mean[c]) / std[c], in the layout of the options.
+ * Vectorized with AVX2, when the CPU supports it, or with NEON, except for gray to RGB expansion in
+ * the HWC layout.
+ * @param image 8 bit, 16 bit (including 10 and 12 bit) or float image, with 1 to 4 channels
+ * @param options layout and normalization of the tensor
+ * @param dst contiguous tensor with the shape returned by getTensorShape()
+ */
+void imageToTensor(const ImageVariant& image, const TensorConversionOptions& options, float* dst);
+
+/**
+ * @brief Converts an image into a half precision model input tensor, see imageToTensor()
+ */
+void imageToTensor(
+    const ImageVariant& image,
+    const TensorConversionOptions& options,
+    Eigen::half* dst);
+
+} // namespace projectaria::tools::image
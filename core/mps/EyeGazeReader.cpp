@@ -22,6 +22,7 @@
 #endif
 #include "EyeGazeReader.h"
 #include "fast-cpp-csv-parser/csv.h"
+#include <trace/Trace.h>
 
 namespace projectaria::tools::mps {
 
@@ -59,6 +60,7 @@ constexpr std::array<const char*, 18> kEyeGazeVergenceColumns = {
 };
 
 EyeGazes readEyeGazeVergence(const std::string& path) {
+  PROJECTARIA_TRACE_SCOPE("mps::readEyeGazeVergence");
   EyeGazes eyeGazeVergences;
   try {
     io::CSVReader<kEyeGazeVergenceColumns.size()> csv(path);
@@ -109,6 +111,7 @@ EyeGazes readEyeGazeVergence(const std::string& path) {
 }
 
 EyeGazes readEyeGaze(const std::string& path) {
+  PROJECTARIA_TRACE_SCOPE("mps::readEyeGaze");
   // First try to read eye gaze vergence file
   EyeGazes eyeGazes = readEyeGazeVergence(path);
   if (!eyeGazes.empty()) {
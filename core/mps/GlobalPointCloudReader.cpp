@@ -20,6 +20,7 @@
 #define CSV_IO_NO_THREAD
 #endif
 #include <fast-cpp-csv-parser/csv.h>
+#include <trace/Trace.h>
 
 #include <array>
 #include <filesystem>
@@ -43,6 +44,7 @@ GlobalPointCloud readGlobalPointCloud(const std::string& path) {
 GlobalPointCloud readGlobalPointCloud(
     const std::string& path,
     const StreamCompressionMode compression) {
+  PROJECTARIA_TRACE_SCOPE("mps::readGlobalPointCloud");
   GlobalPointCloud cloud;
   try {
     CompressedIStream istream(path, compression);
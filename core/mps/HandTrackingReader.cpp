@@ -31,10 +31,12 @@
 
 #include "HandTracking.h"
 #include "HandTrackingReader.h"
+#include <trace/Trace.h>
 
 namespace projectaria::tools::mps {
 
 WristAndPalmPoses readWristAndPalmPoses(const std::string& filepath) {
+  PROJECTARIA_TRACE_SCOPE("mps::readWristAndPalmPoses");
   WristAndPalmPoses wristAndPalmPoses;
   try {
     io::CSVReader<15> csv(filepath);
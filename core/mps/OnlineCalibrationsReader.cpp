@@ -21,6 +21,7 @@
 
 #include <calibration/loader/SensorCalibrationJson.h>
 #include "OnlineCalibration.h"
+#include <trace/Trace.h>
 
 namespace projectaria::tools::mps {
 
@@ -75,6 +76,7 @@ OnlineCalibration readSingleOnlineCalibFromJsonString(const nlohmann::json& doc)
 } // namespace
 
 OnlineCalibrations readOnlineCalibration(const std::string& filepath) {
+  PROJECTARIA_TRACE_SCOPE("mps::readOnlineCalibration");
   std::ifstream infile(filepath);
   if (infile) {
     std::string jsonCalibrationString = "";
@@ -20,6 +20,7 @@
 #define CSV_IO_NO_THREAD
 #endif
 #include "fast-cpp-csv-parser/csv.h"
+#include <trace/Trace.h>
 
 #include <array>
 #include <filesystem>
@@ -48,6 +49,7 @@ PointObservations readPointObservations(const std::string& path) {
 PointObservations readPointObservations(
     const std::string& path,
     const StreamCompressionMode compression) {
+  PROJECTARIA_TRACE_SCOPE("mps::readPointObservations");
   PointObservations observations;
   try {
     CompressedIStream istream(path, compression);
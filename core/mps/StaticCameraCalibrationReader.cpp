@@ -22,6 +22,7 @@
 #define CSV_IO_NO_THREAD
 #endif
 #include <fast-cpp-csv-parser/csv.h>
+#include <trace/Trace.h>
 
 #include <iostream>
 
@@ -36,6 +37,7 @@ constexpr std::array<const char*, 23> kStaticCameraCalibrationHeader = {
 };
 
 StaticCameraCalibrations readStaticCameraCalibrations(const std::string& fileName) {
+  PROJECTARIA_TRACE_SCOPE("mps::readStaticCameraCalibrations");
   StaticCameraCalibrations poses;
   try {
     io::CSVReader<kStaticCameraCalibrationHeader.size()> csv(fileName);
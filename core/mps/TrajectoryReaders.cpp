@@ -20,6 +20,7 @@
 #define CSV_IO_NO_THREAD
 #endif
 #include "fast-cpp-csv-parser/csv.h"
+#include <trace/Trace.h>
 
 #include <array>
 #include <iostream>
@@ -49,6 +50,7 @@ constexpr std::array<const char*, 20> kOpenLoopTrajectoryColumns = {
     "quality_score"};
 
 OpenLoopTrajectory readOpenLoopTrajectory(const std::string& path) {
+  PROJECTARIA_TRACE_SCOPE("mps::readOpenLoopTrajectory");
   OpenLoopTrajectory trajectory;
   try {
     io::CSVReader<kOpenLoopTrajectoryColumns.size()> csv(path);
@@ -131,6 +133,7 @@ constexpr std::array<const char*, 20> kCloseLoopTrajectoryColumns = {
     "quality_score"};
 
 ClosedLoopTrajectory readClosedLoopTrajectory(const std::string& path) {
+  PROJECTARIA_TRACE_SCOPE("mps::readClosedLoopTrajectory");
   ClosedLoopTrajectory trajectory;
   try {
     io::CSVReader<kCloseLoopTrajectoryColumns.size()> csv(path);
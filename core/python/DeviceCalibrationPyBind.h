@@ -23,6 +23,7 @@
 #include <calibration/ImuMagnetometerCalibrationFormat.h>
 #include <calibration/loader/DeviceCalibrationJson.h>
 #include <calibration/utility/Distort.h>
+#include <calibration/utility/StereoRectification.h>
 
 #include <fmt/format.h>
 #include <sophus/se3.hpp>
@@ -39,6 +40,33 @@ namespace projectaria::tools::calibration {
 namespace py = pybind11;
 
 namespace {
+// (N, 3) points, one per row as numpy arrays hold them
+using PointsArray = Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>;
+
+// projects a batch of points with projectBatch (CameraProjection::projectBatch or
+// CameraCalibration::projectBatchNoChecks) and returns the (N, 2) pixels with the (N, 2, 3) and
+// (N, 2, num_params) Jacobians w.r.t. the points and the projection parameters
+template <typename Calib, typename ProjectBatch>
+py::tuple projectBatchWithJacobians(
+    const Calib& calib,
+    ProjectBatch projectBatch,
+    const Eigen::Ref<const PointsArray>& points) {
+  using projectaria::tools::calibration::CameraProjection;
+  const Eigen::Index numPoints = points.rows();
+  Eigen::Matrix2Xd pixels;
+  CameraProjection::BatchJacobians jacobiansWrtPoint;
+  CameraProjection::BatchJacobians jacobiansWrtParams;
+  {
+    py::gil_scoped_release release;
+    (calib.*projectBatch)(points.transpose(), pixels, &jacobiansWrtPoint, &jacobiansWrtParams);
+  }
+  const Eigen::Index numParams = jacobiansWrtParams.cols();
+  return py::make_tuple(
+      Eigen::Matrix<double, Eigen::Dynamic, 2, Eigen::RowMajor>(pixels.transpose()),
+      py::cast(std::move(jacobiansWrtPoint)).attr("reshape")(numPoints, 2, 3),
+      py::cast(std::move(jacobiansWrtParams)).attr("reshape")(numPoints, 2, numParams));
+}
+
 inline void declareCameraCalibration(py::module& m) {
   using namespace projectaria::tools::calibration;
 
@@ -63,6 +91,21 @@ inline void declareCameraCalibration(py::module& m) {
           py::arg("point_in_camera"),
           "projects a 3d world point in the camera space to a 2d pixel in the image space."
           " No checks performed in this process.")
+      .def(
+          "project_batch",
+          [](const CameraProjection& self, const Eigen::Ref<const PointsArray>& pointsInCamera) {
+            return projectBatchWithJacobians(self, &CameraProjection::projectBatch, pointsInCamera);
+          },
+          py::arg("points_in_camera"),
+          R"pbdoc(projects a batch of 3d points in the camera space to 2d pixels in the image space,
+          with the Jacobians of the pixels w.r.t. the points and the projection parameters. The
+          points are projected in parallel. No checks performed in this process.
+          Args:
+            points_in_camera: the 3d points, as an (N, 3) array.
+          Returns:
+            the (N, 2) pixels, the (N, 2, 3) Jacobians w.r.t. the points and the
+            (N, 2, num_params) Jacobians w.r.t. the projection parameters.
+          )pbdoc")
       .def(
           "unproject",
           &CameraProjection::unproject,
@@ -150,6 +193,22 @@ inline void declareCameraCalibration(py::module& m) {
           py::arg("point_in_camera"),
           "Function to project a 3d point (in camera frame) to a 2d camera pixel location. In this"
           " function, no check is performed.")
+      .def(
+          "project_batch_no_checks",
+          [](const CameraCalibration& self, const Eigen::Ref<const PointsArray>& pointsInCamera) {
+            return projectBatchWithJacobians(
+                self, &CameraCalibration::projectBatchNoChecks, pointsInCamera);
+          },
+          py::arg("points_in_camera"),
+          R"pbdoc(Function to project a batch of 3d points (in camera frame) to 2d camera pixel
+          locations, with the Jacobians of the pixels w.r.t. the points and the projection
+          parameters. In this function, no check is performed.
+          Args:
+            points_in_camera: the 3d points in camera frame, as an (N, 3) array.
+          Returns:
+            the (N, 2) pixels, the (N, 2, 3) Jacobians w.r.t. the points and the
+            (N, 2, num_params) Jacobians w.r.t. projection_params().
+          )pbdoc")
       .def(
           "project",
           &CameraCalibration::project,
@@ -432,10 +491,12 @@ inline void declareDeviceCalibration(py::module& m) {
           " in device calibration.")
       .def(
           "get_camera_calib",
-          &DeviceCalibration::getCameraCalib,
+          &DeviceCalibration::findCameraCalib,
           py::arg("label"),
+          py::return_value_policy::reference_internal,
           "returns a camera calibration by its label. Will return None if label does not exist"
-          " in device calibration.")
+          " in device calibration. The camera calibration is shared with the device calibration"
+          " instead of being copied by each call, and keeps the device calibration alive.")
       .def(
           "get_imu_calib",
           &DeviceCalibration::getImuCalib,
@@ -553,6 +614,79 @@ void declareDistortByCalibration(py::module& m) {
       py::arg("method") = image::InterpolationMethod::Bilinear,
       "Distorts an input image to swap its underlying image distortion model.");
 
+  m.def(
+      "warp_by_calibration",
+      [](py::array_t<T> arraySrc,
+         const CalibrationWarp& warp,
+         const image::InterpolationMethod method) {
+        py::buffer_info info = arraySrc.request();
+
+        size_t imageWidth = arraySrc.shape()[1];
+        size_t imageHeight = arraySrc.shape()[0];
+        bool isRgb = arraySrc.ndim() == 3 && arraySrc.shape()[2] == 3;
+        if (!isRgb) {
+          image::Image<T, MaxVal> imageSrc((T*)info.ptr, imageWidth, imageHeight);
+          image::ManagedImageVariant warped;
+          {
+            py::gil_scoped_release release;
+            warped = warpByCalibration(image::ImageVariant{imageSrc}, warp, method);
+          }
+          return image::toPyArrayVariant(warped);
+        } else {
+          if constexpr (std::is_same<T, uint8_t>::value) {
+            image::Image3U8 imageSrc((Eigen::Vector3<T>*)info.ptr, imageWidth, imageHeight);
+            image::ManagedImageVariant warped;
+            {
+              py::gil_scoped_release release;
+              warped = warpByCalibration(image::ImageVariant{imageSrc}, warp, method);
+            }
+            return image::toPyArrayVariant(warped);
+          } else {
+            throw std::runtime_error("Type is not uint8_t but has 3 channels.");
+          }
+        }
+      },
+      py::arg("arraySrc"),
+      py::arg("warp"),
+      py::arg("method") = image::InterpolationMethod::Bilinear,
+      "Warps an input image with a warp prepared by make_calibration_warp, undistorting, "
+      "rotating and resizing it in a single pass.");
+
+  m.def(
+      "rectify_stereo_pair",
+      [](py::array_t<T> arrayLeft,
+         py::array_t<T> arrayRight,
+         const StereoRectification& rectification,
+         const image::InterpolationMethod method) {
+        py::buffer_info infoLeft = arrayLeft.request();
+        py::buffer_info infoRight = arrayRight.request();
+        if (arrayLeft.ndim() != 2 || arrayRight.ndim() != 2) {
+          throw std::runtime_error("Stereo images should have a single channel.");
+        }
+        image::Image<T, MaxVal> imageLeft(
+            (T*)infoLeft.ptr, arrayLeft.shape()[1], arrayLeft.shape()[0]);
+        image::Image<T, MaxVal> imageRight(
+            (T*)infoRight.ptr, arrayRight.shape()[1], arrayRight.shape()[0]);
+        std::pair<image::ManagedImageVariant, image::ManagedImageVariant> rectified;
+        {
+          py::gil_scoped_release release;
+          rectified = rectifyStereoPair(
+              image::ImageVariant{imageLeft},
+              image::ImageVariant{imageRight},
+              rectification,
+              method);
+        }
+        return py::make_tuple(
+            image::toPyArrayVariant(rectified.first), image::toPyArrayVariant(rectified.second));
+      },
+      py::arg("array_left"),
+      py::arg("array_right"),
+      py::arg("rectification"),
+      py::arg("method") = image::InterpolationMethod::Bilinear,
+      "Rectifies a stereo pair of images with a rectification prepared by "
+      "make_stereo_rectification, warping both images in parallel. Returns the rectified left "
+      "and right images.");
+
   m.def(
       "distort_depth_by_calibration",
       [](py::array_t<T> arraySrc,
@@ -598,6 +732,114 @@ void declareDistortByCalibration(py::module& m) {
       "Distorts an input image label using InterpolationMethod::NearestNeighbor to swap its underlying image distortion model.");
 }
 
+inline void declareCalibrationWarp(py::module& m) {
+  py::enum_<ImageRotation>(
+      m, "ImageRotation", "Clockwise in-plane rotation of the output images of a warp.")
+      .value("NONE", ImageRotation::None)
+      .value("CW90", ImageRotation::CW90)
+      .value("ROTATE_180", ImageRotation::Rotate180)
+      .value("CCW90", ImageRotation::CCW90)
+      .export_values();
+
+  py::class_<CalibrationWarp>(
+      m,
+      "CalibrationWarp",
+      "A warp from the images of a camera to the images of another camera model, with the mapping "
+      "of the pixels computed once to warp many images.")
+      .def_readonly(
+          "dst_calib", &CalibrationWarp::dstCalib, "The calibration of the warped images.")
+      .def_property_readonly(
+          "image_size",
+          [](const CalibrationWarp& self) { return self.warpMap.imageSize; },
+          "The size of the warped images.");
+
+  m.def(
+      "make_calibration_warp",
+      py::overload_cast<
+          const CameraCalibration&,
+          CameraProjection::ModelType,
+          const Eigen::Vector2i&,
+          double,
+          ImageRotation>(&makeCalibrationWarp),
+      py::arg("src_calib"),
+      py::arg("dst_model_type"),
+      py::arg("dst_image_size"),
+      py::arg("dst_focal_length"),
+      py::arg("rotation") = ImageRotation::None,
+      py::call_guard<py::gil_scoped_release>(),
+      "Prepares a warp undistorting, rotating and resizing the images of a camera in a single "
+      "pass: the output images are seen by a LINEAR or SPHERICAL camera with its principal point "
+      "at the image center, rotated in-plane from the input camera. dst_image_size is the size of "
+      "the output images once rotated, and the extrinsics of warp.dst_calib account for the "
+      "rotation, as with rotate_camera_calib_cw90deg.");
+
+  m.def(
+      "make_calibration_warp",
+      py::overload_cast<const CameraCalibration&, const CameraCalibration&>(&makeCalibrationWarp),
+      py::arg("src_calib"),
+      py::arg("dst_calib"),
+      py::call_guard<py::gil_scoped_release>(),
+      "Prepares a warp from the images of a camera to the images of another camera at the same "
+      "position, e.g. a rectified camera. The rotation between the cameras is that of their "
+      "extrinsics, the translation between them is ignored.");
+}
+
+inline void declareStereoRectification(py::module& m) {
+  py::class_<StereoRectification>(
+      m,
+      "StereoRectification",
+      "Rectification of a stereo pair of cameras, e.g. camera-slam-left and camera-slam-right. "
+      "The rectified cameras are LINEAR cameras with the same orientation, image size and focal "
+      "length, whose x axis is along the baseline from the left to the right camera. A 3D point "
+      "is seen on the same row of both rectified images, with a disparity u_left - u_right of "
+      "focal_length * baseline / depth pixels.")
+      .def_readonly(
+          "left_warp",
+          &StereoRectification::leftWarp,
+          "The warp from the left images to the rectified left images.")
+      .def_readonly(
+          "right_warp",
+          &StereoRectification::rightWarp,
+          "The warp from the right images to the rectified right images.")
+      .def_readonly(
+          "baseline",
+          &StereoRectification::baseline,
+          "The distance between the centers of the cameras, in meters.")
+      .def_property_readonly(
+          "left_calib",
+          &StereoRectification::getLeftCalib,
+          "The calibration of the rectified left camera.")
+      .def_property_readonly(
+          "right_calib",
+          &StereoRectification::getRightCalib,
+          "The calibration of the rectified right camera.")
+      .def_property_readonly(
+          "focal_length",
+          &StereoRectification::getFocalLength,
+          "The focal length of the rectified cameras, in pixels.")
+      .def(
+          "disparity_to_depth",
+          &StereoRectification::disparityToDepth,
+          py::arg("disparity"),
+          "Depth along the optical axis of the rectified cameras of a point, in meters, from its "
+          "disparity u_left - u_right in the rectified images, in pixels.");
+
+  m.def(
+      "make_stereo_rectification",
+      &makeStereoRectification,
+      py::arg("left_calib"),
+      py::arg("right_calib"),
+      py::arg("image_size"),
+      py::arg("focal_length") = std::nullopt,
+      py::call_guard<py::gil_scoped_release>(),
+      "Computes the rectifying rotations of a stereo pair of cameras from their extrinsics, and "
+      "prepares the warps of their images to the rectified cameras. The optical axis of the "
+      "rectified cameras is the average of the optical axes of the cameras, made orthogonal to the "
+      "baseline. focal_length defaults to the one of the left camera scaled to the width of the "
+      "rectified images. LINEAR cameras see less than 180 degrees, so the rectified images of "
+      "fisheye cameras cover their central part only.");
+}
+
 inline void declareDistortByCalibrationAll(py::module& m) {
   declareDistortByCalibration<uint8_t>(m);
   declareDistortByCalibration<float>(m);
@@ -611,6 +853,8 @@ inline void exportDeviceCalibration(py::module& m) {
 
   declareSensorCalibration(m);
   declareDeviceCalibration(m);
+  declareCalibrationWarp(m);
+  declareStereoRectification(m);
   declareDistortByCalibrationAll(m);
 }
 } // namespace projectaria::tools::calibration
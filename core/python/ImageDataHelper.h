@@ -17,6 +17,8 @@
 #pragma once
 
 #include <image/ImageVariant.h>
+#include <image/utility/TensorConversion.h>
+#include <trace/Trace.h>
 
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
@@ -35,6 +37,15 @@ using PyArrayVariant = std::variant<
 inline PyArrayVariant toPyArrayVariant(const ImageVariant& imageVariant);
 inline PyArrayVariant toPyArrayVariant(const ManagedImageVariant& imageVariant);
 
+/**
+ * @brief Converts an image into a preallocated float32 or float16 numpy array, see imageToTensor()
+ * @param out C contiguous array with the shape of the tensor, e.g. an element of a batch
+ */
+inline void writeTensor(
+    const ImageVariant& imageVariant,
+    const TensorConversionOptions& options,
+    py::array& out);
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 // Implementation below
 
@@ -59,11 +70,41 @@ struct PyArrayVariantVisitor {
 };
 
 inline PyArrayVariant toPyArrayVariant(const ImageVariant& imageVariant) {
+  PROJECTARIA_TRACE_SCOPE("python::toPyArrayVariant");
   return std::visit(PyArrayVariantVisitor(), imageVariant);
 }
 
 inline PyArrayVariant toPyArrayVariant(const ManagedImageVariant& imageVariant) {
+  PROJECTARIA_TRACE_SCOPE("python::toPyArrayVariant");
   return std::visit(PyArrayVariantVisitor(), imageVariant);
 }
 
+inline void writeTensor(
+    const ImageVariant& imageVariant,
+    const TensorConversionOptions& options,
+    py::array& out) {
+  PROJECTARIA_TRACE_SCOPE("python::writeTensor");
+  const auto shape = getTensorShape(imageVariant, options);
+  if (out.ndim() != 3 || static_cast<size_t>(out.shape(0)) != shape[0] ||
+      static_cast<size_t>(out.shape(1)) != shape[1] ||
+      static_cast<size_t>(out.shape(2)) != shape[2]) {
+    throw std::runtime_error(
+        "Expected an output array of shape (" + std::to_string(shape[0]) + ", " +
+        std::to_string(shape[1]) + ", " + std::to_string(shape[2]) + ")");
+  }
+  if (!(out.flags() & py::array::c_style) || !out.writeable()) {
+    throw std::runtime_error("The output array must be C contiguous and writeable");
+  }
+  if (out.dtype().kind() != 'f' || (out.itemsize() != 4 && out.itemsize() != 2)) {
+    throw std::runtime_error("The output array must be of type float32 or float16");
+  }
+  void* dst = out.mutable_data();
+  py::gil_scoped_release release;
+  if (out.itemsize() == 4) {
+    imageToTensor(imageVariant, options, static_cast<float*>(dst));
+  } else {
+    imageToTensor(imageVariant, options, static_cast<Eigen::half*>(dst));
+  }
+}
+
 } // namespace projectaria::tools::image
@@ -21,6 +21,9 @@
 #include <image/ImageVariant.h>
 #include <image/utility/Debayer.h>
 #include <image/utility/Distort.h>
+#include <image/utility/JpegDecode.h>
+#include <image/utility/Resize.h>
+#include <image/utility/TensorConversion.h>
 
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
@@ -82,6 +85,191 @@ void declare_interpolationMethod(py::module& module) {
       .export_values();
 }
 
+void declare_jpegDecodeOptions(py::module& module) {
+  py::class_<ImageRegion>(module, "ImageRegion", "A rectangular region of an image, in pixels.")
+      .def(py::init<>())
+      .def(
+          py::init([](uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+            return ImageRegion{x, y, width, height};
+          }),
+          py::arg("x"),
+          py::arg("y"),
+          py::arg("width"),
+          py::arg("height"))
+      .def_readwrite("x", &ImageRegion::x)
+      .def_readwrite("y", &ImageRegion::y)
+      .def_readwrite("width", &ImageRegion::width)
+      .def_readwrite("height", &ImageRegion::height);
+
+  py::class_<JpegDecodeOptions>(
+      module,
+      "JpegDecodeOptions",
+      "Options to decode a JPEG image at reduced resolution and/or only a region of it.")
+      .def(py::init<>())
+      .def_readwrite(
+          "scale_denominator",
+          &JpegDecodeOptions::scaleDenominator,
+          "Decode at 1/N of the full resolution, N in {1, 2, 4, 8}.")
+      .def_readwrite(
+          "roi", &JpegDecodeOptions::roi, "Region to decode, in full resolution pixels.");
+}
+
+// Views a numpy array of shape (height, width) or (height, width, channels) as an image
+template <class T>
+ImageVariant toImageVariant(py::array& array) {
+  const auto height = static_cast<size_t>(array.shape(0));
+  const auto width = static_cast<size_t>(array.shape(1));
+  const auto channels = array.ndim() == 3 ? static_cast<size_t>(array.shape(2)) : 1;
+  if (array.strides(array.ndim() - 1) != static_cast<py::ssize_t>(sizeof(T)) ||
+      (array.ndim() == 3 && array.strides(1) != static_cast<py::ssize_t>(channels * sizeof(T)))) {
+    throw std::runtime_error("The pixels of the image array must be contiguous");
+  }
+  auto* data = const_cast<T*>(static_cast<const T*>(array.data()));
+  const auto pitch = static_cast<size_t>(array.strides(0));
+  switch (channels) {
+    case 1:
+      return Image<T>(data, width, height, pitch);
+    case 2:
+      return Image<Eigen::Matrix<T, 2, 1>>(
+          reinterpret_cast<Eigen::Matrix<T, 2, 1>*>(data), width, height, pitch);
+    case 3:
+      return Image<Eigen::Matrix<T, 3, 1>>(
+          reinterpret_cast<Eigen::Matrix<T, 3, 1>*>(data), width, height, pitch);
+    default:
+      if constexpr (!std::is_same_v<T, uint16_t>) {
+        if (channels == 4) {
+          return Image<Eigen::Matrix<T, 4, 1>>(
+              reinterpret_cast<Eigen::Matrix<T, 4, 1>*>(data), width, height, pitch);
+        }
+      }
+      throw std::runtime_error("Unsupported number of channels " + std::to_string(channels));
+  }
+}
+
+// Calls f with an image array viewed as an image
+template <class F>
+auto visitImageArray(py::array& image, F&& f) {
+  if (image.ndim() != 2 && image.ndim() != 3) {
+    throw std::runtime_error("Expected an image array of shape (height, width[, channels])");
+  }
+  const py::dtype dtype = image.dtype();
+  if (dtype.is(py::dtype::of<uint8_t>())) {
+    return f(toImageVariant<uint8_t>(image));
+  } else if (dtype.is(py::dtype::of<uint16_t>())) {
+    return f(toImageVariant<uint16_t>(image));
+  } else if (dtype.is(py::dtype::of<float>())) {
+    return f(toImageVariant<float>(image));
+  }
+  throw std::runtime_error("Expected an image array of type uint8, uint16 or float32");
+}
+
+void declare_tensorConversion(py::module& module) {
+  py::enum_<TensorLayout>(module, "TensorLayout", "Order of the elements of a tensor.")
+      .value("CHW", TensorLayout::CHW, "one plane per channel, as expected by most models")
+      .value("HWC", TensorLayout::HWC, "interleaved channels, as in the images")
+      .export_values();
+
+  py::class_<TensorConversionOptions>(
+      module,
+      "TensorConversionOptions",
+      "Options to convert an image into a model input tensor: each pixel value v of channel c is "
+      "written as (v / max_value - mean[c]) / std[c].")
+      .def(py::init<>())
+      .def_readwrite("layout", &TensorConversionOptions::layout)
+      .def_readwrite(
+          "mean",
+          &TensorConversionOptions::mean,
+          "Per channel of the tensor, subtracted from the pixel values scaled to [0, 1]. "
+          "Empty for 0.")
+      .def_readwrite(
+          "std",
+          &TensorConversionOptions::std,
+          "Per channel of the tensor, dividing the pixel values once the mean is subtracted. "
+          "Empty for 1.")
+      .def_readwrite(
+          "max_value",
+          &TensorConversionOptions::maxValue,
+          "Pixel value scaled to 1. If None, the max value of the image type: 255 for 8 bit "
+          "images, 1023 for 10 bit images, 65535 for 16 bit images, 1 for float images.")
+      .def_readwrite(
+          "gray_to_rgb",
+          &TensorConversionOptions::grayToRgb,
+          "Replicate single channel images into 3 channels.");
+
+  module.def(
+      "image_to_tensor",
+      [](py::array image, py::array& out, const TensorConversionOptions& options) {
+        visitImageArray(
+            image, [&](const ImageVariant& src) { writeTensor(src, options, out); });
+      },
+      py::arg("image"),
+      py::arg("out"),
+      py::arg("options") = TensorConversionOptions(),
+      "Converts an image array into a preallocated float32 or float16 array, e.g. an element of a "
+      "batch, in a single pass. uint16 images are scaled by 65535, unless options.max_value is "
+      "set, e.g. to 1023 for 10 bit images.");
+}
+
+void declare_resize(py::module& module) {
+  py::enum_<ResizeMethod>(module, "ResizeMethod", "Filters to resize images with.")
+      .value(
+          "AREA",
+          ResizeMethod::Area,
+          "mean of the input pixels covered by each output pixel, for downscaling")
+      .value(
+          "BILINEAR",
+          ResizeMethod::Bilinear,
+          "bilinear interpolation at the center of each output pixel")
+      .value(
+          "LANCZOS3",
+          ResizeMethod::Lanczos3,
+          "separable Lanczos filter with 3 lobes, widened when downscaling")
+      .export_values();
+
+  py::enum_<PyramidFilter>(module, "PyramidFilter", "Filters to build image pyramids with.")
+      .value(
+          "GAUSSIAN",
+          PyramidFilter::Gaussian,
+          "5x5 Gaussian blur then every other pixel, like OpenCV's pyrDown")
+      .value("BOX", PyramidFilter::Box, "mean of each 2x2 block of pixels")
+      .export_values();
+
+  module.def(
+      "resize",
+      [](py::array image, int width, int height, ResizeMethod method) {
+        const ManagedImageVariant resized = visitImageArray(image, [&](const ImageVariant& src) {
+          py::gil_scoped_release release;
+          return resizeImageVariant(src, {width, height}, method);
+        });
+        return toPyArrayVariant(resized);
+      },
+      py::arg("image"),
+      py::arg("width"),
+      py::arg("height"),
+      py::arg("method") = ResizeMethod::Area,
+      "Resizes a uint8, uint16 or float32 image array of shape (height, width[, channels]).");
+
+  module.def(
+      "build_pyramid",
+      [](py::array image, int numLevels, PyramidFilter filter) {
+        const std::vector<ManagedImageVariant> levels =
+            visitImageArray(image, [&](const ImageVariant& src) {
+              py::gil_scoped_release release;
+              return buildImagePyramid(src, numLevels, filter);
+            });
+        std::vector<PyArrayVariant> arrays;
+        for (const auto& level : levels) {
+          arrays.push_back(toPyArrayVariant(level));
+        }
+        return arrays;
+      },
+      py::arg("image"),
+      py::arg("num_levels"),
+      py::arg("filter") = PyramidFilter::Gaussian,
+      "Builds an image pyramid of a uint8, uint16 or float32 image array: each level is half the "
+      "size of the previous one, rounded up, the first level being the input image.");
+}
+
 inline void exportImage(py::module& m) {
   // For submodule documentation, see: projectaria_tools/projectaria_tools/core/image.py
 
@@ -101,5 +289,11 @@ inline void exportImage(py::module& m) {
   declare_debayer(m);
 
   declare_interpolationMethod(m);
+
+  declare_jpegDecodeOptions(m);
+
+  declare_tensorConversion(m);
+
+  declare_resize(m);
 }
 } // namespace projectaria::tools::image
@@ -145,6 +145,25 @@ inline void declareImageDataRecord(py::module& m) {
             return image::toPyArrayVariant(self.imageVariant().value());
           },
           "Converts to numpy array")
+      .def(
+          "to_tensor",
+          [](const ImageData& self, py::array& out, const image::TensorConversionOptions& options) {
+            checkAndThrow(self.isValid());
+            image::writeTensor(self.imageVariant().value(), options, out);
+          },
+          py::arg("out"),
+          py::arg("options") = image::TensorConversionOptions(),
+          "Converts the image into a preallocated float32 or float16 numpy array of the shape "
+          "returned by get_tensor_shape(), e.g. an element of a batch, scaling and normalizing the "
+          "pixel values as set by the options, without intermediate copies.")
+      .def(
+          "get_tensor_shape",
+          [](const ImageData& self, const image::TensorConversionOptions& options) {
+            checkAndThrow(self.isValid());
+            return image::getTensorShape(self.imageVariant().value(), options);
+          },
+          py::arg("options") = image::TensorConversionOptions(),
+          "Returns the shape of the tensor of the image, as converted by to_tensor()")
       .def(
           "at",
           [](const ImageData& self, int x, int y, int channel) -> image::PixelValueVariant {
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <trace/Trace.h>
+
+namespace py = pybind11;
+
+namespace projectaria::tools::trace {
+
+inline void exportTrace(py::module& m) {
+  // For submodule documentation, see: projectaria_tools/projectaria_tools/core/trace.py
+
+  py::class_<TraceStats>(m, "TraceStats", "Aggregated timings of a traced scope.")
+      .def_readonly("count", &TraceStats::count)
+      .def_readonly("total_ns", &TraceStats::totalNs)
+      .def_readonly("max_ns", &TraceStats::maxNs)
+      .def("__repr__", [](const TraceStats& stats) {
+        return "TraceStats(count=" + std::to_string(stats.count) +
+            ", total_ns=" + std::to_string(stats.totalNs) +
+            ", max_ns=" + std::to_string(stats.maxNs) + ")";
+      });
+
+  m.def(
+      "is_tracing_compiled_in",
+      &isTracingCompiledIn,
+      "Returns if the library was built with PROJECTARIA_TOOLS_ENABLE_TRACING.");
+  m.def(
+      "get_trace_stats",
+      &getTraceStats,
+      "Returns a dict of the timings of all the traced scopes, by scope name.");
+  m.def("reset_trace_stats", &resetTraceStats, "Resets the timings of all the traced scopes.");
+  m.def(
+      "start_trace_event_capture",
+      &startTraceEventCapture,
+      py::arg("max_events_per_thread") = 1 << 16,
+      "Starts capturing one event per run of a traced scope, for the Chrome trace export.");
+  m.def("stop_trace_event_capture", &stopTraceEventCapture, "Stops capturing events.");
+  m.def(
+      "get_dropped_trace_event_count",
+      &getDroppedTraceEventCount,
+      "Returns the number of events dropped because a thread buffer was full.");
+  m.def(
+      "get_chrome_trace_json",
+      &getChromeTraceJson,
+      "Returns the captured events in the Chrome trace event format.");
+  m.def(
+      "write_chrome_trace",
+      &writeChromeTrace,
+      py::arg("path"),
+      "Writes the captured events to a Chrome trace file, loadable by chrome://tracing or Perfetto.");
+}
+
+} // namespace projectaria::tools::trace
@@ -140,7 +140,28 @@ inline void declareDeliverQueued(py::module& m) {
           &DeliverQueuedOptions::setSubsampleRate,
           py::arg("stream_id"),
           py::arg("rate"),
-          "Sets how many times the frame rate is downsampled in a stream i.e, after a data is played, rate - 1 data are skipped.");
+          "Sets how many times the frame rate is downsampled in a stream i.e, after a data is played, rate - 1 data are skipped.")
+      .def(
+          "get_read_content",
+          &DeliverQueuedOptions::getReadContent,
+          py::arg("stream_id"),
+          "Returns if the image or audio content of a stream is read, or only its metadata.")
+      .def(
+          "set_read_content",
+          [](DeliverQueuedOptions& self, const vrs::StreamId& streamId, bool readContent) {
+            self.setReadContent(streamId, readContent);
+          },
+          py::arg("stream_id"),
+          py::arg("read_content"),
+          "Sets if the image or audio content of a stream is read. When turned off, images are delivered with their record and an empty frame, and audio with its record and no samples.")
+      .def(
+          "set_read_content",
+          [](DeliverQueuedOptions& self, const vrs::RecordableTypeId& typeId, bool readContent) {
+            self.setReadContent(typeId, readContent);
+          },
+          py::arg("type_id"),
+          py::arg("read_content"),
+          "Sets if the image or audio content is read for all streams of a specific type.");
 
   py::class_<SensorDataIterator>(
       m, "SensorDataIterator", "Forward iterator for a sensor data container")
@@ -152,6 +173,118 @@ inline void declareDeliverQueued(py::module& m) {
       .def(py::init<VrsDataProvider*, const DeliverQueuedOptions&>());
 }
 
+inline void declareAccessPattern(py::module& m) {
+  py::enum_<AccessPattern>(
+      m, "AccessPattern", "Pattern in which data are read, to read ahead the records.")
+      .value("RANDOM", AccessPattern::Random)
+      .value("SEQUENTIAL", AccessPattern::Sequential)
+      .value("STRIDED", AccessPattern::Strided);
+}
+
+inline void declareImageFrameCache(py::module& m) {
+  py::class_<ImageFrameCache::Stats>(
+      m, "ImageCacheStats", "Counters and memory use of the decoded image cache.")
+      .def_readonly("hits", &ImageFrameCache::Stats::hits)
+      .def_readonly("misses", &ImageFrameCache::Stats::misses)
+      .def_readonly("evictions", &ImageFrameCache::Stats::evictions)
+      .def_readonly("num_frames", &ImageFrameCache::Stats::numFrames)
+      .def_readonly("num_bytes", &ImageFrameCache::Stats::numBytes)
+      .def_readonly("max_bytes", &ImageFrameCache::Stats::maxBytes);
+}
+
+// Python iterator over a FrameSetSequence, reading and decoding each set with the GIL released
+struct PyFrameSetIterator {
+  FrameSetIterator current;
+  FrameSetIterator end;
+  bool started = false;
+};
+
+inline void declareFrameSets(py::module& m) {
+  py::class_<FrameSetOptions>(
+      m,
+      "FrameSetOptions",
+      "Options to group the frames of several image streams by capture time.")
+      .def(py::init<>())
+      .def_readwrite(
+          "stream_ids",
+          &FrameSetOptions::streamIds,
+          "Image streams of a set, in the order of its frames.")
+      .def_readwrite(
+          "tolerance_ns",
+          &FrameSetOptions::toleranceNs,
+          "Max time between the first and last frame of a set.")
+      .def_readwrite(
+          "time_domain",
+          &FrameSetOptions::timeDomain,
+          "Time domain the frames are matched in. RECORD_TIME is matched from the vrs index alone.")
+      .def_readwrite(
+          "drop_incomplete",
+          &FrameSetOptions::dropIncomplete,
+          "Skip the sets missing a frame of some stream, instead of delivering them with None for the missing frames.");
+  py::class_<FrameSet>(
+      m, "FrameSet", "Frames of several image streams captured within a tolerance of each other.")
+      .def_readonly(
+          "timestamp_ns", &FrameSet::timestampNs, "Timestamp of the earliest frame of the set.")
+      .def_readonly(
+          "indices", &FrameSet::indices, "Index of the frame of each stream, -1 if missing.")
+      .def_readonly(
+          "frames",
+          &FrameSet::frames,
+          "Decoded (image_data, image_data_record) of each stream, None if missing.")
+      .def(
+          "is_complete",
+          &FrameSet::isComplete,
+          "Returns True if the set has a frame of every stream.");
+  py::class_<PyFrameSetIterator>(m, "FrameSetIterator", "Iterator over the sets of frames.")
+      .def("__iter__", [](PyFrameSetIterator& self) -> PyFrameSetIterator& { return self; })
+      .def("__next__", [](PyFrameSetIterator& self) -> FrameSet {
+        {
+          py::gil_scoped_release release;
+          if (self.started && self.current != self.end) {
+            ++self.current;
+          }
+          self.started = true;
+        }
+        if (self.current == self.end) {
+          throw py::stop_iteration();
+        }
+        return *self.current;
+      });
+  py::class_<FrameSetSequence>(
+      m,
+      "FrameSetSequence",
+      "Interface for delivering the frames of several image streams grouped by capture time.")
+      .def("__len__", &FrameSetSequence::size)
+      .def(
+          "__iter__",
+          [](FrameSetSequence& self) {
+            py::gil_scoped_release release;
+            return PyFrameSetIterator{self.begin(), self.end()};
+          },
+          py::keep_alive<0, 1>());
+}
+
+inline void declareOpenOptions(py::module& m) {
+  py::class_<VrsDataProviderOpenOptions>(
+      m, "VrsDataProviderOpenOptions", "Options to create a VrsDataProvider.")
+      .def(py::init<>())
+      .def_readwrite(
+          "lazy_initialization",
+          &VrsDataProviderOpenOptions::lazyInitialization,
+          "Defer reading time sync records, stream time ranges and parsing calibration to their first use.");
+  py::class_<VrsDataProviderOpenTimings>(
+      m,
+      "VrsDataProviderOpenTimings",
+      "Time spent in each phase of creating a VrsDataProvider, in nanoseconds.")
+      .def_readonly("lazy_initialization", &VrsDataProviderOpenTimings::lazyInitialization)
+      .def_readonly("open_files_ns", &VrsDataProviderOpenTimings::openFilesNs)
+      .def_readonly("read_configurations_ns", &VrsDataProviderOpenTimings::readConfigurationsNs)
+      .def_readonly("load_calibration_ns", &VrsDataProviderOpenTimings::loadCalibrationNs)
+      .def_readonly("load_time_sync_ns", &VrsDataProviderOpenTimings::loadTimeSyncNs)
+      .def_readonly("build_time_index_ns", &VrsDataProviderOpenTimings::buildTimeIndexNs)
+      .def_readonly("total_ns", &VrsDataProviderOpenTimings::totalNs);
+}
+
 inline void declareVrsDataProvider(py::module& m) {
   py::class_<VrsDataProvider, std::shared_ptr<VrsDataProvider>>(
       m,
@@ -198,13 +331,55 @@ inline void declareVrsDataProvider(py::module& m) {
           "Checks, if a stream with provided ID is of expected type.")
       .def(
           "get_device_calibration",
-          &VrsDataProvider::getDeviceCalibration,
-          "Get calibration of the device.")
+          &VrsDataProvider::getDeviceCalibrationRef,
+          py::return_value_policy::reference_internal,
+          "Get calibration of the device. The calibration is shared with the provider instead of "
+          "being copied by each call, and keeps the provider alive.")
       .def(
           "get_sensor_calibration",
           &VrsDataProvider::getSensorCalibration,
           py::arg("stream_id"),
           "Get calibration of a sensor from the device.")
+      .def(
+          "get_decoded_camera_calibration",
+          &VrsDataProvider::getDecodedCameraCalibration,
+          py::arg("stream_id"),
+          py::arg("decode_options"),
+          "Get calibration of a camera matching its images decoded with given options.")
+      .def(
+          "set_image_decode_options",
+          &VrsDataProvider::setImageDecodeOptions,
+          py::arg("stream_id"),
+          py::arg("decode_options"),
+          "Sets the scale and region at which JPEG images of a stream are decoded on read.")
+      .def(
+          "get_image_decode_options",
+          &VrsDataProvider::getImageDecodeOptions,
+          py::arg("stream_id"),
+          "Returns the options JPEG images of a stream are decoded with.")
+      .def(
+          "set_image_cache_budget",
+          &VrsDataProvider::setImageCacheBudget,
+          py::arg("max_bytes"),
+          "Enables a cache of decoded images for get_image_data_by_index and get_image_data_by_time_ns with a memory budget in bytes, 0 disables it.")
+      .def(
+          "get_image_cache_stats",
+          &VrsDataProvider::getImageCacheStats,
+          "Returns the counters and memory use of the decoded image cache, None if disabled.")
+      .def(
+          "set_access_pattern",
+          &VrsDataProvider::setAccessPattern,
+          py::arg("pattern"),
+          py::arg("read_ahead_bytes") = RecordReadAhead::kDefaultReadAheadBytes,
+          "Sets the pattern in which data will be read, so that the records about to be read are loaded ahead from the files.")
+      .def(
+          "get_access_pattern",
+          &VrsDataProvider::getAccessPattern,
+          "Returns the access pattern the records are read ahead for.")
+      .def(
+          "get_open_timings",
+          &VrsDataProvider::getOpenTimings,
+          "Returns the time spent in each phase of creating this provider.")
       .def(
           "get_configuration",
           &VrsDataProvider::getConfiguration,
@@ -245,6 +420,12 @@ inline void declareVrsDataProvider(py::module& m) {
           },
           py::keep_alive<0, 1>(),
           "Delivers data from vrs file with options sorted by TimeDomain.DEVICE_TIME.")
+      .def(
+          "deliver_frame_sets",
+          &VrsDataProvider::deliverFrameSets,
+          py::arg("options"),
+          py::keep_alive<0, 1>(),
+          "Delivers the frames of several image streams grouped by capture time, each set decoded concurrently.")
       .def(
           "get_num_data",
           &VrsDataProvider::getNumData,
@@ -256,6 +437,12 @@ inline void declareVrsDataProvider(py::module& m) {
           py::arg("stream_id"),
           py::arg("index"),
           "Return the N-th data of a stream, return SensorData of NOT_VALID if out of range. see SensorData for more details on how sensor data are represented.")
+      .def(
+          "get_sensor_data_metadata_by_index",
+          &VrsDataProvider::getSensorDataMetadataByIndex,
+          py::arg("stream_id"),
+          py::arg("index"),
+          "Return the N-th data of a stream without reading image and audio content: images come with their record and an empty frame, audio with its record and no samples.")
       .def(
           "supports_time_domain",
           &VrsDataProvider::supportsTimeDomain,
@@ -351,9 +538,22 @@ inline void declareVrsDataProvider(py::module& m) {
       /* Get data from index */
       .def(
           "get_image_data_by_index",
-          &VrsDataProvider::getImageDataByIndex,
+          [](VrsDataProvider& self, const vrs::StreamId& streamId, const int index) {
+            return self.getImageDataByIndex(streamId, index);
+          },
           py::arg("stream_id"),
           py::arg("index"))
+      .def(
+          "get_image_data_by_index",
+          [](VrsDataProvider& self,
+             const vrs::StreamId& streamId,
+             const int index,
+             const image::JpegDecodeOptions& decodeOptions) {
+            return self.getImageDataByIndex(streamId, index, decodeOptions);
+          },
+          py::arg("stream_id"),
+          py::arg("index"),
+          py::arg("decode_options"))
       .def(
           "get_imu_data_by_index",
           &VrsDataProvider::getImuDataByIndex,
@@ -393,11 +593,33 @@ inline void declareVrsDataProvider(py::module& m) {
       /* Get data before timestamp in nanoseconds*/
       .def(
           "get_image_data_by_time_ns",
-          &VrsDataProvider::getImageDataByTimeNs,
+          [](VrsDataProvider& self,
+             const vrs::StreamId& streamId,
+             const int64_t timeNs,
+             const TimeDomain& timeDomain,
+             const TimeQueryOptions& timeQueryOptions) {
+            return self.getImageDataByTimeNs(streamId, timeNs, timeDomain, timeQueryOptions);
+          },
           py::arg("stream_id"),
           py::arg("time_ns"),
           py::arg("time_domain"),
           py::arg("time_query_options") = TimeQueryOptions::Before)
+      .def(
+          "get_image_data_by_time_ns",
+          [](VrsDataProvider& self,
+             const vrs::StreamId& streamId,
+             const int64_t timeNs,
+             const TimeDomain& timeDomain,
+             const TimeQueryOptions& timeQueryOptions,
+             const image::JpegDecodeOptions& decodeOptions) {
+            return self.getImageDataByTimeNs(
+                streamId, timeNs, timeDomain, timeQueryOptions, decodeOptions);
+          },
+          py::arg("stream_id"),
+          py::arg("time_ns"),
+          py::arg("time_domain"),
+          py::arg("time_query_options"),
+          py::arg("decode_options"))
       .def(
           "get_imu_data_by_time_ns",
           &VrsDataProvider::getImuDataByTimeNs,
@@ -453,14 +675,30 @@ inline void declareVrsDataProvider(py::module& m) {
 inline void exportVrsDataProvider(py::module& m) {
   // For submodule documentation, see: projectaria_tools/projectaria_tools/core/data_provider.py
 
+  declareOpenOptions(m);
   m.def(
       "create_vrs_data_provider",
-      &createVrsDataProvider,
+      [](const std::string& vrsFilename, const VrsDataProviderOpenOptions& options) {
+        return createVrsDataProvider(vrsFilename, options);
+      },
       py::arg("vrs_filename"),
+      py::arg("options") = VrsDataProviderOpenOptions(),
       "Factory class to create a VrsDataProvider class.");
+  m.def(
+      "create_vrs_data_provider",
+      [](const std::vector<std::string>& vrsFilenames, const VrsDataProviderOpenOptions& options) {
+        return createVrsDataProvider(vrsFilenames, options);
+      },
+      py::arg("vrs_filenames"),
+      py::arg("options") = VrsDataProviderOpenOptions(),
+      "Factory class to create a VrsDataProvider class over several vrs files sharing a timeline. "
+      "File names may use `*` wildcards, and continuation chunks of listed files are ignored.");
 
   declareSubstreamSelector(m);
   declareDeliverQueued(m);
+  declareAccessPattern(m);
+  declareImageFrameCache(m);
+  declareFrameSets(m);
   declareVrsDataProvider(m);
 }
 
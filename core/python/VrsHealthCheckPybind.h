@@ -52,7 +52,8 @@ inline void exportVrsHealthCheck(py::module& m) {
       .def_readwrite("default_gps_rate_hz", &Settings::defaultGpsRateHz)
       .def_readwrite("ignore_audio", &Settings::ignoreAudio)
       .def_readwrite("ignore_bluetooth", &Settings::ignoreBluetooth)
-      .def_readwrite("is_interactive", &Settings::isInteractive);
+      .def_readwrite("is_interactive", &Settings::isInteractive)
+      .def_readwrite("result_cache_path", &Settings::resultCachePath);
 
   m.def(
       "run",
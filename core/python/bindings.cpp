@@ -19,6 +19,7 @@
 #include "MpsPyBind.h"
 #include "SensorDataPyBind.h"
 #include "StreamIdPyBind.h"
+#include "TracePyBind.h"
 #include "VrsDataProviderPyBind.h"
 #include "VrsHealthCheckPybind.h"
 #include "VrsPyBind.h"
@@ -57,4 +58,7 @@ PYBIND11_MODULE(_core_pybinds, m) {
 
   py::module vrsHealthCheck = m.def_submodule("vrs_health_check");
   vrs_check::exportVrsHealthCheck(vrsHealthCheck);
+
+  py::module trace = m.def_submodule("trace");
+  trace::exportTrace(trace);
 }
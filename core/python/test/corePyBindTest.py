@@ -17,7 +17,7 @@ import unittest
 
 import numpy as np
 
-from projectaria_tools.core import calibration, data_provider
+from projectaria_tools.core import calibration, data_provider, image
 from projectaria_tools.core.sensor_data import (
     SensorDataType,
     TimeDomain,
@@ -100,6 +100,20 @@ class CalibrationTests(unittest.TestCase):
             )
             np.testing.assert_array_almost_equal(rectified_gyro, rectified_gyro_compare)
 
+    def test_shared_calibration(self) -> None:
+        provider = data_provider.create_vrs_data_provider(vrs_filepath)
+
+        # calibrations are shared instead of being copied by each call
+        device_calib = provider.get_device_calibration()
+        self.assertIs(provider.get_device_calibration(), device_calib)
+        camera_calib = device_calib.get_camera_calib("camera-rgb")
+        self.assertIs(device_calib.get_camera_calib("camera-rgb"), camera_calib)
+        self.assertIsNone(device_calib.get_camera_calib("camera-et"))
+
+        # and keep the objects they are shared with alive
+        del provider, device_calib
+        self.assertEqual(camera_calib.get_label(), "camera-rgb")
+
     def test_calibration_label(self) -> None:
         provider = data_provider.create_vrs_data_provider(vrs_filepath)
 
@@ -144,6 +158,77 @@ class CalibrationTests(unittest.TestCase):
                 assert data.sensor_data_type() != SensorDataType.NOT_VALID
                 assert data.stream_id() == stream_id
 
+    def test_deliver_frame_sets(self) -> None:
+        provider = data_provider.create_vrs_data_provider(vrs_filepath)
+
+        options = data_provider.FrameSetOptions()
+        options.stream_ids = [
+            provider.get_stream_id_from_label("camera-slam-left"),
+            provider.get_stream_id_from_label("camera-slam-right"),
+        ]
+        options.tolerance_ns = 1000000
+        frame_sets = provider.deliver_frame_sets(options)
+        assert len(frame_sets) > 0
+
+        num_sets = 0
+        for frame_set in frame_sets:
+            assert frame_set.is_complete()
+            for image_data, image_record in frame_set.frames:
+                assert image_data.is_valid()
+                time_ns = image_record.capture_timestamp_ns
+                assert 0 <= time_ns - frame_set.timestamp_ns <= options.tolerance_ns
+            num_sets += 1
+        assert num_sets == len(frame_sets)
+
+    def test_image_to_tensor(self) -> None:
+        provider = data_provider.create_vrs_data_provider(vrs_filepath)
+        stream_id = provider.get_stream_id_from_label("camera-rgb")
+        image_data = provider.get_image_data_by_index(stream_id, 0)[0]
+        pixels = image_data.to_numpy_array().astype(np.float32) / 255.0
+
+        options = image.TensorConversionOptions()
+        options.mean = [0.485, 0.456, 0.406]
+        options.std = [0.229, 0.224, 0.225]
+        shape = image_data.get_tensor_shape(options)
+        assert shape == [3, pixels.shape[0], pixels.shape[1]]
+        batch = np.zeros([2] + shape, dtype=np.float32)
+        image_data.to_tensor(batch[1], options)
+        expected = ((pixels - options.mean) / options.std).transpose(2, 0, 1)
+        np.testing.assert_allclose(batch[1], expected, atol=1e-5)
+        assert not batch[0].any()
+
+        options.layout = image.TensorLayout.HWC
+        half = np.empty(pixels.shape, dtype=np.float16)
+        image.image_to_tensor(image_data.to_numpy_array(), half, options)
+        np.testing.assert_allclose(
+            half, (pixels - options.mean) / options.std, atol=1e-2
+        )
+        with self.assertRaises(RuntimeError):
+            image_data.to_tensor(np.empty(shape, dtype=np.float64), options)
+
+    def test_resize_and_pyramid(self) -> None:
+        provider = data_provider.create_vrs_data_provider(vrs_filepath)
+        stream_id = provider.get_stream_id_from_label("camera-rgb")
+        pixels = provider.get_image_data_by_index(stream_id, 0)[0].to_numpy_array()
+        height, width = pixels.shape[:2]
+
+        for method in (
+            image.ResizeMethod.AREA,
+            image.ResizeMethod.BILINEAR,
+            image.ResizeMethod.LANCZOS3,
+        ):
+            resized = image.resize(pixels, width // 3, height // 4, method)
+            assert resized.shape == (height // 4, width // 3, 3)
+            assert resized.dtype == np.uint8
+            assert abs(float(resized.mean()) - float(pixels.mean())) < 2.0
+
+        levels = image.build_pyramid(
+            pixels.astype(np.float32), 3, image.PyramidFilter.BOX
+        )
+        assert len(levels) == 3
+        np.testing.assert_array_equal(levels[0], pixels)
+        assert levels[2].shape == ((height + 3) // 4, (width + 3) // 4, 3)
+
     def test_random_accessor_timestamp(self) -> None:
         provider = data_provider.create_vrs_data_provider(vrs_filepath)
 
@@ -245,3 +330,119 @@ class CalibrationTests(unittest.TestCase):
                 test_pixel=test_pixel, cam_calib=src_calib
             )
         )
+
+    def test_batch_projection_jacobians(self) -> None:
+        provider = data_provider.create_vrs_data_provider(vrs_filepath)
+        cam_calib = provider.get_device_calibration().get_camera_calib("camera-rgb")
+        rng = np.random.default_rng(0)
+        points = rng.uniform(-1, 1, (100, 3)) + np.array([0, 0, 1.5])
+
+        pixels, jacobians_wrt_point, jacobians_wrt_params = (
+            cam_calib.project_batch_no_checks(points)
+        )
+        num_params = len(cam_calib.projection_params())
+        self.assertEqual(pixels.shape, (100, 2))
+        self.assertEqual(jacobians_wrt_point.shape, (100, 2, 3))
+        self.assertEqual(jacobians_wrt_params.shape, (100, 2, num_params))
+
+        # compare with the single point projection and its central differences
+        step = 1e-6
+        for point, pixel, jacobian in zip(points, pixels, jacobians_wrt_point):
+            self.assertTrue(np.allclose(pixel, cam_calib.project_no_checks(point)))
+            numerical = np.stack(
+                [
+                    (
+                        cam_calib.project_no_checks(point + step * axis)
+                        - cam_calib.project_no_checks(point - step * axis)
+                    )
+                    / (2 * step)
+                    for axis in np.eye(3)
+                ],
+                axis=1,
+            )
+            self.assertTrue(np.allclose(jacobian, numerical, rtol=1e-5, atol=1e-4))
+
+    def test_calibration_warp(self) -> None:
+        provider = data_provider.create_vrs_data_provider(timecode_vrs_filepath)
+        sensor_name = "camera-rgb"
+        stream_id = provider.get_stream_id_from_label(sensor_name)
+        src_calib = provider.get_device_calibration().get_camera_calib(sensor_name)
+        image_array = provider.get_image_data_by_index(stream_id, 0)[0].to_numpy_array()
+
+        # undistort, rotate upright and downsize in a single pass
+        warp = calibration.make_calibration_warp(
+            src_calib,
+            calibration.CameraModelType.LINEAR,
+            [300, 400],
+            150,
+            calibration.ImageRotation.CW90,
+        )
+        warped = calibration.warp_by_calibration(image_array, warp)
+        self.assertEqual(warped.shape[:2], (400, 300))
+
+        # same as undistorting then rotating with numpy
+        linear_calib = calibration.get_linear_camera_calibration(
+            400, 300, 150, sensor_name, src_calib.get_transform_device_camera()
+        )
+        undistorted = calibration.distort_by_calibration(
+            image_array, linear_calib, src_calib
+        )
+        np.testing.assert_array_equal(warped, np.rot90(undistorted, k=-1))
+
+        rotated_calib = calibration.rotate_camera_calib_cw90deg(linear_calib)
+        np.testing.assert_allclose(
+            warp.dst_calib.get_transform_device_camera().to_matrix(),
+            rotated_calib.get_transform_device_camera().to_matrix(),
+            atol=1e-9,
+        )
+        np.testing.assert_allclose(
+            warp.dst_calib.projection_params(), rotated_calib.projection_params()
+        )
+
+    def test_stereo_rectification(self) -> None:
+        provider = data_provider.create_vrs_data_provider(vrs_filepath)
+        device_calib = provider.get_device_calibration()
+        left_calib = device_calib.get_camera_calib("camera-slam-left")
+        right_calib = device_calib.get_camera_calib("camera-slam-right")
+        rectification = calibration.make_stereo_rectification(
+            left_calib, right_calib, [480, 480]
+        )
+        self.assertGreater(rectification.baseline, 0)
+
+        # a 3D point is seen on the same row of both rectified images, and its
+        # depth is recovered from its disparity
+        point_in_rect_left = np.array([0.1, -0.05, 2.0])
+        T_device_rect_left = (
+            rectification.left_calib.get_transform_device_camera().to_matrix()
+        )
+        T_device_rect_right = (
+            rectification.right_calib.get_transform_device_camera().to_matrix()
+        )
+        point_in_rect_right = (
+            np.linalg.inv(T_device_rect_right)
+            @ T_device_rect_left
+            @ np.append(point_in_rect_left, 1)
+        )[:3]
+        left_pixel = rectification.left_calib.project(point_in_rect_left)
+        right_pixel = rectification.right_calib.project(point_in_rect_right)
+        self.assertAlmostEqual(left_pixel[1], right_pixel[1], places=6)
+        self.assertAlmostEqual(
+            rectification.disparity_to_depth(left_pixel[0] - right_pixel[0]),
+            point_in_rect_left[2],
+            places=6,
+        )
+
+        left_stream_id = provider.get_stream_id_from_label("camera-slam-left")
+        right_stream_id = provider.get_stream_id_from_label("camera-slam-right")
+        left_image = provider.get_image_data_by_index(left_stream_id, 0)[0]
+        right_image = provider.get_image_data_by_index(right_stream_id, 0)[0]
+        rectified_left, rectified_right = calibration.rectify_stereo_pair(
+            left_image.to_numpy_array(), right_image.to_numpy_array(), rectification
+        )
+        self.assertEqual(rectified_left.shape, (480, 480))
+        np.testing.assert_array_equal(
+            rectified_right,
+            calibration.warp_by_calibration(
+                right_image.to_numpy_array(), rectification.right_warp
+            ),
+        )
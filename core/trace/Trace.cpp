@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <trace/Trace.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace projectaria::tools::trace {
+
+namespace {
+
+struct TraceEvent {
+  const TraceSite* site;
+  int64_t startNs;
+  int64_t durationNs;
+};
+
+// Events of one thread: only the owning thread appends, readers see the events below size
+struct EventBuffer {
+  EventBuffer(size_t capacity, uint32_t threadIndex)
+      : events(capacity), threadIndex(threadIndex) {}
+
+  std::vector<TraceEvent> events;
+  std::atomic<size_t> size{0};
+  const uint32_t threadIndex;
+};
+
+// Intentionally never destroyed: sites and thread buffers may record until the process exits
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<TraceSite*> sites;
+  std::vector<std::shared_ptr<EventBuffer>> eventBuffers;
+
+  std::atomic<bool> isCapturing{false};
+  std::atomic<uint64_t> captureGeneration{0};
+  std::atomic<size_t> maxEventsPerThread{0};
+  std::atomic<uint64_t> droppedEventCount{0};
+  std::atomic<uint32_t> nextThreadIndex{0};
+};
+
+TraceRegistry& getRegistry() {
+  static TraceRegistry* registry = new TraceRegistry();
+  return *registry;
+}
+
+uint32_t getThreadIndex() {
+  thread_local const uint32_t threadIndex = getRegistry().nextThreadIndex.fetch_add(1);
+  return threadIndex;
+}
+
+// Returns the event buffer of the calling thread for the current capture, creating it if needed
+EventBuffer& getThreadEventBuffer(TraceRegistry& registry) {
+  thread_local std::shared_ptr<EventBuffer> buffer;
+  thread_local uint64_t bufferGeneration = 0;
+  const uint64_t generation = registry.captureGeneration.load(std::memory_order_acquire);
+  if (!buffer || bufferGeneration != generation) {
+    buffer = std::make_shared<EventBuffer>(
+        registry.maxEventsPerThread.load(std::memory_order_relaxed), getThreadIndex());
+    bufferGeneration = generation;
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (registry.captureGeneration.load(std::memory_order_relaxed) == generation) {
+      registry.eventBuffers.push_back(buffer);
+    }
+  }
+  return *buffer;
+}
+
+void writeJsonString(std::ostream& os, const char* str) {
+  os << '"';
+  for (const char* c = str; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      os << '\\';
+    }
+    os << *c;
+  }
+  os << '"';
+}
+
+} // namespace
+
+TraceSite::TraceSite(const char* name) : name_(name) {
+  TraceRegistry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.sites.push_back(this);
+}
+
+void TraceSite::record(int64_t startNs, int64_t durationNs) {
+  const auto duration = static_cast<uint64_t>(durationNs);
+  Slot& slot = slots_[getThreadIndex() % kNumSlots];
+  slot.count.fetch_add(1, std::memory_order_relaxed);
+  slot.totalNs.fetch_add(duration, std::memory_order_relaxed);
+  uint64_t maxNs = slot.maxNs.load(std::memory_order_relaxed);
+  while (duration > maxNs &&
+         !slot.maxNs.compare_exchange_weak(maxNs, duration, std::memory_order_relaxed)) {
+  }
+
+  TraceRegistry& registry = getRegistry();
+  if (!registry.isCapturing.load(std::memory_order_relaxed)) {
+    return;
+  }
+  EventBuffer& buffer = getThreadEventBuffer(registry);
+  const size_t index = buffer.size.load(std::memory_order_relaxed);
+  if (index >= buffer.events.size()) {
+    registry.droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.events[index] = TraceEvent{this, startNs, durationNs};
+  buffer.size.store(index + 1, std::memory_order_release);
+}
+
+TraceStats TraceSite::getStats() const {
+  TraceStats stats;
+  for (const auto& slot : slots_) {
+    stats.count += slot.count.load(std::memory_order_relaxed);
+    stats.totalNs += slot.totalNs.load(std::memory_order_relaxed);
+    stats.maxNs = std::max(stats.maxNs, slot.maxNs.load(std::memory_order_relaxed));
+  }
+  return stats;
+}
+
+void TraceSite::resetStats() {
+  for (auto& slot : slots_) {
+    slot.count.store(0, std::memory_order_relaxed);
+    slot.totalNs.store(0, std::memory_order_relaxed);
+    slot.maxNs.store(0, std::memory_order_relaxed);
+  }
+}
+
+ScopedTrace::ScopedTrace(TraceSite& site) : site_(site), startNs_(getTraceClockNs()) {}
+
+ScopedTrace::~ScopedTrace() {
+  site_.record(startNs_, getTraceClockNs() - startNs_);
+}
+
+int64_t getTraceClockNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool isTracingCompiledIn() {
+#ifdef PROJECTARIA_TOOLS_TRACING
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::map<std::string, TraceStats> getTraceStats() {
+  TraceRegistry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::map<std::string, TraceStats> nameToStats;
+  for (const TraceSite* site : registry.sites) {
+    const TraceStats siteStats = site->getStats();
+    TraceStats& stats = nameToStats[site->getName()];
+    stats.count += siteStats.count;
+    stats.totalNs += siteStats.totalNs;
+    stats.maxNs = std::max(stats.maxNs, siteStats.maxNs);
+  }
+  return nameToStats;
+}
+
+void resetTraceStats() {
+  TraceRegistry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (TraceSite* site : registry.sites) {
+    site->resetStats();
+  }
+}
+
+void startTraceEventCapture(size_t maxEventsPerThread) {
+  TraceRegistry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  // buffers of the previous capture stay alive as long as their thread appends to them
+  registry.eventBuffers.clear();
+  registry.droppedEventCount.store(0, std::memory_order_relaxed);
+  registry.maxEventsPerThread.store(maxEventsPerThread, std::memory_order_relaxed);
+  registry.captureGeneration.fetch_add(1, std::memory_order_release);
+  registry.isCapturing.store(true, std::memory_order_relaxed);
+}
+
+void stopTraceEventCapture() {
+  getRegistry().isCapturing.store(false, std::memory_order_relaxed);
+}
+
+uint64_t getDroppedTraceEventCount() {
+  return getRegistry().droppedEventCount.load(std::memory_order_relaxed);
+}
+
+std::string getChromeTraceJson() {
+  TraceRegistry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::ostringstream os;
+  os.precision(3);
+  os << std::fixed << "{\"traceEvents\":[";
+  bool isFirst = true;
+  for (const auto& buffer : registry.eventBuffers) {
+    const size_t size = buffer->size.load(std::memory_order_acquire);
+    for (size_t i = 0; i < size; ++i) {
+      const TraceEvent& event = buffer->events[i];
+      os << (isFirst ? "" : ",") << "{\"name\":";
+      writeJsonString(os, event.site->getName());
+      // Chrome trace timestamps are in microseconds
+      os << ",\"cat\":\"projectaria_tools\",\"ph\":\"X\",\"ts\":" << event.startNs * 1e-3
+         << ",\"dur\":" << event.durationNs * 1e-3 << ",\"pid\":0,\"tid\":" << buffer->threadIndex
+         << "}";
+      isFirst = false;
+    }
+  }
+  os << "],\"displayTimeUnit\":\"ms\"}";
+  return os.str();
+}
+
+bool writeChromeTrace(const std::string& path) {
+  std::ofstream file(path);
+  if (!file) {
+    return false;
+  }
+  file << getChromeTraceJson();
+  return static_cast<bool>(file);
+}
+
+} // namespace projectaria::tools::trace
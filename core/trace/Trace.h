@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace projectaria::tools::trace {
+
+/**
+ * @brief Aggregated timings of a traced scope
+ */
+struct TraceStats {
+  uint64_t count = 0; ///< @brief number of times the scope was run
+  uint64_t totalNs = 0; ///< @brief total time spent in the scope
+  uint64_t maxNs = 0; ///< @brief longest time spent in one run of the scope
+};
+
+/**
+ * @brief A traced scope of the code, created once per call site by PROJECTARIA_TRACE_SCOPE.
+ * Timings are accumulated in per-thread slots of relaxed atomics, so recording never takes a lock
+ * and threads do not share cache lines, unless more threads than slots are tracing.
+ */
+class TraceSite {
+ public:
+  /**
+   * @param name name of the scope, which must outlive the site, e.g. a string literal
+   */
+  explicit TraceSite(const char* name);
+
+  TraceSite(const TraceSite&) = delete;
+  TraceSite& operator=(const TraceSite&) = delete;
+
+  const char* getName() const {
+    return name_;
+  }
+
+  /** @brief Records one run of the scope, and a trace event if events are being captured */
+  void record(int64_t startNs, int64_t durationNs);
+
+  TraceStats getStats() const;
+  void resetStats();
+
+ private:
+  static constexpr size_t kNumSlots = 64;
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> totalNs{0};
+    std::atomic<uint64_t> maxNs{0};
+  };
+
+  const char* name_;
+  std::array<Slot, kNumSlots> slots_;
+};
+
+/**
+ * @brief Times the enclosing scope into a TraceSite
+ */
+class ScopedTrace {
+ public:
+  explicit ScopedTrace(TraceSite& site);
+  ~ScopedTrace();
+
+  ScopedTrace(const ScopedTrace&) = delete;
+  ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+ private:
+  TraceSite& site_;
+  int64_t startNs_;
+};
+
+/** @brief Returns the monotonic clock of the traces, in nanoseconds */
+int64_t getTraceClockNs();
+
+/** @brief Returns if the library was built with PROJECTARIA_TOOLS_ENABLE_TRACING */
+bool isTracingCompiledIn();
+
+/** @brief Returns the timings of all the traced scopes, summed over the call sites of a name */
+std::map<std::string, TraceStats> getTraceStats();
+
+/** @brief Resets the timings of all the traced scopes */
+void resetTraceStats();
+
+/**
+ * @brief Starts capturing one event per run of a traced scope, for getChromeTraceJson(). Events
+ * are appended to a buffer of each thread, without locks; events past the capacity are dropped.
+ * Restarting discards the events captured so far.
+ * @param maxEventsPerThread capacity of the buffer of each thread
+ */
+void startTraceEventCapture(size_t maxEventsPerThread = 1 << 16);
+
+/** @brief Stops capturing events, keeping the events captured so far */
+void stopTraceEventCapture();
+
+/** @brief Returns the number of events dropped because a thread buffer was full */
+uint64_t getDroppedTraceEventCount();
+
+/**
+ * @brief Returns the captured events in the Chrome trace event format, which can be loaded by
+ * chrome://tracing or https://ui.perfetto.dev
+ */
+std::string getChromeTraceJson();
+
+/**
+ * @brief Writes getChromeTraceJson() to a file
+ * @return true if the file was written
+ */
+bool writeChromeTrace(const std::string& path);
+
+} // namespace projectaria::tools::trace
+
+#define PROJECTARIA_TRACE_CONCAT_INNER(a, b) a##b
+#define PROJECTARIA_TRACE_CONCAT(a, b) PROJECTARIA_TRACE_CONCAT_INNER(a, b)
+
+// PROJECTARIA_TRACE_SCOPE(name) times the rest of the enclosing scope under a name, which must be
+// a string literal. It compiles to nothing unless PROJECTARIA_TOOLS_ENABLE_TRACING is set.
+#ifdef PROJECTARIA_TOOLS_TRACING
+#define PROJECTARIA_TRACE_SCOPE(name)                                                    \
+  static ::projectaria::tools::trace::TraceSite PROJECTARIA_TRACE_CONCAT(                \
+      projectariaTraceSite, __LINE__)(name);                                             \
+  const ::projectaria::tools::trace::ScopedTrace PROJECTARIA_TRACE_CONCAT(               \
+      projectariaScopedTrace, __LINE__)(PROJECTARIA_TRACE_CONCAT(projectariaTraceSite, __LINE__))
+#else
+#define PROJECTARIA_TRACE_SCOPE(name)
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <trace/Trace.h>
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+using namespace projectaria::tools::trace;
+
+namespace {
+void runTracedScope(TraceSite& site) {
+  ScopedTrace trace(site);
+}
+} // namespace
+
+TEST(Trace, StatsAreSummedOverThreads) {
+  static TraceSite site("TraceTest::StatsAreSummedOverThreads");
+  constexpr int kNumThreads = 8;
+  constexpr int kNumRuns = 1000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&] {
+      for (int run = 0; run < kNumRuns; ++run) {
+        runTracedScope(site);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = getTraceStats().at(site.getName());
+  EXPECT_EQ(stats.count, kNumThreads * kNumRuns);
+  EXPECT_GE(stats.totalNs, stats.maxNs);
+
+  resetTraceStats();
+  EXPECT_EQ(getTraceStats().at(site.getName()).count, 0u);
+}
+
+TEST(Trace, ChromeTraceJson) {
+  static TraceSite site("TraceTest::ChromeTraceJson");
+  runTracedScope(site); // not captured
+
+  startTraceEventCapture(4);
+  std::thread thread([&] { runTracedScope(site); });
+  thread.join();
+  for (int run = 0; run < 5; ++run) {
+    runTracedScope(site);
+  }
+  stopTraceEventCapture();
+  runTracedScope(site); // not captured
+
+  const auto json = nlohmann::json::parse(getChromeTraceJson());
+  ASSERT_TRUE(json.contains("traceEvents"));
+  size_t numEvents = 0;
+  for (const auto& event : json["traceEvents"]) {
+    if (event["name"] == site.getName()) {
+      EXPECT_EQ(event["ph"], "X");
+      EXPECT_GE(event["dur"].get<double>(), 0.0);
+      ++numEvents;
+    }
+  }
+  // the calling thread buffer holds 4 of its 5 events
+  EXPECT_EQ(numEvents, 5u);
+  EXPECT_EQ(getDroppedTraceEventCount(), 1u);
+
+  // restarting the capture discards the events
+  startTraceEventCapture();
+  stopTraceEventCapture();
+  EXPECT_TRUE(nlohmann::json::parse(getChromeTraceJson())["traceEvents"].empty());
+}
+
+TEST(Trace, ScopeMacro) {
+  {
+    PROJECTARIA_TRACE_SCOPE("TraceTest::ScopeMacro");
+  }
+  const auto nameToStats = getTraceStats();
+  const auto it = nameToStats.find("TraceTest::ScopeMacro");
+  if (isTracingCompiledIn()) {
+    ASSERT_NE(it, nameToStats.end());
+    EXPECT_EQ(it->second.count, 1u);
+  } else {
+    EXPECT_EQ(it, nameToStats.end());
+  }
+}
@@ -51,17 +51,28 @@ bool Audio::setup(vrs::RecordFileReader& reader) {
   periodUs_ = std::round(1 / static_cast<double>(config.sampleRate) * 1e6);
   setMaxDeviationFromPeriodUs();
 
+  return preprocessAudioStream(reader);
+}
+
+bool Audio::refresh(vrs::RecordFileReader& reader) {
+  reader.setStreamPlayer(streamId_, audioPlayer_.get());
+  return preprocessAudioStream(reader);
+}
+
+bool Audio::preprocessAudioStream(vrs::RecordFileReader& reader) {
   // Calculate total and expected
   if (reader.getRecordCount(streamId_, vrs::Record::Type::DATA) > 0) {
     const auto* firstRecord = reader.getRecordByTime(streamId_, vrs::Record::Type::DATA, 0.0);
-    // Enter preprocess mode so the callback can decode samples per record
-    preprocess_ = true;
-    if (reader.readRecord(*firstRecord)) {
-      XR_LOGE("{}: Failed to read the first record", streamId_.getName());
-      return false;
+    if (samplesPerRecord_ == 0) {
+      // Enter preprocess mode so the callback can decode samples per record
+      preprocess_ = true;
+      if (reader.readRecord(*firstRecord)) {
+        XR_LOGE("{}: Failed to read the first record", streamId_.getName());
+        return false;
+      }
+      // Exit preprocess mode
+      preprocess_ = false;
     }
-    // Exit preprocess mode
-    preprocess_ = false;
     const uint64_t firstTimestampUs = firstRecord->timestamp * 1e6;
     const uint64_t lastTimestampUs =
         reader.getLastRecord(streamId_, vrs::Record::Type::DATA)->timestamp * 1e6;
@@ -69,8 +80,8 @@ bool Audio::setup(vrs::RecordFileReader& reader) {
     stats_.expected =
         std::round((lastTimestampUs - firstTimestampUs) / static_cast<float>(periodUs_)) +
         samplesPerRecord_;
+    publishProgress(stats_);
   }
-
   return true;
 }
 
@@ -82,7 +93,6 @@ void Audio::processData(const data_provider::AudioDataRecord& record) {
     return;
   }
 
-  std::lock_guard lock{mutex_};
   for (int i = 0; i < numSamples; i++) {
     processTimestamp(record.captureTimestampsNs[i] / 1e3);
   }
@@ -26,14 +26,17 @@ class Audio : public Periodic {
  public:
   Audio(vrs::StreamId streamId, float minScore);
   bool setup(vrs::RecordFileReader& reader) override; // Setup the audio player
+  bool refresh(vrs::RecordFileReader& reader) override;
 
  private:
   void processData(const data_provider::AudioDataRecord& record);
+  // Update the totals, reading the first record to count its samples if not done yet
+  bool preprocessAudioStream(vrs::RecordFileReader& reader);
   std::unique_ptr<data_provider::AudioPlayer> audioPlayer_;
   // Whether the callback is being used during the preprocess or analysis phase
   bool preprocess_ = false;
   // Number of samples per each data record, assume the same for each record
-  uint64_t samplesPerRecord_;
+  uint64_t samplesPerRecord_ = 0;
 };
 
 } // namespace projectaria::tools::vrs_check
@@ -58,6 +58,12 @@ bool Barometer::setup(vrs::RecordFileReader& reader) {
   return true;
 }
 
+bool Barometer::refresh(vrs::RecordFileReader& reader) {
+  reader.setStreamPlayer(streamId_, barometerPlayer_.get());
+  preprocessStream(reader);
+  return true;
+}
+
 const BarometerStats& Barometer::getBarometerStats() {
   std::lock_guard lock{mutex_};
   return barometerStats_;
@@ -72,6 +78,27 @@ nlohmann::json Barometer::statsToJson() {
   return jsonStats;
 }
 
+nlohmann::json Barometer::checkpointToJson() {
+  nlohmann::json checkpoint = Periodic::checkpointToJson();
+  std::lock_guard lock{mutex_};
+  checkpoint["repeat_pressure"] = barometerStats_.repeatPressure;
+  checkpoint["repeat_temp"] = barometerStats_.repeatTemp;
+  checkpoint["temp_out_of_range"] = barometerStats_.tempOutOfRange;
+  checkpoint["prev_pressure"] = prevPressure_;
+  checkpoint["prev_temp"] = prevTemp_;
+  return checkpoint;
+}
+
+void Barometer::restoreFromJson(const nlohmann::json& checkpoint) {
+  Periodic::restoreFromJson(checkpoint);
+  std::lock_guard lock{mutex_};
+  barometerStats_.repeatPressure = checkpoint.at("repeat_pressure").get<uint64_t>();
+  barometerStats_.repeatTemp = checkpoint.at("repeat_temp").get<uint64_t>();
+  barometerStats_.tempOutOfRange = checkpoint.at("temp_out_of_range").get<uint64_t>();
+  prevPressure_ = checkpoint.at("prev_pressure").get<double>();
+  prevTemp_ = checkpoint.at("prev_temp").get<double>();
+}
+
 void Barometer::logStats() {
   const BarometerStats stats = getBarometerStats();
   std::cout << fmt::format(
@@ -85,7 +112,6 @@ void Barometer::logStats() {
 }
 
 void Barometer::processData(const data_provider::BarometerData& data) {
-  std::lock_guard lock{mutex_};
   // Check for bad data
   if (data.pressure < 0 || data.captureTimestampNs < 0) {
     stats_.bad++;
@@ -33,9 +33,12 @@ class Barometer : public Periodic {
  public:
   Barometer(vrs::StreamId streamId, float minScore, float minTemp, float maxTemp);
   bool setup(vrs::RecordFileReader& reader) override; // Setup the barometer player
+  bool refresh(vrs::RecordFileReader& reader) override;
   const BarometerStats& getBarometerStats(); // Get stats specific to barometer sensors
   void logStats() override;
   nlohmann::json statsToJson() override;
+  nlohmann::json checkpointToJson() override;
+  void restoreFromJson(const nlohmann::json& checkpoint) override;
 
  private:
   void processData(const data_provider::BarometerData& data);
@@ -47,16 +47,49 @@ bool Bluetooth::setup(vrs::RecordFileReader& reader) {
   reader.setStreamPlayer(streamId_, bluetoothPlayer_.get());
   std::unique_lock lock{mutex_};
   stats_.total = reader.getRecordCount(streamId_, vrs::Record::Type::DATA);
+  publishProgress(stats_);
   lock.unlock();
 
   return true;
 }
 
+bool Bluetooth::refresh(vrs::RecordFileReader& reader) {
+  reader.setStreamPlayer(streamId_, bluetoothPlayer_.get());
+  std::unique_lock lock{mutex_};
+  stats_.total = reader.getRecordCount(streamId_, vrs::Record::Type::DATA);
+  publishProgress(stats_);
+  return true;
+}
+
 Stats Bluetooth::getStats() {
   std::lock_guard lock{mutex_};
   return stats_;
 }
 
+nlohmann::json Bluetooth::checkpointToJson() {
+  std::lock_guard lock{mutex_};
+  nlohmann::json checkpoint;
+  checkpoint["processed"] = stats_.processed;
+  checkpoint["bad"] = stats_.bad;
+  checkpoint["out_of_order"] = stats_.outOfOrder;
+  checkpoint["total_per_freq"] = stats_.totalPerFreq;
+  checkpoint["unique_ids"] = uniqueId_;
+  checkpoint["prev_timestamp_us"] = prevTimestampUs_;
+  return checkpoint;
+}
+
+void Bluetooth::restoreFromJson(const nlohmann::json& checkpoint) {
+  std::lock_guard lock{mutex_};
+  stats_.processed = checkpoint.at("processed").get<uint64_t>();
+  stats_.bad = checkpoint.at("bad").get<uint64_t>();
+  stats_.outOfOrder = checkpoint.at("out_of_order").get<uint64_t>();
+  stats_.totalPerFreq = checkpoint.at("total_per_freq").get<std::map<float, uint64_t>>();
+  uniqueId_ = checkpoint.at("unique_ids").get<std::set<std::string>>();
+  stats_.uniqueId = uniqueId_.size();
+  prevTimestampUs_ = checkpoint.at("prev_timestamp_us").get<uint64_t>();
+  publishProgress(stats_);
+}
+
 void Bluetooth::logStats() {
   std::lock_guard lock{mutex_};
   std::stringstream freqStr;
@@ -89,7 +122,6 @@ bool Bluetooth::getResult() {
 }
 
 void Bluetooth::processData(const data_provider::BluetoothBeaconData& data) {
-  std::lock_guard lock{mutex_};
   uint64_t currTimestampUs = data.boardTimestampNs / 1e3;
   if (data.boardTimestampNs < 0 || data.uniqueId.empty() || data.uniqueId == kNilUuid ||
       data.rssi >= 0.0) {
@@ -115,6 +147,7 @@ void Bluetooth::processData(const data_provider::BluetoothBeaconData& data) {
   }
   prevTimestampUs_ = currTimestampUs;
   stats_.processed++;
+  publishProgress(stats_);
 }
 
 } // namespace projectaria::tools::vrs_check
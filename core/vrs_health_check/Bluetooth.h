@@ -32,9 +32,12 @@ class Bluetooth : public Stream {
  public:
   explicit Bluetooth(vrs::StreamId streamId);
   bool setup(vrs::RecordFileReader& reader) override; // Setup the bluetooth player
+  bool refresh(vrs::RecordFileReader& reader) override;
   Stats getStats() override;
   void logStats() override;
   bool getResult() override; // Pass or fail for this stream
+  nlohmann::json checkpointToJson() override;
+  void restoreFromJson(const nlohmann::json& checkpoint) override;
   uint32_t getPeriodUs() override {
     return static_cast<uint32_t>(-1); // No concept of a period for Bluetooth stream
   }
@@ -93,6 +93,13 @@ bool Camera::setup(vrs::RecordFileReader& reader) {
   return true;
 }
 
+bool Camera::refresh(vrs::RecordFileReader& reader) {
+  reader.setStreamPlayer(streamId_, imageSensorPlayer_.get());
+  totalFrames_ = reader.getRecordCount(streamId_, ::vrs::Record::Type::DATA);
+  preprocessStream(reader);
+  return true;
+}
+
 void Camera::performSensorSerialCheck(vrs::RecordFileReader& reader) {
   std::unique_lock lock{mutex_};
   data_provider::ImageConfigRecord config = imageSensorPlayer_->getConfigRecord();
@@ -157,6 +164,31 @@ nlohmann::json Camera::statsToJson() {
   return jsonStats;
 }
 
+nlohmann::json Camera::checkpointToJson() {
+  nlohmann::json checkpoint = Periodic::checkpointToJson();
+  std::lock_guard lock{mutex_};
+  checkpoint["longest_frame_drop_us"] = cameraStats_.longestFrameDropUs;
+  checkpoint["temp_out_of_range"] = cameraStats_.tempOutOfRange;
+  checkpoint["roi_bad_frames"] = roiBadFrames_;
+  checkpoint["prev_exposure_duration_us"] = prevExposureDurationUs_;
+  checkpoint["unphysical_exposure_time"] = unphysicalExposureTime_;
+  checkpoint["gain_out_of_range"] = gainOutOfRange_;
+  checkpoint["exposure_out_of_range"] = exposureOutOfRange_;
+  return checkpoint;
+}
+
+void Camera::restoreFromJson(const nlohmann::json& checkpoint) {
+  Periodic::restoreFromJson(checkpoint);
+  std::lock_guard lock{mutex_};
+  cameraStats_.longestFrameDropUs = checkpoint.at("longest_frame_drop_us").get<uint64_t>();
+  cameraStats_.tempOutOfRange = checkpoint.at("temp_out_of_range").get<uint64_t>();
+  roiBadFrames_ = checkpoint.at("roi_bad_frames").get<int>();
+  prevExposureDurationUs_ = checkpoint.at("prev_exposure_duration_us").get<uint64_t>();
+  unphysicalExposureTime_ = checkpoint.at("unphysical_exposure_time").get<uint64_t>();
+  gainOutOfRange_ = checkpoint.at("gain_out_of_range").get<uint64_t>();
+  exposureOutOfRange_ = checkpoint.at("exposure_out_of_range").get<uint64_t>();
+}
+
 void Camera::logStats() {
   std::unique_lock lock{mutex_};
   std::cout
@@ -259,7 +291,6 @@ void Camera::processGain(uint64_t frameCenterExposureUs, float gain) {
 void Camera::processData(
     const data_provider::ImageData& data,
     const data_provider::ImageDataRecord& record) {
-  std::lock_guard lock{mutex_};
   const uint64_t frameCenterExposureUs = record.captureTimestampNs * 1e-3;
   if (!data.isValid() ||
       data.pixelFrame->size() != data.pixelFrame->getStride() * data.pixelFrame->getHeight() ||
@@ -267,6 +298,7 @@ void Camera::processData(
       record.captureTimestampNs < 0) {
     stats_.processed++;
     stats_.bad++;
+    publishProgress(stats_);
     return;
   }
 
@@ -53,10 +53,13 @@ class Camera : public Periodic {
       float maxTemp,
       const CameraCheckSetting& cameraCheckSetting);
   bool setup(vrs::RecordFileReader& reader) override; // Setup the camera player
+  bool refresh(vrs::RecordFileReader& reader) override;
   CameraStats getCameraStats(); // Get stats specific to camera sensors
   void logStats() override;
   bool getResult() override; // Pass or fail for this stream
   nlohmann::json statsToJson() override;
+  nlohmann::json checkpointToJson() override;
+  void restoreFromJson(const nlohmann::json& checkpoint) override;
 
  private:
   void processData(
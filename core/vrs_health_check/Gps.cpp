@@ -69,11 +69,34 @@ bool Gps::setup(vrs::RecordFileReader& reader) {
   return true;
 }
 
+bool Gps::refresh(vrs::RecordFileReader& reader) {
+  reader.setStreamPlayer(streamId_, gpsPlayer_.get());
+  preprocessStream(reader);
+  return true;
+}
+
 GpsStats Gps::getGpsStats() {
   std::lock_guard lock{mutex_};
   return gpsStats_;
 }
 
+nlohmann::json Gps::checkpointToJson() {
+  nlohmann::json checkpoint = Periodic::checkpointToJson();
+  std::lock_guard lock{mutex_};
+  checkpoint["accurate"] = gpsStats_.accurate;
+  checkpoint["raw_measurement"] = gpsStats_.rawMeasurement;
+  checkpoint["invalid_raw_measurement"] = gpsStats_.invalidRawMeasurement;
+  return checkpoint;
+}
+
+void Gps::restoreFromJson(const nlohmann::json& checkpoint) {
+  Periodic::restoreFromJson(checkpoint);
+  std::lock_guard lock{mutex_};
+  gpsStats_.accurate = checkpoint.at("accurate").get<uint64_t>();
+  gpsStats_.rawMeasurement = checkpoint.at("raw_measurement").get<uint64_t>();
+  gpsStats_.invalidRawMeasurement = checkpoint.at("invalid_raw_measurement").get<uint64_t>();
+}
+
 void Gps::logStats() {
   std::unique_lock lock{mutex_};
   std::stringstream seqDropStr;
@@ -119,7 +142,6 @@ bool Gps::getResult() {
 }
 
 void Gps::processData(const data_provider::GpsData& data) {
-  std::lock_guard lock{mutex_};
   if (data.captureTimestampNs < 0 || data.latitude > kLatitudeMax || data.latitude < kLatitudeMin ||
       data.longitude > kLongitudeMax || data.longitude < kLongitudeMin ||
       data.altitude > kAltitudeMax || data.altitude < kAltitudeMin || data.utcTimeMs < kUtcMsMin) {
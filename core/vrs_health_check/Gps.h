@@ -33,9 +33,12 @@ class Gps : public Periodic {
   Gps(vrs::StreamId streamId, double sampleRateHz, float minAccuracy);
   // Setup the gps player
   bool setup(vrs::RecordFileReader& reader) override;
+  bool refresh(vrs::RecordFileReader& reader) override;
   GpsStats getGpsStats(); // Get stats specific to GPS
   void logStats() override;
   bool getResult() override; // Pass or fail for this stream
+  nlohmann::json checkpointToJson() override;
+  void restoreFromJson(const nlohmann::json& checkpoint) override;
 
  private:
   void processData(const data_provider::GpsData& data);
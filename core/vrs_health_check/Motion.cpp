@@ -78,6 +78,12 @@ bool Motion::setup(vrs::RecordFileReader& reader) {
   return true;
 }
 
+bool Motion::refresh(vrs::RecordFileReader& reader) {
+  reader.setStreamPlayer(streamId_, motionSensorPlayer_.get());
+  preprocessStream(reader);
+  return true;
+}
+
 MotionStats Motion::getMotionStats() {
   std::lock_guard lock{mutex_};
   return motionStats_;
@@ -103,6 +109,68 @@ nlohmann::json Motion::statsToJson() {
   return jsonStats;
 }
 
+namespace {
+nlohmann::json optionalToJson(const std::optional<int64_t>& value) {
+  return value ? nlohmann::json(*value) : nlohmann::json(nullptr);
+}
+
+std::optional<int64_t> optionalFromJson(const nlohmann::json& value) {
+  return value.is_null() ? std::nullopt : std::optional<int64_t>(value.get<int64_t>());
+}
+} // namespace
+
+nlohmann::json Motion::checkpointToJson() {
+  nlohmann::json checkpoint = Periodic::checkpointToJson();
+  std::lock_guard lock{mutex_};
+  checkpoint["repeat_accel"] = motionStats_.repeatAccel;
+  checkpoint["repeat_gyro"] = motionStats_.repeatGyro;
+  checkpoint["repeat_mag"] = motionStats_.repeatMag;
+  checkpoint["longest_cont_repeat_accel"] = motionStats_.longestContRepeatAccel;
+  checkpoint["longest_cont_repeat_gyro"] = motionStats_.longestContRepeatGyro;
+  checkpoint["zero_accel"] = motionStats_.zeroAccel;
+  checkpoint["zero_gyro"] = motionStats_.zeroGyro;
+  checkpoint["zero_mag"] = motionStats_.zeroMag;
+  checkpoint["non_physical_accel"] = motionStats_.nonPhysicalAccel;
+  checkpoint["max_observed_rotation_accel_rad_per_s2"] =
+      motionStats_.maxObservedRotationAccel_radPerS2_;
+  checkpoint["num_non_physical_rotation_accel"] = motionStats_.numNonPhysicalRotationAccel_;
+  checkpoint["longest_imu_skip_us"] = motionStats_.longestImuSkipUs;
+  checkpoint["prev_accel"] = prevAccel_;
+  checkpoint["prev_gyro"] = prevGyro_;
+  checkpoint["prev_mag"] = prevMag_;
+  checkpoint["prev_gyro_timestamp_ns"] = optionalToJson(prevGyroTimeStampNs);
+  checkpoint["cont_repeat_accel"] = contRepeatAccel_;
+  checkpoint["cont_repeat_gyro"] = contRepeatGyro_;
+  checkpoint["last_valid_timestamp_ns"] = optionalToJson(lastValidTimestampNs_);
+  return checkpoint;
+}
+
+void Motion::restoreFromJson(const nlohmann::json& checkpoint) {
+  Periodic::restoreFromJson(checkpoint);
+  std::lock_guard lock{mutex_};
+  motionStats_.repeatAccel = checkpoint.at("repeat_accel").get<uint64_t>();
+  motionStats_.repeatGyro = checkpoint.at("repeat_gyro").get<uint64_t>();
+  motionStats_.repeatMag = checkpoint.at("repeat_mag").get<uint64_t>();
+  motionStats_.longestContRepeatAccel = checkpoint.at("longest_cont_repeat_accel").get<uint64_t>();
+  motionStats_.longestContRepeatGyro = checkpoint.at("longest_cont_repeat_gyro").get<uint64_t>();
+  motionStats_.zeroAccel = checkpoint.at("zero_accel").get<uint64_t>();
+  motionStats_.zeroGyro = checkpoint.at("zero_gyro").get<uint64_t>();
+  motionStats_.zeroMag = checkpoint.at("zero_mag").get<uint64_t>();
+  motionStats_.nonPhysicalAccel = checkpoint.at("non_physical_accel").get<uint64_t>();
+  motionStats_.maxObservedRotationAccel_radPerS2_ =
+      checkpoint.at("max_observed_rotation_accel_rad_per_s2").get<float>();
+  motionStats_.numNonPhysicalRotationAccel_ =
+      checkpoint.at("num_non_physical_rotation_accel").get<uint64_t>();
+  motionStats_.longestImuSkipUs = checkpoint.at("longest_imu_skip_us").get<uint64_t>();
+  prevAccel_ = checkpoint.at("prev_accel").get<std::array<float, 3>>();
+  prevGyro_ = checkpoint.at("prev_gyro").get<std::array<float, 3>>();
+  prevMag_ = checkpoint.at("prev_mag").get<std::array<float, 3>>();
+  prevGyroTimeStampNs = optionalFromJson(checkpoint.at("prev_gyro_timestamp_ns"));
+  contRepeatAccel_ = checkpoint.at("cont_repeat_accel").get<uint64_t>();
+  contRepeatGyro_ = checkpoint.at("cont_repeat_gyro").get<uint64_t>();
+  lastValidTimestampNs_ = optionalFromJson(checkpoint.at("last_valid_timestamp_ns"));
+}
+
 void Motion::logStats() {
   std::unique_lock lock{mutex_};
   std::cout
@@ -152,7 +220,6 @@ bool Motion::getResult() {
 }
 
 void Motion::processData(const data_provider::MotionData& data) {
-  std::lock_guard lock{mutex_};
   bool currentSampleIsBad = false;
   // Skip if just doing preprocessing
   if (preprocess_) {
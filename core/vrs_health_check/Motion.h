@@ -56,10 +56,13 @@ class Motion : public Periodic {
       float maxAllowedRotationAccel_radPerS2,
       float defaultPeriodUs);
   bool setup(vrs::RecordFileReader& reader) override; // Setup the camera player
+  bool refresh(vrs::RecordFileReader& reader) override;
   MotionStats getMotionStats(); // Get stats specific to motion sensors
   void logStats() override;
   bool getResult() override; // Pass or fail for this stream
   nlohmann::json statsToJson() override;
+  nlohmann::json checkpointToJson() override;
+  void restoreFromJson(const nlohmann::json& checkpoint) override;
 
  protected:
   void processData(const data_provider::MotionData& data);
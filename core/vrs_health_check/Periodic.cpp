@@ -20,6 +20,7 @@
 #include <fmt/format.h>
 #include <format/Format.h>
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -42,6 +43,7 @@ void Periodic::setMaxDeviationFromPeriodUs() {
 void Periodic::setSensorMisalignmentStats(
     const std::map<std::string, std::unique_ptr<SensorHealthStats>>& sensorHealthStatsMap) {
   sensorMisalignmentStats_ = std::make_unique<SensorMisalignmentStats>(sensorHealthStatsMap);
+  sensorMisalignmentStatsGeneration_++;
 }
 
 SensorMisalignmentStats* Periodic::getSensorMisalignmentStats() {
@@ -72,6 +74,59 @@ nlohmann::json Periodic::statsToJson() {
   return jsonStats;
 }
 
+nlohmann::json Periodic::checkpointToJson() {
+  std::lock_guard lock{mutex_};
+  nlohmann::json checkpoint;
+  checkpoint["processed"] = stats_.processed;
+  checkpoint["bad"] = stats_.bad;
+  checkpoint["dropped"] = stats_.dropped;
+  checkpoint["time_error"] = stats_.timeError;
+  checkpoint["consecutive_drops"] = stats_.consecutiveDrops;
+  checkpoint["largest_deviation_from_period_us"] = stats_.largestDeviationFromPeriodUs;
+  checkpoint["non_monotonic"] = stats_.nonMonotonic;
+  checkpoint["prev_timestamp_us"] = prevTimestampUs_;
+  checkpoint["first_timestamp_us"] = firstTimestampUs_;
+  nlohmann::json droppedFramesJson = nlohmann::json::array();
+  for (const auto& sample : droppedFrames_) {
+    droppedFramesJson.push_back(
+        {sample.captureTimestampUs,
+         sample.expectedTimestampUs,
+         sample.deltaFromExpectedUs,
+         sample.deltaFromPreviousUs,
+         sample.periodUs,
+         sample.dropped});
+  }
+  checkpoint["dropped_frames"] = droppedFramesJson;
+  return checkpoint;
+}
+
+void Periodic::restoreFromJson(const nlohmann::json& checkpoint) {
+  std::lock_guard lock{mutex_};
+  // total and expected are not restored, they come from the file in preprocessStream()
+  stats_.processed = checkpoint.at("processed").get<uint64_t>();
+  stats_.bad = checkpoint.at("bad").get<uint64_t>();
+  stats_.dropped = checkpoint.at("dropped").get<uint64_t>();
+  stats_.timeError = checkpoint.at("time_error").get<uint64_t>();
+  stats_.consecutiveDrops =
+      checkpoint.at("consecutive_drops").get<std::map<uint64_t, uint64_t>>();
+  stats_.largestDeviationFromPeriodUs =
+      checkpoint.at("largest_deviation_from_period_us").get<uint64_t>();
+  stats_.nonMonotonic = checkpoint.at("non_monotonic").get<uint64_t>();
+  prevTimestampUs_ = checkpoint.at("prev_timestamp_us").get<uint64_t>();
+  firstTimestampUs_ = checkpoint.at("first_timestamp_us").get<uint64_t>();
+  droppedFrames_.clear();
+  for (const auto& sampleJson : checkpoint.at("dropped_frames")) {
+    DroppedFrame& sample = droppedFrames_.emplace_back();
+    sample.captureTimestampUs = sampleJson.at(0).get<uint64_t>();
+    sample.expectedTimestampUs = sampleJson.at(1).get<uint64_t>();
+    sample.deltaFromExpectedUs = sampleJson.at(2).get<uint64_t>();
+    sample.deltaFromPreviousUs = sampleJson.at(3).get<uint64_t>();
+    sample.periodUs = sampleJson.at(4).get<uint64_t>();
+    sample.dropped = sampleJson.at(5).get<int>();
+  }
+  publishProgress(stats_);
+}
+
 void Periodic::logStats() {
   std::unique_lock lock{mutex_};
   std::stringstream seqDropStr;
@@ -111,6 +166,18 @@ float Periodic::getScore() {
   }
 }
 
+float Periodic::getRollingScore() {
+  std::lock_guard lock{mutex_};
+  if (stats_.processed == 0) {
+    return std::nanf("");
+  }
+  // Only account for the time range processed so far, the tail of the file is still pending
+  const uint64_t expected =
+      uint64_t(round(double(prevTimestampUs_ - firstTimestampUs_) / periodUs_)) + 1;
+  return float(
+      100.0 * (1.0 - std::min(1.0, double(stats_.dropped + stats_.bad) / double(expected))));
+}
+
 void Periodic::logScore() {
   Utils::logScore(streamId_.getName(), getScore(), minScore_);
 }
@@ -162,6 +229,7 @@ void Periodic::preprocessStream(vrs::RecordFileReader& reader) {
         reader.getLastRecord(streamId_, vrs::Record::Type::DATA)->timestamp * 1e6;
     stats_.expected = uint64_t(round((lastTimestampUs - firstTimestampUs) / periodUs_)) + 1;
   }
+  publishProgress(stats_);
 }
 
 void Periodic::processTimestamp(const uint64_t captureTimestampUs) {
@@ -223,8 +291,15 @@ void Periodic::processTimestamp(const uint64_t captureTimestampUs) {
     }
   }
   prevTimestampUs_ = captureTimestampUs;
-  sensorMisalignmentStats_->checkMisalignment(streamId_.getName(), captureTimestampUs);
+  if (misalignmentSamplesGeneration_ != sensorMisalignmentStatsGeneration_) {
+    misalignmentSamples_ = sensorMisalignmentStats_->getSampleBuffer(streamId_.getName());
+    misalignmentSamplesGeneration_ = sensorMisalignmentStatsGeneration_;
+  }
+  if (misalignmentSamples_ != nullptr) {
+    misalignmentSamples_->push_back(captureTimestampUs);
+  }
   stats_.processed++;
+  publishProgress(stats_);
 }
 
 } // namespace projectaria::tools::vrs_check
@@ -49,6 +49,7 @@ class Periodic : public Stream {
   Stats getStats() override;
   void logStats() override;
   float getScore() override;
+  float getRollingScore() override;
   void logScore() override;
   bool getResult() override; // Pass or fail for this stream
   uint32_t getPeriodUs() override {
@@ -60,13 +61,16 @@ class Periodic : public Stream {
 
   static SensorMisalignmentStats* getSensorMisalignmentStats();
   nlohmann::json statsToJson() override;
+  nlohmann::json checkpointToJson() override;
+  void restoreFromJson(const nlohmann::json& checkpoint) override;
 
  private:
   std::vector<DroppedFrame> droppedFrames_;
 
  protected:
   void preprocessStream(vrs::RecordFileReader& reader);
-  void processTimestamp(uint64_t captureTimestampUs); // Needs to be called with the lock held
+  // Only called by the thread processing the records of this stream
+  void processTimestamp(uint64_t captureTimestampUs);
   const float minScore_; // Minimum score for pass criteria
   PeriodicStats stats_;
   uint32_t periodUs_; // Expected interval between frames
@@ -74,6 +78,13 @@ class Periodic : public Stream {
   uint64_t maxDeviationFromPeriodUs_;
   uint64_t firstTimestampUs_ = 0;
   inline static std::unique_ptr<SensorMisalignmentStats> sensorMisalignmentStats_;
+  // Incremented whenever sensorMisalignmentStats_ is replaced, to refresh misalignmentSamples_
+  inline static uint64_t sensorMisalignmentStatsGeneration_ = 0;
+
+ private:
+  // Where to record timestamps for the misalignment checks, nullptr if not considered
+  SensorMisalignmentStats::SampleBuffer* misalignmentSamples_ = nullptr;
+  uint64_t misalignmentSamplesGeneration_ = 0;
 };
 
 } // namespace projectaria::tools::vrs_check
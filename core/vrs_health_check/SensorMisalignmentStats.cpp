@@ -16,17 +16,18 @@
 
 #include "SensorMisalignmentStats.h"
 
+#include <algorithm>
 #include <cmath>
-#include <mutex>
 #include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 #include <utility> // for pair
 #include <vector>
 
+#include <dispenso/parallel_for.h>
+
 #define DEFAULT_LOG_CHANNEL "VrsHealthCheck:SensorMisalignmentStats"
 #include <logging/Log.h>
 
@@ -40,13 +41,14 @@ std::unordered_map<std::string, int64_t> kAlignmentToleranceUsMap = {
     {"SLAM-SLAM", 200},
     {"SLAM-RGB", 200}};
 
-std::set<std::string> kConsideredSensors = {
+const std::set<std::string> kConsideredSensors = {
     "Camera Data (SLAM) #1",
     "Camera Data (SLAM) #2",
     "RGB Camera Class #1"};
 
-constexpr const int64_t kDeleteToleranceUs = 2e6;
-constexpr const uint32_t kSamplesBacklogSize = 1000;
+// Bounds on how the samples are split into time ranges checked in parallel
+constexpr size_t kMinSamplesPerRange = 1024;
+constexpr size_t kMaxRanges = 256;
 
 bool isMatchingSensorType(const std::string& sensorId, const std::string& sensorType) {
   return sensorId.find(sensorType) != std::string::npos;
@@ -88,51 +90,47 @@ SensorHealthStats::SensorHealthStats(const std::string& sensorName, int64_t peri
 
 SensorMisalignmentStats::SensorMisalignmentStats(
     const std::map<std::string, std::unique_ptr<SensorHealthStats>>& sensorHealthStatsMap) {
-  std::unordered_set<std::string> disabledSensors;
+  // kConsideredSensors is ordered, so sensorIds_ is in alphanumerical order
   for (const auto& sensorId : kConsideredSensors) {
-    if (sensorHealthStatsMap.find(sensorId) == sensorHealthStatsMap.end()) {
-      disabledSensors.insert(sensorId);
+    const auto sensorHealthStats = sensorHealthStatsMap.find(sensorId);
+    if (sensorHealthStats == sensorHealthStatsMap.end()) {
       continue;
     }
-    const auto& sensorPeriodUs = sensorHealthStatsMap.at(sensorId)->getPeriodUs();
+    sensorIds_.push_back(sensorId);
+    const auto& sensorPeriodUs = sensorHealthStats->second->getPeriodUs();
     if (sensorPeriodUs < affinityRangeUs_) {
       affinityRangeUs_ = sensorPeriodUs;
     }
   }
-  // Filter out disabled sensors
-  for (const auto& sensorId : disabledSensors) {
-    kConsideredSensors.erase(sensorId);
+  sampleBuffers_.resize(sensorIds_.size());
+  alignmentToleranceUs_.resize(sensorIds_.size() * sensorIds_.size());
+  for (size_t i = 0; i < sensorIds_.size(); ++i) {
+    for (size_t j = i + 1; j < sensorIds_.size(); ++j) {
+      alignmentToleranceUs_[i * sensorIds_.size() + j] =
+          getAlignmentToleranceUs(sensorIds_[i], sensorIds_[j]);
+    }
   }
   // Set affinity range as half of the shortest period to ensure alignment checks only performed
   // within relevant samples
   affinityRangeUs_ /= 2;
 }
 
-void SensorMisalignmentStats::checkMisalignmentInSamplesVector(const SamplesVector& samplesVector) {
-  for (const auto& sample1 : samplesVector) {
-    for (const auto& sample2 : samplesVector) {
-      // skip if equal or not in alphanumerical order
-      if (sample1.first >= sample2.first) {
-        continue;
-      }
-
-      const auto& sample1SensorTimestampUs = sample1.second;
-      const auto& sample2SensorTimestampUs = sample2.second;
-      std::string firstSensorId = sample1.first;
-      std::string secondSensorId = sample2.first;
-
-      // create implicitly if not there yet!
-      SensorMisalignmentStatistics& stats =
-          misalignmentStatisticsMap_[firstSensorId][secondSensorId];
-
-      const int64_t misalignment = std::abs(sample1SensorTimestampUs - sample2SensorTimestampUs);
+SensorMisalignmentStats::SampleBuffer* SensorMisalignmentStats::getSampleBuffer(
+    const std::string& sensorId) {
+  const auto sensor = std::lower_bound(sensorIds_.begin(), sensorIds_.end(), sensorId);
+  if (sensor == sensorIds_.end() || *sensor != sensorId) {
+    return nullptr;
+  }
+  return &sampleBuffers_[sensor - sensorIds_.begin()];
+}
 
-      stats.total++;
-      stats.max_misalignment_us = std::max(stats.max_misalignment_us, misalignment);
-      if (misalignment > getAlignmentToleranceUs(firstSensorId, secondSensorId)) {
-        stats.misaligned++;
-      }
-    }
+void SensorMisalignmentStats::checkMisalignment(
+    const std::string& newSensorId,
+    int64_t newSensorTimestampUs) {
+  // Skip sample if it belongs to a sensor that is not considered for misalignment checks
+  SampleBuffer* sampleBuffer = getSampleBuffer(newSensorId);
+  if (sampleBuffer != nullptr) {
+    sampleBuffer->push_back(newSensorTimestampUs);
   }
 }
 
@@ -141,56 +139,124 @@ void SensorMisalignmentStats::checkMisalignmentInSamplesVector(const SamplesVect
 // latest timestamps at each check. Instead, grouping samples with respect to their timestamps
 // allows checking alignment for all sensors around a timepoint regardless of their period. This
 // simplifies the algorithm by not worrying about dropped samples and just comparing all samples
-// available at a given time
-void SensorMisalignmentStats::checkMisalignment(
-    const std::string& newSensorId,
-    int64_t newSensorTimestampUs) {
-  std::unique_lock<std::mutex> misalignmentLock(misalignmentMutex_);
-  // Skip sample if it belongs to a sensor that is not considered for misalignment checks
-  if (kConsideredSensors.find(newSensorId) == kConsideredSensors.end()) {
-    return;
+// available at a given time.
+// The samples are sorted by time, so a sample either joins the time bucket started by the latest
+// bucket's first sample, or starts a new bucket.
+void SensorMisalignmentStats::checkMisalignmentInTimeRange(
+    const Sample* begin,
+    const Sample* end,
+    std::vector<SensorMisalignmentStatistics>& stats) const {
+  const size_t numSensors = sensorIds_.size();
+  auto checkBucket = [&](const Sample* bucketBegin, const Sample* bucketEnd) {
+    for (const Sample* sample1 = bucketBegin; sample1 != bucketEnd; ++sample1) {
+      for (const Sample* sample2 = bucketBegin; sample2 != bucketEnd; ++sample2) {
+        // skip if equal or not in alphanumerical order
+        if (sample1->second >= sample2->second) {
+          continue;
+        }
+        const size_t pairIndex = sample1->second * numSensors + sample2->second;
+        SensorMisalignmentStatistics& pairStats = stats[pairIndex];
+        const int64_t misalignment = std::abs(sample1->first - sample2->first);
+        pairStats.total++;
+        pairStats.max_misalignment_us = std::max(pairStats.max_misalignment_us, misalignment);
+        if (misalignment > alignmentToleranceUs_[pairIndex]) {
+          pairStats.misaligned++;
+        }
+      }
+    }
+  };
+  const Sample* bucketBegin = begin;
+  for (const Sample* sample = begin; sample != end; ++sample) {
+    if (sample->first - bucketBegin->first >= affinityRangeUs_) {
+      checkBucket(bucketBegin, sample);
+      bucketBegin = sample;
+    }
   }
-  bool timeBucketFound = false;
-  // Check all previously created time buckets to place the new sample in a vector to perform
-  // the alignment check with
-  for (auto& alignmentCheck : alignmentCheckMap_) {
-    // Timestamp for the time bucket
-    const auto& referenceTimestampUs = alignmentCheck.first;
-    // If time bucket is older than kDeleteToleranceUs, check misalignment for all samples in the
-    // samples vector and add timestamp of the bucket to the set of timestampsToDelete_ for
-    // preventing increasing memory usage
-    if (newSensorTimestampUs - referenceTimestampUs > kDeleteToleranceUs) {
-      // Check misalignment for all samples in the bucket
-      checkMisalignmentInSamplesVector(alignmentCheck.second);
-      // Add bucket to the set of buckets to be deleted
-      timestampsToDelete_.insert(referenceTimestampUs);
-      continue;
+  checkBucket(bucketBegin, end);
+}
+
+void SensorMisalignmentStats::mergeSamples(int64_t untilUs) {
+  // Gather the pending samples of all sensors in time order
+  std::vector<Sample> samples;
+  for (size_t sensorIndex = 0; sensorIndex < sampleBuffers_.size(); ++sensorIndex) {
+    for (const int64_t timestampUs : sampleBuffers_[sensorIndex]) {
+      if (timestampUs <= untilUs) {
+        samples.emplace_back(timestampUs, sensorIndex);
+      }
     }
-    // If new timestamp is close enough to the bucket's timestamp, add it to the bucket
-    if (newSensorTimestampUs - referenceTimestampUs < affinityRangeUs_) {
-      timeBucketFound = true;
-      alignmentCheck.second.push_back({newSensorId, newSensorTimestampUs});
-      break;
+  }
+  std::sort(samples.begin(), samples.end());
+
+  // Samples at least affinityRangeUs_ apart never share a time bucket, so the samples can be cut
+  // at such gaps into ranges that are checked independently. When only merging up to untilUs,
+  // stop at the last gap so later samples can still join the last bucket.
+  size_t numMerged = samples.size();
+  if (untilUs != std::numeric_limits<int64_t>::max()) {
+    while (numMerged > 0 &&
+           (numMerged == samples.size() ||
+            samples[numMerged].first - samples[numMerged - 1].first < affinityRangeUs_)) {
+      --numMerged;
     }
   }
-  // Discard old time buckets
-  for (const auto& timestampToDelete : timestampsToDelete_) {
-    alignmentCheckMap_.erase(timestampToDelete);
+  if (numMerged == 0) {
+    return;
+  }
+  const int64_t mergedUntilUs =
+      numMerged < samples.size() ? samples[numMerged].first : std::numeric_limits<int64_t>::max();
+  for (auto& sampleBuffer : sampleBuffers_) {
+    sampleBuffer.erase(
+        std::remove_if(
+            sampleBuffer.begin(),
+            sampleBuffer.end(),
+            [mergedUntilUs](int64_t timestampUs) { return timestampUs < mergedUntilUs; }),
+        sampleBuffer.end());
   }
-  // Create a new time bucket with this sample's timestamp and add the sample to the list if there
-  // was no matching bucket for it
-  if (!timeBucketFound) {
-    alignmentCheckMap_[newSensorTimestampUs].push_back({newSensorId, newSensorTimestampUs});
+
+  std::vector<size_t> rangeBegins = {0};
+  const size_t targetRangeSize = std::max<size_t>(kMinSamplesPerRange, numMerged / kMaxRanges);
+  for (size_t i = 1; i < numMerged; ++i) {
+    if (i - rangeBegins.back() >= targetRangeSize &&
+        samples[i].first - samples[i - 1].first >= affinityRangeUs_) {
+      rangeBegins.push_back(i);
+    }
+  }
+  rangeBegins.push_back(numMerged);
+
+  const size_t numRanges = rangeBegins.size() - 1;
+  const size_t numPairs = sensorIds_.size() * sensorIds_.size();
+  std::vector<std::vector<SensorMisalignmentStatistics>> rangeStats(
+      numRanges, std::vector<SensorMisalignmentStatistics>(numPairs));
+  dispenso::parallel_for(0, numRanges, [&](size_t range) {
+    checkMisalignmentInTimeRange(
+        samples.data() + rangeBegins[range],
+        samples.data() + rangeBegins[range + 1],
+        rangeStats[range]);
+  });
+
+  for (size_t i = 0; i < sensorIds_.size(); ++i) {
+    for (size_t j = i + 1; j < sensorIds_.size(); ++j) {
+      const size_t pairIndex = i * sensorIds_.size() + j;
+      for (const auto& stats : rangeStats) {
+        const SensorMisalignmentStatistics& pairStats = stats[pairIndex];
+        if (pairStats.total == 0) {
+          continue;
+        }
+        // create implicitly if not there yet!
+        SensorMisalignmentStatistics& mergedStats =
+            misalignmentStatisticsMap_[sensorIds_[i]][sensorIds_[j]];
+        mergedStats.total += pairStats.total;
+        mergedStats.misaligned += pairStats.misaligned;
+        mergedStats.max_misalignment_us =
+            std::max(mergedStats.max_misalignment_us, pairStats.max_misalignment_us);
+      }
+    }
   }
-  // Reset timestampsToDelete_
-  timestampsToDelete_.clear();
-  timestampsToDelete_.reserve(kSamplesBacklogSize);
 }
 
 void SensorMisalignmentStats::computeScores() {
-  for (auto& alignmentCheck : alignmentCheckMap_) {
-    checkMisalignmentInSamplesVector(alignmentCheck.second);
-  }
+  // All samples are accounted for after this, so computing the scores again doesn't count them
+  // twice
+  mergeSamples();
   for (auto& [sensor1Id, misalignedTos] : misalignmentStatisticsMap_) {
     for (auto& misalignedTo : misalignedTos) {
       const auto& sensor2Id = misalignedTo.first;
@@ -209,4 +275,44 @@ void SensorMisalignmentStats::computeScores() {
   }
 }
 
+nlohmann::json SensorMisalignmentStats::checkpointToJson() {
+  nlohmann::json checkpoint;
+  nlohmann::json pendingJson = nlohmann::json::object();
+  for (size_t sensorIndex = 0; sensorIndex < sensorIds_.size(); ++sensorIndex) {
+    pendingJson[sensorIds_[sensorIndex]] = sampleBuffers_[sensorIndex];
+  }
+  checkpoint["pending_samples"] = pendingJson;
+  nlohmann::json statisticsJson = nlohmann::json::array();
+  for (const auto& [sensor1Id, misalignedTos] : misalignmentStatisticsMap_) {
+    for (const auto& [sensor2Id, stats] : misalignedTos) {
+      statisticsJson.push_back(
+          {{"sensor1", sensor1Id},
+           {"sensor2", sensor2Id},
+           {"total", stats.total},
+           {"misaligned", stats.misaligned},
+           {"max_misalignment_us", stats.max_misalignment_us}});
+    }
+  }
+  checkpoint["statistics"] = statisticsJson;
+  return checkpoint;
+}
+
+void SensorMisalignmentStats::restoreFromJson(const nlohmann::json& checkpoint) {
+  const auto& pendingJson = checkpoint.at("pending_samples");
+  for (size_t sensorIndex = 0; sensorIndex < sensorIds_.size(); ++sensorIndex) {
+    sampleBuffers_[sensorIndex] = pendingJson.contains(sensorIds_[sensorIndex])
+        ? pendingJson.at(sensorIds_[sensorIndex]).get<SampleBuffer>()
+        : SampleBuffer{};
+  }
+  misalignmentStatisticsMap_.clear();
+  for (const auto& statsJson : checkpoint.at("statistics")) {
+    SensorMisalignmentStatistics& stats =
+        misalignmentStatisticsMap_[statsJson.at("sensor1").get<std::string>()]
+                                  [statsJson.at("sensor2").get<std::string>()];
+    stats.total = statsJson.at("total").get<int64_t>();
+    stats.misaligned = statsJson.at("misaligned").get<int64_t>();
+    stats.max_misalignment_us = statsJson.at("max_misalignment_us").get<int64_t>();
+  }
+}
+
 } // namespace projectaria::tools::vrs_check
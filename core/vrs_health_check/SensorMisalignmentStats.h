@@ -25,9 +25,10 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
+#include "nlohmann/json.hpp"
+
 namespace projectaria::tools::vrs_check {
 
 struct SensorMisalignmentStatistics {
@@ -52,17 +53,33 @@ class SensorHealthStats {
   std::mutex mutex_; // Protect stats_ since it can be called async by the client
 };
 
-using SamplesVector = std::vector<std::pair<std::string, int64_t>>;
-
 class SensorMisalignmentStats {
  public:
+  // Timestamps of one sensor waiting to be checked. Each buffer is only written by the thread
+  // processing the stream of that sensor, so samples are recorded without taking any lock.
+  using SampleBuffer = std::vector<int64_t>;
+
   explicit SensorMisalignmentStats(
       const std::map<std::string, std::unique_ptr<SensorHealthStats>>& sensorHealthStatsMap);
 
+  // Buffer to record the timestamps of a sensor, nullptr if the sensor is not considered for
+  // misalignment checks. The buffers are stable for the lifetime of this object.
+  SampleBuffer* getSampleBuffer(const std::string& sensorId);
+
   void checkMisalignment(const std::string& newSensorId, int64_t newSensorTimestampUs);
 
+  // Check the buffered samples up to untilUs and fold them into the statistics. The samples are
+  // split in independent time ranges which are checked in parallel. Must not be called while
+  // samples are being recorded.
+  void mergeSamples(int64_t untilUs = std::numeric_limits<int64_t>::max());
+
   void computeScores();
 
+  // Serialize the pending samples and the statistics gathered so far, so an incremental
+  // check can resume after a restart
+  nlohmann::json checkpointToJson();
+  void restoreFromJson(const nlohmann::json& checkpoint);
+
   const std::
       unordered_map<std::string, std::unordered_map<std::string, SensorMisalignmentStatistics>>&
       misalignmentStatisticsMap() {
@@ -70,14 +87,20 @@ class SensorMisalignmentStats {
   }
 
  private:
-  void checkMisalignmentInSamplesVector(const SamplesVector& samplesVector);
+  // Sample of a time range being checked, with the index of its sensor in sensorIds_
+  using Sample = std::pair<int64_t, size_t>;
+
+  void checkMisalignmentInTimeRange(
+      const Sample* begin,
+      const Sample* end,
+      std::vector<SensorMisalignmentStatistics>& stats) const;
 
   std::unordered_map<std::string, std::unordered_map<std::string, SensorMisalignmentStatistics>>
       misalignmentStatisticsMap_;
 
-  std::map<int64_t, SamplesVector> alignmentCheckMap_;
-  std::unordered_set<int64_t> timestampsToDelete_;
-  std::mutex misalignmentMutex_;
+  std::vector<std::string> sensorIds_; // Considered sensors, in alphanumerical order
+  std::vector<SampleBuffer> sampleBuffers_; // Pending samples of each sensor in sensorIds_
+  std::vector<int64_t> alignmentToleranceUs_; // Tolerance of each pair of sensors
   int64_t affinityRangeUs_ = std::numeric_limits<int64_t>::max();
 };
 
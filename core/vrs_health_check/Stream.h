@@ -20,8 +20,10 @@
 
 #include <vrs/RecordFileReader.h>
 #include <vrs/StreamId.h>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
+#include <mutex>
 
 namespace projectaria::tools::vrs_check {
 
@@ -38,8 +40,19 @@ class Stream {
   virtual ~Stream() {}
   // Setup the motion player
   virtual bool setup(vrs::RecordFileReader& reader) = 0;
-  // Get stats during processing, useful for showing processing progress
+  // Bind the player made by setup() to a new reader of the same file, opened again after records
+  // were appended to it, and update the totals. Unlike setup(), the configuration isn't read again.
+  virtual bool refresh(vrs::RecordFileReader& reader) = 0;
+  // Get stats once processing is done
   virtual Stats getStats() = 0;
+  // Get the total and processed counts, safe to call from any thread while records are being
+  // processed, useful for showing processing progress
+  Stats getProgress() const {
+    Stats progress;
+    progress.total = progressTotal_.load(std::memory_order_relaxed);
+    progress.processed = progressProcessed_.load(std::memory_order_relaxed);
+    return progress;
+  }
   virtual void logStats() = 0;
   //! "Score" is an integrity check (all expected records are present),
   //! not a quality check (I like the values I got).
@@ -63,10 +76,30 @@ class Stream {
     jsonStats["bad"] = stats.bad;
     return jsonStats;
   }
+  // Score over the records processed so far. Used to publish rolling results while a file is
+  // still being checked incrementally, when the totals of the file are not final yet.
+  virtual float getRollingScore() {
+    return getScore();
+  }
+  // Serialize the processing state so an incremental check can resume after a restart
+  virtual nlohmann::json checkpointToJson() {
+    return nlohmann::json::object();
+  }
+  // Restore the processing state saved by checkpointToJson(). Must be called after setup().
+  virtual void restoreFromJson(const nlohmann::json& /* checkpoint */) {}
 
  protected:
-  std::mutex mutex_; // Protect stats_ since it can be called async by the client
+  // Publish the counts returned by getProgress(), called by the thread processing the records
+  void publishProgress(const Stats& stats) {
+    progressTotal_.store(stats.total, std::memory_order_relaxed);
+    progressProcessed_.store(stats.processed, std::memory_order_relaxed);
+  }
+  // Serialize the accessors. Records of a stream are processed by a single thread, which owns
+  // the stats without taking this lock; other threads only read them through getProgress().
+  std::mutex mutex_;
   const vrs::StreamId streamId_;
+  std::atomic<uint64_t> progressTotal_{0};
+  std::atomic<uint64_t> progressProcessed_{0};
 };
 
 } // namespace projectaria::tools::vrs_check
@@ -61,8 +61,13 @@ bool TimeDomainMapping::setup(vrs::RecordFileReader& reader) {
   return true;
 }
 
+bool TimeDomainMapping::refresh(vrs::RecordFileReader& reader) {
+  reader.setStreamPlayer(streamId_, timeSyncPlayer_.get());
+  preprocessStream(reader);
+  return true;
+}
+
 void TimeDomainMapping::processData(const data_provider::TimeSyncData& data) {
-  std::lock_guard lock{mutex_};
   if (data.monotonicTimestampNs < 0 || data.realTimestampNs < 0) {
     stats_.bad++;
   }
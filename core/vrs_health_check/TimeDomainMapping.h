@@ -27,6 +27,7 @@ class TimeDomainMapping : public Periodic {
   TimeDomainMapping(vrs::StreamId streamId, float minScore);
   // Setup the TimeDomainMapping player
   bool setup(vrs::RecordFileReader& reader) override;
+  bool refresh(vrs::RecordFileReader& reader) override;
 
  private:
   void processData(const data_provider::TimeSyncData& data);
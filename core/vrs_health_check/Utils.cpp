@@ -16,8 +16,11 @@
 
 #include "VrsHealthCheck.h"
 
+#include <chrono>
+#include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <thread>
 
 #if defined(_WIN32)
 #include <io.h>
@@ -38,8 +41,61 @@
 
 #include "Logging.h"
 
+namespace fs = std::filesystem;
+
 namespace projectaria::tools::vrs_check {
 
+namespace {
+
+constexpr auto kFollowPollInterval = std::chrono::seconds(1);
+
+// Total size of the VRS files in the path, used to detect when a recording stopped growing
+uint64_t getVrsFilesSize(const std::string& path) {
+  std::error_code ec;
+  uint64_t size = 0;
+  if (fs::is_directory(path)) {
+    for (const auto& p : fs::directory_iterator(path, ec)) {
+      if (p.path().extension() == ".vrs") {
+        size += fs::file_size(p.path(), ec);
+      }
+    }
+  } else {
+    size = fs::file_size(path, ec);
+  }
+  return ec ? 0 : size;
+}
+
+// Validate the VRS files while they are still being written, and finalize once they haven't
+// grown for idleSec seconds
+bool runHealthCheckFollowing(
+    VrsHealthCheck& healthCheck,
+    const std::string& path,
+    const std::string& checkpointPath,
+    double idleSec) {
+  if (!checkpointPath.empty() && fs::exists(checkpointPath)) {
+    healthCheck.loadCheckpoint(checkpointPath);
+  }
+  uint64_t prevSize = getVrsFilesSize(path);
+  auto lastGrowth = std::chrono::steady_clock::now();
+  while (true) {
+    if (!healthCheck.runIncremental()) {
+      XR_LOGW("Incremental pass failed, retrying");
+    }
+    std::this_thread::sleep_for(kFollowPollInterval);
+    const uint64_t size = getVrsFilesSize(path);
+    const auto now = std::chrono::steady_clock::now();
+    if (size != prevSize) {
+      prevSize = size;
+      lastGrowth = now;
+    } else if (std::chrono::duration<double>(now - lastGrowth).count() >= idleSec) {
+      break;
+    }
+  }
+  return healthCheck.finalize();
+}
+
+} // namespace
+
 bool Utils::doColor_ = true;
 
 void Utils::logScore(const std::string& streamName, const float score, const float minScore) {
@@ -148,6 +204,7 @@ int Utils::runVrsHealthCheck(int argc, char* argv[]) {
   bool verbose = false;
   std::string jsonOutFilename;
   std::string droppedOutFilename;
+  double followIdleSec = 0.0;
 
   std::string path_desc = "VRS file location (or directory)";
   app.add_option("--path", path, path_desc)->required();
@@ -171,6 +228,19 @@ int Utils::runVrsHealthCheck(int argc, char* argv[]) {
   app.add_option("--default-gps-rate-hz", settings.defaultGpsRateHz, "Default GPS rate in Hz");
   app.add_flag("--ignore-audio", settings.ignoreAudio, "Ignore audio errors");
   app.add_flag("--ignore-bluetooth", settings.ignoreBluetooth, "Ignore bluetooth errors");
+  app.add_option(
+      "--follow-idle-sec",
+      followIdleSec,
+      "Validate the file(s) while they are being written, and finish once they did not grow for"
+      " this many seconds");
+  app.add_option(
+      "--checkpoint",
+      settings.checkpointPath,
+      "With --follow-idle-sec, save progress to this file and resume from it if it exists");
+  app.add_option(
+      "--result-cache",
+      settings.resultCachePath,
+      "Sidecar file caching the stream counters, reused while the file(s) don't change");
 
   // settings related to camera roi check
   settings.cameraCheckSettings = {
@@ -260,11 +330,20 @@ int Utils::runVrsHealthCheck(int argc, char* argv[]) {
     }
   } // end for camera roiSetting
 
+  if (followIdleSec > 0) {
+    settings.rollingScoreCallback = [](const std::string& streamName, float score) {
+      XR_LOGI("{}: rolling score {:.3f}%", streamName, score);
+    };
+  }
+
   VrsHealthCheck healthCheck(settings);
   if (!healthCheck.setup(path)) {
     return EXIT_FAILURE;
   }
-  if (!healthCheck.run()) {
+  const bool runResult = followIdleSec > 0
+      ? runHealthCheckFollowing(healthCheck, path, settings.checkpointPath, followIdleSec)
+      : healthCheck.run();
+  if (!runResult) {
     return EXIT_FAILURE;
   }
   if (printStats) {
@@ -18,6 +18,7 @@
 
 #include <fmt/format.h>
 #include <format/Format.h>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <exception>
@@ -39,6 +40,7 @@
 #include "Logging.h"
 
 #include <vrs/ErrorCode.h>
+#include <vrs/IndexRecord.h>
 #include <vrs/StreamId.h>
 #include <filesystem>
 
@@ -59,6 +61,40 @@ using namespace std::literals::chrono_literals;
 
 namespace projectaria::tools::vrs_check {
 
+namespace {
+constexpr int kCheckpointVersion = 2;
+constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+// FNV-1a hash of the bytes of a trivially copyable value, combined into hash
+template <typename T>
+void fnvHash(uint64_t& hash, const T& value) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    hash = (hash ^ bytes[i]) * kFnvPrime;
+  }
+}
+
+// Write to a temporary file first so an interruption never leaves a truncated file behind
+bool writeJsonAtomically(const std::string& filepath, const nlohmann::json& json) {
+  const std::string tmpFilepath = filepath + ".tmp";
+  std::ofstream outputFile(tmpFilepath);
+  if (!outputFile.is_open()) {
+    XR_LOGE("Unable to open file for writing: {}", tmpFilepath);
+    return false;
+  }
+  outputFile << json;
+  outputFile.close();
+  std::error_code ec;
+  fs::rename(tmpFilepath, filepath, ec);
+  if (ec) {
+    XR_LOGE("Unable to write file {}: {}", filepath, ec.message());
+    return false;
+  }
+  return true;
+}
+} // namespace
+
 VrsHealthCheck::VrsHealthCheck(Settings settings) : settings_{settings} {}
 
 bool VrsHealthCheck::setup(const std::string& path) {
@@ -80,6 +116,7 @@ bool VrsHealthCheck::setupFiles(const std::string& path) {
     for (const auto& p : fs::directory_iterator(path)) {
       if (p.path().extension() == ".vrs") {
         filePaths.emplace_back(p.path().filename().string());
+        filePaths_.emplace_back(p.path().string());
         reader_.emplace_back(std::make_unique<vrs::RecordFileReader>());
         int rc = reader_.back()->openFile(p.path().string());
         if (rc) {
@@ -90,6 +127,7 @@ bool VrsHealthCheck::setupFiles(const std::string& path) {
     }
   } else if (fs::path(path).extension() == ".vrs") {
     filePaths.emplace_back(fs::path(path).filename().string());
+    filePaths_.emplace_back(path);
     reader_.emplace_back(std::make_unique<vrs::RecordFileReader>());
     int rc = reader_.back()->openFile(path);
     if (rc) {
@@ -101,12 +139,19 @@ bool VrsHealthCheck::setupFiles(const std::string& path) {
     XR_LOGE("No VRS file found");
     return false;
   }
+  processedUntilTimeSec_.assign(reader_.size(), std::numeric_limits<double>::lowest());
+  for (const auto& filePath : filePaths_) {
+    std::error_code ec;
+    fileSizes_.push_back(fs::file_size(filePath, ec));
+  }
   return setupPlayables(filePaths);
 }
 
 bool VrsHealthCheck::setupPlayables(const std::vector<std::string>& filePaths) {
+  bool result = true;
   // Add all playables
-  for (const auto& reader : reader_) {
+  for (size_t fileIndex = 0; fileIndex < reader_.size(); ++fileIndex) {
+    const auto& reader = reader_[fileIndex];
     const std::set<vrs::StreamId>& recordables = reader->getStreams();
     for (const auto& recordable : recordables) {
       std::unique_ptr<Stream> stream = nullptr;
@@ -171,13 +216,20 @@ bool VrsHealthCheck::setupPlayables(const std::vector<std::string>& filePaths) {
           break;
       }
       if (stream) {
-        stream->setup(*reader);
+        if (!stream->setup(*reader)) {
+          XR_LOGE("Failed to setup stream {}", recordable.getName());
+          // The player may already be registered, it goes away with the stream
+          reader->setStreamPlayer(recordable, nullptr);
+          result = false;
+          continue;
+        }
         streams_.push_back(std::move(stream));
+        streamFileIndex_.push_back(fileIndex);
       }
     }
   }
 
-  return true;
+  return result;
 }
 
 void VrsHealthCheck::setupSensorHealthStatsMap() {
@@ -216,7 +268,7 @@ double VrsHealthCheck::getLastDataRecordTime() {
 
 void VrsHealthCheck::printProgress() {
   for (const auto& stream : streams_) {
-    const auto stats = stream->getStats();
+    const auto stats = stream->getProgress();
     std::string streamName = stream->getStreamId().getName();
 
     float current = static_cast<float>(stats.processed);
@@ -233,6 +285,15 @@ void VrsHealthCheck::printProgress() {
 bool VrsHealthCheck::run() {
   bool result = true;
   Utils::enableColoredText(settings_.isInteractive);
+  usedResultCache_ =
+      !settings_.resultCachePath.empty() && loadResultCache(settings_.resultCachePath);
+  if (usedResultCache_) {
+    XR_LOGI("Reusing the cached results from {}", settings_.resultCachePath);
+    Periodic::getSensorMisalignmentStats()->computeScores();
+    cachedMisalignmentStatistics_ =
+        Periodic::getSensorMisalignmentStats()->misalignmentStatisticsMap();
+    return true;
+  }
   XR_LOGI("Reading all records!");
   auto readStart = std::chrono::high_resolution_clock::now();
   std::vector<std::future<int>> readFut;
@@ -289,6 +350,153 @@ bool VrsHealthCheck::run() {
 
   Periodic::getSensorMisalignmentStats()->computeScores();
 
+  cachedMisalignmentStatistics_ =
+      Periodic::getSensorMisalignmentStats()->misalignmentStatisticsMap();
+
+  if (result) {
+    // Everything was read, keep the per-file cursors consistent with the saved state
+    for (size_t fileIndex = 0; fileIndex < reader_.size(); ++fileIndex) {
+      const auto& index = reader_[fileIndex]->getIndex();
+      if (!index.empty()) {
+        processedUntilTimeSec_[fileIndex] = index.back().timestamp;
+      }
+    }
+    if (!settings_.resultCachePath.empty()) {
+      saveResultCache(settings_.resultCachePath);
+    }
+  }
+
+  XR_LOGI("Finished reading all records!");
+  return result;
+}
+
+bool VrsHealthCheck::processRecords(size_t fileIndex, double horizonSec) {
+  vrs::RecordFileReader& reader = *reader_[fileIndex];
+  std::set<vrs::StreamId> streamIds;
+  for (size_t streamIndex = 0; streamIndex < streams_.size(); ++streamIndex) {
+    if (streamFileIndex_[streamIndex] == fileIndex) {
+      streamIds.insert(streams_[streamIndex]->getStreamId());
+    }
+  }
+  // The index is sorted by timestamp, resume right after the last record processed
+  const std::vector<vrs::IndexRecord::RecordInfo>& index = reader.getIndex();
+  double& processedUntilTimeSec = processedUntilTimeSec_[fileIndex];
+  auto record = std::upper_bound(
+      index.begin(),
+      index.end(),
+      processedUntilTimeSec,
+      [](double timestampSec, const vrs::IndexRecord::RecordInfo& recordInfo) {
+        return timestampSec < recordInfo.timestamp;
+      });
+  for (; record != index.end() && record->timestamp <= horizonSec; ++record) {
+    if (record->recordType == vrs::Record::Type::DATA && streamIds.count(record->streamId) > 0) {
+      const int rc = reader.readRecord(*record);
+      if (rc) {
+        XR_LOGE(
+            "Failed to read {} record at {}s, error = {}",
+            record->streamId.getName(),
+            record->timestamp,
+            rc);
+        return false;
+      }
+    }
+    processedUntilTimeSec = record->timestamp;
+  }
+  return true;
+}
+
+void VrsHealthCheck::publishRollingScores() {
+  for (const auto& stream : streams_) {
+    const std::string streamName = stream->getStreamId().getName();
+    if (settings_.progressCallback != nullptr) {
+      const auto stats = stream->getProgress();
+      settings_.progressCallback(
+          streamName, static_cast<float>(stats.processed), static_cast<float>(stats.total));
+    }
+    const float score = stream->getRollingScore();
+    if (settings_.rollingScoreCallback != nullptr && std::isfinite(score)) {
+      settings_.rollingScoreCallback(streamName, score);
+    }
+  }
+}
+
+bool VrsHealthCheck::reopenIfGrown(size_t fileIndex) {
+  const std::string& filePath = filePaths_[fileIndex];
+  std::error_code ec;
+  const uintmax_t fileSize = fs::file_size(filePath, ec);
+  if (ec) {
+    XR_LOGE("Failed to get the size of {}: {}", filePath, ec.message());
+    return false;
+  }
+  if (fileSize == fileSizes_[fileIndex]) {
+    // Nothing was appended since the previous pass, the index of the reader is up to date
+    return true;
+  }
+  // A VRS reader can't extend the index of an open file, so open it again to index the records
+  // appended since. The players keep their state, they are only bound to the new reader and
+  // their totals updated.
+  auto reader = std::make_unique<vrs::RecordFileReader>();
+  const int rc = reader->openFile(filePath);
+  if (rc) {
+    XR_LOGE("Failed to open file {}, error = {}", filePath, rc);
+    return false;
+  }
+  bool result = true;
+  for (size_t streamIndex = 0; streamIndex < streams_.size(); ++streamIndex) {
+    if (streamFileIndex_[streamIndex] == fileIndex && !streams_[streamIndex]->refresh(*reader)) {
+      XR_LOGE("Failed to refresh stream {}", streams_[streamIndex]->getStreamId().getName());
+      result = false;
+    }
+  }
+  reader_[fileIndex] = std::move(reader);
+  fileSizes_[fileIndex] = fileSize;
+  return result;
+}
+
+bool VrsHealthCheck::runIncremental(bool isComplete) {
+  bool result = true;
+  for (size_t fileIndex = 0; fileIndex < reader_.size(); ++fileIndex) {
+    if (!reopenIfGrown(fileIndex)) {
+      result = false;
+      continue;
+    }
+    const auto& index = reader_[fileIndex]->getIndex();
+    double horizonSec = std::numeric_limits<double>::infinity();
+    if (!isComplete) {
+      horizonSec = index.empty() ? std::numeric_limits<double>::lowest()
+                                 : index.back().timestamp - settings_.incrementalSettleTimeSec;
+    }
+    try {
+      result &= processRecords(fileIndex, horizonSec);
+    } catch (const std::exception& e) {
+      XR_LOGE("Exception while reading {}: {}", filePaths_[fileIndex], e.what());
+      result = false;
+    }
+  }
+  // Check the misalignment of the samples that records of later passes can't affect anymore, so
+  // the pending samples don't grow with the length of the recording
+  if (!isComplete && !processedUntilTimeSec_.empty()) {
+    const double mergeUntilSec =
+        *std::min_element(processedUntilTimeSec_.begin(), processedUntilTimeSec_.end()) -
+        settings_.incrementalSettleTimeSec;
+    if (mergeUntilSec > 0) {
+      Periodic::getSensorMisalignmentStats()->mergeSamples(
+          static_cast<int64_t>(mergeUntilSec * 1e6));
+    }
+  }
+  publishRollingScores();
+  if (!settings_.checkpointPath.empty()) {
+    result &= saveCheckpoint(settings_.checkpointPath);
+  }
+  return result;
+}
+
+bool VrsHealthCheck::finalize() {
+  Utils::enableColoredText(settings_.isInteractive);
+  const bool result = runIncremental(true);
+
+  Periodic::getSensorMisalignmentStats()->computeScores();
+
   cachedMisalignmentStatistics_ =
       Periodic::getSensorMisalignmentStats()->misalignmentStatisticsMap();
 
@@ -296,6 +504,167 @@ bool VrsHealthCheck::run() {
   return result;
 }
 
+std::string VrsHealthCheck::getCheckpointKey(size_t streamIndex) const {
+  return fmt::format(
+      "{}/{}",
+      fs::path(filePaths_[streamFileIndex_[streamIndex]]).filename().string(),
+      streams_[streamIndex]->getStreamId().getNumericName());
+}
+
+nlohmann::json VrsHealthCheck::stateToJson() {
+  nlohmann::json checkpoint;
+  checkpoint["version"] = kCheckpointVersion;
+  for (size_t fileIndex = 0; fileIndex < filePaths_.size(); ++fileIndex) {
+    checkpoint["processed_until_time_sec"][fs::path(filePaths_[fileIndex]).filename().string()] =
+        processedUntilTimeSec_[fileIndex];
+  }
+  for (size_t streamIndex = 0; streamIndex < streams_.size(); ++streamIndex) {
+    checkpoint["streams"][getCheckpointKey(streamIndex)] =
+        streams_[streamIndex]->checkpointToJson();
+  }
+  checkpoint["misalignment"] = Periodic::getSensorMisalignmentStats()->checkpointToJson();
+  return checkpoint;
+}
+
+bool VrsHealthCheck::restoreState(const nlohmann::json& checkpoint, const std::string& filepath) {
+  try {
+    if (checkpoint.at("version").get<int>() != kCheckpointVersion) {
+      XR_LOGW("Ignoring checkpoint {} with unsupported version", filepath);
+      return false;
+    }
+    // Only resume if the checkpoint covers exactly the files and streams being checked
+    const auto& processedUntilJson = checkpoint.at("processed_until_time_sec");
+    const auto& streamsJson = checkpoint.at("streams");
+    std::vector<double> processedUntilTimeSec;
+    for (const auto& path : filePaths_) {
+      const std::string filename = fs::path(path).filename().string();
+      if (!processedUntilJson.contains(filename)) {
+        XR_LOGW("Ignoring checkpoint {} which does not cover {}", filepath, filename);
+        return false;
+      }
+      processedUntilTimeSec.push_back(processedUntilJson.at(filename).get<double>());
+    }
+    for (size_t streamIndex = 0; streamIndex < streams_.size(); ++streamIndex) {
+      if (!streamsJson.contains(getCheckpointKey(streamIndex))) {
+        XR_LOGW(
+            "Ignoring checkpoint {} which does not cover {}",
+            filepath,
+            getCheckpointKey(streamIndex));
+        return false;
+      }
+    }
+
+    for (size_t streamIndex = 0; streamIndex < streams_.size(); ++streamIndex) {
+      streams_[streamIndex]->restoreFromJson(streamsJson.at(getCheckpointKey(streamIndex)));
+    }
+    Periodic::getSensorMisalignmentStats()->restoreFromJson(checkpoint.at("misalignment"));
+    processedUntilTimeSec_ = std::move(processedUntilTimeSec);
+  } catch (const nlohmann::json::exception& e) {
+    XR_LOGE("Invalid checkpoint in {}: {}", filepath, e.what());
+    return false;
+  }
+  return true;
+}
+
+bool VrsHealthCheck::saveCheckpoint(const std::string& filepath) {
+  return writeJsonAtomically(filepath, stateToJson());
+}
+
+bool VrsHealthCheck::loadCheckpoint(const std::string& filepath) {
+  std::ifstream inputFile(filepath);
+  if (!inputFile.is_open()) {
+    XR_LOGW("Unable to open checkpoint file {}", filepath);
+    return false;
+  }
+  nlohmann::json checkpoint;
+  try {
+    checkpoint = nlohmann::json::parse(inputFile);
+  } catch (const nlohmann::json::exception& e) {
+    XR_LOGE("Invalid checkpoint file {}: {}", filepath, e.what());
+    return false;
+  }
+  if (!restoreState(checkpoint, filepath)) {
+    return false;
+  }
+  XR_LOGI("Resuming from checkpoint {}", filepath);
+  return true;
+}
+
+nlohmann::json VrsHealthCheck::getResultCacheKey() {
+  nlohmann::json key;
+  for (size_t fileIndex = 0; fileIndex < reader_.size(); ++fileIndex) {
+    // Hash the index rather than the file content, it changes whenever a record is added, moved or
+    // resized and is already in memory
+    uint64_t indexChecksum = kFnvOffsetBasis;
+    for (const auto& record : reader_[fileIndex]->getIndex()) {
+      fnvHash(indexChecksum, record.timestamp);
+      fnvHash(indexChecksum, record.fileOffset);
+      fnvHash(indexChecksum, record.streamId.getTypeId());
+      fnvHash(indexChecksum, record.streamId.getInstanceId());
+      fnvHash(indexChecksum, record.recordType);
+    }
+    std::error_code ec;
+    const std::string filename = fs::path(filePaths_[fileIndex]).filename().string();
+    key["files"][filename]["size"] = fs::file_size(filePaths_[fileIndex], ec);
+    key["files"][filename]["index_checksum"] = indexChecksum;
+  }
+  // Only the settings that change the per-stream counters are part of the key. The pass/fail
+  // thresholds are applied when scoring, so changing them reuses the cached counters.
+  nlohmann::json& settingsJson = key["settings"];
+  settingsJson["physical_accel_threshold"] = settings_.physicalAccelThreshold;
+  settingsJson["max_allowed_rotation_accel_rad_per_s2"] =
+      settings_.maxAllowedRotationAccel_radPerS2;
+  settingsJson["default_imu_period_us"] = settings_.defaultImuPeriodUs;
+  settingsJson["min_temp"] = settings_.minTemp;
+  settingsJson["max_temp"] = settings_.maxTemp;
+  settingsJson["min_camera_gain"] = settings_.minCameraGain;
+  settingsJson["max_camera_gain"] = settings_.maxCameraGain;
+  settingsJson["min_camera_exposure_ms"] = settings_.minCameraExposureMs;
+  settingsJson["max_camera_exposure_ms"] = settings_.maxCameraExposureMs;
+  settingsJson["min_gps_accuracy"] = settings_.minGpsAccuracy;
+  settingsJson["default_gps_rate_hz"] = settings_.defaultGpsRateHz;
+  for (const auto& [typeId, cameraCheckSetting] : settings_.cameraCheckSettings) {
+    nlohmann::json& cameraJson = settingsJson["cameras"][std::to_string(static_cast<int>(typeId))];
+    if (!cameraCheckSetting.roiToCheck.isEmpty()) {
+      cameraJson["roi_to_check"] = {
+          cameraCheckSetting.roiToCheck.min().x(),
+          cameraCheckSetting.roiToCheck.min().y(),
+          cameraCheckSetting.roiToCheck.max().x(),
+          cameraCheckSetting.roiToCheck.max().y()};
+    }
+    cameraJson["roi_lower_thresh"] = cameraCheckSetting.roiLowerThresh;
+    cameraJson["roi_upper_thresh"] = cameraCheckSetting.roiUpperThresh;
+  }
+  return key;
+}
+
+bool VrsHealthCheck::loadResultCache(const std::string& filepath) {
+  std::ifstream inputFile(filepath);
+  if (!inputFile.is_open()) {
+    return false;
+  }
+  try {
+    const nlohmann::json cache = nlohmann::json::parse(inputFile);
+    if (cache.at("key") != getResultCacheKey()) {
+      XR_LOGI("Result cache {} is stale, re-reading the files", filepath);
+      return false;
+    }
+    return restoreState(cache.at("state"), filepath);
+  } catch (const nlohmann::json::exception& e) {
+    XR_LOGW("Ignoring invalid result cache {}: {}", filepath, e.what());
+    return false;
+  }
+}
+
+bool VrsHealthCheck::saveResultCache(const std::string& filepath) {
+  nlohmann::json cache;
+  cache["key"] = getResultCacheKey();
+  cache["state"] = stateToJson();
+  // Also store the stats as logged by logStatsJson(), for consumers that only need the numbers
+  cache["stats"] = statsToJson();
+  return writeJsonAtomically(filepath, cache);
+}
+
 void VrsHealthCheck::logStats() {
   for (const auto& stream : streams_) {
     stream->logStats();
@@ -313,7 +682,7 @@ void VrsHealthCheck::logStats() {
   }
 }
 
-void VrsHealthCheck::logStatsJson(const std::string& filepath) {
+nlohmann::json VrsHealthCheck::statsToJson() {
   nlohmann::json aggregatedJsonResults;
   for (const auto& stream : streams_) {
     nlohmann::json statsJson = stream->statsToJson();
@@ -338,7 +707,11 @@ void VrsHealthCheck::logStatsJson(const std::string& filepath) {
                            ["num_frames_checked"] = sensorToAlign.second.total;
     }
   }
+  return aggregatedJsonResults;
+}
 
+void VrsHealthCheck::logStatsJson(const std::string& filepath) {
+  const nlohmann::json aggregatedJsonResults = statsToJson();
   if (!filepath.empty()) {
     std::ofstream outputFile(filepath);
     if (!outputFile.is_open()) {
@@ -366,6 +739,10 @@ void VrsHealthCheck::logDroppedFrames(const std::string& filepath) {
   csvWriter.close();
 }
 
+bool VrsHealthCheck::usedResultCache() const {
+  return usedResultCache_;
+}
+
 bool VrsHealthCheck::getResult() {
   bool result = true;
   for (const auto& stream : streams_) {
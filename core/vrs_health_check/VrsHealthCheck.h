@@ -65,6 +65,17 @@ struct Settings {
   std::unordered_map<::vrs::RecordableTypeId, CameraCheckSetting> cameraCheckSettings;
   bool isInteractive = true; // Whether to show progress interactively
   std::function<void(const std::string&, float, float)> progressCallback = nullptr;
+  // Incremental mode: records within this window of the newest record of a file still being
+  // written are left for the next pass, since other streams may still append older timestamps
+  double incrementalSettleTimeSec = 2.0;
+  // Incremental mode: if set, the processing state is saved to this file after every pass
+  std::string checkpointPath;
+  // Incremental mode: called after every pass with the stream name and its rolling score
+  std::function<void(const std::string&, float)> rollingScoreCallback = nullptr;
+  // If set, run() caches the per-stream counters in this sidecar file, keyed by the size and
+  // index checksum of the files and the settings that affect the counters. Later runs on the same
+  // files reuse them without reading any record, even if the score thresholds changed.
+  std::string resultCachePath;
 };
 
 class VrsHealthCheck {
@@ -72,12 +83,25 @@ class VrsHealthCheck {
   explicit VrsHealthCheck(Settings settings);
   bool setup(const std::string& path); // Setup readers and playables
   bool run(); // Parse through all records in all files to get the health result
+  // Incremental mode, for files that are still being written or uploaded in chunks, used instead
+  // of run(). Each pass re-opens the files that grew and only processes the records appended since
+  // the previous pass. Rolling scores are published through the settings callbacks.
+  bool runIncremental(bool isComplete = false);
+  // Process the tail of the files once they are complete and compute the final scores
+  bool finalize();
+  // Save or restore the incremental processing state, so a restart resumes instead of re-reading.
+  // loadCheckpoint() must be called after setup() and before the first pass.
+  bool saveCheckpoint(const std::string& filepath);
+  bool loadCheckpoint(const std::string& filepath);
   void logStats(); // Log to console statistics about all streams
+  nlohmann::json statsToJson(); // Statistics about all streams as JSON
   void logStatsJson(const std::string& filepath); // Log to JSON statistics about all streams
   void logDroppedFrames(const std::string& filepath); // Log to csv statistics about dropped
                                                       // frames in all the streams
   // Result of the VRS verification. Determine if the VRS files are useful or not.
   bool getResult();
+  // Whether the last run() restored the counters from the result cache instead of reading records
+  bool usedResultCache() const;
 
  private:
   bool setupFiles(const std::string& path); // Setup file readers and playables
@@ -86,12 +110,27 @@ class VrsHealthCheck {
   double getLastDataRecordTime();
   double getFirstDataRecordTime();
   void printProgress();
+  bool reopenIfGrown(size_t fileIndex);
+  bool processRecords(size_t fileIndex, double horizonSec);
+  void publishRollingScores();
+  std::string getCheckpointKey(size_t streamIndex) const;
+  nlohmann::json stateToJson();
+  bool restoreState(const nlohmann::json& checkpoint, const std::string& filepath);
+  nlohmann::json getResultCacheKey();
+  bool loadResultCache(const std::string& filepath);
+  bool saveResultCache(const std::string& filepath);
   const Settings settings_;
   std::vector<std::unique_ptr<vrs::RecordFileReader>> reader_;
   std::vector<std::unique_ptr<Stream>> streams_;
+  std::vector<std::string> filePaths_; // Path of the file opened by each reader
+  std::vector<uintmax_t> fileSizes_; // Size of each file when its reader was opened
+  std::vector<size_t> streamFileIndex_; // Index of the reader each stream is read from
+  // Per file, timestamp of the last record processed in incremental mode
+  std::vector<double> processedUntilTimeSec_;
   std::shared_ptr<SensorMisalignmentStats> sensorMisalignmentStats_;
   std::unordered_map<std::string, std::unordered_map<std::string, SensorMisalignmentStatistics>>
       cachedMisalignmentStatistics_;
+  bool usedResultCache_ = false;
 };
 
 } // namespace projectaria::tools::vrs_check
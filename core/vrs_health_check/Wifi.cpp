@@ -48,16 +48,54 @@ bool Wifi::setup(vrs::RecordFileReader& reader) {
 
   std::unique_lock lock{mutex_};
   stats_.total = reader.getRecordCount(streamId_, vrs::Record::Type::DATA);
+  publishProgress(stats_);
   lock.unlock();
 
   return true;
 }
 
+bool Wifi::refresh(vrs::RecordFileReader& reader) {
+  reader.setStreamPlayer(streamId_, wifiBeaconPlayer_.get());
+  std::unique_lock lock{mutex_};
+  stats_.total = reader.getRecordCount(streamId_, vrs::Record::Type::DATA);
+  publishProgress(stats_);
+  return true;
+}
+
 Stats Wifi::getStats() {
   std::lock_guard lock{mutex_};
   return stats_;
 }
 
+nlohmann::json Wifi::checkpointToJson() {
+  std::lock_guard lock{mutex_};
+  nlohmann::json checkpoint;
+  checkpoint["processed"] = stats_.processed;
+  checkpoint["bad"] = stats_.bad;
+  checkpoint["nomap"] = stats_.nomap;
+  checkpoint["out_of_order"] = stats_.outOfOrder;
+  checkpoint["total_per_freq"] = stats_.totalPerFreq;
+  checkpoint["ssids"] = ssid_;
+  checkpoint["bssids"] = bssid_;
+  checkpoint["prev_timestamp_us"] = prevTimestampUs_;
+  return checkpoint;
+}
+
+void Wifi::restoreFromJson(const nlohmann::json& checkpoint) {
+  std::lock_guard lock{mutex_};
+  stats_.processed = checkpoint.at("processed").get<uint64_t>();
+  stats_.bad = checkpoint.at("bad").get<uint64_t>();
+  stats_.nomap = checkpoint.at("nomap").get<uint64_t>();
+  stats_.outOfOrder = checkpoint.at("out_of_order").get<uint64_t>();
+  stats_.totalPerFreq = checkpoint.at("total_per_freq").get<std::map<float, uint64_t>>();
+  ssid_ = checkpoint.at("ssids").get<std::set<std::string>>();
+  bssid_ = checkpoint.at("bssids").get<std::set<std::string>>();
+  stats_.ssid = ssid_.size();
+  stats_.bssid = bssid_.size();
+  prevTimestampUs_ = checkpoint.at("prev_timestamp_us").get<uint64_t>();
+  publishProgress(stats_);
+}
+
 void Wifi::logStats() {
   std::lock_guard lock{mutex_};
   std::stringstream freqStr;
@@ -109,7 +147,6 @@ inline bool hasSuffix(const std::string& str, const std::string& suffix) {
 } // namespace
 
 void Wifi::processData(const data_provider::WifiBeaconData& data) {
-  std::lock_guard lock{mutex_};
   std::string ssidLower = data.ssid;
   std::transform(ssidLower.begin(), ssidLower.end(), ssidLower.begin(), [](unsigned char c) {
     return std::tolower(c);
@@ -143,6 +180,7 @@ void Wifi::processData(const data_provider::WifiBeaconData& data) {
   }
   prevTimestampUs_ = currTimestampUs;
   stats_.processed++;
+  publishProgress(stats_);
 }
 
 } // namespace projectaria::tools::vrs_check
@@ -34,9 +34,12 @@ class Wifi : public Stream {
  public:
   explicit Wifi(vrs::StreamId streamId);
   bool setup(vrs::RecordFileReader& reader) override; // Setup the Wi-Fi player
+  bool refresh(vrs::RecordFileReader& reader) override;
   Stats getStats() override;
   void logStats() override;
   bool getResult() override; // Pass or fail for this stream
+  nlohmann::json checkpointToJson() override;
+  void restoreFromJson(const nlohmann::json& checkpoint) override;
   uint32_t getPeriodUs() override {
     return static_cast<uint32_t>(-1); // No concept of a period for Wifi stream
   }
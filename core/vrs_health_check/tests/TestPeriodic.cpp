@@ -242,4 +242,49 @@ TEST(TestVrsHealthCheckPeriodic, NonMonotonic) {
   EXPECT_FALSE(mockPeriodic.getResult());
 }
 
+TEST(TestVrsHealthCheckPeriodic, CheckpointResume) {
+  /*
+  Test the case when an incremental check is interrupted half way through
+  and resumed from a checkpoint. The resumed stream should end up with the
+  same stats as a stream that processed all the samples in one go.
+  */
+  const size_t droppedSampleIdx = numSamples / 4;
+  const size_t checkpointSampleIdx = numSamples / 2;
+  const vrs::StreamId streamId(vrs::RecordableTypeId::UnitTestRecordableClass, 0);
+
+  MockPeriodic referencePeriodic(streamId, minScore, defaultPeriodUs, numSamples);
+  referencePeriodic.setup(recordFileReader);
+  MockPeriodic interruptedPeriodic(streamId, minScore, defaultPeriodUs, numSamples);
+  interruptedPeriodic.setup(recordFileReader);
+
+  for (size_t sampleIdx = 0; sampleIdx < numSamples; sampleIdx++) {
+    if (sampleIdx == droppedSampleIdx) {
+      continue;
+    }
+    const uint64_t currentTimeStampUs = sampleIdx * defaultPeriodUs;
+    referencePeriodic.processData(currentTimeStampUs);
+    if (sampleIdx < checkpointSampleIdx) {
+      interruptedPeriodic.processData(currentTimeStampUs);
+    }
+  }
+  // Round trip through text, like a checkpoint file would
+  const nlohmann::json checkpoint =
+      nlohmann::json::parse(interruptedPeriodic.checkpointToJson().dump());
+
+  // The rolling score only accounts for the samples processed so far
+  EXPECT_NEAR(
+      interruptedPeriodic.getRollingScore(), 100.0 * (1.0 - 1.0 / checkpointSampleIdx), 1e-3);
+
+  MockPeriodic resumedPeriodic(streamId, minScore, defaultPeriodUs, numSamples);
+  resumedPeriodic.setup(recordFileReader);
+  resumedPeriodic.restoreFromJson(checkpoint);
+  for (size_t sampleIdx = checkpointSampleIdx; sampleIdx < numSamples; sampleIdx++) {
+    resumedPeriodic.processData(sampleIdx * defaultPeriodUs);
+  }
+
+  EXPECT_EQ(resumedPeriodic.statsToJson(), referencePeriodic.statsToJson());
+  EXPECT_EQ(resumedPeriodic.getScore(), referencePeriodic.getScore());
+  EXPECT_EQ(resumedPeriodic.getRollingScore(), referencePeriodic.getRollingScore());
+}
+
 } // namespace projectaria::tools::vrs_check
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VrsHealthCheck.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#define STRING(x) #x
+#define XSTRING(x) std::string(STRING(x))
+
+namespace fs = std::filesystem;
+
+namespace projectaria::tools::vrs_check {
+
+namespace {
+
+const std::string kTestFolder = XSTRING(TEST_FOLDER);
+const std::string kRecording = kTestFolder + "aria_unit_test_timecode_sequence_calib.vrs";
+const std::string kOtherRecording =
+    kTestFolder + "aria_everyday_activities_test_data/recording.vrs";
+
+struct CheckOutput {
+  nlohmann::json stats;
+  bool result = false;
+  bool usedResultCache = false;
+};
+
+Settings makeSettings(const std::string& resultCachePath) {
+  Settings settings;
+  settings.isInteractive = false;
+  settings.resultCachePath = resultCachePath;
+  settings.cameraCheckSettings = {
+      {vrs::RecordableTypeId::SlamCameraData, CameraCheckSetting{"slam"}},
+      {vrs::RecordableTypeId::EyeCameraRecordableClass, CameraCheckSetting{"eyetracking"}},
+      {vrs::RecordableTypeId::RgbCameraRecordableClass, CameraCheckSetting{"rgb"}},
+  };
+  return settings;
+}
+
+CheckOutput runCheck(const Settings& settings, const std::string& path) {
+  VrsHealthCheck healthCheck(settings);
+  EXPECT_TRUE(healthCheck.setup(path));
+  EXPECT_TRUE(healthCheck.run());
+  CheckOutput output;
+  output.stats = healthCheck.statsToJson();
+  output.result = healthCheck.getResult();
+  output.usedResultCache = healthCheck.usedResultCache();
+  return output;
+}
+
+// Copy the recording to a scratch directory, so the tests can replace it and own the cache file
+class ResultCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+    testDir_ = fs::temp_directory_path() / (std::string("vrs_health_check_") + testInfo->name());
+    fs::remove_all(testDir_);
+    fs::create_directories(testDir_);
+    recordingPath_ = (testDir_ / "recording.vrs").string();
+    cachePath_ = (testDir_ / "recording.health_cache.json").string();
+    fs::copy_file(kRecording, recordingPath_);
+  }
+
+  void TearDown() override {
+    fs::remove_all(testDir_);
+  }
+
+  fs::path testDir_;
+  std::string recordingPath_;
+  std::string cachePath_;
+};
+
+} // namespace
+
+TEST_F(ResultCacheTest, SecondRunReusesCache) {
+  const CheckOutput uncached = runCheck(makeSettings(""), recordingPath_);
+  EXPECT_FALSE(uncached.usedResultCache);
+  EXPECT_FALSE(fs::exists(cachePath_));
+
+  const CheckOutput first = runCheck(makeSettings(cachePath_), recordingPath_);
+  EXPECT_FALSE(first.usedResultCache);
+  ASSERT_TRUE(fs::exists(cachePath_));
+  EXPECT_EQ(first.stats, uncached.stats);
+
+  const CheckOutput second = runCheck(makeSettings(cachePath_), recordingPath_);
+  EXPECT_TRUE(second.usedResultCache);
+  EXPECT_EQ(second.stats, first.stats);
+  EXPECT_EQ(second.result, first.result);
+}
+
+TEST_F(ResultCacheTest, RestoredMisalignmentIsNotCountedTwice) {
+  const CheckOutput first = runCheck(makeSettings(cachePath_), recordingPath_);
+  // Restore the same cache twice, the misalignment counters must stay those of a single read
+  for (int run = 0; run < 2; ++run) {
+    const CheckOutput cached = runCheck(makeSettings(cachePath_), recordingPath_);
+    ASSERT_TRUE(cached.usedResultCache);
+    bool hasMisalignmentStats = false;
+    for (const auto& item : first.stats.items()) {
+      const nlohmann::json& expected = item.value();
+      if (!expected.contains("num_frames_checked")) {
+        continue;
+      }
+      hasMisalignmentStats = true;
+      const nlohmann::json& actual = cached.stats.at(item.key());
+      EXPECT_EQ(actual.at("num_frames_checked"), expected.at("num_frames_checked")) << item.key();
+      EXPECT_EQ(actual.at("num_frames_misaligned"), expected.at("num_frames_misaligned"))
+          << item.key();
+    }
+    EXPECT_TRUE(hasMisalignmentStats);
+  }
+}
+
+TEST_F(ResultCacheTest, ScoreThresholdChangeReusesCache) {
+  const CheckOutput first = runCheck(makeSettings(cachePath_), recordingPath_);
+
+  // No stream can reach a score above 100, so the stricter thresholds must fail the check
+  Settings strictSettings = makeSettings(cachePath_);
+  strictSettings.minImuScore = 101.0;
+  strictSettings.minCameraScore = 101.0;
+  const CheckOutput strict = runCheck(strictSettings, recordingPath_);
+  EXPECT_TRUE(strict.usedResultCache);
+  EXPECT_FALSE(strict.result);
+
+  // The rescored results are those of a full read with the same thresholds
+  strictSettings.resultCachePath = "";
+  const CheckOutput strictUncached = runCheck(strictSettings, recordingPath_);
+  EXPECT_FALSE(strictUncached.usedResultCache);
+  EXPECT_EQ(strict.stats, strictUncached.stats);
+  EXPECT_EQ(strict.result, strictUncached.result);
+  EXPECT_EQ(strict.stats, first.stats);
+}
+
+TEST_F(ResultCacheTest, CounterSettingChangeMissesCache) {
+  runCheck(makeSettings(cachePath_), recordingPath_);
+
+  Settings settings = makeSettings(cachePath_);
+  settings.physicalAccelThreshold /= 2;
+  const CheckOutput changed = runCheck(settings, recordingPath_);
+  EXPECT_FALSE(changed.usedResultCache);
+
+  settings.resultCachePath = "";
+  EXPECT_EQ(changed.stats, runCheck(settings, recordingPath_).stats);
+
+  // The cache now holds the counters of the new settings
+  settings.resultCachePath = cachePath_;
+  EXPECT_TRUE(runCheck(settings, recordingPath_).usedResultCache);
+}
+
+TEST_F(ResultCacheTest, FileChangeMissesCache) {
+  runCheck(makeSettings(cachePath_), recordingPath_);
+
+  // Same file name, different content
+  fs::copy_file(kOtherRecording, recordingPath_, fs::copy_options::overwrite_existing);
+  const CheckOutput changed = runCheck(makeSettings(cachePath_), recordingPath_);
+  EXPECT_FALSE(changed.usedResultCache);
+  EXPECT_EQ(changed.stats, runCheck(makeSettings(""), recordingPath_).stats);
+}
+
+TEST_F(ResultCacheTest, MalformedCacheMissesCache) {
+  const CheckOutput first = runCheck(makeSettings(cachePath_), recordingPath_);
+  nlohmann::json cache;
+  {
+    std::ifstream cacheFile(cachePath_);
+    cache = nlohmann::json::parse(cacheFile);
+  }
+
+  // A current key with a missing or mistyped state is an invalid cache, not an error
+  for (const auto& state : {nlohmann::json(), nlohmann::json(42)}) {
+    if (state.is_null()) {
+      cache.erase("state");
+    } else {
+      cache["state"] = state;
+    }
+    std::ofstream(cachePath_) << cache.dump();
+    const CheckOutput malformed = runCheck(makeSettings(cachePath_), recordingPath_);
+    EXPECT_FALSE(malformed.usedResultCache);
+    EXPECT_EQ(malformed.stats, first.stats);
+  }
+}
+
+} // namespace projectaria::tools::vrs_check
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SensorMisalignmentStats.h"
+
+#include <gtest/gtest.h>
+
+namespace projectaria::tools::vrs_check {
+
+namespace {
+
+const std::vector<std::string> kSensors = {
+    "Camera Data (SLAM) #1",
+    "Camera Data (SLAM) #2",
+    "RGB Camera Class #1"};
+
+const int64_t kPeriodUs = 100000;
+
+std::map<std::string, std::unique_ptr<SensorHealthStats>> makeSensorHealthStatsMap() {
+  std::map<std::string, std::unique_ptr<SensorHealthStats>> sensorHealthStatsMap;
+  for (const auto& sensor : kSensors) {
+    sensorHealthStatsMap.emplace(sensor, std::make_unique<SensorHealthStats>(sensor, kPeriodUs));
+  }
+  return sensorHealthStatsMap;
+}
+
+} // namespace
+
+TEST(TestVrsHealthCheckSensorMisalignmentStats, MisalignedFrames) {
+  /*
+  Every 10th frame of the RGB camera is 1ms late, all other frames are
+  within the tolerance.
+  */
+  const int64_t numFrames = 1000;
+  SensorMisalignmentStats stats(makeSensorHealthStatsMap());
+  for (int64_t frameIdx = 0; frameIdx < numFrames; frameIdx++) {
+    const int64_t frameTimestampUs = frameIdx * kPeriodUs;
+    stats.checkMisalignment(kSensors[0], frameTimestampUs);
+    stats.checkMisalignment(kSensors[1], frameTimestampUs + 50);
+    stats.checkMisalignment(kSensors[2], frameTimestampUs + (frameIdx % 10 == 0 ? 1000 : 100));
+  }
+  stats.computeScores();
+
+  const auto& statisticsMap = stats.misalignmentStatisticsMap();
+  const auto& slamSlam = statisticsMap.at(kSensors[0]).at(kSensors[1]);
+  EXPECT_EQ(slamSlam.total, numFrames);
+  EXPECT_EQ(slamSlam.misaligned, 0);
+  EXPECT_EQ(slamSlam.max_misalignment_us, 50);
+  EXPECT_EQ(slamSlam.score, 100.0);
+
+  const auto& slamRgb = statisticsMap.at(kSensors[0]).at(kSensors[2]);
+  EXPECT_EQ(slamRgb.total, numFrames);
+  EXPECT_EQ(slamRgb.misaligned, numFrames / 10);
+  EXPECT_EQ(slamRgb.max_misalignment_us, 1000);
+}
+
+TEST(TestVrsHealthCheckSensorMisalignmentStats, IncrementalMerge) {
+  /*
+  Merging the samples in several passes, with a checkpoint round trip in
+  between, should give the same statistics as merging them all at the end.
+  */
+  const size_t numFrames = 5000;
+  SensorMisalignmentStats referenceStats(makeSensorHealthStatsMap());
+  SensorMisalignmentStats incrementalStats(makeSensorHealthStatsMap());
+  for (size_t frameIdx = 0; frameIdx < numFrames; frameIdx++) {
+    const int64_t frameTimestampUs = frameIdx * kPeriodUs;
+    for (size_t sensorIdx = 0; sensorIdx < kSensors.size(); sensorIdx++) {
+      // Drop some frames and make some of them misaligned
+      if ((frameIdx + sensorIdx) % 37 == 0) {
+        continue;
+      }
+      const int64_t jitterUs = ((frameIdx * 7 + sensorIdx * 13) % 11 == 0) ? 700 : 30 * sensorIdx;
+      referenceStats.checkMisalignment(kSensors[sensorIdx], frameTimestampUs + jitterUs);
+      incrementalStats.checkMisalignment(kSensors[sensorIdx], frameTimestampUs + jitterUs);
+    }
+    if (frameIdx % 500 == 499) {
+      incrementalStats.mergeSamples(frameTimestampUs - 2 * kPeriodUs);
+      SensorMisalignmentStats restoredStats(makeSensorHealthStatsMap());
+      restoredStats.restoreFromJson(
+          nlohmann::json::parse(incrementalStats.checkpointToJson().dump()));
+      incrementalStats.restoreFromJson(restoredStats.checkpointToJson());
+    }
+  }
+  referenceStats.computeScores();
+  incrementalStats.computeScores();
+
+  for (const auto& [sensor1, misalignedTos] : referenceStats.misalignmentStatisticsMap()) {
+    for (const auto& [sensor2, expected] : misalignedTos) {
+      const auto& actual = incrementalStats.misalignmentStatisticsMap().at(sensor1).at(sensor2);
+      EXPECT_EQ(actual.total, expected.total);
+      EXPECT_EQ(actual.misaligned, expected.misaligned);
+      EXPECT_EQ(actual.max_misalignment_us, expected.max_misalignment_us);
+      EXPECT_EQ(actual.score, expected.score);
+    }
+  }
+}
+
+TEST(TestVrsHealthCheckSensorMisalignmentStats, ComputeScoresTwice) {
+  /*
+  Computing the scores again, as done after restoring a result cache, must
+  not count the samples that were already accounted for.
+  */
+  const int64_t numFrames = 100;
+  SensorMisalignmentStats stats(makeSensorHealthStatsMap());
+  for (int64_t frameIdx = 0; frameIdx < numFrames; frameIdx++) {
+    const int64_t frameTimestampUs = frameIdx * kPeriodUs;
+    stats.checkMisalignment(kSensors[0], frameTimestampUs);
+    stats.checkMisalignment(kSensors[1], frameTimestampUs + (frameIdx % 4 == 0 ? 1000 : 50));
+    stats.checkMisalignment(kSensors[2], frameTimestampUs + 100);
+  }
+  stats.computeScores();
+  const auto expectedMap = stats.misalignmentStatisticsMap();
+
+  SensorMisalignmentStats restoredStats(makeSensorHealthStatsMap());
+  restoredStats.restoreFromJson(nlohmann::json::parse(stats.checkpointToJson().dump()));
+  for (auto* computedStats : {&stats, &restoredStats}) {
+    computedStats->computeScores();
+    for (const auto& [sensor1, misalignedTos] : expectedMap) {
+      for (const auto& [sensor2, expected] : misalignedTos) {
+        const auto& actual = computedStats->misalignmentStatisticsMap().at(sensor1).at(sensor2);
+        EXPECT_EQ(actual.total, numFrames);
+        EXPECT_EQ(actual.total, expected.total);
+        EXPECT_EQ(actual.misaligned, expected.misaligned);
+        EXPECT_EQ(actual.score, expected.score);
+      }
+    }
+  }
+}
+
+} // namespace projectaria::tools::vrs_check
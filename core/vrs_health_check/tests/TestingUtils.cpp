@@ -45,6 +45,10 @@ bool MockPeriodic::setup(vrs::RecordFileReader& /*reader*/) {
   return true;
 }
 
+bool MockPeriodic::refresh(vrs::RecordFileReader& /*reader*/) {
+  return true;
+}
+
 void MockPeriodic::processData(uint64_t captureTimestampUs) {
   processTimestamp(captureTimestampUs);
 }
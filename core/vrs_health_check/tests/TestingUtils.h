@@ -26,6 +26,7 @@ class MockPeriodic : public Periodic {
  public:
   MockPeriodic(vrs::StreamId streamId, float minScore, uint32_t defaultPeriodUs, size_t numSamples);
   bool setup(vrs::RecordFileReader& reader) override; // Setup the camera player
+  bool refresh(vrs::RecordFileReader& reader) override;
   void processData(uint64_t captureTimestampUs);
 
  protected:
@@ -26,6 +26,7 @@ from . import (  # noqa
     sensor_data,
     sophus,
     stream_id,
+    trace,
     vrs,
     vrs_health_check,
 )
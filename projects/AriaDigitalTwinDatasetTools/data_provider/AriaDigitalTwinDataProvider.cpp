@@ -21,7 +21,9 @@
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iterator>
+#include <numeric>
 #include <stdexcept>
 #include <valarray>
 
@@ -29,6 +31,7 @@
 #include <rapidjson/document.h>
 #include <rapidjson/rapidjson.h>
 
+#include <dispenso/parallel_for.h>
 #include <sophus/interpolate.hpp>
 
 #define DEFAULT_LOG_CHANNEL "AriaDigitalTwinDataProvider"
@@ -190,36 +193,136 @@ CanonicalPose getCanonicalPoseFromInstancesJsonObject(
 
 } // namespace
 
-AriaDigitalTwinDataProvider::AriaDigitalTwinDataProvider(const AriaDigitalTwinDataPaths& dataPaths)
+AriaDigitalTwinDataProvider::AriaDigitalTwinDataProvider(
+    const AriaDigitalTwinDataPaths& dataPaths,
+    AdtDataLoadMode loadMode)
     : dataPaths_(dataPaths) {
-  // Load raw VRS data
-  if (!dataPaths_.ariaVrsFilePath.empty()) {
-    dataProvider_ = createVrsDataProvider(dataPaths_.ariaVrsFilePath);
-    if (!dataProvider_->supportsTimeDomain(
-            vrs::StreamId::fromNumericName("1201-1") /*left_slam*/, TimeDomain::DeviceTime)) {
-      XR_LOGW("At least left slam camera should contain device (capture) time domain");
-      throw std::runtime_error{
-          "At least left slam camera should contain device (capture) time domain"};
+  // The dataset version is always validated upfront so that incompatible data fails fast
+  ensureLoaded(LoadStep::DatasetVersion);
+
+  switch (loadMode) {
+    case AdtDataLoadMode::Sequential:
+      loadAllSequential();
+      break;
+    case AdtDataLoadMode::Parallel:
+      loadAllParallel();
+      break;
+    case AdtDataLoadMode::Lazy:
+      break;
+  }
+}
+
+std::vector<AriaDigitalTwinDataProvider::LoadStep>
+AriaDigitalTwinDataProvider::getLoadStepDependencies(LoadStep step) {
+  switch (step) {
+    case LoadStep::Object3dBoundingBoxes:
+      return {LoadStep::ObjectAabbs};
+    default:
+      return {};
+  }
+}
+
+void AriaDigitalTwinDataProvider::ensureLoaded(LoadStep step) const {
+  std::call_once(
+      loadStepFlags_.at(static_cast<size_t>(step)), [this, step]() { runLoadStep(step); });
+}
+
+void AriaDigitalTwinDataProvider::runLoadStep(LoadStep step) const {
+  for (const auto& dependency : getLoadStepDependencies(step)) {
+    ensureLoaded(dependency);
+  }
+
+  switch (step) {
+    case LoadStep::AriaVrs:
+      loadAriaVrs();
+      break;
+    case LoadStep::DatasetVersion:
+      loadDatasetVersion();
+      validateDatasetVersion();
+      break;
+    case LoadStep::InstancesInfo:
+      // skeleton info amends the instances info with device associations
+      loadInstancesInfo();
+      loadSkeletonInfo();
+      break;
+    case LoadStep::ObjectAabbs:
+      loadObjectAABBbboxes();
+      break;
+    case LoadStep::Aria3dPoses:
+      loadAria3dPoses();
+      break;
+    case LoadStep::Object3dBoundingBoxes:
+      loadObject3dBoundingBoxes();
+      break;
+    case LoadStep::Instance2dBoundingBoxes:
+      loadInstance2dBoundingBoxes();
+      break;
+    case LoadStep::Segmentations:
+      loadSegmentations();
+      break;
+    case LoadStep::DepthImages:
+      loadDepthImages();
+      break;
+    case LoadStep::SyntheticVrs:
+      loadSyntheticVrs();
+      break;
+    case LoadStep::Skeletons:
+      loadSkeletons();
+      break;
+    case LoadStep::EyeGaze:
+      loadEyeGaze();
+      break;
+    case LoadStep::Mps:
+      loadMps();
+      break;
+    case LoadStep::Count:
+      throw std::runtime_error{"invalid load step"};
+  }
+}
+
+void AriaDigitalTwinDataProvider::loadAllSequential() const {
+  for (size_t i = 0; i < static_cast<size_t>(LoadStep::Count); ++i) {
+    ensureLoaded(static_cast<LoadStep>(i));
+  }
+}
+
+void AriaDigitalTwinDataProvider::loadAllParallel() const {
+  // Every step is scheduled at once, steps with dependencies block in `ensureLoaded` until their
+  // dependencies are done.
+  std::vector<std::future<void>> loadFutures;
+  for (size_t i = 0; i < static_cast<size_t>(LoadStep::Count); ++i) {
+    loadFutures.emplace_back(std::async(
+        std::launch::async, [this, i]() { ensureLoaded(static_cast<LoadStep>(i)); }));
+  }
+
+  // wait for all steps before reporting the first failure, so no step outlives the provider
+  std::exception_ptr firstError;
+  for (auto& loadFuture : loadFutures) {
+    try {
+      loadFuture.get();
+    } catch (...) {
+      if (!firstError) {
+        firstError = std::current_exception();
+      }
     }
-  } else {
-    XR_LOGI("skip loading VRS data because the data path is empty");
   }
+  if (firstError) {
+    std::rethrow_exception(firstError);
+  }
+}
 
-  // Load GT data
-  loadDatasetVersion();
-  validateDatasetVersion();
-  loadInstancesInfo();
-  loadObjectAABBbboxes();
-  loadAria3dPoses();
-  loadObject3dBoundingBoxes();
-  loadInstance2dBoundingBoxes();
-  loadSegmentations();
-  loadDepthImages();
-  loadSyntheticVrs();
-  loadSkeletonInfo();
-  loadSkeletons();
-  loadEyeGaze();
-  loadMps();
+void AriaDigitalTwinDataProvider::loadAriaVrs() const {
+  if (dataPaths_.ariaVrsFilePath.empty()) {
+    XR_LOGI("skip loading VRS data because the data path is empty");
+    return;
+  }
+  dataProvider_ = createVrsDataProvider(dataPaths_.ariaVrsFilePath);
+  if (!dataProvider_->supportsTimeDomain(
+          vrs::StreamId::fromNumericName("1201-1") /*left_slam*/, TimeDomain::DeviceTime)) {
+    XR_LOGW("At least left slam camera should contain device (capture) time domain");
+    throw std::runtime_error{
+        "At least left slam camera should contain device (capture) time domain"};
+  }
 }
 
 std::set<vrs::StreamId> AriaDigitalTwinDataProvider::getAriaAllStreams() const {
@@ -296,7 +399,7 @@ std::optional<CameraCalibration> AriaDigitalTwinDataProvider::getAriaCameraCalib
     XR_LOGE("StreamId not found in data: {}, returning empty result", streamId.getNumericName());
     return {};
   }
-  return dataProvider_->getDeviceCalibration()->getCameraCalib(maybeLabel.value());
+  return dataProvider_->getDeviceCalibrationRef()->getCameraCalib(maybeLabel.value());
 }
 
 Sophus::SE3d AriaDigitalTwinDataProvider::getAria_T_Device_Camera(
@@ -312,7 +415,7 @@ Sophus::SE3d AriaDigitalTwinDataProvider::getAria_T_Device_Camera(
   }
 
   const auto maybeT_Device_Camera =
-      dataProvider_->getDeviceCalibration()->getT_Device_Sensor(maybeLabel.value());
+      dataProvider_->getDeviceCalibrationRef()->getT_Device_Sensor(maybeLabel.value());
   if (!maybeT_Device_Camera) {
     XR_LOGE("could not get T_Device_Camera for stream {}", streamId.getNumericName());
     throw std::runtime_error{"invalid stream ID"};
@@ -375,6 +478,7 @@ BoundingBox2dDataWithDt AriaDigitalTwinDataProvider::getObject2dBoundingBoxesByT
     int64_t deviceTimeStampNs,
     const vrs::StreamId& streamId,
     const TimeQueryOptions& timeQueryOptions) const {
+  ensureLoaded(LoadStep::Instance2dBoundingBoxes);
   if (instance2dBoundingBoxes_.find(streamId) == instance2dBoundingBoxes_.end()) {
     XR_LOGW("Camera {} has no object 2d box data \n", streamId.getNumericName());
     return BoundingBox2dDataWithDt();
@@ -412,6 +516,7 @@ BoundingBox2dDataWithDt AriaDigitalTwinDataProvider::getSkeleton2dBoundingBoxesB
     int64_t deviceTimeStampNs,
     const vrs::StreamId& streamId,
     const TimeQueryOptions& timeQueryOptions) const {
+  ensureLoaded(LoadStep::Instance2dBoundingBoxes);
   if (instance2dBoundingBoxes_.find(streamId) == instance2dBoundingBoxes_.end()) {
     XR_LOGW("Camera {} has no skeleton 2d box data \n", streamId.getNumericName());
     return BoundingBox2dDataWithDt();
@@ -447,7 +552,7 @@ BoundingBox2dDataWithDt AriaDigitalTwinDataProvider::getSkeleton2dBoundingBoxesB
 EyeGazeWithDt AriaDigitalTwinDataProvider::getEyeGazeByTimestampNs(
     int64_t deviceTimeStampNs,
     const TimeQueryOptions& timeQueryOptions) const {
-  if (eyeGazes_.empty()) {
+  if (!hasEyeGaze()) {
     XR_LOGW("No eye gaze data\n");
     return EyeGazeWithDt();
   }
@@ -553,7 +658,7 @@ SyntheticDataWithDt AriaDigitalTwinDataProvider::getSyntheticImageByTimestampNs(
   return SyntheticDataWithDt(syntheticData, gtTNs - deviceTimeStampNs);
 }
 
-void AriaDigitalTwinDataProvider::loadInstancesInfo() {
+void AriaDigitalTwinDataProvider::loadInstancesInfo() const {
   XR_LOGI("loading instance info from json file {}", dataPaths_.instancesFilePath);
   fs::path fileInstances(dataPaths_.instancesFilePath);
   if (fileInstances.empty()) {
@@ -662,7 +767,7 @@ void AriaDigitalTwinDataProvider::loadInstancesInfo() {
   fileStream.close();
 }
 
-void AriaDigitalTwinDataProvider::loadObjectAABBbboxes() {
+void AriaDigitalTwinDataProvider::loadObjectAABBbboxes() const {
   fs::path file3dBox(dataPaths_.objectBoundingBox3dFilePath);
   if (file3dBox.empty()) {
     XR_LOGI("skip loading file3dBox because the data path is empty");
@@ -695,17 +800,13 @@ void AriaDigitalTwinDataProvider::loadObjectAABBbboxes() {
   fileStream.close();
 }
 
-void AriaDigitalTwinDataProvider::loadObject3dBoundingBoxes() {
+void AriaDigitalTwinDataProvider::loadObject3dBoundingBoxes() const {
   fs::path fileObjectTraj = fs::path(dataPaths_.objectTrajectoriesFilePath);
   if (fileObjectTraj.empty()) {
     XR_LOGI("skip loading fileObjectTraj because the data path is empty");
     return;
   }
 
-  if (objectIdToAabb_.empty()) {
-    loadObjectAABBbboxes();
-  }
-
   std::ifstream fileStream = openFile(fileObjectTraj);
   std::string line;
   std::vector<std::string> tokens;
@@ -763,9 +864,31 @@ void AriaDigitalTwinDataProvider::loadObject3dBoundingBoxes() {
     }
   }
   fileStream.close();
+
+  // Build per-object tracks, iterating the series in time order keeps each track sorted
+  for (const auto& [deviceTimeStampNs, objectBoxes] : dynamicObject3dBoundingBoxSeries_) {
+    for (const auto& [objId, box] : objectBoxes) {
+      Object3dTrack& track = dynamicObject3dTracks_[objId];
+      track.timestampsNs.push_back(deviceTimeStampNs);
+      track.q_Scene_Object.push_back(box.T_Scene_Object.unit_quaternion());
+      track.t_Scene_Object.push_back(box.T_Scene_Object.translation());
+      track.aabb = box.aabb;
+    }
+  }
+}
+
+const std::unordered_map<InstanceId, Object3dTrack>&
+AriaDigitalTwinDataProvider::getDynamicObject3dTracks() const {
+  ensureLoaded(LoadStep::Object3dBoundingBoxes);
+  return dynamicObject3dTracks_;
 }
 
-void AriaDigitalTwinDataProvider::loadAria3dPoses() {
+const TypeBoundingBox3dMap& AriaDigitalTwinDataProvider::getStaticObject3dBoundingBoxes() const {
+  ensureLoaded(LoadStep::Object3dBoundingBoxes);
+  return staticObject3dBoundingBoxes_;
+}
+
+void AriaDigitalTwinDataProvider::loadAria3dPoses() const {
   if (dataPaths_.ariaTrajectoryFilePath.empty()) {
     XR_LOGI("skip loading fileAriaTraj because the data path is empty");
     return;
@@ -786,7 +909,7 @@ void AriaDigitalTwinDataProvider::loadAria3dPoses() {
   }
 }
 
-void AriaDigitalTwinDataProvider::loadInstance2dBoundingBoxes() {
+void AriaDigitalTwinDataProvider::loadInstance2dBoundingBoxes() const {
   fs::path fileBbox2d(dataPaths_.boundingBoxes2dFilePath);
   if (fileBbox2d.empty()) {
     XR_LOGI("skip loading 2dbboxes because the data path is empty");
@@ -816,7 +939,7 @@ void AriaDigitalTwinDataProvider::loadInstance2dBoundingBoxes() {
   fileStream.close();
 }
 
-void AriaDigitalTwinDataProvider::loadEyeGaze() {
+void AriaDigitalTwinDataProvider::loadEyeGaze() const {
   if (dataPaths_.eyeGazesFilePath.empty()) {
     XR_LOGI("skip loading eyeGazesFilePath because the data path is empty");
     return;
@@ -834,7 +957,7 @@ void AriaDigitalTwinDataProvider::loadEyeGaze() {
   }
 }
 
-void AriaDigitalTwinDataProvider::loadDatasetVersion() {
+void AriaDigitalTwinDataProvider::loadDatasetVersion() const {
   if (dataPaths_.metaDataFilePath.empty()) {
     XR_LOGW(
         "No metadata file provided to data provider, setting the dataset version to {}.",
@@ -935,7 +1058,7 @@ void AriaDigitalTwinDataProvider::validateDatasetVersion() const {
   }
 }
 
-void AriaDigitalTwinDataProvider::loadSegmentations() {
+void AriaDigitalTwinDataProvider::loadSegmentations() const {
   fs::path fileSeg(dataPaths_.segmentationsFilePath);
   if (fileSeg.empty()) {
     XR_LOGI("skip loading fileSegmentation because the data path is empty");
@@ -947,7 +1070,7 @@ void AriaDigitalTwinDataProvider::loadSegmentations() {
   }
 }
 
-void AriaDigitalTwinDataProvider::loadDepthImages() {
+void AriaDigitalTwinDataProvider::loadDepthImages() const {
   fs::path fileDep(dataPaths_.depthImagesFilePath);
   if (fileDep.empty()) {
     XR_LOGI("skip loading fileDepth because the data path is empty");
@@ -959,7 +1082,7 @@ void AriaDigitalTwinDataProvider::loadDepthImages() {
   }
 }
 
-void AriaDigitalTwinDataProvider::loadSyntheticVrs() {
+void AriaDigitalTwinDataProvider::loadSyntheticVrs() const {
   fs::path fileSynthetic(dataPaths_.syntheticVrsFilePath);
   if (fileSynthetic.empty()) {
     XR_LOGI("skip loading fileSynthetic because the data path is empty");
@@ -971,7 +1094,7 @@ void AriaDigitalTwinDataProvider::loadSyntheticVrs() {
   }
 }
 
-void AriaDigitalTwinDataProvider::loadSkeletonInfo() {
+void AriaDigitalTwinDataProvider::loadSkeletonInfo() const {
   if (dataPaths_.skeletonMetaDataFilePath.empty()) {
     XR_LOGI("skip loading skeletonMetaDataFilePath because the data path is empty");
     return;
@@ -1052,7 +1175,7 @@ void AriaDigitalTwinDataProvider::loadSkeletonInfo() {
   }
 }
 
-void AriaDigitalTwinDataProvider::loadSkeletons() {
+void AriaDigitalTwinDataProvider::loadSkeletons() const {
   if (dataPaths_.skeletonsFilePaths.empty()) {
     XR_LOGI("skip loading skeletonsFilePaths because the data path is empty");
     return;
@@ -1066,6 +1189,7 @@ SkeletonFrameWithDt AriaDigitalTwinDataProvider::getSkeletonByTimestampNs(
     int64_t deviceTimeStampNs,
     InstanceId instanceId,
     const TimeQueryOptions& timeQueryOptions) const {
+  ensureLoaded(LoadStep::Skeletons);
   auto iter = skeletons_.find(instanceId);
   if (iter == skeletons_.end()) {
     XR_LOGW("no skeleton with instance id: {}", instanceId);
@@ -1075,6 +1199,7 @@ SkeletonFrameWithDt AriaDigitalTwinDataProvider::getSkeletonByTimestampNs(
 }
 
 std::vector<InstanceId> AriaDigitalTwinDataProvider::getInstanceIds() const {
+  ensureLoaded(LoadStep::InstancesInfo);
   std::vector<InstanceId> instanceIds;
   for (const auto& [instanceId, _] : instancesInfo_) {
     instanceIds.push_back(instanceId);
@@ -1083,10 +1208,12 @@ std::vector<InstanceId> AriaDigitalTwinDataProvider::getInstanceIds() const {
 }
 
 bool AriaDigitalTwinDataProvider::hasInstanceId(InstanceId instanceId) const {
+  ensureLoaded(LoadStep::InstancesInfo);
   return instancesInfo_.find(instanceId) != instancesInfo_.end();
 }
 
 const InstanceInfo& AriaDigitalTwinDataProvider::getInstanceInfoById(InstanceId instanceId) const {
+  ensureLoaded(LoadStep::InstancesInfo);
   if (instancesInfo_.find(instanceId) == instancesInfo_.end()) {
     throw std::runtime_error(fmt::format("No such instance loaded {}", instanceId));
   }
@@ -1094,6 +1221,7 @@ const InstanceInfo& AriaDigitalTwinDataProvider::getInstanceInfoById(InstanceId
 }
 
 std::vector<InstanceId> AriaDigitalTwinDataProvider::getObjectIds() const {
+  ensureLoaded(LoadStep::InstancesInfo);
   std::vector<InstanceId> objectIds;
   for (const auto& [id, info] : instancesInfo_) {
     if (info.instanceType == InstanceType::Object) {
@@ -1104,6 +1232,7 @@ std::vector<InstanceId> AriaDigitalTwinDataProvider::getObjectIds() const {
 }
 
 std::vector<InstanceId> AriaDigitalTwinDataProvider::getSkeletonIds() const {
+  ensureLoaded(LoadStep::InstancesInfo);
   std::vector<InstanceId> skeletonIds;
   for (const auto& [id, info] : instancesInfo_) {
     if (info.instanceType == InstanceType::Human) {
@@ -1115,13 +1244,14 @@ std::vector<InstanceId> AriaDigitalTwinDataProvider::getSkeletonIds() const {
 
 const AriaDigitalTwinSkeletonProvider& AriaDigitalTwinDataProvider::getSkeletonProvider(
     InstanceId instanceId) const {
+  ensureLoaded(LoadStep::Skeletons);
   if (skeletons_.find(instanceId) == skeletons_.end()) {
     throw std::runtime_error(fmt::format("No skeleton with instance id {}", instanceId));
   }
   return skeletons_.at(instanceId);
 }
 
-void AriaDigitalTwinDataProvider::loadMps() {
+void AriaDigitalTwinDataProvider::loadMps() const {
   mps_ = std::make_shared<projectaria::tools::mps::MpsDataProvider>(dataPaths_.mps);
 }
 
@@ -1218,4 +1348,115 @@ BoundingBox3dDataWithDt getInterpolatedObject3dBoundingBoxesAtTimestampNs(
   return BoundingBox3dDataWithDt(object3dBoundingBoxMap, 0);
 }
 
+BoundingBox3dBatch getInterpolatedObject3dBoundingBoxesAtTimestampsNs(
+    const AriaDigitalTwinDataProvider& provider,
+    const std::vector<int64_t>& deviceTimeStampsNs,
+    bool approximate) {
+  BoundingBox3dBatch batch;
+  if (!provider.hasObject3dBoundingboxes()) {
+    XR_LOGW("Object 3D poses is empty, query will return empty result\n");
+    return batch;
+  }
+
+  const auto& dynamicTracks = provider.getDynamicObject3dTracks();
+  const auto& staticBoxes = provider.getStaticObject3dBoundingBoxes();
+
+  std::vector<InstanceId> dynamicIds;
+  dynamicIds.reserve(dynamicTracks.size());
+  for (const auto& [objId, _] : dynamicTracks) {
+    dynamicIds.push_back(objId);
+  }
+  std::sort(dynamicIds.begin(), dynamicIds.end());
+  std::vector<InstanceId> staticIds;
+  staticIds.reserve(staticBoxes.size());
+  for (const auto& [objId, _] : staticBoxes) {
+    staticIds.push_back(objId);
+  }
+  std::sort(staticIds.begin(), staticIds.end());
+
+  batch.objectIds = dynamicIds;
+  batch.objectIds.insert(batch.objectIds.end(), staticIds.begin(), staticIds.end());
+  batch.timestampsNs = deviceTimeStampsNs;
+
+  const size_t numObjects = batch.objectIds.size();
+  const size_t numTimestamps = deviceTimeStampsNs.size();
+  batch.aabbs.resize(numObjects);
+  batch.T_Scene_Objects.resize(numObjects * numTimestamps);
+  batch.isValid.resize(numObjects * numTimestamps, 0);
+
+  // visit the query timestamps in ascending order so that each track is walked only once
+  std::vector<size_t> sortedQueryIndices(numTimestamps);
+  std::iota(sortedQueryIndices.begin(), sortedQueryIndices.end(), 0);
+  std::sort(
+      sortedQueryIndices.begin(),
+      sortedQueryIndices.end(),
+      [&deviceTimeStampsNs](size_t a, size_t b) {
+        return deviceTimeStampsNs[a] < deviceTimeStampsNs[b];
+      });
+
+  dispenso::parallel_for(0, numObjects, [&](size_t objIndex) {
+    const InstanceId objId = batch.objectIds[objIndex];
+
+    if (objIndex >= dynamicIds.size()) {
+      const BoundingBox3dData& staticBox = staticBoxes.at(objId);
+      batch.aabbs[objIndex] = staticBox.aabb;
+      for (size_t queryIndex = 0; queryIndex < numTimestamps; ++queryIndex) {
+        batch.T_Scene_Objects[queryIndex * numObjects + objIndex] = staticBox.T_Scene_Object;
+        batch.isValid[queryIndex * numObjects + objIndex] = 1;
+      }
+      return;
+    }
+
+    const Object3dTrack& track = dynamicTracks.at(objId);
+    batch.aabbs[objIndex] = track.aabb;
+    const auto& trackTimes = track.timestampsNs;
+
+    // index of the first sample with time >= query time
+    size_t after = 0;
+    for (const size_t queryIndex : sortedQueryIndices) {
+      const int64_t queryTimeNs = deviceTimeStampsNs[queryIndex];
+      while (after < trackTimes.size() && trackTimes[after] < queryTimeNs) {
+        ++after;
+      }
+      if (after == trackTimes.size() || (after == 0 && trackTimes[0] != queryTimeNs)) {
+        // out of the object's trajectory
+        continue;
+      }
+
+      const size_t outIndex = queryIndex * numObjects + objIndex;
+      batch.isValid[outIndex] = 1;
+      if (trackTimes[after] == queryTimeNs) {
+        batch.T_Scene_Objects[outIndex] =
+            Sophus::SE3d(track.q_Scene_Object[after], track.t_Scene_Object[after]);
+        continue;
+      }
+
+      const size_t before = after - 1;
+      const double alpha = static_cast<double>(queryTimeNs - trackTimes[before]) /
+          static_cast<double>(trackTimes[after] - trackTimes[before]);
+      if (approximate) {
+        Eigen::Quaterniond qBefore = track.q_Scene_Object[before];
+        const Eigen::Quaterniond& qAfter = track.q_Scene_Object[after];
+        // take the shortest path
+        if (qBefore.dot(qAfter) < 0.0) {
+          qBefore.coeffs() = -qBefore.coeffs();
+        }
+        Eigen::Quaterniond q;
+        q.coeffs() = (1.0 - alpha) * qBefore.coeffs() + alpha * qAfter.coeffs();
+        q.normalize();
+        batch.T_Scene_Objects[outIndex] = Sophus::SE3d(
+            q,
+            (1.0 - alpha) * track.t_Scene_Object[before] + alpha * track.t_Scene_Object[after]);
+      } else {
+        batch.T_Scene_Objects[outIndex] = Sophus::interpolate(
+            Sophus::SE3d(track.q_Scene_Object[before], track.t_Scene_Object[before]),
+            Sophus::SE3d(track.q_Scene_Object[after], track.t_Scene_Object[after]),
+            alpha);
+      }
+    }
+  });
+
+  return batch;
+}
+
 } // namespace projectaria::dataset::adt
@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <optional>
 
 #include "AriaDigitalTwinDataPathsProvider.h"
@@ -30,6 +32,15 @@
 
 namespace projectaria::dataset::adt {
 
+/**
+ * @brief Strategy used by `AriaDigitalTwinDataProvider` to load the data of a sequence.
+ */
+enum class AdtDataLoadMode {
+  Sequential, // load every modality one after another in the constructor
+  Parallel, // load independent modalities concurrently in the constructor
+  Lazy, // load each modality on first access. Loading is thread-safe.
+};
+
 /**
  * @brief This is the core data loader that should provide all the data access you will need for
  * an ADT sequence. Note that each sequence may contain multiple devices, you should create one
@@ -37,7 +48,15 @@ namespace projectaria::dataset::adt {
  */
 class AriaDigitalTwinDataProvider {
  public:
-  explicit AriaDigitalTwinDataProvider(const AriaDigitalTwinDataPaths& dataPaths);
+  /**
+   * @brief Construct a data provider for one device of an ADT sequence.
+   * @param dataPaths The paths of all data files to load, see `AriaDigitalTwinDataPathsProvider`.
+   * @param loadMode How the data files are loaded. Default to `AdtDataLoadMode::Parallel`. Use
+   * `AdtDataLoadMode::Lazy` to only pay for the modalities that are actually queried.
+   */
+  explicit AriaDigitalTwinDataProvider(
+      const AriaDigitalTwinDataPaths& dataPaths,
+      AdtDataLoadMode loadMode = AdtDataLoadMode::Parallel);
 
   // ---- Query ADT Aria data ----
   /**
@@ -132,6 +151,20 @@ class AriaDigitalTwinDataProvider {
       int64_t deviceTimeStampNs,
       const TimeQueryOptions& timeQueryOptions = TimeQueryOptions::Closest) const;
 
+  /**
+   * @brief Get the trajectories of all dynamic objects, one time-sorted track per object. This is
+   * the preferred representation when querying many timestamps, see
+   * `getInterpolatedObject3dBoundingBoxesAtTimestampsNs`.
+   * @return a map of objectId <-> object trajectory. Static objects are not included.
+   */
+  const std::unordered_map<InstanceId, Object3dTrack>& getDynamicObject3dTracks() const;
+
+  /**
+   * @brief Get the 3D bounding boxes of all static objects.
+   * @return a map of objectId <-> 3d bounding box, valid at any timestamp.
+   */
+  const TypeBoundingBox3dMap& getStaticObject3dBoundingBoxes() const;
+
   /**
    * @brief Query 2D object bounding boxes by timestamp, in the view of a given camera.
    * @param deviceTimeStampNs The query timestamp in `TimeDomain::DeviceTime`.
@@ -226,46 +259,57 @@ class AriaDigitalTwinDataProvider {
 
   // ---- Functions to check availability of ground-truth data ----
   bool hasAriaData() const {
+    ensureLoaded(LoadStep::AriaVrs);
     return dataProvider_ != nullptr;
   }
 
   bool hasAria3dPoses() const {
+    ensureLoaded(LoadStep::Aria3dPoses);
     return !aria3dPoses_.empty();
   }
 
   bool hasObject3dBoundingboxes() const {
+    ensureLoaded(LoadStep::Object3dBoundingBoxes);
     return !dynamicObject3dBoundingBoxSeries_.empty() || !staticObject3dBoundingBoxes_.empty();
   }
 
   bool hasInstance2dBoundingBoxes() const {
+    ensureLoaded(LoadStep::Instance2dBoundingBoxes);
     return !instance2dBoundingBoxes_.empty();
   }
 
   bool hasSegmentationImages() const {
+    ensureLoaded(LoadStep::Segmentations);
     return segmentationProvider_ != nullptr;
   }
 
   bool hasDepthImages() const {
+    ensureLoaded(LoadStep::DepthImages);
     return depthImageProvider_ != nullptr;
   }
 
   bool hasSyntheticImages() const {
+    ensureLoaded(LoadStep::SyntheticVrs);
     return syntheticVrsProvider_ != nullptr;
   }
 
   bool hasEyeGaze() const {
+    ensureLoaded(LoadStep::EyeGaze);
     return !eyeGazes_.empty();
   }
 
   bool hasSkeleton() const {
+    ensureLoaded(LoadStep::Skeletons);
     return !skeletons_.empty();
   }
 
   bool hasInstancesInfo() const {
+    ensureLoaded(LoadStep::InstancesInfo);
     return !instancesInfo_.empty();
   }
 
   bool hasMps() const {
+    ensureLoaded(LoadStep::Mps);
     return mps_ != nullptr;
   }
 
@@ -297,91 +341,133 @@ class AriaDigitalTwinDataProvider {
 
   // ---- Query time range of ground-truth data for a sequence ----
   int64_t getStartTimeNs() const {
-    return aria3dPoses_.empty() ? 0 : aria3dPoses_.begin()->first;
+    return hasAria3dPoses() ? aria3dPoses_.begin()->first : 0;
   }
 
   int64_t getEndTimeNs() const {
-    return aria3dPoses_.empty() ? 0 : aria3dPoses_.rbegin()->first;
+    return hasAria3dPoses() ? aria3dPoses_.rbegin()->first : 0;
   }
 
   // ---- Getter of all stored data provider pointers within ADTDataProvider----
   // Also provide API to the core data provider itself.
   const std::shared_ptr<const tools::data_provider::VrsDataProvider> rawDataProviderPtr() const {
+    ensureLoaded(LoadStep::AriaVrs);
     return dataProvider_;
   }
   const std::shared_ptr<const tools::data_provider::VrsDataProvider> segmentationDataProviderPtr()
       const {
+    ensureLoaded(LoadStep::Segmentations);
     return segmentationProvider_;
   }
   const std::shared_ptr<const tools::data_provider::VrsDataProvider> depthDataProviderPtr() const {
+    ensureLoaded(LoadStep::DepthImages);
     return depthImageProvider_;
   }
   const std::shared_ptr<const tools::data_provider::VrsDataProvider> syntheticDataProviderPtr()
       const {
+    ensureLoaded(LoadStep::SyntheticVrs);
     return syntheticVrsProvider_;
   }
   std::shared_ptr<tools::mps::MpsDataProvider> mpsDataProviderPtr() {
+    ensureLoaded(LoadStep::Mps);
     return mps_;
   }
 
   const AriaDigitalTwinSkeletonProvider& getSkeletonProvider(InstanceId instanceId) const;
 
  protected:
-  void loadDatasetVersion();
+  // Independent units of work of the loader. Each step is run at most once, see `ensureLoaded`.
+  enum class LoadStep : size_t {
+    AriaVrs = 0,
+    DatasetVersion,
+    InstancesInfo,
+    ObjectAabbs,
+    Aria3dPoses,
+    Object3dBoundingBoxes,
+    Instance2dBoundingBoxes,
+    Segmentations,
+    DepthImages,
+    SyntheticVrs,
+    Skeletons,
+    EyeGaze,
+    Mps,
+    Count,
+  };
+
+  // returns the steps that need to be completed before `step` can run
+  static std::vector<LoadStep> getLoadStepDependencies(LoadStep step);
+
+  // run `step` (and its dependencies) if it has not been run yet, blocks if another thread is
+  // currently running it
+  void ensureLoaded(LoadStep step) const;
+  void runLoadStep(LoadStep step) const;
+  void loadAllSequential() const;
+  void loadAllParallel() const;
+
+  void loadAriaVrs() const;
+  void loadDatasetVersion() const;
   void validateDatasetVersion() const;
-  void loadAria3dPoses();
-  void loadObject3dBoundingBoxes();
-  void loadInstance2dBoundingBoxes();
-  void loadSegmentations();
-  void loadDepthImages();
-  void loadSyntheticVrs();
-  void loadSkeletonInfo();
-  void loadSkeletons();
-  void loadEyeGaze();
-  void loadMps();
-
-  void loadObjectAABBbboxes();
-  void loadInstancesInfo();
+  void loadAria3dPoses() const;
+  void loadObject3dBoundingBoxes() const;
+  void loadInstance2dBoundingBoxes() const;
+  void loadSegmentations() const;
+  void loadDepthImages() const;
+  void loadSyntheticVrs() const;
+  void loadSkeletonInfo() const;
+  void loadSkeletons() const;
+  void loadEyeGaze() const;
+  void loadMps() const;
+
+  void loadObjectAABBbboxes() const;
+  void loadInstancesInfo() const;
 
   // data paths that are used to load all ground truth data
   AriaDigitalTwinDataPaths dataPaths_;
 
+  mutable std::array<std::once_flag, static_cast<size_t>(LoadStep::Count)> loadStepFlags_;
+
+  // All data below is filled by the load steps, which may run after construction when lazy loading
+  // is enabled.
+
   // vrs provider for raw vrs data
-  std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider> dataProvider_;
+  mutable std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider> dataProvider_;
 
   // MPS data provider
-  std::shared_ptr<projectaria::tools::mps::MpsDataProvider> mps_;
+  mutable std::shared_ptr<projectaria::tools::mps::MpsDataProvider> mps_;
 
   // <ts, aria pose in global coordinate>
-  std::map<int64_t, Aria3dPose> aria3dPoses_;
+  mutable std::map<int64_t, Aria3dPose> aria3dPoses_;
   // <ts, Object3dBoundingBoxMap> for dynamic objects
-  std::map<int64_t, TypeBoundingBox3dMap> dynamicObject3dBoundingBoxSeries_;
+  mutable std::map<int64_t, TypeBoundingBox3dMap> dynamicObject3dBoundingBoxSeries_;
+  // <objId, trajectory> for dynamic objects, same data as above in per-object layout
+  mutable std::unordered_map<InstanceId, Object3dTrack> dynamicObject3dTracks_;
   // <Object3dBoundingBoxMap> for static objects, ts is not needed
-  TypeBoundingBox3dMap staticObject3dBoundingBoxes_;
+  mutable TypeBoundingBox3dMap staticObject3dBoundingBoxes_;
   // 2D bboxes for instances <streamId, <ts, BoundingBox2dMap> > >
   // including both objects and skeletons
-  std::unordered_map<
+  mutable std::unordered_map<
       vrs::StreamId,
       std::map<int64_t, TypeBoundingBox2dMap>,
       ::projectaria::dataset::adt::StreamIdHash>
       instance2dBoundingBoxes_;
   // vrs provider for segmentation
-  std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider> segmentationProvider_;
+  mutable std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider>
+      segmentationProvider_;
   // vrs provider for depth images
-  std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider> depthImageProvider_;
+  mutable std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider> depthImageProvider_;
   // vrs provider for synthetic images
-  std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider> syntheticVrsProvider_ =
-      nullptr;
+  mutable std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider>
+      syntheticVrsProvider_ = nullptr;
   // <ts, EyeGaze>, sorted in device timestamps
-  std::map<int64_t, EyeGaze> eyeGazes_;
+  mutable std::map<int64_t, EyeGaze> eyeGazes_;
   // all skeleton providers
-  std::unordered_map<InstanceId, AriaDigitalTwinSkeletonProvider> skeletons_;
+  mutable std::unordered_map<InstanceId, AriaDigitalTwinSkeletonProvider> skeletons_;
   // <objId, 3d bbox in object's local coordinate>
-  std::unordered_map<InstanceId, Vector6d> objectIdToAabb_;
-  std::unordered_map<InstanceId, InstanceInfo> instancesInfo_;
+  mutable std::unordered_map<InstanceId, Vector6d> objectIdToAabb_;
+  mutable std::unordered_map<InstanceId, InstanceInfo> instancesInfo_;
 
-  std::string datasetName_;
-  std::string datasetVersion_;
+  mutable std::string datasetName_;
+  mutable std::string datasetVersion_;
 };
 
 /**
@@ -407,4 +493,21 @@ BoundingBox3dDataWithDt getInterpolatedObject3dBoundingBoxesAtTimestampNs(
     const AriaDigitalTwinDataProvider& provider,
     int64_t deviceTimeStampNs);
 
+/**
+ * @brief helper function to return interpolated 3D bounding boxes of all objects at a batch of
+ * timestamps. Each dynamic object is interpolated between its own neighbouring samples, objects are
+ * processed in parallel.
+ * @param provider: the Data Provider to query poses from.
+ * @param deviceTimeStampsNs: query times, in any order.
+ * @param approximate: if true, rotations are interpolated with normalized linear interpolation and
+ * translations linearly, instead of interpolating along the SE3 geodesic. This is faster and the
+ * difference is negligible at the ADT sampling rate.
+ * @return BoundingBox3dBatch with dynamic objects first, then static objects, each group sorted by
+ * id. A dynamic object is flagged invalid at timestamps outside of its trajectory.
+ */
+BoundingBox3dBatch getInterpolatedObject3dBoundingBoxesAtTimestampsNs(
+    const AriaDigitalTwinDataProvider& provider,
+    const std::vector<int64_t>& deviceTimeStampsNs,
+    bool approximate = false);
+
 } // namespace projectaria::dataset::adt
@@ -114,6 +114,30 @@ struct BoundingBox3dData {
                     AABB is represented in [xmin, xmax, ymin, ymax, zmin, zmax] */
 };
 
+/**
+ * @brief time-sorted trajectory of a single dynamic object, stored as structure-of-arrays. All
+ * per-sample vectors have the same length.
+ */
+struct Object3dTrack {
+  std::vector<int64_t> timestampsNs; /**< device timestamps of the samples, ascending */
+  std::vector<Eigen::Quaterniond> q_Scene_Object; /**< object orientation in the scene */
+  std::vector<Eigen::Vector3d> t_Scene_Object; /**< object position in the scene */
+  Vector6d aabb; /**< object AABB in the object's local coordinate frame, constant over time */
+};
+
+/**
+ * @brief 3D bounding boxes of a set of objects at a set of timestamps, stored in contiguous arrays.
+ * Per-sample arrays are laid out as [timestamp][object], i.e. the pose of object `j` at timestamp
+ * `i` is at index `i * objectIds.size() + j`.
+ */
+struct BoundingBox3dBatch {
+  std::vector<InstanceId> objectIds; /**< the queried objects */
+  std::vector<int64_t> timestampsNs; /**< the queried timestamps, in device time */
+  std::vector<Vector6d> aabbs; /**< AABB of each object, indexed like `objectIds` */
+  std::vector<Sophus::SE3d> T_Scene_Objects; /**< object poses, see layout above */
+  std::vector<uint8_t> isValid; /**< 0 if the timestamp is outside of the object's trajectory */
+};
+
 /**
  * @brief a simple struct to represent a 2D bounding box for an instance
  */
@@ -17,6 +17,8 @@
 #include <gtest/gtest.h>
 #include <sophus/average.hpp>
 
+#include <thread>
+
 #include "AriaDigitalTwinDataProvider.h"
 #include "AriaStreamIds.h"
 
@@ -255,6 +257,44 @@ TEST(AdtDataProvider, DataProviderPtrAndFlagApi) {
   EXPECT_TRUE(provider->hasSyntheticImages());
 }
 
+TEST(AdtDataProvider, LoadModes) {
+  const auto dataPathsProvider = AriaDigitalTwinDataPathsProvider(adtTestDataPath);
+  const auto maybeDataPaths = dataPathsProvider.getDataPathsByDeviceNum(0, true);
+  EXPECT_TRUE(maybeDataPaths.has_value());
+
+  auto sequentialProvider = std::make_shared<AriaDigitalTwinDataProvider>(
+      maybeDataPaths.value(), AdtDataLoadMode::Sequential);
+  auto lazyProvider =
+      std::make_shared<AriaDigitalTwinDataProvider>(maybeDataPaths.value(), AdtDataLoadMode::Lazy);
+
+  // All modalities are loaded on first access, from several threads at once
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&lazyProvider]() {
+      EXPECT_TRUE(lazyProvider->hasAria3dPoses());
+      EXPECT_TRUE(lazyProvider->hasObject3dBoundingboxes());
+      EXPECT_TRUE(lazyProvider->hasInstancesInfo());
+    });
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(lazyProvider->getStartTimeNs(), sequentialProvider->getStartTimeNs());
+  EXPECT_EQ(lazyProvider->getEndTimeNs(), sequentialProvider->getEndTimeNs());
+  EXPECT_EQ(lazyProvider->getInstanceIds().size(), sequentialProvider->getInstanceIds().size());
+  EXPECT_EQ(lazyProvider->hasAriaData(), sequentialProvider->hasAriaData());
+  EXPECT_EQ(lazyProvider->hasSkeleton(), sequentialProvider->hasSkeleton());
+  EXPECT_EQ(lazyProvider->hasEyeGaze(), sequentialProvider->hasEyeGaze());
+
+  const int64_t queryTimeNs = sequentialProvider->getStartTimeNs();
+  const auto lazyBoxes = lazyProvider->getObject3dBoundingBoxesByTimestampNs(queryTimeNs);
+  const auto sequentialBoxes =
+      sequentialProvider->getObject3dBoundingBoxesByTimestampNs(queryTimeNs);
+  EXPECT_EQ(lazyBoxes.isValid(), sequentialBoxes.isValid());
+  EXPECT_EQ(lazyBoxes.data().size(), sequentialBoxes.data().size());
+}
+
 TEST(AdtDataProvider, InstanceQueryAPI) {
   // Construct a ADT data provider from the test data path
   const auto dataPathsProvider = AriaDigitalTwinDataPathsProvider(adtTestDataPath);
@@ -291,6 +331,42 @@ TEST(AdtDataProvider, InterpolationTest) {
   interpolationTester.run();
 }
 
+TEST(AdtDataProvider, BatchedObjectInterpolationTest) {
+  const auto dataPathsProvider = AriaDigitalTwinDataPathsProvider(adtTestDataPath);
+  const auto maybeDataPaths = dataPathsProvider.getDataPathsByDeviceNum(0);
+  EXPECT_TRUE(maybeDataPaths.has_value());
+
+  auto provider = std::make_shared<AriaDigitalTwinDataProvider>(maybeDataPaths.value());
+  const int64_t startTimeNs = provider->getStartTimeNs();
+  const int64_t endTimeNs = provider->getEndTimeNs();
+  const std::vector<int64_t> queryTimesNs = {
+      endTimeNs, startTimeNs, startTimeNs / 2 + endTimeNs / 2, startTimeNs / 3 + endTimeNs / 3 * 2};
+
+  for (const bool approximate : {false, true}) {
+    const auto batch =
+        getInterpolatedObject3dBoundingBoxesAtTimestampsNs(*provider, queryTimesNs, approximate);
+    const size_t numObjects = batch.objectIds.size();
+    EXPECT_EQ(batch.T_Scene_Objects.size(), numObjects * queryTimesNs.size());
+    EXPECT_EQ(batch.isValid.size(), numObjects * queryTimesNs.size());
+
+    for (size_t i = 0; i < queryTimesNs.size(); ++i) {
+      const auto single =
+          getInterpolatedObject3dBoundingBoxesAtTimestampNs(*provider, queryTimesNs[i]);
+      EXPECT_TRUE(single.isValid());
+      for (size_t j = 0; j < numObjects; ++j) {
+        const auto singleIter = single.data().find(batch.objectIds[j]);
+        if (!batch.isValid[i * numObjects + j] || singleIter == single.data().end()) {
+          continue;
+        }
+        const Sophus::SE3d& T_Scene_Object = batch.T_Scene_Objects[i * numObjects + j];
+        EXPECT_NEAR(
+            (T_Scene_Object.inverse() * singleIter->second.T_Scene_Object).log().norm(), 0, 1e-3);
+        EXPECT_TRUE(batch.aabbs[j].isApprox(singleIter->second.aabb));
+      }
+    }
+  }
+}
+
 TEST(AdtDataProvider, Mps) {
   // Construct a ADT data provider from the test data path
   const auto dataPathsProvider = AriaDigitalTwinDataPathsProvider(adtTestDataPath);
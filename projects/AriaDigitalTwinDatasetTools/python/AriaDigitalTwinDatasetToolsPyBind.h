@@ -89,6 +89,79 @@ void exportAriaDigitalTwin(py::module& m) {
           "object AABB (axes-aligned-bounding-box) in the object's local "
           "coordinate frame, AABB is represented in [xmin, xmax, ymin, ymax, zmin, zmax]");
 
+  py::class_<BoundingBox3dBatch>(
+      m,
+      "BoundingBox3dBatch",
+      "3D bounding boxes of a set of objects at a set of timestamps, stored in contiguous arrays "
+      "indexed as [timestamp, object]")
+      .def_readonly("object_ids", &BoundingBox3dBatch::objectIds, "the queried objects")
+      .def_readonly("timestamps_ns", &BoundingBox3dBatch::timestampsNs, "the queried timestamps")
+      .def_property_readonly(
+          "aabbs",
+          [](const BoundingBox3dBatch& self) {
+            py::array_t<double> aabbs({self.aabbs.size(), size_t(6)});
+            auto view = aabbs.mutable_unchecked<2>();
+            for (size_t j = 0; j < self.aabbs.size(); ++j) {
+              for (int k = 0; k < 6; ++k) {
+                view(j, k) = self.aabbs[j](k);
+              }
+            }
+            return aabbs;
+          },
+          "AABB of each object as a [num_objects, 6] array")
+      .def_property_readonly(
+          "translations_scene_object",
+          [](const BoundingBox3dBatch& self) {
+            const size_t numObjects = self.objectIds.size();
+            py::array_t<double> translations({self.timestampsNs.size(), numObjects, size_t(3)});
+            auto view = translations.mutable_unchecked<3>();
+            for (size_t i = 0; i < self.timestampsNs.size(); ++i) {
+              for (size_t j = 0; j < numObjects; ++j) {
+                const Eigen::Vector3d& t = self.T_Scene_Objects[i * numObjects + j].translation();
+                for (int k = 0; k < 3; ++k) {
+                  view(i, j, k) = t(k);
+                }
+              }
+            }
+            return translations;
+          },
+          "object positions in the scene as a [num_timestamps, num_objects, 3] array")
+      .def_property_readonly(
+          "quaternions_scene_object",
+          [](const BoundingBox3dBatch& self) {
+            const size_t numObjects = self.objectIds.size();
+            py::array_t<double> quaternions({self.timestampsNs.size(), numObjects, size_t(4)});
+            auto view = quaternions.mutable_unchecked<3>();
+            for (size_t i = 0; i < self.timestampsNs.size(); ++i) {
+              for (size_t j = 0; j < numObjects; ++j) {
+                const Eigen::Quaterniond& q =
+                    self.T_Scene_Objects[i * numObjects + j].unit_quaternion();
+                view(i, j, 0) = q.w();
+                view(i, j, 1) = q.x();
+                view(i, j, 2) = q.y();
+                view(i, j, 3) = q.z();
+              }
+            }
+            return quaternions;
+          },
+          "object orientations in the scene as a [num_timestamps, num_objects, 4] array of "
+          "(w, x, y, z) quaternions")
+      .def_property_readonly(
+          "is_valid",
+          [](const BoundingBox3dBatch& self) {
+            const size_t numObjects = self.objectIds.size();
+            py::array_t<bool> isValid({self.timestampsNs.size(), numObjects});
+            auto view = isValid.mutable_unchecked<2>();
+            for (size_t i = 0; i < self.timestampsNs.size(); ++i) {
+              for (size_t j = 0; j < numObjects; ++j) {
+                view(i, j) = self.isValid[i * numObjects + j] != 0;
+              }
+            }
+            return isValid;
+          },
+          "[num_timestamps, num_objects] array, false where the timestamp is outside of the "
+          "object's trajectory");
+
   py::class_<BoundingBox2dData>(
       m, "BoundingBox2dData", "a simple struct to represent a 2D bounding box for an instance")
       .def(py::init<>())
@@ -477,13 +550,23 @@ void exportAriaDigitalTwin(py::module& m) {
           "Device serial associated with this object. This is only applicable to Humans, and will be NONE if the human is not wearing an Aria device")
       .def("__repr__", [](const InstanceInfo& d) { return d.toString(); });
 
+  py::enum_<AdtDataLoadMode>(
+      m, "AdtDataLoadMode", "Strategy used by AriaDigitalTwinDataProvider to load the data")
+      .value("SEQUENTIAL", AdtDataLoadMode::Sequential)
+      .value("PARALLEL", AdtDataLoadMode::Parallel)
+      .value("LAZY", AdtDataLoadMode::Lazy)
+      .export_values();
+
   py::class_<AriaDigitalTwinDataProvider>(
       m,
       "AriaDigitalTwinDataProvider",
       "This is the core data loader that should provide all the data access you will need for"
       "an ADT sequence. Note that each sequence may contain multiple devices, you should create one"
       "`AriaDigitalTwinDataProvider` instance for each device.")
-      .def(py::init<const AriaDigitalTwinDataPaths&>())
+      .def(
+          py::init<const AriaDigitalTwinDataPaths&, AdtDataLoadMode>(),
+          py::arg("data_paths"),
+          py::arg("load_mode") = AdtDataLoadMode::Parallel)
       .def(
           "get_aria_device_capture_timestamps_ns",
           &AriaDigitalTwinDataProvider::getAriaDeviceCaptureTimestampsNs,
@@ -664,6 +747,14 @@ void exportAriaDigitalTwin(py::module& m) {
       "helper function to return an interpolated object 3D bounding box given a query timestamp",
       py::arg("provider"),
       py::arg("device_time_stamp_ns"));
+  m.def(
+      "get_interpolated_object_3d_boundingboxes_at_timestamps_ns",
+      &getInterpolatedObject3dBoundingBoxesAtTimestampsNs,
+      "helper function to return interpolated 3D bounding boxes of all objects at a batch of "
+      "timestamps, as contiguous arrays",
+      py::arg("provider"),
+      py::arg("device_time_stamps_ns"),
+      py::arg("approximate") = false);
 
   // Bind utility functions
   m.def(
@@ -343,7 +343,7 @@ void AriaDigitalTwinViewer::drawRawImage(
         const Eigen::Vector3d gazeCenterInCpf = Eigen::Vector3d(
             tan(eyeGaze.yaw) * eyeGaze.depth, tan(eyeGaze.pitch) * eyeGaze.depth, eyeGaze.depth);
         const auto maybeT_Cpf_Camera =
-            adtDataProvider_->rawDataProviderPtr()->getDeviceCalibration()->getT_Cpf_Sensor(
+            adtDataProvider_->rawDataProviderPtr()->getDeviceCalibrationRef()->getT_Cpf_Sensor(
                 camModel.getLabel(), true);
 
         if (!maybeT_Cpf_Camera.has_value()) {
@@ -35,24 +35,6 @@ EyeGazeAriaPlayer::EyeGazeAriaPlayer(
       calibratedEyeGazes_(calibratedEyeGazes),
       calibratedEyeGazesVisData_(calibratedEyeGazesVisData) {}
 
-void EyeGazeAriaPlayer::playFromTimeNsMultiThread(int64_t timestampNs) {
-  std::vector<std::thread> threadPool;
-  for (auto streamId : visData_->playbackStreamIds_) {
-    if (!dataProvider_->checkStreamIsActive(streamId)) {
-      continue;
-    }
-    threadPool.emplace_back(
-        [this, timestampNs, streamId]() { playStreamFromTimeNs(timestampNs, streamId); });
-  }
-  threadPool.emplace_back([this, timestampNs]() { playEyetrackingFromTimeNs(timestampNs); });
-  for (auto& thread : threadPool) {
-    thread.join();
-  }
-  // request to stop playing
-  visControl_->isPlaying_ = false;
-  return;
-}
-
 namespace {
 // Convert a Timestamp stored in double to microseconds with std::chrono
 inline constexpr auto durationDoubleToChronoUsCast(const double time_s) {
@@ -82,8 +64,17 @@ inline int queryEyetrackIndex(const EyeGazes& eyeGazes, std::chrono::microsecond
 }
 } // namespace
 
+void EyeGazeAriaPlayer::updatePlayhead(int64_t timestampNs) {
+  AriaPlayer::updatePlayhead(timestampNs);
+  updateEyeGazes(timestampNs);
+}
+
 void EyeGazeAriaPlayer::updateImagesStatic(int64_t timestampNs) {
   AriaPlayer::updateImagesStatic(timestampNs);
+  updateEyeGazes(timestampNs);
+}
+
+void EyeGazeAriaPlayer::updateEyeGazes(int64_t timestampNs) {
   auto timestampUs = durationDoubleToChronoUsCast(timestampNs * 1e-9);
   int startIndex = queryEyetrackIndex(*generalizedEyeGazes_, timestampUs);
   if (startIndex != -1) {
@@ -97,37 +88,6 @@ void EyeGazeAriaPlayer::updateImagesStatic(int64_t timestampNs) {
   }
 }
 
-void EyeGazeAriaPlayer::playEyetrackingFromTimeNs(int64_t timestampNs) {
-  int64_t playbackStartTime = timestampNs;
-  auto systemStartTime = std::chrono::steady_clock::now();
-
-  auto timestampUs = durationDoubleToChronoUsCast(timestampNs * 1e-9);
-  int startIndex = std::max(queryEyetrackIndex(*generalizedEyeGazes_, timestampUs), 0);
-  for (int i = startIndex; i < generalizedEyeGazes_->size(); ++i) {
-    if (!visControl_->isPlaying_ || visControl_->shouldClose_) {
-      return;
-    }
-
-    auto generalizedEyeGaze = generalizedEyeGazes_->at(i);
-    generalizedEyeGazesVisData_->lastYawPitch =
-        Sophus::Vector2d(generalizedEyeGaze.yaw, generalizedEyeGaze.pitch);
-
-    if (calibratedEyeGazes_ && !calibratedEyeGazes_->empty()) {
-      auto calibratedEyeGaze = calibratedEyeGazes_->at(i);
-      calibratedEyeGazesVisData_->lastYawPitch =
-          Sophus::Vector2d(calibratedEyeGaze.yaw, calibratedEyeGaze.pitch);
-    }
-
-    uint64_t currentTimestampNs = generalizedEyeGaze.trackingTimestamp.count() * 1e3;
-    auto sensorTimeDiffNs = currentTimestampNs - playbackStartTime;
-    auto systemDiffNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                            std::chrono::steady_clock::now() - systemStartTime)
-                            .count();
-    auto waitTimeNs = sensorTimeDiffNs - systemDiffNs;
-    std::this_thread::sleep_for(std::chrono::nanoseconds(waitTimeNs));
-  }
-}
-
 std::shared_ptr<EyeGazeAriaPlayer> createEyeGazeAriaPlayer(
     const std::string& vrsPath,
     const std::string& generalizedGazePath,
@@ -40,9 +40,9 @@ class EyeGazeAriaPlayer : public AriaPlayer {
   }
 
  protected:
-  void playFromTimeNsMultiThread(int64_t timestampNs) override;
+  void updatePlayhead(int64_t timestampNs) override;
   void updateImagesStatic(int64_t timestampNs) override;
-  void playEyetrackingFromTimeNs(int64_t timestampNs);
+  void updateEyeGazes(int64_t timestampNs);
 
  private:
   std::shared_ptr<projectaria::tools::mps::EyeGazes> generalizedEyeGazes_;
@@ -119,9 +119,8 @@ std::optional<Eigen::Vector2d> ProjectEyeGazePointInCamera(
     const Eigen::Vector3d& eyeGazePointCpf) {
   // Since EyeGaze results is defined in CPF you can project in Aria cameras
   // we are projecting directly using the camera calibration relative to CPF
-  if (deviceModel.getCameraCalib(cameraString)) {
-    // Get back camera of interest
-    const auto vrsCamera = deviceModel.getCameraCalib(cameraString);
+  // Get back camera of interest
+  if (const auto* vrsCamera = deviceModel.findCameraCalib(cameraString)) {
     const auto T_Cpf_Sensor = deviceModel.getT_Cpf_Sensor(cameraString, true);
 
     auto projection = vrsCamera->project(T_Cpf_Sensor->inverse() * eyeGazePointCpf);
@@ -164,7 +163,7 @@ void drawEyeGazePoint(
       Eigen::Vector3d gazePointCpf = getEyeGazePointAtDepth(
           eyeGazesVisData->lastYawPitch.x(), eyeGazesVisData->lastYawPitch.y(), depth);
       auto gazePointProjected = ProjectEyeGazePointInCamera(
-          cameraString, dataProvider->getDeviceCalibration().value(), gazePointCpf);
+          cameraString, dataProvider->getDeviceCalibrationRef().value(), gazePointCpf);
       if (gazePointProjected) {
         // Compensate for OpenGL coordinate system difference and 90 degree image rotation
         gazePointProjected->y() = imageData.getHeight() - gazePointProjected->y();
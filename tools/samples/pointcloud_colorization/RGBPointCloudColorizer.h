@@ -82,6 +82,13 @@ class RGBPointCloudColorizer : public PointCloudColorizer {
 
     TrajectoryProvider trajectoryProvider(trajectory_, startTimestampNs, endTimestampNs);
 
+    // Look up the camera calibrations once, without copying them
+    const auto& deviceCalib = dataProvider_->getDeviceCalibrationRef();
+    const std::array<const projectaria::tools::calibration::CameraCalibration*, 3> cameras{
+        deviceCalib->findCameraCalib("camera-rgb"),
+        deviceCalib->findCameraCalib("camera-slam-left"),
+        deviceCalib->findCameraCalib("camera-slam-right")};
+
     // Loop through the frames and color the points cloud
     {
       boost::timer::progress_display progressBar(
@@ -112,11 +119,6 @@ class RGBPointCloudColorizer : public PointCloudColorizer {
           continue;
         }
 
-        const std::array<projectaria::tools::calibration::CameraCalibration, 3> cameras{
-            *dataProvider_->getDeviceCalibration()->getCameraCalib("camera-rgb"),
-            *dataProvider_->getDeviceCalibration()->getCameraCalib("camera-slam-left"),
-            *dataProvider_->getDeviceCalibration()->getCameraCalib("camera-slam-right")};
-
         std::vector<std::vector<PointObservationPair>> currentFramePointObservations;
         currentFramePointObservations.push_back(
             pointObsProvider.findAllPointObs(leftCameraSerial, captureTimestampNs));
@@ -134,14 +136,14 @@ class RGBPointCloudColorizer : public PointCloudColorizer {
             for (const int index : {0, 1, 2}) // RGB, SLAM LEFT, SLAM RIGHT
             {
               // Use Point Projection
-              const auto T_Device_camera = cameras[index].getT_Device_Camera();
+              const auto T_Device_camera = cameras[index]->getT_Device_Camera();
 
               // Retrieve corresponding World Point
               const auto position_world = ptIt.second.position_world;
               const auto T_world_cam = pose->T_world_device * T_Device_camera;
               const auto position_local = T_world_cam.inverse() * position_world;
 
-              const auto projection = cameras[index].project(position_local);
+              const auto projection = cameras[index]->project(position_local);
               if (!projection) {
                 // 3D point is not visible, continue to next image
                 continue;
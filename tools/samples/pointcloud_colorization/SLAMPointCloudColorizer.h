@@ -85,6 +85,12 @@ class SLAMPointCloudColorizer : public PointCloudColorizer {
 
     TrajectoryProvider trajectoryProvider(trajectory_, startTimestampNs, endTimestampNs);
 
+    // Look up the camera calibrations once, without copying them
+    const auto& deviceCalib = dataProvider_->getDeviceCalibrationRef();
+    const std::array<const projectaria::tools::calibration::CameraCalibration*, 2> cameras{
+        deviceCalib->findCameraCalib("camera-slam-left"),
+        deviceCalib->findCameraCalib("camera-slam-right")};
+
     // Loop through the frames and color the points cloud
     {
       boost::timer::progress_display progressBar(
@@ -114,10 +120,6 @@ class SLAMPointCloudColorizer : public PointCloudColorizer {
             std::get<ImageU8>(imageDataAndRecord[0].first.imageVariant().value()),
             std::get<ImageU8>(imageDataAndRecord[1].first.imageVariant().value())};
 
-        const std::array<projectaria::tools::calibration::CameraCalibration, 2> cameras{
-            *dataProvider_->getDeviceCalibration()->getCameraCalib("camera-slam-left"),
-            *dataProvider_->getDeviceCalibration()->getCameraCalib("camera-slam-right")};
-
         const std::array<std::vector<PointObservationPair>, 2> currentFramePointObservations{
             pointObsProvider.findAllPointObs(leftCameraSerial, captureTimestampNs),
             pointObsProvider.findAllPointObs(rightCameraSerial, captureTimestampNs)};
@@ -132,14 +134,14 @@ class SLAMPointCloudColorizer : public PointCloudColorizer {
 
             if (useProjectedPoints_) {
               // Use Point Projection
-              const auto T_Device_camera = cameras[index].getT_Device_Camera();
+              const auto T_Device_camera = cameras[index]->getT_Device_Camera();
 
               // Retrieve corresponding World Point
               const auto position_world = ptIt.second.position_world;
               const auto T_world_cam = pose->T_world_device * T_Device_camera;
               const auto position_local = T_world_cam.inverse() * position_world;
 
-              const auto projection = cameras[index].project(position_local);
+              const auto projection = cameras[index]->project(position_local);
               if (!projection) {
                 // 3D point is not visible
                 continue;
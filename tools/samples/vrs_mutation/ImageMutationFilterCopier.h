@@ -21,22 +21,13 @@
 #include <vrs/utils/FilteredFileReader.h>
 #include <vrs/utils/PixelFrame.h>
 
-namespace vrs::utils {
+#include "ImageMutationPipeline.h"
+#include "UserDefinedImageMutator.h"
 
-// Abstract PixelFrame mutator to be used in conjunction of
-// ImageMutationFilter to modify VRS frame when performing a VRS copy.
-class UserDefinedImageMutator {
- public:
-  virtual ~UserDefinedImageMutator() {}
-  // Operator allowing to modify a given PixelFrame (according to its timestamp and streamId)
-  // -> Note the image size (Width, Height, Stride) must be left unchanged
-  virtual bool operator()(
-      double, // timestamp
-      const vrs::StreamId&, // streamId
-      vrs::utils::PixelFrame* // frame
-      ) = 0;
-};
+namespace vrs::utils {
 
+// Applies a UserDefinedImageMutator to the JPG frames of a stream during a VRS copy.
+// With a pipeline, the frames are mutated ahead of the copy, on the pipeline's threads.
 class ImageMutationFilter : public RecordFilterCopier {
  public:
   ImageMutationFilter(
@@ -44,9 +35,11 @@ class ImageMutationFilter : public RecordFilterCopier {
       vrs::RecordFileWriter& fileWriter,
       vrs::StreamId id,
       const CopyOptions& copyOptions,
-      UserDefinedImageMutator* userDefinedImageMutator)
+      UserDefinedImageMutator* userDefinedImageMutator,
+      ImageMutationPipeline* pipeline = nullptr)
       : RecordFilterCopier(fileReader, fileWriter, id, copyOptions),
-        userDefinedImageMutator_(userDefinedImageMutator) {}
+        userDefinedImageMutator_(userDefinedImageMutator),
+        pipeline_(pipeline) {}
 
   bool shouldCopyVerbatim(const CurrentRecord& record) override {
     auto tupleId = tuple<Record::Type, uint32_t>(record.recordType, record.formatVersion);
@@ -64,11 +57,20 @@ class ImageMutationFilter : public RecordFilterCopier {
   }
   void filterImage(
       const CurrentRecord& record,
-      size_t /*blockIndex*/,
+      size_t blockIndex,
       const ContentBlock& cb,
       vector<uint8_t>& pixels) override {
     const auto& imageSpec = cb.image();
 
+    // Collect the frame mutated ahead of the copy, in record order
+    if (pipeline_ && imageSpec.getImageFormat() == vrs::ImageFormat::JPG) {
+      if (!pipeline_->takeFrame(record.streamId, record.timestamp, blockIndex, pixels)) {
+        // Not read ahead: mutated on this thread, in its turn after the frames read ahead
+        pipeline_->mutateJpegFrame(record.streamId, record.timestamp, pixels);
+      }
+      return;
+    }
+
     // Synchronously read the image data, which is jpg compressed with Aria
     if (imageSpec.getImageFormat() == vrs::ImageFormat::JPG) {
       std::shared_ptr<vrs::utils::PixelFrame> frame = std::make_shared<PixelFrame>();
@@ -78,9 +80,7 @@ class ImageMutationFilter : public RecordFilterCopier {
       if (userDefinedImageMutator_) {
         if (!userDefinedImageMutator_->operator()(record.timestamp, record.streamId, &(*frame))) {
           // If mutator not successful, we return an empty black frame
-          if (!pixels.empty()) {
-            memset(pixels.data(), 0, pixels.size());
-          }
+          memset(frame->wdata(), 0, frame->getStride() * frame->getHeight());
         }
       }
       // Re-encode to JPG
@@ -93,6 +93,7 @@ class ImageMutationFilter : public RecordFilterCopier {
  protected:
   map<tuple<Record::Type, uint32_t>, bool> verbatimCopy_;
   UserDefinedImageMutator* userDefinedImageMutator_;
+  ImageMutationPipeline* pipeline_;
 };
 
 } // namespace vrs::utils
@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ImageMutationPipeline.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <fmt/core.h>
+#include <vrs/ErrorCode.h>
+#include <vrs/RecordFormatStreamPlayer.h>
+#include <vrs/utils/PixelFrame.h>
+
+#define DEFAULT_LOG_CHANNEL "ImageMutationPipeline"
+#include <logging/Log.h>
+
+namespace vrs::utils {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+struct ImageMutationPipeline::Job {
+  uint64_t sequence;
+  StreamId streamId;
+  double timestamp;
+  size_t blockIndex;
+  size_t inputSize;
+  std::vector<uint8_t> jpeg; // read, then mutated in place
+  bool done = false;
+};
+
+// Reads the JPEG image blocks of the data records, for the workers
+class ImageMutationPipeline::ReadAheadPlayer : public RecordFormatStreamPlayer {
+ public:
+  explicit ReadAheadPlayer(ImageMutationPipeline& pipeline) : pipeline_(pipeline) {}
+
+  bool onImageRead(const CurrentRecord& record, size_t blockIndex, const ContentBlock& cb)
+      override {
+    if (record.recordType != Record::Type::DATA ||
+        cb.image().getImageFormat() != ImageFormat::JPG) {
+      return true; // left as is by the copy
+    }
+    std::vector<uint8_t> jpeg(cb.getBlockSize());
+    const int status = record.reader->read(jpeg);
+    if (status != 0) {
+      throw std::runtime_error(fmt::format(
+          "Failed to read the image of the {} record at {:.3f}: {}",
+          record.streamId.getNumericName(),
+          record.timestamp,
+          errorCodeToMessage(status)));
+    }
+    return pipeline_.enqueue(record.streamId, record.timestamp, blockIndex, std::move(jpeg));
+  }
+
+ private:
+  ImageMutationPipeline& pipeline_;
+};
+
+// Exclusive access to a mutator that is not thread safe, granted in job sequence order.
+// The turn is passed on when destroyed, whether the frame was mutated or not.
+class ImageMutationPipeline::MutationTurn {
+ public:
+  MutationTurn(ImageMutationPipeline& pipeline, uint64_t sequence, double& waitTimeSec)
+      : pipeline_(pipeline), sequence_(sequence) {
+    if (pipeline_.mutator_ == nullptr || pipeline_.mutator_->isThreadSafe()) {
+      return;
+    }
+    const auto start = Clock::now();
+    lock_ = std::unique_lock<std::mutex>(pipeline_.mutatorMutex_);
+    pipeline_.mutatorTurn_.wait(lock_, [this] {
+      return pipeline_.stopping_ || pipeline_.nextMutationSequence_ == sequence_;
+    });
+    waitTimeSec += secondsSince(start);
+  }
+
+  ~MutationTurn() {
+    if (lock_.owns_lock()) {
+      ++pipeline_.nextMutationSequence_;
+      lock_.unlock();
+      pipeline_.mutatorTurn_.notify_all();
+    }
+  }
+
+  MutationTurn(const MutationTurn&) = delete;
+  MutationTurn& operator=(const MutationTurn&) = delete;
+
+ private:
+  ImageMutationPipeline& pipeline_;
+  const uint64_t sequence_;
+  std::unique_lock<std::mutex> lock_;
+};
+
+double ImageMutationPipelineStats::framesPerSec() const {
+  return wallTimeSec > 0 ? (frameCount + synchronousFrameCount) / wallTimeSec : 0;
+}
+
+std::string ImageMutationPipelineStats::toString() const {
+  return fmt::format(
+      "{} frames ({} mutated synchronously, {} discarded) in {:.2f}s: {:.1f} frames/s, "
+      "{:.1f} MB in, {:.1f} MB out. Thread time decoding {:.2f}s, mutating {:.2f}s, "
+      "encoding {:.2f}s. Copy waited {:.2f}s for frames, read-ahead blocked {:.2f}s "
+      "(peak {} frames in flight), mutator turns waited {:.2f}s.",
+      frameCount + synchronousFrameCount,
+      synchronousFrameCount,
+      discardedFrameCount,
+      wallTimeSec,
+      framesPerSec(),
+      inputBytes / 1e6,
+      outputBytes / 1e6,
+      decodeTimeSec,
+      mutateTimeSec,
+      encodeTimeSec,
+      copyWaitTimeSec,
+      readAheadBlockedTimeSec,
+      peakFramesInFlight,
+      mutatorTurnWaitTimeSec);
+}
+
+ImageMutationPipeline::ImageMutationPipeline(
+    const std::string& vrsPath,
+    const std::set<StreamId>& streamIds,
+    UserDefinedImageMutator* mutator,
+    const ImageMutationPipelineOptions& options)
+    : streamIds_(streamIds), mutator_(mutator), options_(options), startTime_(Clock::now()) {
+  if (options_.numThreads == 0) {
+    options_.numThreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  if (options_.maxFramesInFlight == 0) {
+    options_.maxFramesInFlight = 4 * options_.numThreads;
+  }
+  const int status = reader_.openFile(vrsPath);
+  if (status != 0) {
+    throw std::runtime_error(
+        fmt::format("Can't open '{}': {}", vrsPath, errorCodeToMessage(status)));
+  }
+  readAheadThread_ = std::thread(&ImageMutationPipeline::readAhead, this);
+  workers_.reserve(options_.numThreads);
+  for (size_t i = 0; i < options_.numThreads; ++i) {
+    workers_.emplace_back(&ImageMutationPipeline::work, this);
+  }
+}
+
+ImageMutationPipeline::~ImageMutationPipeline() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  jobReady_.notify_all();
+  jobDone_.notify_all();
+  slotFree_.notify_all();
+  {
+    // don't notify between the predicate check and the wait of a worker
+    std::unique_lock<std::mutex> lock(mutatorMutex_);
+  }
+  mutatorTurn_.notify_all();
+  readAheadThread_.join();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::set<StreamId> ImageMutationPipeline::getImageStreams(RecordFileReader& reader) {
+  std::set<StreamId> imageStreams;
+  for (const auto& streamId : reader.getStreams()) {
+    RecordFormatMap formats;
+    reader.getRecordFormats(streamId, formats);
+    for (const auto& [typeAndVersion, format] : formats) {
+      if (typeAndVersion.first == Record::Type::DATA &&
+          format.getBlocksOfTypeCount(ContentType::IMAGE) > 0) {
+        imageStreams.insert(streamId);
+      }
+    }
+  }
+  return imageStreams;
+}
+
+bool ImageMutationPipeline::enqueue(
+    const StreamId& streamId,
+    double timestamp,
+    size_t blockIndex,
+    std::vector<uint8_t>&& jpeg) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (frames_.size() >= options_.maxFramesInFlight) {
+    const auto start = Clock::now();
+    slotFree_.wait(
+        lock, [this] { return stopping_ || frames_.size() < options_.maxFramesInFlight; });
+    stats_.readAheadBlockedTimeSec += secondsSince(start);
+  }
+  if (stopping_) {
+    return false;
+  }
+  auto job = std::make_shared<Job>();
+  job->sequence = nextSequence_++;
+  job->streamId = streamId;
+  job->timestamp = timestamp;
+  job->blockIndex = blockIndex;
+  job->inputSize = jpeg.size();
+  job->jpeg = std::move(jpeg);
+  frames_.push_back(job);
+  pending_.push_back(std::move(job));
+  stats_.peakFramesInFlight = std::max(stats_.peakFramesInFlight, frames_.size());
+  jobReady_.notify_one();
+  return true;
+}
+
+void ImageMutationPipeline::readAhead() {
+  try {
+    ReadAheadPlayer player(*this);
+    for (const auto& streamId : streamIds_) {
+      reader_.setStreamPlayer(streamId, &player);
+    }
+    for (const auto& record : reader_.getIndex()) {
+      if (stopping_) {
+        break;
+      }
+      if (streamIds_.count(record.streamId) == 0) {
+        continue;
+      }
+      const int status = reader_.readRecord(record);
+      if (status != 0) {
+        throw std::runtime_error(fmt::format(
+            "Failed to read the {} record at {:.3f}: {}",
+            record.streamId.getNumericName(),
+            record.timestamp,
+            errorCodeToMessage(status)));
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      readAheadTimestamp_ = record.timestamp;
+      jobDone_.notify_all();
+    }
+  } catch (const std::exception& e) {
+    XR_LOGE("{}", e.what());
+    std::unique_lock<std::mutex> lock(mutex_);
+    error_ = std::current_exception();
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  readAheadDone_ = true;
+  jobReady_.notify_all();
+  jobDone_.notify_all();
+}
+
+void ImageMutationPipeline::work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    jobReady_.wait(lock, [this] { return stopping_ || readAheadDone_ || !pending_.empty(); });
+    if (stopping_ || pending_.empty()) {
+      return;
+    }
+    std::shared_ptr<Job> job = std::move(pending_.front());
+    pending_.pop_front();
+    lock.unlock();
+
+    ImageMutationPipelineStats stats;
+    std::exception_ptr error;
+    try {
+      processFrame(job->streamId, job->timestamp, job->sequence, job->jpeg, stats);
+    } catch (const std::exception& e) {
+      XR_LOGE("{}", e.what());
+      error = std::current_exception();
+    }
+
+    lock.lock();
+    stats_.decodeTimeSec += stats.decodeTimeSec;
+    stats_.mutateTimeSec += stats.mutateTimeSec;
+    stats_.encodeTimeSec += stats.encodeTimeSec;
+    stats_.mutatorTurnWaitTimeSec += stats.mutatorTurnWaitTimeSec;
+    if (error && !error_) {
+      error_ = error;
+    }
+    job->done = true;
+    jobDone_.notify_all();
+  }
+}
+
+void ImageMutationPipeline::processFrame(
+    const StreamId& streamId,
+    double timestamp,
+    uint64_t jobSequence,
+    std::vector<uint8_t>& jpeg,
+    ImageMutationPipelineStats& stats) {
+  auto start = Clock::now();
+  PixelFrame frame;
+  const bool decoded = frame.readJpegFrame(jpeg, jpeg.size());
+  stats.decodeTimeSec += secondsSince(start);
+
+  bool mutated = true;
+  {
+    MutationTurn turn(*this, jobSequence, stats.mutatorTurnWaitTimeSec);
+    if (stopping_) {
+      return;
+    }
+    start = Clock::now();
+    if (decoded && mutator_ != nullptr) {
+      mutated = (*mutator_)(timestamp, streamId, &frame);
+    }
+    stats.mutateTimeSec += secondsSince(start);
+  }
+  if (!decoded) {
+    XR_LOGW(
+        "Can't decode the {} frame at {:.3f}, copied as is",
+        streamId.getNumericName(),
+        timestamp);
+    return;
+  }
+  if (!mutated) {
+    // If mutator not successful, we return an empty black frame
+    memset(frame.wdata(), 0, frame.getStride() * frame.getHeight());
+  }
+  start = Clock::now();
+  frame.jpgCompress(jpeg, options_.jpegQuality);
+  stats.encodeTimeSec += secondsSince(start);
+}
+
+void ImageMutationPipeline::discardFront() {
+  frames_.pop_front();
+  ++stats_.discardedFrameCount;
+  slotFree_.notify_one();
+}
+
+void ImageMutationPipeline::rethrowError() {
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+bool ImageMutationPipeline::takeFrame(
+    const StreamId& streamId,
+    double timestamp,
+    size_t blockIndex,
+    std::vector<uint8_t>& outJpeg) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    rethrowError();
+    // The copy went past these records without requesting their frames
+    while (!frames_.empty() && frames_.front()->timestamp < timestamp) {
+      discardFront();
+    }
+    auto frame = std::find_if(frames_.begin(), frames_.end(), [&](const auto& job) {
+      return job->streamId == streamId && job->timestamp == timestamp &&
+          job->blockIndex == blockIndex;
+    });
+    if (frame != frames_.end()) {
+      Job& job = **frame;
+      if (job.done) {
+        outJpeg.swap(job.jpeg);
+        ++stats_.frameCount;
+        stats_.inputBytes += job.inputSize;
+        stats_.outputBytes += outJpeg.size();
+        frames_.erase(frame);
+        slotFree_.notify_one();
+        return true;
+      }
+    } else if (
+        readAheadDone_ || readAheadTimestamp_ > timestamp ||
+        frames_.size() >= options_.maxFramesInFlight) {
+      return false;
+    }
+    const auto start = Clock::now();
+    jobDone_.wait(lock);
+    stats_.copyWaitTimeSec += secondsSince(start);
+  }
+}
+
+void ImageMutationPipeline::mutateJpegFrame(
+    const StreamId& streamId,
+    double timestamp,
+    std::vector<uint8_t>& jpeg) {
+  // A mutator that is not thread safe is called for the frames read ahead so far first, as for
+  // a frame of the read-ahead, which couldn't hold this one in its window yet
+  uint64_t sequence = 0;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    sequence = nextSequence_++;
+  }
+  ImageMutationPipelineStats stats;
+  const size_t inputSize = jpeg.size();
+  processFrame(streamId, timestamp, sequence, jpeg, stats);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  ++stats_.synchronousFrameCount;
+  stats_.inputBytes += inputSize;
+  stats_.outputBytes += jpeg.size();
+  stats_.decodeTimeSec += stats.decodeTimeSec;
+  stats_.mutateTimeSec += stats.mutateTimeSec;
+  stats_.encodeTimeSec += stats.encodeTimeSec;
+  stats_.mutatorTurnWaitTimeSec += stats.mutatorTurnWaitTimeSec;
+}
+
+ImageMutationPipelineStats ImageMutationPipeline::getStats() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  ImageMutationPipelineStats stats = stats_;
+  stats.wallTimeSec = secondsSince(startTime_);
+  return stats;
+}
+
+} // namespace vrs::utils
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <vrs/RecordFileReader.h>
+#include <vrs/StreamId.h>
+
+#include "UserDefinedImageMutator.h"
+
+namespace vrs::utils {
+
+struct ImageMutationPipelineOptions {
+  // Number of threads decoding, mutating and re-encoding frames, 0 for one per core
+  size_t numThreads = 0;
+  // Maximum number of frames read ahead of the copy, 0 for 4 per thread
+  size_t maxFramesInFlight = 0;
+  // Quality of the re-encoded JPEG frames
+  uint32_t jpegQuality = 90;
+};
+
+struct ImageMutationPipelineStats {
+  // Frames handed to the copy, mutated in the pipeline
+  uint64_t frameCount = 0;
+  // Frames the copy requested but the pipeline had not read ahead, mutated synchronously
+  uint64_t synchronousFrameCount = 0;
+  // Frames read ahead but never requested by the copy
+  uint64_t discardedFrameCount = 0;
+  uint64_t inputBytes = 0;
+  uint64_t outputBytes = 0;
+
+  double wallTimeSec = 0;
+  // Time spent in each stage, summed over the worker threads
+  double decodeTimeSec = 0;
+  double mutateTimeSec = 0;
+  double encodeTimeSec = 0;
+
+  // Backpressure: time the read-ahead thread was blocked on maxFramesInFlight pending frames,
+  // i.e. the copy is the bottleneck
+  double readAheadBlockedTimeSec = 0;
+  // Time the copy waited for its next frame, i.e. the workers are the bottleneck
+  double copyWaitTimeSec = 0;
+  // Time workers waited for their turn to call a mutator that is not thread safe
+  double mutatorTurnWaitTimeSec = 0;
+  size_t peakFramesInFlight = 0;
+
+  double framesPerSec() const;
+  std::string toString() const;
+};
+
+// Decodes, mutates and re-encodes the JPEG frames of a VRS file on a pool of threads,
+// ahead of the copy of the file, which then collects the frames in record order.
+// The frames are read with a reader of its own, so the copy thread only waits for frames
+// that are not ready yet, and at most maxFramesInFlight frames are held in memory.
+class ImageMutationPipeline {
+ public:
+  ImageMutationPipeline(
+      const std::string& vrsPath,
+      const std::set<StreamId>& streamIds,
+      UserDefinedImageMutator* mutator,
+      const ImageMutationPipelineOptions& options = {});
+  ~ImageMutationPipeline();
+
+  ImageMutationPipeline(const ImageMutationPipeline&) = delete;
+  ImageMutationPipeline& operator=(const ImageMutationPipeline&) = delete;
+
+  // Get the mutated JPEG frame of an image block, which must be requested in record order.
+  // Frames read ahead for earlier records are discarded.
+  // Returns false if the block wasn't read ahead: use mutateJpegFrame() instead.
+  bool takeFrame(
+      const StreamId& streamId,
+      double timestamp,
+      size_t blockIndex,
+      std::vector<uint8_t>& outJpeg);
+
+  // Synchronously decode, mutate and re-encode a JPEG frame, in place.
+  // The frame takes the next place in the pipeline's sequence: a mutator that is not thread safe
+  // is called for it after the frames read ahead so far, which precede it in record order unless
+  // the read-ahead skipped it (e.g. its stream isn't one of the pipeline's).
+  void mutateJpegFrame(const StreamId& streamId, double timestamp, std::vector<uint8_t>& jpeg);
+
+  ImageMutationPipelineStats getStats() const;
+
+  // Streams with images in their data records
+  static std::set<StreamId> getImageStreams(RecordFileReader& reader);
+
+ private:
+  struct Job;
+  class ReadAheadPlayer;
+  class MutationTurn;
+
+  // Called by the read-ahead player, blocks while maxFramesInFlight frames are pending.
+  // Returns false when the pipeline is stopping.
+  bool enqueue(
+      const StreamId& streamId,
+      double timestamp,
+      size_t blockIndex,
+      std::vector<uint8_t>&& jpeg);
+  void readAhead();
+  void work();
+  // Decode, mutate and re-encode a frame. jobSequence orders the calls of a mutator that is not
+  // thread safe.
+  void processFrame(
+      const StreamId& streamId,
+      double timestamp,
+      uint64_t jobSequence,
+      std::vector<uint8_t>& jpeg,
+      ImageMutationPipelineStats& stats);
+  void discardFront();
+  void rethrowError();
+
+  RecordFileReader reader_;
+  const std::set<StreamId> streamIds_;
+  UserDefinedImageMutator* mutator_;
+  ImageMutationPipelineOptions options_; // with the defaults resolved
+  const std::chrono::steady_clock::time_point startTime_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable jobReady_; // for workers
+  std::condition_variable jobDone_; // for the copy
+  std::condition_variable slotFree_; // for the read-ahead thread
+  std::deque<std::shared_ptr<Job>> frames_; // frames not handed to the copy, in record order
+  std::deque<std::shared_ptr<Job>> pending_; // frames not picked up by a worker
+  uint64_t nextSequence_ = 0; // of the frames read ahead or mutated synchronously
+  double readAheadTimestamp_ = -1; // records up to that time were read ahead, if not done
+  bool readAheadDone_ = false;
+  std::atomic<bool> stopping_{false};
+  std::exception_ptr error_;
+  ImageMutationPipelineStats stats_;
+
+  // Orders the calls of a mutator that is not thread safe
+  std::mutex mutatorMutex_;
+  std::condition_variable mutatorTurn_;
+  uint64_t nextMutationSequence_ = 0;
+
+  std::thread readAheadThread_;
+  std::vector<std::thread> workers_;
+};
+
+} // namespace vrs::utils
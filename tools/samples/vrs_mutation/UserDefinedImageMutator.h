@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <vrs/StreamId.h>
+#include <vrs/utils/PixelFrame.h>
+
+namespace vrs::utils {
+
+// Abstract PixelFrame mutator to be used in conjunction of
+// ImageMutationFilter to modify VRS frame when performing a VRS copy.
+class UserDefinedImageMutator {
+ public:
+  virtual ~UserDefinedImageMutator() {}
+  // Operator allowing to modify a given PixelFrame (according to its timestamp and streamId)
+  // -> Note the image size (Width, Height, Stride) must be left unchanged
+  virtual bool operator()(
+      double, // timestamp
+      const vrs::StreamId&, // streamId
+      vrs::utils::PixelFrame* // frame
+      ) = 0;
+
+  // Whether the operator may be called concurrently on different frames.
+  // Mutators that are not thread safe are called one frame at a time, in record order.
+  virtual bool isThreadSafe() const {
+    return false;
+  }
+};
+
+} // namespace vrs::utils
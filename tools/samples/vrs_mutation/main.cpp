@@ -15,6 +15,7 @@
  */
 
 #include <cstdlib>
+#include <exception>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -29,6 +30,7 @@
 #include <vrs/utils/RecordFileInfo.h>
 
 #include "ImageMutationFilterCopier.h"
+#include "ImageMutationPipeline.h"
 
 #include <CLI/CLI.hpp>
 
@@ -57,6 +59,11 @@ struct NullifyEvenRowsImageMutator : public vrs::utils::UserDefinedImageMutator
     }
     return true;
   }
+
+  // Stateless, so frames can be mutated concurrently
+  bool isThreadSafe() const override {
+    return true;
+  }
 };
 
 // Demonstration on how to implement a variant of the abstract class "UserDefinedImageMutator"
@@ -107,6 +114,7 @@ int main(int argc, const char* argv[]) {
   std::string vrsPathIn;
   std::string vrsPathOut;
   std::string vrsExportPath;
+  vrs::utils::ImageMutationPipelineOptions pipelineOptions;
 
   CLI::App app{"VRS file Mutation example by using VRS Copy + Filter mechanism"};
 
@@ -121,6 +129,16 @@ int main(int argc, const char* argv[]) {
          "  Note: NULLIFY_EVEN_ROWS is shared as a DEMO example only")
       ->required();
   app.add_option("-e,--exportPath", vrsExportPath, "VRS export output path");
+  app.add_option(
+         "-j,--threads",
+         pipelineOptions.numThreads,
+         "Number of threads decoding, mutating and re-encoding frames, 0 for one per core")
+      ->capture_default_str();
+  app.add_option(
+         "--max-frames-in-flight",
+         pipelineOptions.maxFramesInFlight,
+         "Maximum number of frames mutated ahead of the copy, 0 for 4 per thread")
+      ->capture_default_str();
 
   CLI11_PARSE(app, argc, argv);
 
@@ -155,19 +173,38 @@ int main(int argc, const char* argv[]) {
     imageMutator = std::make_shared<VrsExportLoader>(vrsExportPath);
   }
 
-  auto copyMakeStreamFilterFunction = [&imageMutator](
+  // Decode, mutate and re-encode the frames on all cores, ahead of the copy
+  std::unique_ptr<vrs::utils::ImageMutationPipeline> pipeline;
+  try {
+    pipeline = std::make_unique<vrs::utils::ImageMutationPipeline>(
+        vrsPathIn,
+        vrs::utils::ImageMutationPipeline::getImageStreams(filteredReader.reader),
+        imageMutator.get(),
+        pipelineOptions);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto copyMakeStreamFilterFunction = [&imageMutator, &pipeline](
                                           vrs::RecordFileReader& fileReader,
                                           vrs::RecordFileWriter& fileWriter,
                                           vrs::StreamId streamId,
                                           const vrs::utils::CopyOptions& copyOptions)
       -> std::unique_ptr<vrs::utils::RecordFilterCopier> {
     auto imageMutatorFilter = std::make_unique<vrs::utils::ImageMutationFilter>(
-        fileReader, fileWriter, streamId, copyOptions, imageMutator.get());
+        fileReader, fileWriter, streamId, copyOptions, imageMutator.get(), pipeline.get());
     return imageMutatorFilter;
   };
 
-  const int statusCode =
-      filterCopy(filteredReader, targetPath, copyOptions, copyMakeStreamFilterFunction);
+  int statusCode = EXIT_FAILURE;
+  try {
+    statusCode =
+        filterCopy(filteredReader, targetPath, copyOptions, copyMakeStreamFilterFunction);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+  }
+  fmt::print("{}\n", pipeline->getStats().toString());
 
   return statusCode;
 }
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ImageMutationPipeline.h"
+
+#include <benchmarks/SyntheticAriaRecording.h>
+#include <vrs/RecordFormatStreamPlayer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace vrs;
+using namespace vrs::utils;
+using namespace projectaria::tools::benchmarks;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const StreamId kSlamLeft(RecordableTypeId::SlamCameraData, 1);
+const StreamId kSlamRight(RecordableTypeId::SlamCameraData, 2);
+const StreamId kEt(RecordableTypeId::EyeCameraRecordableClass, 1);
+
+struct Frame {
+  StreamId streamId;
+  double timestamp;
+  size_t blockIndex;
+  std::vector<uint8_t> jpeg;
+};
+
+// Collects the JPEG image blocks of the data records, in record order
+class JpegCollector : public RecordFormatStreamPlayer {
+ public:
+  bool onImageRead(const CurrentRecord& record, size_t blockIndex, const ContentBlock& cb)
+      override {
+    if (record.recordType != Record::Type::DATA ||
+        cb.image().getImageFormat() != ImageFormat::JPG) {
+      return true;
+    }
+    frames.push_back({record.streamId, record.timestamp, blockIndex, {}});
+    frames.back().jpeg.resize(cb.getBlockSize());
+    EXPECT_EQ(record.reader->read(frames.back().jpeg), 0);
+    return true;
+  }
+
+  std::vector<Frame> frames;
+};
+
+// Writes the first row of each frame, with a value that depends on the frames mutated before
+// if the mutator is not thread safe, so that its output depends on the call order.
+// Sleeps for a random time, so that the workers complete out of order.
+class MarkingMutator : public UserDefinedImageMutator {
+ public:
+  explicit MarkingMutator(bool threadSafe, bool sleep = true)
+      : threadSafe_(threadSafe), sleep_(sleep) {}
+
+  bool operator()(double timestamp, const StreamId& streamId, PixelFrame* frame) override {
+    if (sleep_) {
+      std::this_thread::sleep_for(std::chrono::microseconds(randomSleepUs()));
+    }
+    uint8_t mark = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      calls.emplace_back(streamId, timestamp);
+      mark = threadSafe_ ? static_cast<uint8_t>(timestamp * 100 + streamId.getInstanceId())
+                         : static_cast<uint8_t>(calls.size() * 7);
+    }
+    memset(frame->wdata(), mark, frame->getStride());
+    return true;
+  }
+
+  bool isThreadSafe() const override {
+    return threadSafe_;
+  }
+
+  std::vector<std::pair<StreamId, double>> calls;
+
+ private:
+  int randomSleepUs() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::uniform_int_distribution<int>(0, 2000)(rng_);
+  }
+
+  const bool threadSafe_;
+  const bool sleep_;
+  std::mutex mutex_;
+  std::minstd_rand rng_{42};
+};
+
+// The frames mutated the way the copy does without a pipeline
+void mutateSynchronously(std::vector<Frame>& frames, UserDefinedImageMutator& mutator) {
+  for (auto& frame : frames) {
+    PixelFrame pixelFrame;
+    ASSERT_TRUE(pixelFrame.readJpegFrame(frame.jpeg, frame.jpeg.size()));
+    if (!mutator(frame.timestamp, frame.streamId, &pixelFrame)) {
+      memset(pixelFrame.wdata(), 0, pixelFrame.getStride() * pixelFrame.getHeight());
+    }
+    pixelFrame.jpgCompress(frame.jpeg, 90);
+  }
+}
+
+// Take the frames from the pipeline in record order, falling back to mutateJpegFrame as the copy
+// does. Returns how many frames were mutated synchronously.
+size_t takeFrames(ImageMutationPipeline& pipeline, std::vector<Frame>& frames) {
+  size_t synchronousFrameCount = 0;
+  for (auto& frame : frames) {
+    if (!pipeline.takeFrame(frame.streamId, frame.timestamp, frame.blockIndex, frame.jpeg)) {
+      pipeline.mutateJpegFrame(frame.streamId, frame.timestamp, frame.jpeg);
+      ++synchronousFrameCount;
+    }
+  }
+  return synchronousFrameCount;
+}
+
+size_t totalSize(const std::vector<Frame>& frames) {
+  size_t size = 0;
+  for (const auto& frame : frames) {
+    size += frame.jpeg.size();
+  }
+  return size;
+}
+
+void expectSameFrames(const std::vector<Frame>& actual, const std::vector<Frame>& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_EQ(actual[i].streamId, expected[i].streamId) << "Frame " << i;
+    EXPECT_EQ(actual[i].timestamp, expected[i].timestamp) << "Frame " << i;
+    EXPECT_TRUE(actual[i].jpeg == expected[i].jpeg) << "Frame " << i;
+  }
+}
+
+class ImageMutationPipelineTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+    testDir_ = fs::temp_directory_path() / (std::string("vrs_mutation_") + testInfo->name());
+    fs::remove_all(testDir_);
+    fs::create_directories(testDir_);
+    path_ = (testDir_ / "input.vrs").string();
+
+    // 3 JPEG streams, with frames of all the cameras at the same timestamps
+    SyntheticRecordingOptions options;
+    options.durationSec = 1;
+    options.rgb.enabled = false;
+    options.slam.encoding = SyntheticImageEncoding::Jpeg;
+    options.et.encoding = SyntheticImageEncoding::Jpeg;
+    options.enableAudio = false;
+    writeSyntheticAriaRecording(path_, options);
+
+    RecordFileReader reader;
+    ASSERT_EQ(reader.openFile(path_), 0);
+    streamIds_ = ImageMutationPipeline::getImageStreams(reader);
+    ASSERT_EQ(streamIds_, (std::set<StreamId>{kSlamLeft, kSlamRight, kEt}));
+    JpegCollector collector;
+    for (const auto& streamId : streamIds_) {
+      reader.setStreamPlayer(streamId, &collector);
+    }
+    ASSERT_EQ(reader.readAllRecords(), 0);
+    frames_ = std::move(collector.frames);
+    ASSERT_EQ(frames_.size(), 30);
+  }
+
+  void TearDown() override {
+    fs::remove_all(testDir_);
+  }
+
+  fs::path testDir_;
+  std::string path_;
+  std::set<StreamId> streamIds_;
+  std::vector<Frame> frames_;
+};
+
+} // namespace
+
+TEST_F(ImageMutationPipelineTest, NotThreadSafeMutatorCalledInRecordOrder) {
+  std::vector<Frame> expected = frames_;
+  MarkingMutator synchronousMutator(false, false);
+  mutateSynchronously(expected, synchronousMutator);
+
+  std::vector<Frame> actual = frames_;
+  MarkingMutator mutator(false);
+  ImageMutationPipelineOptions options;
+  options.numThreads = 4;
+  options.maxFramesInFlight = 6;
+  ImageMutationPipelineStats stats;
+  {
+    ImageMutationPipeline pipeline(path_, streamIds_, &mutator, options);
+    EXPECT_EQ(takeFrames(pipeline, actual), 0);
+    stats = pipeline.getStats();
+  }
+  expectSameFrames(actual, expected);
+  EXPECT_EQ(mutator.calls, synchronousMutator.calls);
+
+  EXPECT_EQ(stats.frameCount, frames_.size());
+  EXPECT_EQ(stats.synchronousFrameCount, 0);
+  EXPECT_EQ(stats.discardedFrameCount, 0);
+  EXPECT_EQ(stats.inputBytes, totalSize(frames_));
+  EXPECT_EQ(stats.outputBytes, totalSize(actual));
+  EXPECT_GE(stats.peakFramesInFlight, 1);
+  EXPECT_LE(stats.peakFramesInFlight, options.maxFramesInFlight);
+  EXPECT_GT(stats.mutateTimeSec, 0);
+}
+
+TEST_F(ImageMutationPipelineTest, ThreadSafeMutatorMatchesSynchronousPath) {
+  std::vector<Frame> expected = frames_;
+  MarkingMutator synchronousMutator(true, false);
+  mutateSynchronously(expected, synchronousMutator);
+
+  for (size_t numThreads : {1, 4}) {
+    std::vector<Frame> actual = frames_;
+    MarkingMutator mutator(true);
+    ImageMutationPipelineOptions options;
+    options.numThreads = numThreads;
+    ImageMutationPipeline pipeline(path_, streamIds_, &mutator, options);
+    EXPECT_EQ(takeFrames(pipeline, actual), 0);
+    expectSameFrames(actual, expected);
+    EXPECT_EQ(pipeline.getStats().frameCount, frames_.size());
+  }
+}
+
+TEST_F(ImageMutationPipelineTest, DiscardsFramesNotRequested) {
+  // Request every other frame, as a copy that filters records would
+  std::vector<Frame> requested;
+  size_t expectedDiscarded = 0;
+  for (size_t i = 0; i < frames_.size(); ++i) {
+    if (i % 2 == 0) {
+      requested.push_back(frames_[i]);
+    }
+  }
+  for (size_t i = 1; i < frames_.size(); i += 2) {
+    // Skipped frames are discarded when a later record is requested
+    if (frames_[i].timestamp < requested.back().timestamp) {
+      ++expectedDiscarded;
+    }
+  }
+  std::vector<Frame> expected = requested;
+  MarkingMutator synchronousMutator(true, false);
+  mutateSynchronously(expected, synchronousMutator);
+
+  MarkingMutator mutator(true);
+  ImageMutationPipelineOptions options;
+  options.numThreads = 3;
+  options.maxFramesInFlight = 4;
+  ImageMutationPipeline pipeline(path_, streamIds_, &mutator, options);
+  EXPECT_EQ(takeFrames(pipeline, requested), 0);
+  expectSameFrames(requested, expected);
+
+  const ImageMutationPipelineStats stats = pipeline.getStats();
+  EXPECT_EQ(stats.frameCount, requested.size());
+  EXPECT_EQ(stats.synchronousFrameCount, 0);
+  EXPECT_EQ(stats.discardedFrameCount, expectedDiscarded);
+}
+
+TEST_F(ImageMutationPipelineTest, MutatesFramesNotReadAheadSynchronously) {
+  std::vector<Frame> expected = frames_;
+  MarkingMutator synchronousMutator(true, false);
+  mutateSynchronously(expected, synchronousMutator);
+
+  // The pipeline doesn't read the ET frames ahead
+  size_t etFrameCount = 0;
+  for (const auto& frame : frames_) {
+    etFrameCount += frame.streamId == kEt ? 1 : 0;
+  }
+  std::vector<Frame> actual = frames_;
+  MarkingMutator mutator(true);
+  ImageMutationPipelineOptions options;
+  options.numThreads = 2;
+  ImageMutationPipeline pipeline(path_, {kSlamLeft, kSlamRight}, &mutator, options);
+  EXPECT_EQ(takeFrames(pipeline, actual), etFrameCount);
+  expectSameFrames(actual, expected);
+
+  const ImageMutationPipelineStats stats = pipeline.getStats();
+  EXPECT_EQ(stats.frameCount, frames_.size() - etFrameCount);
+  EXPECT_EQ(stats.synchronousFrameCount, etFrameCount);
+  EXPECT_EQ(stats.inputBytes, totalSize(frames_));
+  EXPECT_EQ(stats.outputBytes, totalSize(actual));
+}
+
+TEST_F(ImageMutationPipelineTest, SynchronousFrameWaitsForFramesReadAhead) {
+  // With a single frame in flight, the left frame fills the read-ahead window, so the right
+  // frame of the same timestamp, requested first, can't be read ahead
+  auto left = std::find_if(frames_.begin(), frames_.end(), [](const Frame& frame) {
+    return frame.streamId == kSlamLeft;
+  });
+  ASSERT_NE(left, frames_.end());
+  const Frame& right = *(left + 1);
+  ASSERT_EQ(right.streamId, kSlamRight);
+  ASSERT_EQ(left->timestamp, right.timestamp);
+
+  MarkingMutator mutator(false);
+  {
+    ImageMutationPipelineOptions options;
+    options.numThreads = 2;
+    options.maxFramesInFlight = 1;
+    ImageMutationPipeline pipeline(path_, {kSlamLeft, kSlamRight}, &mutator, options);
+
+    std::vector<uint8_t> jpeg = right.jpeg;
+    ASSERT_FALSE(pipeline.takeFrame(right.streamId, right.timestamp, right.blockIndex, jpeg));
+    pipeline.mutateJpegFrame(right.streamId, right.timestamp, jpeg);
+    jpeg = left->jpeg;
+    ASSERT_TRUE(pipeline.takeFrame(left->streamId, left->timestamp, left->blockIndex, jpeg));
+    EXPECT_EQ(pipeline.getStats().synchronousFrameCount, 1);
+  }
+
+  // The mutator was called for the frame read ahead first, as in record order
+  ASSERT_GE(mutator.calls.size(), 2);
+  EXPECT_EQ(mutator.calls[0], std::make_pair(left->streamId, left->timestamp));
+  EXPECT_EQ(mutator.calls[1], std::make_pair(right.streamId, right.timestamp));
+}
@@ -16,23 +16,104 @@
 
 #include "AriaPlayer.h"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 using namespace projectaria::tools::data_provider;
-constexpr int64_t kSleepInteruptPeriodNs = 100000000; // 100 ms
+
+namespace {
+// wall clock time of data read ahead of the playhead
+constexpr int64_t kReadAheadNs = 200000000; // 200 ms
+// the player wakes up at least this often to follow the playback controls
+constexpr auto kMaxWaitPeriod = std::chrono::milliseconds(10);
+constexpr auto kMinWaitPeriod = std::chrono::milliseconds(1);
+} // namespace
 
 AriaPlayer::AriaPlayer(
     std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider> dataProvider,
     std::shared_ptr<AriaVisualizationData> visData,
     std::shared_ptr<AriaVisualizationControl> visControl)
-    : dataProvider_(dataProvider), visData_(visData), visControl_(visControl) {}
+    : dataProvider_(dataProvider),
+      visData_(visData),
+      visControl_(visControl),
+      scheduler_(std::make_unique<PlaybackScheduler>(dataProvider, visData->playbackStreamIds_)) {}
 
 void AriaPlayer::run() {
+  using Clock = std::chrono::steady_clock;
+  bool wasPlaying = false;
+  int64_t staticTimestampNs = -1;
+  // the playhead moves at playbackSpeed from startTimestampNs, reached at startTime
+  int64_t playheadNs = 0;
+  int64_t startTimestampNs = 0;
+  Clock::time_point startTime;
+  float playbackSpeed = 1.f;
+
   while (!visControl_->shouldClose_) {
-    int64_t timestampNs = visControl_->timestampNs_;
-    playFromTimeNsMultiThread(timestampNs);
-    updateImagesStatic(visControl_->timestampNs_);
+    if (!visControl_->isPlaying_) {
+      if (wasPlaying) {
+        printPlaybackStats();
+        wasPlaying = false;
+      }
+      const int64_t timestampNs = visControl_->timestampNs_;
+      if (timestampNs != staticTimestampNs) {
+        updateImagesStatic(timestampNs);
+        staticTimestampNs = timestampNs;
+      }
+      std::this_thread::sleep_for(kMaxWaitPeriod);
+      continue;
+    }
+
+    const auto now = Clock::now();
+    const float requestedSpeed =
+        std::clamp<float>(visControl_->playbackSpeed_, kMinPlaybackSpeed, kMaxPlaybackSpeed);
+    if (!wasPlaying || visControl_->timestampNs_ != playheadNs) {
+      // start playing, or seek to the timestamp set by the viewer, without restarting the workers
+      playheadNs = visControl_->timestampNs_;
+      scheduler_->seek(playheadNs);
+      startTimestampNs = playheadNs;
+      startTime = now;
+      playbackSpeed = requestedSpeed;
+      wasPlaying = true;
+    } else if (requestedSpeed != playbackSpeed) {
+      startTimestampNs = playheadNs;
+      startTime = now;
+      playbackSpeed = requestedSpeed;
+    }
+
+    const int64_t elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - startTime).count();
+    const int64_t nextPlayheadNs =
+        startTimestampNs + static_cast<int64_t>(static_cast<double>(elapsedNs) * playbackSpeed);
+    updatePlayhead(nextPlayheadNs);
+    // keep the timestamp if the viewer changed it meanwhile, to seek to it
+    int64_t expectedNs = playheadNs;
+    if (visControl_->timestampNs_.compare_exchange_strong(expectedNs, nextPlayheadNs)) {
+      playheadNs = nextPlayheadNs;
+    }
+
+    if (scheduler_->isFinished()) {
+      // request to stop playing
+      visControl_->isPlaying_ = false;
+      continue;
+    }
+    // sleep until the next data is due, or the next check of the controls
+    const auto waitPeriod = std::chrono::nanoseconds(static_cast<int64_t>(
+        static_cast<double>(scheduler_->getNextTimeNs() - nextPlayheadNs) / playbackSpeed));
+    std::this_thread::sleep_for(std::clamp<Clock::duration>(
+        std::chrono::duration_cast<Clock::duration>(waitPeriod), kMinWaitPeriod, kMaxWaitPeriod));
   }
 }
 
+void AriaPlayer::updatePlayhead(int64_t timestampNs) {
+  const float playbackSpeed =
+      std::clamp<float>(visControl_->playbackSpeed_, kMinPlaybackSpeed, kMaxPlaybackSpeed);
+  scheduler_->advance(
+      timestampNs,
+      static_cast<int64_t>(kReadAheadNs * playbackSpeed),
+      [this](const SensorData& sensorData) { visData_->updateData(sensorData); });
+}
+
 void AriaPlayer::updateImagesStatic(int64_t timestampNs) {
   for (auto streamId : visData_->playbackStreamIds_) {
     if (!dataProvider_->checkStreamIsActive(streamId)) {
@@ -48,61 +129,18 @@ void AriaPlayer::updateImagesStatic(int64_t timestampNs) {
   }
 }
 
-void AriaPlayer::playFromTimeNsMultiThread(int64_t timestampNs) {
-  std::vector<std::thread> threadPool;
-  for (auto streamId : visData_->playbackStreamIds_) {
-    if (!dataProvider_->checkStreamIsActive(streamId)) {
+void AriaPlayer::printPlaybackStats() const {
+  for (const auto& [streamId, stats] : scheduler_->getStats()) {
+    if (stats.numDelivered == 0) {
       continue;
     }
-    threadPool.emplace_back(
-        [this, timestampNs, streamId]() { playStreamFromTimeNs(timestampNs, streamId); });
-  }
-  for (auto& thread : threadPool) {
-    thread.join();
-  }
-  // request to stop playing
-  visControl_->isPlaying_ = false;
-  return;
-}
-
-void AriaPlayer::playStreamFromTimeNs(int64_t timestampNs, const vrs::StreamId& streamId) {
-  const int numData = dataProvider_->getNumData(streamId);
-  int startIndex = dataProvider_->getIndexByTimeNs(
-      streamId, timestampNs, TimeDomain::DeviceTime, TimeQueryOptions::After);
-
-  int64_t playbackStartTime = timestampNs;
-  auto systemStartTime = std::chrono::steady_clock::now();
-  for (size_t i = startIndex; i < numData; ++i) {
-    if (!visControl_->isPlaying_ || visControl_->shouldClose_) {
-      return;
-    }
-
-    auto sensorData = dataProvider_->getSensorDataByIndex(streamId, i);
-    visData_->updateData(sensorData);
-
-    const int64_t currentTimestampNs = sensorData.getTimeNs(TimeDomain::DeviceTime);
-
-    if (visControl_->timestampNs_ < currentTimestampNs) {
-      visControl_->timestampNs_ = currentTimestampNs;
-    }
-    auto sensorTimeDiffNs = currentTimestampNs - playbackStartTime;
-    auto systemDiffNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                            std::chrono::steady_clock::now() - systemStartTime)
-                            .count();
-    auto waitTimeNs =
-        sensorTimeDiffNs - static_cast<int64_t>(systemDiffNs * visControl_->playbackSpeed_);
-
-    // Sleep for waitTimeNs and check if the viewer gets interupted during the sleep period
-    // This prevents the viewer from doing nothing if waitTimeNs is too long, which happens when
-    // playbackSpeed is set to too high and the renderer cannot catch up
-    for (int64_t timer = 0; timer < waitTimeNs - kSleepInteruptPeriodNs;
-         timer += kSleepInteruptPeriodNs) {
-      std::this_thread::sleep_for(std::chrono::nanoseconds(kSleepInteruptPeriodNs));
-      if (!visControl_->isPlaying_ || visControl_->shouldClose_) {
-        return;
-      }
-    }
-    std::this_thread::sleep_for(std::chrono::nanoseconds(waitTimeNs % kSleepInteruptPeriodNs));
+    fmt::print(
+        stdout,
+        "{}: {:.1f} fps, {} delivered, {} dropped\n",
+        dataProvider_->getLabelFromStreamId(streamId).value_or(streamId.getName()),
+        stats.achievedFps,
+        stats.numDelivered,
+        stats.numDropped);
   }
 }
 
@@ -117,6 +155,8 @@ std::shared_ptr<AriaPlayer> createAriaPlayer(
   if (!dataProvider) {
     return nullptr;
   }
+  // the playback reads the records of each stream in order
+  dataProvider->setAccessPattern(AccessPattern::Sequential);
 
   fmt::print(stdout, "Opened '{}'.\n", vrsPath);
 
@@ -17,6 +17,11 @@
 #pragma once
 
 #include "AriaVisualizationControlAndData.h"
+#include "PlaybackScheduler.h"
+
+// Range of the playback speed, relative to real time
+constexpr float kMinPlaybackSpeed = 0.25f;
+constexpr float kMaxPlaybackSpeed = 16.f;
 
 class AriaPlayer {
  public:
@@ -26,6 +31,9 @@ class AriaPlayer {
       std::shared_ptr<AriaVisualizationControl> visControl);
   virtual ~AriaPlayer() = default;
 
+  // Plays the data along the clock of the playback until the viewer closes: while playing, the
+  // playhead advances from visControl->timestampNs_ at visControl->playbackSpeed_, and a change of
+  // timestampNs_ by the viewer seeks to it
   void run();
 
   std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider> getDataProviderPtr() {
@@ -38,16 +46,24 @@ class AriaPlayer {
     return visControl_;
   }
 
+  // Achieved frame rate and dropped frames of each stream since the playback last started
+  std::map<vrs::StreamId, StreamPlaybackStats> getPlaybackStats() const {
+    return scheduler_->getStats();
+  }
+
  protected:
-  virtual void playFromTimeNsMultiThread(int64_t timestampNs);
+  // Updates the data played at timestampNs while playing
+  virtual void updatePlayhead(int64_t timestampNs);
+  // Updates the images at timestampNs while the playback is paused
   virtual void updateImagesStatic(int64_t timestampNs);
 
-  void playStreamFromTimeNs(int64_t timestampNs, const vrs::StreamId& streamId);
+  void printPlaybackStats() const;
 
  protected:
   std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider> dataProvider_;
   std::shared_ptr<AriaVisualizationData> visData_;
   std::shared_ptr<AriaVisualizationControl> visControl_;
+  std::unique_ptr<PlaybackScheduler> scheduler_;
 };
 
 std::shared_ptr<AriaPlayer> createAriaPlayer(
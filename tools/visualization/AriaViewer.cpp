@@ -106,8 +106,8 @@ void AriaViewer::addControlPanel(std::shared_ptr<VrsDataProvider> dataProvider)
       static_cast<float>(dataProvider->getLastTimeNsAllStreams(TimeDomain::DeviceTime)) * 1e-9;
   timestampSec_ = std::make_unique<pangolin::Var<float>>(
       prefix + ".timestamp(s)", startTime, startTime, endTime);
-  playbackSpeed_ =
-      std::make_unique<pangolin::Var<float>>(prefix + ".playback speed", 1.0, 0.01, 10.0);
+  playbackSpeed_ = std::make_unique<pangolin::Var<float>>(
+      prefix + ".playback speed", 1.0, kMinPlaybackSpeed, kMaxPlaybackSpeed);
 
   pangolin::Var<std::function<void(void)>> save_window(prefix + ".Snapshot UI", [&]() {
     std::ostringstream filename;
@@ -263,11 +263,12 @@ void AriaViewer::updateGuiAndControl() {
     *isPlaying_ = ariaVisControl_->isPlaying_;
   }
 
-  if (timestampSec_->GuiChanged() || playbackSpeed_->GuiChanged()) { // triggers random access mode
+  if (playbackSpeed_->GuiChanged()) { // applied by the player without interrupting the playback
     ariaVisControl_->playbackSpeed_ = *playbackSpeed_;
+  }
 
-    ariaVisControl_->isPlaying_ = false;
-    *isPlaying_ = false;
+  if (timestampSec_->GuiChanged()) { // seeks, playing from the new timestamp if playing
+    ariaVisControl_->timestampNs_ = static_cast<int64_t>(*timestampSec_ * 1e9);
     for (const auto& it : streamIdToDataLog_) {
       it.second->Clear();
     }
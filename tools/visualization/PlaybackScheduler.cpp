@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PlaybackScheduler.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+using namespace projectaria::tools::data_provider;
+
+namespace {
+// image frames are large and are dropped when late, only the next few are read ahead
+constexpr int kMaxFramesReadAhead = 4;
+constexpr int kMaxSamplesReadAhead = 512;
+constexpr auto kFpsWindow = std::chrono::seconds(1);
+} // namespace
+
+PlaybackScheduler::PlaybackScheduler(
+    std::shared_ptr<VrsDataProvider> dataProvider,
+    const std::vector<vrs::StreamId>& streamIds,
+    int numWorkers)
+    : dataProvider_(dataProvider) {
+  for (const auto& streamId : streamIds) {
+    if (!dataProvider_->checkStreamIsActive(streamId)) {
+      continue;
+    }
+    StreamState& stream = streams_.emplace_back();
+    stream.streamId = streamId;
+    stream.timestampsNs = dataProvider_->getTimestampsNs(streamId, TimeDomain::DeviceTime);
+    stream.dropFrames = dataProvider_->checkStreamIsType(streamId, SensorDataType::Image);
+  }
+  for (int i = 0; i < std::max(numWorkers, 1); ++i) {
+    workers_.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+PlaybackScheduler::~PlaybackScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopWorkers_ = true;
+  }
+  jobsCondition_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void PlaybackScheduler::seek(int64_t timestampNs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++generation_;
+  jobs_ = {};
+  for (auto& stream : streams_) {
+    const int index = static_cast<int>(
+        std::lower_bound(stream.timestampsNs.begin(), stream.timestampsNs.end(), timestampNs) -
+        stream.timestampsNs.begin());
+    stream.firstReadIndex = index;
+    stream.nextReadIndex = index;
+    stream.nextDeliverIndex = index;
+    stream.readData.clear();
+    stream.stats = {};
+    stream.deliveryTimes.clear();
+  }
+}
+
+void PlaybackScheduler::advance(
+    int64_t playheadNs,
+    int64_t lookaheadNs,
+    const DeliverCallback& callback) {
+  for (size_t streamIndex = 0; streamIndex < streams_.size(); ++streamIndex) {
+    StreamState& stream = streams_[streamIndex];
+    // data before dueIndex is due at the playhead
+    const int dueIndex = static_cast<int>(
+        std::upper_bound(stream.timestampsNs.begin(), stream.timestampsNs.end(), playheadNs) -
+        stream.timestampsNs.begin());
+
+    if (stream.dropFrames) {
+      // show the newest due frame read so far, the older ones are dropped
+      std::optional<std::pair<int, SensorData>> frame;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = stream.readData.lower_bound(dueIndex);
+        if (it != stream.readData.begin()) {
+          --it;
+          if (it->first >= stream.nextDeliverIndex) {
+            frame.emplace(it->first, std::move(it->second));
+          }
+          stream.readData.erase(stream.readData.begin(), std::next(it));
+        }
+      }
+      if (frame) {
+        deliver(stream, frame->first, std::move(frame->second), callback);
+      }
+    } else {
+      while (stream.nextDeliverIndex < dueIndex) {
+        std::optional<SensorData> sample;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          auto it = stream.readData.find(stream.nextDeliverIndex);
+          if (it == stream.readData.end()) {
+            break;
+          }
+          sample.emplace(std::move(it->second));
+          stream.readData.erase(it);
+        }
+        deliver(stream, stream.nextDeliverIndex, std::move(*sample), callback);
+      }
+    }
+
+    // frames already superseded at the playhead are not worth reading
+    const int firstIndex = stream.dropFrames ? std::max(stream.nextDeliverIndex, dueIndex - 1)
+                                             : stream.nextDeliverIndex;
+    issueReads(stream, streamIndex, firstIndex, playheadNs + lookaheadNs);
+  }
+}
+
+void PlaybackScheduler::issueReads(
+    StreamState& stream,
+    size_t streamIndex,
+    int firstIndex,
+    int64_t endTimeNs) {
+  const int numData = static_cast<int>(stream.timestampsNs.size());
+  const int maxReadAhead = stream.dropFrames ? kMaxFramesReadAhead : kMaxSamplesReadAhead;
+  const int endIndex = std::min(numData, firstIndex + maxReadAhead);
+  stream.nextReadIndex = std::max(stream.nextReadIndex, firstIndex);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stream.firstReadIndex = firstIndex;
+    for (; stream.nextReadIndex < endIndex &&
+         stream.timestampsNs[stream.nextReadIndex] <= endTimeNs;
+         ++stream.nextReadIndex) {
+      jobs_.push(
+          {stream.timestampsNs[stream.nextReadIndex],
+           generation_,
+           streamIndex,
+           stream.nextReadIndex});
+    }
+  }
+  jobsCondition_.notify_all();
+}
+
+void PlaybackScheduler::deliver(
+    StreamState& stream,
+    int index,
+    SensorData&& data,
+    const DeliverCallback& callback) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the data skipped since the last delivery was dropped
+    stream.stats.numDropped += index - stream.nextDeliverIndex;
+    stream.nextDeliverIndex = index + 1;
+  }
+  if (data.sensorDataType() == SensorDataType::NotValid) {
+    return;
+  }
+  callback(data);
+
+  const auto now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stream.stats.numDelivered;
+  stream.deliveryTimes.push_back(now);
+  while (now - stream.deliveryTimes.front() > kFpsWindow) {
+    stream.deliveryTimes.pop_front();
+  }
+}
+
+int64_t PlaybackScheduler::getNextTimeNs() const {
+  int64_t nextTimeNs = std::numeric_limits<int64_t>::max();
+  for (const auto& stream : streams_) {
+    if (stream.nextDeliverIndex < static_cast<int>(stream.timestampsNs.size())) {
+      nextTimeNs = std::min(nextTimeNs, stream.timestampsNs[stream.nextDeliverIndex]);
+    }
+  }
+  return nextTimeNs;
+}
+
+bool PlaybackScheduler::isFinished() const {
+  return getNextTimeNs() == std::numeric_limits<int64_t>::max();
+}
+
+std::map<vrs::StreamId, StreamPlaybackStats> PlaybackScheduler::getStats() const {
+  const auto now = std::chrono::steady_clock::now();
+  std::map<vrs::StreamId, StreamPlaybackStats> stats;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& stream : streams_) {
+    StreamPlaybackStats& streamStats = stats[stream.streamId] = stream.stats;
+    streamStats.achievedFps = std::count_if(
+        stream.deliveryTimes.begin(), stream.deliveryTimes.end(), [&](const auto& time) {
+          return now - time <= kFpsWindow;
+        });
+  }
+  return stats;
+}
+
+void PlaybackScheduler::workerLoop() {
+  while (true) {
+    ReadJob job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      jobsCondition_.wait(lock, [this]() { return stopWorkers_ || !jobs_.empty(); });
+      if (stopWorkers_) {
+        return;
+      }
+      job = jobs_.top();
+      jobs_.pop();
+      // skip the frames superseded since the read was issued
+      if (job.generation != generation_ ||
+          job.index < streams_[job.streamIndex].firstReadIndex) {
+        continue;
+      }
+    }
+    StreamState& stream = streams_[job.streamIndex];
+    SensorData data = dataProvider_->getSensorDataByIndex(stream.streamId, job.index);
+
+    // a frame superseded while it was read is still shown if it is newer than the one shown
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (job.generation == generation_) {
+      stream.readData.emplace(job.index, std::move(data));
+    }
+  }
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <data_provider/VrsDataProvider.h>
+#include <vrs/StreamId.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Playback statistics of a stream since the last seek
+struct StreamPlaybackStats {
+  int64_t numDelivered = 0;
+  // image frames skipped because a newer frame was due before they could be shown
+  int64_t numDropped = 0;
+  // frames delivered per second of wall clock time, over the last second
+  double achievedFps = 0;
+};
+
+/**
+ * @brief Plays the streams of a VRS file along a playhead driven by a single clock. Reads of the
+ * data about to be played are issued ahead of the playhead to a pool of workers, in order of
+ * time across all streams, and the data is delivered once the playhead reaches it. When the
+ * playback falls behind, image frames superseded by a newer due frame are dropped instead of
+ * stalling the playback, while the samples of the other streams are all delivered in order.
+ */
+class PlaybackScheduler {
+ public:
+  using DeliverCallback =
+      std::function<void(const projectaria::tools::data_provider::SensorData&)>;
+
+  // reads are serialized by the data provider, more workers only queue on its reader
+  static constexpr int kDefaultNumWorkers = 2;
+
+  PlaybackScheduler(
+      std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider> dataProvider,
+      const std::vector<vrs::StreamId>& streamIds,
+      int numWorkers = kDefaultNumWorkers);
+  ~PlaybackScheduler();
+
+  PlaybackScheduler(const PlaybackScheduler&) = delete;
+  PlaybackScheduler& operator=(const PlaybackScheduler&) = delete;
+
+  // Restarts the playback of all streams at timestampNs, discarding the data read ahead for the
+  // previous position and resetting the statistics. The workers keep running.
+  void seek(int64_t timestampNs);
+
+  // Delivers the data of all streams up to playheadNs, and issues the reads of the data up to
+  // lookaheadNs after it
+  void advance(int64_t playheadNs, int64_t lookaheadNs, const DeliverCallback& deliver);
+
+  // Timestamp of the next data to deliver, or INT64_MAX when all streams were played
+  int64_t getNextTimeNs() const;
+  bool isFinished() const;
+
+  std::map<vrs::StreamId, StreamPlaybackStats> getStats() const;
+
+ private:
+  struct StreamState {
+    vrs::StreamId streamId;
+    std::vector<int64_t> timestampsNs;
+    bool dropFrames = false;
+    // data before firstReadIndex is delivered or superseded, guarded by mutex_
+    int firstReadIndex = 0;
+    int nextReadIndex = 0;
+    // written under mutex_, read without it by the playback thread that writes it
+    int nextDeliverIndex = 0;
+    // data read ahead, by index, guarded by mutex_
+    std::map<int, projectaria::tools::data_provider::SensorData> readData;
+    // guarded by mutex_, as getStats() may be called from any thread
+    StreamPlaybackStats stats;
+    std::deque<std::chrono::steady_clock::time_point> deliveryTimes;
+  };
+
+  struct ReadJob {
+    int64_t timestampNs;
+    uint64_t generation;
+    size_t streamIndex;
+    int index;
+
+    // the earliest job is at the top of the queue
+    bool operator<(const ReadJob& other) const {
+      return timestampNs > other.timestampNs;
+    }
+  };
+
+  // issues the reads from firstIndex to endTimeNs that were not issued yet
+  void issueReads(StreamState& stream, size_t streamIndex, int firstIndex, int64_t endTimeNs);
+  void deliver(
+      StreamState& stream,
+      int index,
+      projectaria::tools::data_provider::SensorData&& data,
+      const DeliverCallback& callback);
+  void workerLoop();
+
+  std::shared_ptr<projectaria::tools::data_provider::VrsDataProvider> dataProvider_;
+  std::vector<StreamState> streams_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable jobsCondition_;
+  std::priority_queue<ReadJob> jobs_;
+  // incremented by each seek, to discard the reads issued before it
+  std::atomic<uint64_t> generation_ = 0;
+  bool stopWorkers_ = false;
+  std::vector<std::thread> workers_;
+};
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DownscaleFilter.h"
+
+#include <stdexcept>
+
+#include <fmt/core.h>
+#include <image/utility/Resize.h>
+
+namespace projectaria::tools::vrs_downscale {
+
+using vrs::datalayout_conventions::ImageSpecType;
+
+uint32_t getResizableChannelCount(vrs::PixelFormat pixelFormat) {
+  switch (pixelFormat) {
+    case vrs::PixelFormat::GREY8:
+      return 1;
+    case vrs::PixelFormat::RGB8:
+      return 3;
+    default:
+      throw std::runtime_error(fmt::format("Can't resize {} images", vrs::toString(pixelFormat)));
+  }
+}
+
+bool ResizeImageMutator::operator()(
+    double /*timestamp*/,
+    const vrs::StreamId& streamId,
+    vrs::utils::PixelFrame* frame) {
+  if (!frame) {
+    return false;
+  }
+  const ImageResolution& resolution = resolutions_.at(streamId);
+  const uint32_t channels = getResizableChannelCount(frame->getPixelFormat());
+  vrs::utils::PixelFrame resized(
+      vrs::ImageContentBlockSpec(frame->getPixelFormat(), resolution.width, resolution.height));
+  image::resizeAreaU8(
+      frame->rdata(),
+      frame->getWidth(),
+      frame->getHeight(),
+      frame->getStride(),
+      channels,
+      resized.wdata(),
+      resolution.width,
+      resolution.height,
+      resized.getStride());
+  *frame = std::move(resized);
+  return true;
+}
+
+void DownscaleFilter::doDataLayoutEdits(
+    const vrs::CurrentRecord& record,
+    size_t /*blockIndex*/,
+    vrs::DataLayout& dl) {
+  if (!resolution_ || record.recordType != vrs::Record::Type::CONFIGURATION) {
+    return;
+  }
+  auto* width = dl.findDataPieceValue<ImageSpecType>(vrs::datalayout_conventions::kImageWidth);
+  auto* height = dl.findDataPieceValue<ImageSpecType>(vrs::datalayout_conventions::kImageHeight);
+  auto* stride = dl.findDataPieceValue<ImageSpecType>(vrs::datalayout_conventions::kImageStride);
+  if (width == nullptr || height == nullptr || width->get() == 0) {
+    return;
+  }
+  // Resized RAW frames are packed
+  if (stride != nullptr && stride->get() > 0) {
+    stride->set(resolution_->width * (stride->get() / width->get()));
+  }
+  width->set(resolution_->width);
+  height->set(resolution_->height);
+}
+
+void DownscaleFilter::filterImage(
+    const vrs::CurrentRecord& record,
+    size_t blockIndex,
+    const vrs::ContentBlock& cb,
+    std::vector<uint8_t>& pixels) {
+  const auto& imageSpec = cb.image();
+  if (!resolution_ || imageSpec.getImageFormat() != vrs::ImageFormat::RAW) {
+    ImageMutationFilter::filterImage(record, blockIndex, cb, pixels);
+    return;
+  }
+  // RAW frames don't need decoding, they are resized synchronously
+  const uint32_t channels = getResizableChannelCount(imageSpec.getPixelFormat());
+  const size_t stride = static_cast<size_t>(resolution_->width) * channels;
+  std::vector<uint8_t> resized(stride * resolution_->height);
+  image::resizeAreaU8(
+      pixels.data(),
+      imageSpec.getWidth(),
+      imageSpec.getHeight(),
+      imageSpec.getStride(),
+      channels,
+      resized.data(),
+      resolution_->width,
+      resolution_->height,
+      stride);
+  pixels.swap(resized);
+}
+
+} // namespace projectaria::tools::vrs_downscale
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include <vrs/DataLayoutConventions.h>
+#include <vrs/StreamId.h>
+#include <vrs/utils/PixelFrame.h>
+
+#include "ImageMutationFilterCopier.h"
+#include "ImageMutationPipeline.h"
+#include "UserDefinedImageMutator.h"
+
+namespace projectaria::tools::vrs_downscale {
+
+struct ImageResolution {
+  uint32_t width = 0;
+  uint32_t height = 0;
+};
+
+// Number of channels of the 8 bit pixel formats that can be resized
+uint32_t getResizableChannelCount(vrs::PixelFormat pixelFormat);
+
+// Resizes the decoded frames of each stream to its output resolution
+class ResizeImageMutator : public vrs::utils::UserDefinedImageMutator {
+ public:
+  explicit ResizeImageMutator(std::map<vrs::StreamId, ImageResolution> resolutions)
+      : resolutions_(std::move(resolutions)) {}
+
+  bool operator()(double timestamp, const vrs::StreamId& streamId, vrs::utils::PixelFrame* frame)
+      override;
+
+  bool isThreadSafe() const override {
+    return true;
+  }
+
+ private:
+  const std::map<vrs::StreamId, ImageResolution> resolutions_;
+};
+
+// Copies a stream verbatim, or with its images resized to the given resolution: JPG frames are
+// collected from the pipeline, RAW frames are resized on the copy thread, and the image size of
+// the configuration records is updated.
+class DownscaleFilter : public vrs::utils::ImageMutationFilter {
+ public:
+  DownscaleFilter(
+      vrs::RecordFileReader& fileReader,
+      vrs::RecordFileWriter& fileWriter,
+      vrs::StreamId id,
+      const vrs::utils::CopyOptions& copyOptions,
+      vrs::utils::UserDefinedImageMutator* mutator,
+      vrs::utils::ImageMutationPipeline* pipeline,
+      std::optional<ImageResolution> resolution)
+      : ImageMutationFilter(fileReader, fileWriter, id, copyOptions, mutator, pipeline),
+        resolution_(resolution) {}
+
+  bool shouldCopyVerbatim(const vrs::CurrentRecord& record) override {
+    return !resolution_ || ImageMutationFilter::shouldCopyVerbatim(record);
+  }
+
+  void doDataLayoutEdits(const vrs::CurrentRecord& record, size_t blockIndex, vrs::DataLayout& dl)
+      override;
+
+  void filterImage(
+      const vrs::CurrentRecord& record,
+      size_t blockIndex,
+      const vrs::ContentBlock& cb,
+      std::vector<uint8_t>& pixels) override;
+
+ private:
+  const std::optional<ImageResolution> resolution_;
+};
+
+} // namespace projectaria::tools::vrs_downscale
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VrsDownscale.h"
+
+#include <memory>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <calibration/loader/AriaCalibRescaleAndCrop.h>
+#include <calibration/loader/DeviceCalibrationJson.h>
+#include <data_layout/ImageSensorMetadata.h>
+#include <data_provider/StreamIdLabelMapper.h>
+#include <fmt/core.h>
+#include <vrs/RecordFormatStreamPlayer.h>
+#include <vrs/utils/CopyHelpers.h>
+#include <vrs/utils/FilterCopy.h>
+#include <vrs/utils/FilteredFileReader.h>
+
+#include "DownscaleFilter.h"
+
+#define DEFAULT_LOG_CHANNEL "VrsDownscale"
+#include <logging/Log.h>
+
+namespace projectaria::tools::vrs_downscale {
+
+namespace {
+
+constexpr const char* kCalibJsonTag = "calib_json";
+constexpr const char* kEtLabel = "camera-et";
+
+// Reads the image resolution of a camera configuration record
+class ImageConfigReader : public vrs::RecordFormatStreamPlayer {
+ public:
+  bool onDataLayoutRead(const vrs::CurrentRecord& /*r*/, size_t blockIndex, vrs::DataLayout& dl)
+      override {
+    auto& config = getExpectedLayout<datalayout::ImageSensorConfigRecordMetadata>(dl, blockIndex);
+    resolution.width = config.imageWidth.get();
+    resolution.height = config.imageHeight.get();
+    return true;
+  }
+
+  ImageResolution resolution;
+};
+
+struct StreamResize {
+  std::string label;
+  ImageResolution source;
+  ImageResolution output;
+};
+
+std::map<vrs::StreamId, StreamResize> getStreamResizes(
+    vrs::RecordFileReader& reader,
+    const DownscaleOptions& options) {
+  const auto streamIdLabelMapper = data_provider::getAriaStreamIdLabelMapper();
+  std::map<vrs::StreamId, StreamResize> resizes;
+  for (const auto& [label, width] : options.imageWidths) {
+    const auto streamId = streamIdLabelMapper->getStreamIdFromLabel(label);
+    if (!streamId || reader.getStreams().count(*streamId) == 0) {
+      throw std::runtime_error(fmt::format("No {} stream to downscale", label));
+    }
+    ImageConfigReader configReader;
+    if (!reader.readFirstConfigurationRecord(*streamId, &configReader) ||
+        configReader.resolution.width == 0) {
+      throw std::runtime_error(fmt::format("Can't read the image size of {}", label));
+    }
+    const ImageResolution& source = configReader.resolution;
+    // The calibration can only be rescaled isometrically, and each eye of the ET stream separately
+    const uint64_t scaledHeight = static_cast<uint64_t>(source.height) * width;
+    if (width == 0 || width > source.width || scaledHeight % source.width != 0 ||
+        (label == kEtLabel && width % 2 != 0)) {
+      throw std::runtime_error(fmt::format(
+          "Can't downscale {} from {}x{} to a width of {} with the same aspect ratio",
+          label,
+          source.width,
+          source.height,
+          width));
+    }
+    const ImageResolution output{width, static_cast<uint32_t>(scaledHeight / source.width)};
+    resizes.emplace(*streamId, StreamResize{label, source, output});
+  }
+  return resizes;
+}
+
+// Rescales the camera calibrations to the output resolutions. Calibrations that are not at the
+// resolution of the recording are first cropped and scaled the way VrsDataProvider does.
+std::string rescaleCalibration(
+    const std::string& calibJsonStr,
+    const std::map<vrs::StreamId, StreamResize>& resizes) {
+  auto maybeDeviceCalib = calibration::deviceCalibrationFromJson(calibJsonStr);
+  if (!maybeDeviceCalib) {
+    throw std::runtime_error("Can't parse the calib json");
+  }
+  calibration::DeviceCalibration& deviceCalib = *maybeDeviceCalib;
+  std::vector<calibration::CameraCalibration> rescaledCalibs;
+  for (const auto& [streamId, resize] : resizes) {
+    const bool isEt = resize.label == kEtLabel;
+    const std::vector<std::string> cameraLabels = isEt
+        ? std::vector<std::string>{"camera-et-left", "camera-et-right"}
+        : std::vector<std::string>{resize.label};
+    const int eyeCount = isEt ? 2 : 1;
+    const Eigen::Vector2i sourceSize(resize.source.width / eyeCount, resize.source.height);
+    const Eigen::Vector2i outputSize(resize.output.width / eyeCount, resize.output.height);
+    for (const auto& cameraLabel : cameraLabels) {
+      auto camCalib = deviceCalib.getCameraCalib(cameraLabel);
+      if (!camCalib) {
+        XR_LOGW("No calibration for {}, it is left as is", cameraLabel);
+        continue;
+      }
+      if (camCalib->getImageSize() != sourceSize) {
+        calibration::tryCropAndScaleCameraCalibration(deviceCalib, {{cameraLabel, sourceSize}});
+        camCalib = deviceCalib.getCameraCalib(cameraLabel);
+      }
+      rescaledCalibs.push_back(
+          camCalib->rescale(outputSize, static_cast<double>(outputSize.x()) / sourceSize.x()));
+    }
+  }
+  return calibration::updateCameraCalibrationsInJson(calibJsonStr, rescaledCalibs);
+}
+
+} // namespace
+
+vrs::utils::ImageMutationPipelineStats downscaleVrs(
+    const std::string& inputPath,
+    const std::string& outputPath,
+    const DownscaleOptions& options) {
+  if (inputPath == outputPath) {
+    throw std::runtime_error("The input and output paths must be different");
+  }
+  vrs::utils::FilteredFileReader filteredReader;
+  filteredReader.setSource(inputPath);
+  if (filteredReader.openFile() != 0) {
+    throw std::runtime_error(fmt::format("Can't open '{}'", inputPath));
+  }
+  filteredReader.applyFilters({});
+
+  const auto resizes = getStreamResizes(filteredReader.reader, options);
+  std::map<vrs::StreamId, ImageResolution> outputResolutions;
+  std::set<vrs::StreamId> resizedStreams;
+  for (const auto& [streamId, resize] : resizes) {
+    outputResolutions.emplace(streamId, resize.output);
+    resizedStreams.insert(streamId);
+  }
+
+  std::string calibJsonStr = filteredReader.reader.getTag(kCalibJsonTag);
+  if (calibJsonStr.empty()) {
+    XR_LOGW("{} has no {} tag, no calibration to rescale", inputPath, kCalibJsonTag);
+  } else {
+    calibJsonStr = rescaleCalibration(calibJsonStr, resizes);
+  }
+
+  ResizeImageMutator mutator(outputResolutions);
+  vrs::utils::ImageMutationPipeline pipeline(inputPath, resizedStreams, &mutator, options.pipeline);
+
+  auto makeStreamFilter = [&](vrs::RecordFileReader& fileReader,
+                              vrs::RecordFileWriter& fileWriter,
+                              vrs::StreamId streamId,
+                              const vrs::utils::CopyOptions& copyOptions)
+      -> std::unique_ptr<vrs::utils::RecordFilterCopier> {
+    std::optional<ImageResolution> resolution;
+    if (const auto resolutionIt = outputResolutions.find(streamId);
+        resolutionIt != outputResolutions.end()) {
+      resolution = resolutionIt->second;
+    }
+    return std::make_unique<DownscaleFilter>(
+        fileReader, fileWriter, streamId, copyOptions, &mutator, &pipeline, resolution);
+  };
+
+  vrs::utils::CopyOptions copyOptions;
+  copyOptions.setCompressionPreset(vrs::CompressionPreset::Default);
+  if (!calibJsonStr.empty()) {
+    // Replaces the source tag once the file tags are copied
+    copyOptions.tagOverrider = std::make_unique<vrs::utils::TagOverrider>();
+    copyOptions.tagOverrider->fileTags[kCalibJsonTag] = calibJsonStr;
+  }
+  const int status = filterCopy(filteredReader, outputPath, copyOptions, makeStreamFilter);
+  if (status != 0) {
+    throw std::runtime_error(fmt::format("Failed to write '{}': {}", outputPath, status));
+  }
+  return pipeline.getStats();
+}
+
+} // namespace projectaria::tools::vrs_downscale
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "ImageMutationPipeline.h"
+
+namespace projectaria::tools::vrs_downscale {
+
+struct DownscaleOptions {
+  // Width of the output images, by stream label: "camera-rgb", "camera-slam-left",
+  // "camera-slam-right", or "camera-et" for both eyes. The height keeps the aspect ratio, and must
+  // be a whole number of pixels.
+  std::map<std::string, uint32_t> imageWidths;
+  // Threads, read-ahead and JPEG quality of the re-encoded frames
+  vrs::utils::ImageMutationPipelineOptions pipeline;
+};
+
+/**
+ * @brief Copies a VRS file with its image streams downscaled, e.g. to cache training data at the
+ * resolution it is used at. Images are resized with an area filter and re-encoded in parallel,
+ * the other streams are copied verbatim, and the camera calibrations of the calib_json tag are
+ * rescaled, so the copy opens with createVrsDataProvider(). The images don't depend on the number
+ * of threads.
+ * @param inputPath the VRS file to downscale
+ * @param outputPath the VRS file to write
+ * @param options the output resolutions and the pipeline options
+ * @return the statistics of the image pipeline
+ */
+vrs::utils::ImageMutationPipelineStats downscaleVrs(
+    const std::string& inputPath,
+    const std::string& outputPath,
+    const DownscaleOptions& options);
+
+} // namespace projectaria::tools::vrs_downscale
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include <fmt/core.h>
+
+#include <CLI/CLI.hpp>
+
+#include "VrsDownscale.h"
+
+using namespace projectaria::tools::vrs_downscale;
+
+int main(int argc, const char* argv[]) {
+  std::string vrsPathIn;
+  std::string vrsPathOut;
+  uint32_t rgbWidth = 0;
+  uint32_t slamWidth = 0;
+  uint32_t etWidth = 0;
+  DownscaleOptions options;
+
+  CLI::App app{
+      "Copies an Aria VRS file with its images downscaled and its calibration rescaled, e.g. to "
+      "cache training data"};
+  app.add_option("-i,--in", vrsPathIn, "VRS input")->required();
+  app.add_option("-o,--out", vrsPathOut, "VRS output")->required();
+  app.add_option("--rgb-width", rgbWidth, "Width of the output RGB images");
+  app.add_option("--slam-width", slamWidth, "Width of the output SLAM images");
+  app.add_option("--et-width", etWidth, "Width of one eye in the output ET images");
+  app.add_option(
+         "-j,--threads",
+         options.pipeline.numThreads,
+         "Number of threads decoding, resizing and re-encoding frames, 0 for one per core")
+      ->capture_default_str();
+  app.add_option(
+         "--max-frames-in-flight",
+         options.pipeline.maxFramesInFlight,
+         "Maximum number of frames resized ahead of the copy, 0 for 4 per thread")
+      ->capture_default_str();
+  app.add_option("--jpeg-quality", options.pipeline.jpegQuality, "Quality of the JPEG frames")
+      ->check(CLI::Range(1, 100))
+      ->capture_default_str();
+
+  CLI11_PARSE(app, argc, argv);
+
+  if (rgbWidth > 0) {
+    options.imageWidths["camera-rgb"] = rgbWidth;
+  }
+  if (slamWidth > 0) {
+    options.imageWidths["camera-slam-left"] = slamWidth;
+    options.imageWidths["camera-slam-right"] = slamWidth;
+  }
+  if (etWidth > 0) {
+    options.imageWidths["camera-et"] = 2 * etWidth;
+  }
+  if (options.imageWidths.empty()) {
+    std::cerr << "Specify at least one of --rgb-width, --slam-width or --et-width." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    const auto stats = downscaleVrs(vrsPathIn, vrsPathOut, options);
+    fmt::print("{}\n", stats.toString());
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VrsDownscale.h"
+
+#include <benchmarks/SyntheticAriaRecording.h>
+#include <data_provider/VrsDataProvider.h>
+#include <vrs/RecordFileReader.h>
+#include <vrs/StreamPlayer.h>
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace projectaria::tools::vrs_downscale;
+using namespace projectaria::tools::benchmarks;
+using namespace projectaria::tools::data_provider;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct RecordContent {
+  double timestamp;
+  vrs::StreamId streamId;
+  vrs::Record::Type recordType;
+  std::vector<uint8_t> bytes;
+
+  bool operator==(const RecordContent& other) const {
+    return timestamp == other.timestamp && streamId == other.streamId &&
+        recordType == other.recordType && bytes == other.bytes;
+  }
+};
+
+// Collects the uncompressed content of all the records of a file
+class RecordCollector : public vrs::StreamPlayer {
+ public:
+  bool processRecordHeader(const vrs::CurrentRecord& record, vrs::DataReference& outDataReference)
+      override {
+    records.push_back({record.timestamp, record.streamId, record.recordType, {}});
+    records.back().bytes.resize(record.recordSize);
+    outDataReference.useVector(records.back().bytes);
+    return true;
+  }
+
+  void processRecord(const vrs::CurrentRecord& /*record*/, uint32_t /*readSize*/) override {}
+
+  std::vector<RecordContent> records;
+};
+
+std::vector<RecordContent> readAllRecordContents(const std::string& path) {
+  vrs::RecordFileReader reader;
+  EXPECT_EQ(reader.openFile(path), 0);
+  RecordCollector collector;
+  for (const auto& streamId : reader.getStreams()) {
+    reader.setStreamPlayer(streamId, &collector);
+  }
+  EXPECT_EQ(reader.readAllRecords(), 0);
+  return collector.records;
+}
+
+std::map<std::string, std::string> readFileTags(const std::string& path) {
+  vrs::RecordFileReader reader;
+  EXPECT_EQ(reader.openFile(path), 0);
+  return reader.getTags();
+}
+
+} // namespace
+
+TEST(VrsDownscale, SameOutputForAnyThreadCount) {
+  const fs::path testDir = fs::temp_directory_path() / "vrs_downscale_test";
+  fs::remove_all(testDir);
+  fs::create_directories(testDir);
+  const std::string inputPath = (testDir / "input.vrs").string();
+  SyntheticRecordingOptions recordingOptions;
+  recordingOptions.durationSec = 1;
+  recordingOptions.et.encoding = SyntheticImageEncoding::Jpeg;
+  writeSyntheticAriaRecording(inputPath, recordingOptions);
+
+  DownscaleOptions options;
+  options.imageWidths = {
+      {"camera-rgb", 704},
+      {"camera-slam-left", 320},
+      {"camera-slam-right", 320},
+      {"camera-et", 320}};
+
+  options.pipeline.numThreads = 1;
+  const std::string singleThreadPath = (testDir / "single_thread.vrs").string();
+  const auto singleThreadStats = downscaleVrs(inputPath, singleThreadPath, options);
+
+  options.pipeline.numThreads = 4;
+  options.pipeline.maxFramesInFlight = 3;
+  const std::string multiThreadPath = (testDir / "multi_thread.vrs").string();
+  const auto multiThreadStats = downscaleVrs(inputPath, multiThreadPath, options);
+
+  // The RGB and ET frames are JPEG, so they go through the pipeline
+  EXPECT_EQ(singleThreadStats.frameCount + singleThreadStats.synchronousFrameCount, 20);
+  EXPECT_EQ(multiThreadStats.frameCount + multiThreadStats.synchronousFrameCount, 20);
+
+  // The VRS file header holds a creation id, so the files are compared record by record
+  EXPECT_EQ(readFileTags(singleThreadPath), readFileTags(multiThreadPath));
+  const auto singleThreadRecords = readAllRecordContents(singleThreadPath);
+  const auto multiThreadRecords = readAllRecordContents(multiThreadPath);
+  ASSERT_EQ(singleThreadRecords.size(), readAllRecordContents(inputPath).size());
+  ASSERT_EQ(singleThreadRecords.size(), multiThreadRecords.size());
+  for (size_t i = 0; i < singleThreadRecords.size(); ++i) {
+    EXPECT_TRUE(singleThreadRecords[i] == multiThreadRecords[i])
+        << "Record " << i << " of " << singleThreadRecords[i].streamId.getName() << " at "
+        << singleThreadRecords[i].timestamp;
+  }
+
+  // The output opens with the image sizes and the calibrations rescaled together
+  auto inputProvider = createVrsDataProvider(inputPath);
+  auto outputProvider = createVrsDataProvider(multiThreadPath);
+  ASSERT_TRUE(inputProvider);
+  ASSERT_TRUE(outputProvider);
+  const auto inputCalib = inputProvider->getDeviceCalibration().value();
+  const auto outputCalib = outputProvider->getDeviceCalibration().value();
+  const auto expectRescaled = [&](const std::string& streamLabel,
+                                  const std::vector<std::string>& cameraLabels,
+                                  const Eigen::Vector2i& expectedImageSize) {
+    const auto streamId = outputProvider->getStreamIdFromLabel(streamLabel).value();
+    const auto image = outputProvider->getImageDataByIndex(streamId, 0).first;
+    ASSERT_TRUE(image.isValid()) << streamLabel;
+    EXPECT_EQ(image.getWidth(), expectedImageSize.x()) << streamLabel;
+    EXPECT_EQ(image.getHeight(), expectedImageSize.y()) << streamLabel;
+    const auto& imageConfig = outputProvider->getConfiguration(streamId).imageConfiguration();
+    EXPECT_EQ(imageConfig.imageWidth, expectedImageSize.x()) << streamLabel;
+    EXPECT_EQ(imageConfig.imageHeight, expectedImageSize.y()) << streamLabel;
+
+    // The ET frames hold both eyes side by side
+    const Eigen::Vector2i cameraSize(
+        expectedImageSize.x() / static_cast<int>(cameraLabels.size()), expectedImageSize.y());
+    for (const auto& cameraLabel : cameraLabels) {
+      const auto camCalib = outputCalib.getCameraCalib(cameraLabel).value();
+      EXPECT_EQ(camCalib.getImageSize(), cameraSize) << cameraLabel;
+      const auto sourceCalib = inputCalib.getCameraCalib(cameraLabel).value();
+      const auto expectedCalib = sourceCalib.rescale(
+          cameraSize, static_cast<double>(cameraSize.x()) / sourceCalib.getImageSize().x());
+      EXPECT_TRUE(camCalib.projectionParams().isApprox(expectedCalib.projectionParams()))
+          << cameraLabel;
+    }
+  };
+  expectRescaled("camera-rgb", {"camera-rgb"}, {704, 704});
+  expectRescaled("camera-slam-left", {"camera-slam-left"}, {320, 240});
+  expectRescaled("camera-slam-right", {"camera-slam-right"}, {320, 240});
+  expectRescaled("camera-et", {"camera-et-left", "camera-et-right"}, {320, 120});
+
+  inputProvider.reset();
+  outputProvider.reset();
+  fs::remove_all(testDir);
+}